@@ -236,7 +236,7 @@ impl TableType {
 #[cfg(test)]
 mod tests {
     use super::*;
-    use crate::{RefType, ValType};
+    use crate::{FuncType, Function, RefType, ValType};
 
     #[test]
     fn test_table_type() {
@@ -308,14 +308,26 @@ mod tests {
         assert!(value.is_null_ref());
         assert_eq!(value.ty(), ValType::FuncRef);
 
+        // create a host function
+        let result = FuncType::create(vec![], vec![]);
+        assert!(result.is_ok());
+        let func_ty = result.unwrap();
+        let result = Function::create(func_ty, Box::new(real_nop), 0);
+        assert!(result.is_ok());
+        let host_func = result.unwrap();
+
         // set data
-        let result = table.set_data(Value::from_func_ref(5), 3);
+        let result = table.set_data(Value::from_func_ref(&host_func), 3);
         assert!(result.is_ok());
         // get data
         let result = table.get_data(3);
         assert!(result.is_ok());
-        let idx = result.unwrap().func_idx();
-        assert!(idx.is_some());
-        assert_eq!(idx.unwrap(), 5);
+        let func = result.unwrap().func_ref();
+        assert!(func.is_some());
+        assert_eq!(func.unwrap().ctx, host_func.ctx);
+    }
+
+    fn real_nop(_: Vec<Value>) -> Result<Vec<Value>, u8> {
+        Ok(vec![])
     }
 }
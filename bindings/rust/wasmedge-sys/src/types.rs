@@ -1,6 +1,6 @@
 //! Defines the WebAssembly primitive types.
 
-use crate::wasmedge;
+use crate::{wasmedge, Function};
 use core::ffi::c_void;
 use std::{ffi::CString, fmt, str::FromStr};
 
@@ -452,24 +452,27 @@ impl Value {
     ///
     /// # Argument
     ///
-    /// - `idx` specifies the function index.
-    pub fn from_func_ref(idx: u32) -> Self {
+    /// - `func` specifies the [function](crate::Function) to refer to, which must outlive the [`Value`].
+    pub fn from_func_ref(func: &Function) -> Self {
         Self {
-            raw: unsafe { wasmedge::WasmEdge_ValueGenFuncRef(idx) },
+            raw: unsafe { wasmedge::WasmEdge_ValueGenFuncRefFromInstance(func.ctx) },
             ty: ValType::FuncRef,
         }
     }
 
-    /// Returns the function index.
+    /// Returns the referred [function](crate::Function).
     ///
     /// If the [`Value`] is a `NullRef`, then `None` is returned.
-    pub fn func_idx(&self) -> Option<u32> {
+    pub fn func_ref(&self) -> Option<Function> {
         unsafe {
             match wasmedge::WasmEdge_ValueIsNullRef(self.raw) {
                 true => None,
                 false => {
-                    let idx = wasmedge::WasmEdge_ValueGetFuncIdx(self.raw);
-                    Some(idx)
+                    let ctx = wasmedge::WasmEdge_ValueGetFuncRef(self.raw);
+                    Some(Function {
+                        ctx: ctx as *mut _,
+                        registered: true,
+                    })
                 }
             }
         }
@@ -33,6 +33,7 @@ public:
   void compile(const AST::ExportSection &ExportSection);
   void compile(const AST::TypeSection &TypeSection);
   void compile(const AST::GlobalSection &GlobalSection);
+  void compile(const AST::TagSection &TagSection);
   void compile(const AST::MemorySection &MemorySection,
                const AST::DataSection &DataSection);
   void compile(const AST::TableSection &TableSection,
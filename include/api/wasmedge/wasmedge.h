@@ -26,6 +26,12 @@
 #define WASMEDGE_CAPI_EXPORT __attribute__((visibility("default")))
 #endif // _WIN32
 
+#if defined(_MSC_VER)
+#define WASMEDGE_CAPI_DEPRECATED(Msg) __declspec(deprecated(Msg))
+#else
+#define WASMEDGE_CAPI_DEPRECATED(Msg) __attribute__((deprecated(Msg)))
+#endif // _MSC_VER
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -235,12 +241,32 @@ WasmEdge_ValueGenNullRef(const enum WasmEdge_RefType T);
 /// `WasmEdge_Proposal_BulkMemoryOperations` or the
 /// `WasmEdge_Proposal_ReferenceTypes` turns on in configuration.
 ///
-/// \param Index the function index.
+/// This function is deprecated. The reference refers to the function address
+/// in the store which executes it. Use the
+/// `WasmEdge_ValueGenFuncRefFromInstance` instead.
+///
+/// \param Index the function address.
 ///
 /// \returns WasmEdge_Value struct with the function reference.
+WASMEDGE_CAPI_DEPRECATED("use WasmEdge_ValueGenFuncRefFromInstance instead")
 WASMEDGE_CAPI_EXPORT extern WasmEdge_Value
 WasmEdge_ValueGenFuncRef(const uint32_t Index);
 
+/// Generate the function reference WASM value from a function instance.
+///
+/// The values generated by this function are only meaningful when the
+/// `WasmEdge_Proposal_BulkMemoryOperations` or the
+/// `WasmEdge_Proposal_ReferenceTypes` turns on in configuration.
+///
+/// \param Cxt the function instance context to refer to. The reference is
+/// valid while the function instance is alive, and only can be called in the
+/// store which the function instance is instantiated or registered in.
+///
+/// \returns WasmEdge_Value struct with the function reference.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Value
+WasmEdge_ValueGenFuncRefFromInstance(
+    const WasmEdge_FunctionInstanceContext *Cxt);
+
 /// Generate the function reference WASM value.
 ///
 /// The values generated by this function are only meaningful when the
@@ -300,14 +326,32 @@ WasmEdge_ValueGetV128(const WasmEdge_Value Val);
 WASMEDGE_CAPI_EXPORT extern bool
 WasmEdge_ValueIsNullRef(const WasmEdge_Value Val);
 
-/// Retrieve the function index from the WASM value.
+/// Retrieve the function address from the WASM value.
+///
+/// This function is deprecated. For the references generated from the
+/// function instances, the address in the store which the function instance
+/// was last instantiated or registered in is returned. Use the
+/// `WasmEdge_ValueGetFuncRef` instead.
 ///
 /// \param Val the WasmEdge_Value struct.
 ///
-/// \returns function index in the input struct.
+/// \returns function address in the input struct.
+WASMEDGE_CAPI_DEPRECATED("use WasmEdge_ValueGetFuncRef instead")
 WASMEDGE_CAPI_EXPORT extern uint32_t
 WasmEdge_ValueGetFuncIdx(const WasmEdge_Value Val);
 
+/// Retrieve the function instance context from the WASM value.
+///
+/// The function instance context is owned by its store or import object and
+/// should __NOT__ be destroyed.
+///
+/// \param Val the WasmEdge_Value struct.
+///
+/// \returns pointer to function instance context in the input struct, NULL if
+/// the reference is generated by the deprecated `WasmEdge_ValueGenFuncRef`.
+WASMEDGE_CAPI_EXPORT extern const WasmEdge_FunctionInstanceContext *
+WasmEdge_ValueGetFuncRef(const WasmEdge_Value Val);
+
 /// Retrieve the external reference from the WASM value.
 ///
 /// \param Val the WasmEdge_Value struct.
@@ -750,6 +794,94 @@ WASMEDGE_CAPI_EXPORT extern void
 WasmEdge_StatisticsSetCostLimit(WasmEdge_StatisticsContext *Cxt,
                                 const uint64_t Limit);
 
+/// Function type definition for the cost model of host function work.
+///
+/// The callback returns the cost of the `Amount` of the `Kind` work done by a
+/// host function, such as the bytes transferred by `fd_write`.
+typedef uint64_t (*WasmEdge_HostCostModel_t)(void *Data,
+                                             const enum WasmEdge_HostWork Kind,
+                                             const uint64_t Amount);
+
+/// Set the cost model of the work done by host functions.
+///
+/// The cost returned by the model is added to the total cost after the host
+/// function returns, in addition to the fixed cost of the host function. The
+/// execution will be aborted with the ErrCode::CostLimitExceeded if the cost
+/// exceeded the limit. The work is free if the model is not set.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to set the cost model.
+/// \param Func the cost model callback. NULL to clear the cost model.
+/// \param Data the additional data passed to the callback. The caller owns the
+/// data and should keep it valid until the cost model is cleared.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_StatisticsSetHostCostModel(WasmEdge_StatisticsContext *Cxt,
+                                    WasmEdge_HostCostModel_t Func, void *Data);
+
+/// Get the total amount of the work done by host functions.
+///
+/// The work is counted whether the cost model is set or not.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to get data.
+/// \param Kind the kind of the work.
+///
+/// \returns the total amount of the work.
+WASMEDGE_CAPI_EXPORT extern uint64_t
+WasmEdge_StatisticsGetHostWorkCount(const WasmEdge_StatisticsContext *Cxt,
+                                    const enum WasmEdge_HostWork Kind);
+
+/// Set the CPU time measuring in execution.
+///
+/// The CPU time of the executing thread is recorded along with the execution
+/// time, and the difference is reported as the blocked time.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to set.
+/// \param IsMeasure the boolean value.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_StatisticsSetCPUTimeMeasuring(WasmEdge_StatisticsContext *Cxt,
+                                       const bool IsMeasure);
+
+/// Get the CPU time of executing wasm instructions in nanoseconds.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to get data.
+///
+/// \returns the CPU time in nanoseconds.
+WASMEDGE_CAPI_EXPORT extern uint64_t
+WasmEdge_StatisticsGetWasmCPUTime(const WasmEdge_StatisticsContext *Cxt);
+
+/// Get the CPU time of running host functions in nanoseconds.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to get data.
+///
+/// \returns the CPU time in nanoseconds.
+WASMEDGE_CAPI_EXPORT extern uint64_t
+WasmEdge_StatisticsGetHostFuncCPUTime(const WasmEdge_StatisticsContext *Cxt);
+
+/// Get the execution time off the CPU in nanoseconds.
+///
+/// The blocked time is the execution time minus the CPU time, such as waiting
+/// in the blocking host functions or being preempted.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to get data.
+///
+/// \returns the blocked time in nanoseconds.
+WASMEDGE_CAPI_EXPORT extern uint64_t
+WasmEdge_StatisticsGetBlockedTime(const WasmEdge_StatisticsContext *Cxt);
+
+/// Set the CPU time limit in execution.
+///
+/// The WASM execution will be aborted if the CPU time exceeded the limit and
+/// the ErrCode::CPUTimeLimitExceeded will be returned. The limit is checked
+/// periodically in the calls and branches, and after every host function. The
+/// AOT compiled code checks it periodically in the loops if compiled with the
+/// interruptible or the gas measuring option, and otherwise only at the calls
+/// into the runtime. Setting a limit turns on the CPU time measuring.
+///
+/// \param Cxt the WasmEdge_StatisticsContext to set.
+/// \param Nanoseconds the CPU time limit. 0 for no limit.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_StatisticsSetCPUTimeLimit(WasmEdge_StatisticsContext *Cxt,
+                                   const uint64_t Nanoseconds);
+
 /// Deletion of the WasmEdge_StatisticsContext.
 ///
 /// After calling this function, the context will be freed and should __NOT__ be
@@ -2276,6 +2408,22 @@ WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
 WasmEdge_MemoryInstanceGrowPage(WasmEdge_MemoryInstanceContext *Cxt,
                                 const uint32_t Page);
 
+/// Discard pages of a memory instance and return the physical memory back to
+/// the system.
+///
+/// The page size of the memory instance is not changed, and the discarded pages
+/// are read as zeros afterwards.
+///
+/// \param Cxt the WasmEdge_MemoryInstanceContext.
+/// \param Start the index of the first page to discard.
+/// \param Page the page count to discard in the memory instance.
+///
+/// \returns WasmEdge_Result. Call `WasmEdge_ResultGetMessage` for the error
+/// message.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_Result
+WasmEdge_MemoryInstanceDiscardPage(WasmEdge_MemoryInstanceContext *Cxt,
+                                   const uint32_t Start, const uint32_t Page);
+
 /// Deletion of the WasmEdge_MemoryInstanceContext.
 ///
 /// After calling this function, the context will be freed and should __NOT__ be
@@ -2417,6 +2565,83 @@ WASMEDGE_CAPI_EXPORT extern void WasmEdge_ImportObjectInitWASI(
 WASMEDGE_CAPI_EXPORT extern uint32_t
 WasmEdge_ImportObjectWASIGetExitCode(WasmEdge_ImportObjectContext *Cxt);
 
+/// Function type definition for the WASI standard input callback.
+///
+/// The callback fills at most `Length` bytes into the `Buffer`, and returns the
+/// filled length. Return 0 for the end of the stream, or a negative value for
+/// an I/O error.
+typedef int64_t (*WasmEdge_WASIReadFunc_t)(void *Data, uint8_t *Buffer,
+                                           const uint32_t Length);
+
+/// Function type definition for the WASI standard output callback.
+///
+/// The callback consumes at most `Length` bytes from the `Buffer`, and returns
+/// the consumed length, or a negative value for an I/O error.
+typedef int64_t (*WasmEdge_WASIWriteFunc_t)(void *Data, const uint8_t *Buffer,
+                                            const uint32_t Length);
+
+/// Replace the standard input of the WASI import object with a callback.
+///
+/// This function should be called after `WasmEdge_ImportObjectInitWASI`, and
+/// the callback will be invoked when the WASM reads the file descriptor 0. The
+/// callback should not block the calling thread for long. The caller owns the
+/// `Data` and should keep it valid until the import object is deleted or the
+/// standard input is replaced again.
+///
+/// \param Cxt the WasmEdge_ImportObjectContext of WASI import object.
+/// \param Func the read callback. NULL to restore the system standard input.
+/// \param Data the additional data passed to the callback.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ImportObjectWASISetStdin(WasmEdge_ImportObjectContext *Cxt,
+                                  WasmEdge_WASIReadFunc_t Func, void *Data);
+
+/// Replace the standard output of the WASI import object with a callback.
+///
+/// Similar to `WasmEdge_ImportObjectWASISetStdin`, and the callback will be
+/// invoked when the WASM writes the file descriptor 1.
+///
+/// \param Cxt the WasmEdge_ImportObjectContext of WASI import object.
+/// \param Func the write callback. NULL to restore the system standard output.
+/// \param Data the additional data passed to the callback.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ImportObjectWASISetStdout(WasmEdge_ImportObjectContext *Cxt,
+                                   WasmEdge_WASIWriteFunc_t Func, void *Data);
+
+/// Replace the standard error of the WASI import object with a callback.
+///
+/// Similar to `WasmEdge_ImportObjectWASISetStdin`, and the callback will be
+/// invoked when the WASM writes the file descriptor 2.
+///
+/// \param Cxt the WasmEdge_ImportObjectContext of WASI import object.
+/// \param Func the write callback. NULL to restore the system standard error.
+/// \param Data the additional data passed to the callback.
+WASMEDGE_CAPI_EXPORT extern void
+WasmEdge_ImportObjectWASISetStderr(WasmEdge_ImportObjectContext *Cxt,
+                                   WasmEdge_WASIWriteFunc_t Func, void *Data);
+
+/// Limit the I/O rate of the WASI import object.
+///
+/// The reads, writes, and socket transfers share the token buckets of the
+/// bytes and the operations. The buffers of an operation are truncated to the
+/// available bytes. When the tokens are exhausted, the operation waits for the
+/// tokens, or fails with the `EAGAIN` error if not blocking. The throttled
+/// operations and the waiting time are counted as the
+/// `WasmEdge_HostWork_ThrottledOps` and `WasmEdge_HostWork_ThrottledNanos`
+/// host function work in the statistics.
+///
+/// \param Cxt the WasmEdge_ImportObjectContext of WASI import object.
+/// \param BytesPerSecond the bytes transferred per second, 0 for no limit.
+/// \param BytesBurst the bytes which can be transferred at once, 0 for one
+/// second of bytes.
+/// \param OpsPerSecond the operations per second, 0 for no limit.
+/// \param OpsBurst the operations which can be issued at once, 0 for one
+/// second of operations.
+/// \param Blocking true to wait for the tokens, false to fail with `EAGAIN`.
+WASMEDGE_CAPI_EXPORT extern void WasmEdge_ImportObjectWASISetIOLimit(
+    WasmEdge_ImportObjectContext *Cxt, const uint64_t BytesPerSecond,
+    const uint64_t BytesBurst, const uint64_t OpsPerSecond,
+    const uint64_t OpsBurst, const bool Blocking);
+
 /// Creation of the WasmEdge_ImportObjectContext for the wasmedge_process
 /// specification.
 ///
@@ -2454,6 +2679,18 @@ WASMEDGE_CAPI_EXPORT extern void WasmEdge_ImportObjectInitWasmEdgeProcess(
     WasmEdge_ImportObjectContext *Cxt, const char *const *AllowedCmds,
     const uint32_t CmdsLen, const bool AllowAll);
 
+/// Creation of the WasmEdge_ImportObjectContext for the wasmedge_memory
+/// specification.
+///
+/// This function will create a wasmedge_memory host module that contains the
+/// host functions to manage the linear memory of the calling module. The
+/// caller owns the object and should call `WasmEdge_ImportObjectDelete` to free
+/// it.
+///
+/// \returns pointer to context, NULL if failed.
+WASMEDGE_CAPI_EXPORT extern WasmEdge_ImportObjectContext *
+WasmEdge_ImportObjectCreateWasmEdgeMemory(void);
+
 /// Add a function instance context into a WasmEdge_ImportObjectContext.
 ///
 /// Move the function instance context into the import object. The caller should
@@ -2525,6 +2762,8 @@ WasmEdge_ImportObjectDelete(WasmEdge_ImportObjectContext *Cxt);
 
 /// Wait a WasmEdge_Async execution.
 ///
+/// Returns after the execution finished and the completion callbacks returned.
+///
 /// \param Cxt the WasmEdge_ASync.
 WASMEDGE_CAPI_EXPORT void WasmEdge_AsyncWait(WasmEdge_Async *Cxt);
 
@@ -2543,6 +2782,44 @@ WASMEDGE_CAPI_EXPORT bool WasmEdge_AsyncWaitFor(WasmEdge_Async *Cxt,
 /// \param Cxt the WasmEdge_ASync.
 WASMEDGE_CAPI_EXPORT void WasmEdge_AsyncCancel(WasmEdge_Async *Cxt);
 
+/// Function type definition for the WasmEdge_Async completion callback.
+typedef void (*WasmEdge_AsyncCallback_t)(void *Data);
+
+/// Register a completion callback of a WasmEdge_Async execution.
+///
+/// The callback will be invoked once in the execution thread after the result
+/// is ready, or immediately in the calling thread if the execution has already
+/// finished. `WasmEdge_AsyncGet` will not block in the callback, but the
+/// callback must not call `WasmEdge_AsyncWait` or `WasmEdge_AsyncWaitFor` on
+/// the same WasmEdge_Async. The callback should return quickly, for example by
+/// signaling the event loop of the host. Multiple callbacks can be registered
+/// and are invoked in order, and one callback can be shared by a group of
+/// WasmEdge_Async executions to notify a single event source.
+///
+/// \param Cxt the WasmEdge_ASync.
+/// \param Func the callback function.
+/// \param Data the additional data passed to the callback. The caller owns the
+/// data and should keep it valid until the callback is invoked.
+WASMEDGE_CAPI_EXPORT void WasmEdge_AsyncSetCallback(
+    WasmEdge_Async *Cxt, WasmEdge_AsyncCallback_t Func, void *Data);
+
+/// Get the pollable file descriptor of a WasmEdge_Async execution.
+///
+/// The returned non-blocking file descriptor becomes readable after the
+/// execution finished, and can be registered into the `epoll`, `kqueue`, or
+/// `io_uring` event loop of the host. It is an eventfd on Linux and the read
+/// end of a pipe on macOS. Repeated calls return the same file descriptor.
+///
+/// The caller does not own the file descriptor and must not close it. The
+/// WasmEdge_Async keeps it open until `WasmEdge_AsyncDelete`, so the caller
+/// should remove it from the event loop before deleting the WasmEdge_Async.
+///
+/// \param Cxt the WasmEdge_ASync.
+///
+/// \returns the file descriptor, -1 if the `Cxt` is NULL, the creation failed,
+/// or the platform is not supported.
+WASMEDGE_CAPI_EXPORT int WasmEdge_AsyncGetFd(WasmEdge_Async *Cxt);
+
 /// Wait and get the return list length of the WasmEdge_Async execution.
 ///
 /// This function will wait until the execution finished and return the return
@@ -59,6 +59,8 @@ public:
   MemoryType &getExternalMemoryType() noexcept { return MemType; }
   const GlobalType &getExternalGlobalType() const noexcept { return GlobType; }
   GlobalType &getExternalGlobalType() noexcept { return GlobType; }
+  uint32_t getExternalTagTypeIdx() const noexcept { return TagTypeIdx; }
+  void setExternalTagTypeIdx(uint32_t Idx) noexcept { TagTypeIdx = Idx; }
 
 private:
   /// \name Data of ImportDesc: Module name, External name, and content node.
@@ -68,6 +70,7 @@ private:
   TableType TabType;
   MemoryType MemType;
   GlobalType GlobType;
+  uint32_t TagTypeIdx = 0;
   /// @}
 };
 
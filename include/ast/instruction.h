@@ -13,6 +13,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "ast/type.h"
 #include "common/enum_ast.h"
 #include "common/span.h"
 #include "common/types.h"
@@ -37,6 +38,8 @@ public:
 #endif
     Flags.IsAllocLabelList = false;
     Flags.IsAllocValTypeList = false;
+    Flags.HasBranchHint = false;
+    Flags.IsBranchLikely = false;
   }
 
   /// Copy constructor.
@@ -80,12 +83,23 @@ public:
   /// Getter of Offset.
   uint32_t getOffset() const noexcept { return Offset; }
 
+  /// Getter and setter of the branch hint of the If and Br_if instructions.
+  bool hasBranchHint() const noexcept { return Flags.HasBranchHint; }
+  bool isBranchLikely() const noexcept { return Flags.IsBranchLikely; }
+  void setBranchHint(bool Likely) noexcept {
+    Flags.HasBranchHint = true;
+    Flags.IsBranchLikely = Likely;
+  }
+
   /// Getter and setter of block type.
   BlockType getBlockType() const noexcept { return Data.Blocks.ResType; }
   void setBlockType(ValType VType) noexcept {
     Data.Blocks.ResType.setData(VType);
   }
   void setBlockType(uint32_t Idx) noexcept { Data.Blocks.ResType.setData(Idx); }
+  void setBlockType(uint32_t TypeIdx, bool Nullable) noexcept {
+    Data.Blocks.ResType.setTypedRef(TypeIdx, Nullable);
+  }
 
   /// Getter and setter of jump count to End instruction.
   uint32_t getJumpEnd() const noexcept { return Data.Blocks.JumpEnd; }
@@ -95,9 +109,27 @@ public:
   uint32_t getJumpElse() const noexcept { return Data.Blocks.JumpElse; }
   void setJumpElse(const uint32_t Cnt) noexcept { Data.Blocks.JumpElse = Cnt; }
 
+  /// Getter and setter of jump count to the next Catch, Catch_all, or End
+  /// instruction of the Try block.
+  uint32_t getJumpCatch() const noexcept { return Data.Catches.JumpCatch; }
+  void setJumpCatch(const uint32_t Cnt) noexcept {
+    Data.Catches.JumpCatch = Cnt;
+  }
+
   /// Getter and setter of reference type.
-  RefType getRefType() const noexcept { return Data.ReferenceType; }
-  void setRefType(RefType RType) noexcept { Data.ReferenceType = RType; }
+  RefType getRefType() const noexcept { return Data.Reference.Type; }
+  void setRefType(RefType RType) noexcept {
+    Data.Reference.Type = RType;
+    Data.Reference.TypeIdx = TypedRef::AbstractIdx;
+  }
+
+  /// Getter and setter of the function type index of the typed reference in
+  /// the function references proposal.
+  uint32_t getRefTypeIdx() const noexcept { return Data.Reference.TypeIdx; }
+  void setRefTypeIdx(uint32_t Idx) noexcept {
+    Data.Reference.Type = RefType::FuncRef;
+    Data.Reference.TypeIdx = Idx;
+  }
 
   /// Getter and setter of label list.
   void setLabelListSize(uint32_t Size) {
@@ -213,8 +245,11 @@ private:
       uint32_t LabelListSize;
       uint32_t *LabelList;
     } BrTable;
-    // Type 4: RefType.
-    RefType ReferenceType;
+    // Type 4: RefType and the type index of the typed reference.
+    struct {
+      RefType Type;
+      uint32_t TypeIdx;
+    } Reference;
     // Type 5: ValTypeList.
     struct {
       uint32_t ValTypeListSize;
@@ -236,12 +271,19 @@ private:
       uint64_t High;
     } Num;
 #endif
+    // Type 8: TargetIdx and JumpCatch.
+    struct {
+      uint32_t TargetIdx;
+      uint32_t JumpCatch;
+    } Catches;
   } Data;
   uint32_t Offset = 0;
   OpCode Code = OpCode::End;
   struct {
     bool IsAllocLabelList : 1;
     bool IsAllocValTypeList : 1;
+    bool HasBranchHint : 1;
+    bool IsBranchLikely : 1;
   } Flags;
   /// @}
 };
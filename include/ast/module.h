@@ -16,6 +16,8 @@
 
 #include "ast/section.h"
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
@@ -63,6 +65,8 @@ public:
   DataSection &getDataSection() { return DataSec; }
   const DataCountSection &getDataCountSection() const { return DataCountSec; }
   DataCountSection &getDataCountSection() { return DataCountSec; }
+  const TagSection &getTagSection() const { return TagSec; }
+  TagSection &getTagSection() { return TagSec; }
   const AOTSection &getAOTSection() const { return AOTSec; }
   AOTSection &getAOTSection() { return AOTSec; }
 
@@ -85,6 +89,13 @@ public:
     kTableInit,
     kElemDrop,
     kRefFunc,
+    kCallRef,
+    kCheckCPUTime,
+    kThrow,
+    kRethrow,
+    kCatchTag,
+    kCatchAll,
+    kReleaseExceptions,
     kIntrinsicMax,
   };
   using IntrinsicsTable = void * [uint32_t(Intrinsics::kIntrinsicMax)];
@@ -95,6 +106,60 @@ public:
     IntrSymbol = std::move(S);
   }
 
+  /// Immutable data shared by the module instances of this module.
+  struct InstantiationData {
+    /// Function types in type section.
+    std::vector<FunctionType> FuncTypes;
+    /// Local declarations of functions in code section.
+    std::vector<std::vector<std::pair<uint32_t, ValType>>> FuncLocals;
+    /// Instructions of functions in code section. Empty if compiled.
+    std::vector<InstrVec> FuncInstrs;
+  };
+
+  /// Getter of instantiation data. The data is generated at the first
+  /// instantiation and shared by the following ones. Module instances keep it
+  /// alive after this module is destroyed.
+  std::shared_ptr<const InstantiationData> getInstantiationData() const {
+    if (auto Data = std::atomic_load(&InstData)) {
+      return Data;
+    }
+    auto NewData = std::make_shared<InstantiationData>();
+    const auto &Types = TypeSec.getContent();
+    NewData->FuncTypes.assign(Types.begin(), Types.end());
+    // Resolve the typed references to compare the types across modules.
+    auto Resolve = [&NewData](std::vector<TypedRef> &Refs) {
+      for (auto &Ref : Refs) {
+        if (Ref.hasTypeIdx() && Ref.getTypeIdx() < NewData->FuncTypes.size()) {
+          Ref.setResolvedType(&NewData->FuncTypes[Ref.getTypeIdx()]);
+        }
+      }
+    };
+    for (auto &FuncType : NewData->FuncTypes) {
+      Resolve(FuncType.getParamRefs());
+      Resolve(FuncType.getReturnRefs());
+    }
+    const auto &CodeSegs = CodeSec.getContent();
+    NewData->FuncLocals.reserve(CodeSegs.size());
+    NewData->FuncInstrs.resize(CodeSegs.size());
+    for (size_t I = 0; I < CodeSegs.size(); ++I) {
+      const auto Locals = CodeSegs[I].getLocals();
+      NewData->FuncLocals.emplace_back(Locals.begin(), Locals.end());
+      if (!CodeSegs[I].getSymbol()) {
+        const auto Instrs = CodeSegs[I].getExpr().getInstrs();
+        // FIXME: Modify the capacity to prevent from connection of 2 vectors.
+        NewData->FuncInstrs[I].reserve(Instrs.size() + 1);
+        NewData->FuncInstrs[I].assign(Instrs.begin(), Instrs.end());
+      }
+    }
+    // Other thread may generate the data at the same time. Use the first one.
+    std::shared_ptr<const InstantiationData> Expected;
+    std::shared_ptr<const InstantiationData> Desired = std::move(NewData);
+    if (std::atomic_compare_exchange_strong(&InstData, &Expected, Desired)) {
+      return Desired;
+    }
+    return Expected;
+  }
+
 private:
   /// \name Data of Module node.
   /// @{
@@ -117,6 +182,7 @@ private:
   CodeSection CodeSec;
   DataSection DataSec;
   DataCountSection DataCountSec;
+  TagSection TagSec;
   /// @}
 
   /// \name Data of AOT.
@@ -124,6 +190,9 @@ private:
   AOTSection AOTSec;
   Symbol<const IntrinsicsTable *> IntrSymbol;
   /// @}
+
+  /// Cached instantiation data.
+  mutable std::shared_ptr<const InstantiationData> InstData;
 };
 
 } // namespace AST
@@ -221,6 +221,20 @@ private:
   /// @}
 };
 
+/// AST TagSection node.
+class TagSection : public Section {
+public:
+  /// Getter of content vector, which is the function type indices of tags.
+  Span<const uint32_t> getContent() const noexcept { return Content; }
+  std::vector<uint32_t> &getContent() noexcept { return Content; }
+
+private:
+  /// \name Data of TagSection.
+  /// @{
+  std::vector<uint32_t> Content;
+  /// @}
+};
+
 class AOTSection {
 public:
   /// Getter and setter of version.
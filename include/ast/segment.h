@@ -87,6 +87,10 @@ public:
   uint32_t getSegSize() const noexcept { return SegSize; }
   void setSegSize(uint32_t Size) noexcept { SegSize = Size; }
 
+  /// Getter and setter of the offset of the function body in the binary.
+  uint32_t getBodyOffset() const noexcept { return BodyOffset; }
+  void setBodyOffset(uint32_t Off) noexcept { BodyOffset = Off; }
+
   /// Getter of locals vector.
   Span<const std::pair<uint32_t, ValType>> getLocals() const noexcept {
     return Locals;
@@ -95,6 +99,11 @@ public:
     return Locals;
   }
 
+  /// Getter of the typed reference annotations of the locals vector. Empty if
+  /// there is no typed reference, or the same size as the locals vector.
+  Span<const TypedRef> getLocalRefs() const noexcept { return LocalRefs; }
+  std::vector<TypedRef> &getLocalRefs() noexcept { return LocalRefs; }
+
   /// Getter and setter of compiled symbol.
   const auto &getSymbol() const noexcept { return FuncSymbol; }
   void setSymbol(Symbol<void> S) noexcept { FuncSymbol = std::move(S); }
@@ -103,7 +112,9 @@ private:
   /// \name Data of CodeSegment node.
   /// @{
   uint32_t SegSize = 0;
+  uint32_t BodyOffset = 0;
   std::vector<std::pair<uint32_t, ValType>> Locals;
+  std::vector<TypedRef> LocalRefs;
   Symbol<void> FuncSymbol;
   /// @}
 };
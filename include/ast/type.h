@@ -8,8 +8,8 @@
 //===----------------------------------------------------------------------===//
 ///
 /// \file
-/// This file contains the declaration of the type classes: Limit, FunctionType,
-/// MemoryType, TableType, and GlobalType.
+/// This file contains the declaration of the type classes: Limit, TypedRef,
+/// FunctionType, MemoryType, TableType, and GlobalType.
 ///
 //===----------------------------------------------------------------------===//
 #pragma once
@@ -18,11 +18,15 @@
 #include "common/symbol.h"
 #include "common/types.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 namespace WasmEdge {
 namespace AST {
 
+class FunctionType;
+
 /// AST Limit node.
 class Limit {
 public:
@@ -60,6 +64,48 @@ private:
   /// @}
 };
 
+/// AST TypedRef node.
+///
+/// The annotation of a reference value type in the function references
+/// proposal. The typed references `(ref $t)` and `(ref null $t)` are FuncRef
+/// values in execution, so the value type is kept as FuncRef and the function
+/// type index and the nullability are recorded here. The default annotation is
+/// the nullable abstract reference type, such as FuncRef.
+class TypedRef {
+public:
+  /// Type index of the abstract heap type.
+  static inline constexpr uint32_t AbstractIdx = UINT32_MAX;
+
+  /// Constructors.
+  TypedRef() noexcept = default;
+  TypedRef(uint32_t Idx, bool IsNullable) noexcept
+      : TypeIdx(Idx), Nullable(IsNullable) {}
+
+  /// Getter of the function type index.
+  bool hasTypeIdx() const noexcept { return TypeIdx != AbstractIdx; }
+  uint32_t getTypeIdx() const noexcept { return TypeIdx; }
+
+  /// Getter of the nullability.
+  bool isNullable() const noexcept { return Nullable; }
+
+  /// Return true if this is the annotation of the plain value types.
+  bool isPlain() const noexcept { return !hasTypeIdx() && Nullable; }
+
+  /// Getter and setter of the function type resolved in instantiation. The
+  /// type indices are only meaningful in the same module, so the resolved
+  /// types are compared when matching the types across modules.
+  const FunctionType *getResolvedType() const noexcept { return Resolved; }
+  void setResolvedType(const FunctionType *Type) noexcept { Resolved = Type; }
+
+private:
+  /// \name Data of TypedRef.
+  /// @{
+  uint32_t TypeIdx = AbstractIdx;
+  bool Nullable = true;
+  const FunctionType *Resolved = nullptr;
+  /// @}
+};
+
 /// AST FunctionType node.
 class FunctionType {
 public:
@@ -78,8 +124,20 @@ public:
   /// `==` and `!=` operator overloadings.
   friend bool operator==(const FunctionType &LHS,
                          const FunctionType &RHS) noexcept {
-    return LHS.ParamTypes == RHS.ParamTypes &&
-           LHS.ReturnTypes == RHS.ReturnTypes;
+    // The function instances of a module share the types of the module.
+    if (&LHS == &RHS) {
+      return true;
+    }
+    if (LHS.ParamTypes != RHS.ParamTypes ||
+        LHS.ReturnTypes != RHS.ReturnTypes) {
+      return false;
+    }
+    if (LHS.ParamRefs.empty() && LHS.ReturnRefs.empty() &&
+        RHS.ParamRefs.empty() && RHS.ReturnRefs.empty()) {
+      return true;
+    }
+    std::vector<std::pair<const FunctionType *, const FunctionType *>> Assumed;
+    return isRefsMatched(LHS, RHS, Assumed);
   }
 
   friend bool operator!=(const FunctionType &LHS,
@@ -99,15 +157,88 @@ public:
   }
   std::vector<ValType> &getReturnTypes() noexcept { return ReturnTypes; }
 
+  /// Getter of the typed reference annotations of the param and return types.
+  /// Empty if there is no typed reference, or the same size as the types.
+  const std::vector<TypedRef> &getParamRefs() const noexcept {
+    return ParamRefs;
+  }
+  std::vector<TypedRef> &getParamRefs() noexcept { return ParamRefs; }
+  const std::vector<TypedRef> &getReturnRefs() const noexcept {
+    return ReturnRefs;
+  }
+  std::vector<TypedRef> &getReturnRefs() noexcept { return ReturnRefs; }
+  TypedRef getParamRef(size_t I) const noexcept {
+    return I < ParamRefs.size() ? ParamRefs[I] : TypedRef();
+  }
+  TypedRef getReturnRef(size_t I) const noexcept {
+    return I < ReturnRefs.size() ? ReturnRefs[I] : TypedRef();
+  }
+
+  /// Drop the typed reference annotations.
+  void clearRefs() noexcept {
+    ParamRefs.clear();
+    ReturnRefs.clear();
+  }
+
   /// Getter and setter of symbol.
   const auto &getSymbol() const noexcept { return WrapSymbol; }
   void setSymbol(Symbol<Wrapper> S) noexcept { WrapSymbol = std::move(S); }
 
+  /// Return true if the typed reference annotations are matched. The function
+  /// types are compared structurally by the resolved types, and the recursive
+  /// types already under comparison are assumed to be matched.
+  static bool isRefMatched(
+      const TypedRef &LHS, const TypedRef &RHS,
+      std::vector<std::pair<const FunctionType *, const FunctionType *>>
+          &Assumed) noexcept {
+    if (LHS.isNullable() != RHS.isNullable() ||
+        LHS.hasTypeIdx() != RHS.hasTypeIdx()) {
+      return false;
+    }
+    if (!LHS.hasTypeIdx()) {
+      return true;
+    }
+    const auto *L = LHS.getResolvedType();
+    const auto *R = RHS.getResolvedType();
+    if (!L || !R) {
+      // Not resolved. Only the types in the same module are compared.
+      return !L && !R && LHS.getTypeIdx() == RHS.getTypeIdx();
+    }
+    if (L == R || std::find(Assumed.begin(), Assumed.end(),
+                            std::make_pair(L, R)) != Assumed.end()) {
+      return true;
+    }
+    if (L->ParamTypes != R->ParamTypes || L->ReturnTypes != R->ReturnTypes) {
+      return false;
+    }
+    Assumed.emplace_back(L, R);
+    return isRefsMatched(*L, *R, Assumed);
+  }
+
 private:
+  static bool isRefsMatched(
+      const FunctionType &LHS, const FunctionType &RHS,
+      std::vector<std::pair<const FunctionType *, const FunctionType *>>
+          &Assumed) noexcept {
+    for (size_t I = 0; I < LHS.ParamTypes.size(); ++I) {
+      if (!isRefMatched(LHS.getParamRef(I), RHS.getParamRef(I), Assumed)) {
+        return false;
+      }
+    }
+    for (size_t I = 0; I < LHS.ReturnTypes.size(); ++I) {
+      if (!isRefMatched(LHS.getReturnRef(I), RHS.getReturnRef(I), Assumed)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   /// \name Data of FunctionType.
   /// @{
   std::vector<ValType> ParamTypes;
   std::vector<ValType> ReturnTypes;
+  std::vector<TypedRef> ParamRefs;
+  std::vector<TypedRef> ReturnRefs;
   Symbol<Wrapper> WrapSymbol;
   /// @}
 };
@@ -169,7 +300,11 @@ public:
   /// `==` and `!=` operator overloadings.
   friend bool operator==(const GlobalType &LHS,
                          const GlobalType &RHS) noexcept {
-    return LHS.Type == RHS.Type && LHS.Mut == RHS.Mut;
+    if (LHS.Type != RHS.Type || LHS.Mut != RHS.Mut) {
+      return false;
+    }
+    std::vector<std::pair<const FunctionType *, const FunctionType *>> Assumed;
+    return FunctionType::isRefMatched(LHS.Ref, RHS.Ref, Assumed);
   }
 
   friend bool operator!=(const GlobalType &LHS,
@@ -185,11 +320,17 @@ public:
   ValMut getValMut() const noexcept { return Mut; }
   void setValMut(ValMut VMut) noexcept { Mut = VMut; }
 
+  /// Getter and setter of the typed reference annotation.
+  const TypedRef &getRef() const noexcept { return Ref; }
+  TypedRef &getRef() noexcept { return Ref; }
+  void setRef(const TypedRef &R) noexcept { Ref = R; }
+
 private:
   /// \name Data of GlobalType.
   /// @{
   ValType Type;
   ValMut Mut;
+  TypedRef Ref;
   /// @}
 };
 
@@ -14,14 +14,32 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "common/config.h"
 #include "common/enum_configure.h"
 
 #include <bitset>
+#include <chrono>
 #include <cstdint>
 #include <initializer_list>
 
 namespace WasmEdge {
 
+/// Check if the proposal is built in. The proposals pruned at build time are
+/// never enabled regardless of the configuration.
+inline constexpr bool isProposalBuilt(const Proposal Type) noexcept {
+  switch (Type) {
+  case Proposal::SIMD:
+  case Proposal::RelaxedSIMD:
+    return WASMEDGE_BUILD_PROPOSAL_SIMD;
+  case Proposal::ReferenceTypes:
+    return WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES;
+  case Proposal::BulkMemoryOperations:
+    return WASMEDGE_BUILD_PROPOSAL_BULK_MEMORY_OPERATIONS;
+  default:
+    return true;
+  }
+}
+
 class CompilerConfigure {
 public:
   /// AOT compiler optimization level enum class.
@@ -112,11 +130,25 @@ public:
 
   uint64_t getCostLimit() const noexcept { return CostLimit; }
 
+  void setProfiling(bool IsProfile) noexcept { Profiling = IsProfile; }
+
+  bool isProfiling() const noexcept { return Profiling; }
+
+  void setProfileInterval(std::chrono::microseconds Interval) noexcept {
+    ProfileInterval = Interval;
+  }
+
+  std::chrono::microseconds getProfileInterval() const noexcept {
+    return ProfileInterval;
+  }
+
 private:
   bool InstrCounting = false;
   bool CostMeasuring = false;
   bool TimeMeasuring = false;
+  bool Profiling = false;
   uint64_t CostLimit = UINT64_C(-1);
+  std::chrono::microseconds ProfileInterval = std::chrono::milliseconds(10);
 };
 
 class Configure {
@@ -143,7 +175,7 @@ public:
   }
 
   bool hasProposal(const Proposal Type) const noexcept {
-    return Proposals.test(static_cast<uint8_t>(Type));
+    return isProposalBuilt(Type) && Proposals.test(static_cast<uint8_t>(Type));
   }
 
   void addHostRegistration(const HostRegistration Host) noexcept {
@@ -42,6 +42,7 @@ enum class ASTNodeAttr : uint8_t {
   Sec_Code,
   Sec_Data,
   Sec_DataCount,
+  Sec_Tag,
   Desc_Import,
   Desc_Export,
   Seg_Global,
@@ -74,6 +75,7 @@ static inline std::unordered_map<ASTNodeAttr, std::string> ASTNodeAttrStr = {
     {ASTNodeAttr::Sec_Code, "code section"},
     {ASTNodeAttr::Sec_Data, "data section"},
     {ASTNodeAttr::Sec_DataCount, "data count section"},
+    {ASTNodeAttr::Sec_Tag, "tag section"},
     {ASTNodeAttr::Desc_Import, "import description"},
     {ASTNodeAttr::Desc_Export, "export description"},
     {ASTNodeAttr::Seg_Global, "global segment"},
@@ -88,8 +90,9 @@ static inline std::unordered_map<ASTNodeAttr, std::string> ASTNodeAttrStr = {
     {ASTNodeAttr::Expression, "expression"},
     {ASTNodeAttr::Instruction, "instruction"}};
 
-/// Instruction opcode enumeration class.
-enum class OpCode : uint16_t {
+/// Instruction opcode enumeration class. The prefixed opcodes are the prefix
+/// byte shifted left by 16 bits plus the sub-opcode.
+enum class OpCode : uint32_t {
   // Control instructions
   Unreachable = 0x00,
   Nop = 0x01,
@@ -97,6 +100,10 @@ enum class OpCode : uint16_t {
   Loop = 0x03,
   If = 0x04,
   Else = 0x05,
+  Try = 0x06,
+  Catch = 0x07,
+  Throw = 0x08,
+  Rethrow = 0x09,
   End = 0x0B,
   Br = 0x0C,
   Br_if = 0x0D,
@@ -104,11 +111,16 @@ enum class OpCode : uint16_t {
   Return = 0x0F,
   Call = 0x10,
   Call_indirect = 0x11,
+  Call_ref = 0x14,
+  Delegate = 0x18,
+  Catch_all = 0x19,
 
   // Reference Instructions
   Ref__null = 0xD0,
   Ref__is_null = 0xD1,
   Ref__func = 0xD2,
+  Ref__as_non_null = 0xD4,
+  Br_on_null = 0xD5,
 
   // Parametric Instructions
   Drop = 0x1A,
@@ -288,288 +300,310 @@ enum class OpCode : uint16_t {
   I64__extend8_s = 0xC2,
   I64__extend16_s = 0xC3,
   I64__extend32_s = 0xC4,
-  I32__trunc_sat_f32_s = 0xFC00,
-  I32__trunc_sat_f32_u = 0xFC01,
-  I32__trunc_sat_f64_s = 0xFC02,
-  I32__trunc_sat_f64_u = 0xFC03,
-  I64__trunc_sat_f32_s = 0xFC04,
-  I64__trunc_sat_f32_u = 0xFC05,
-  I64__trunc_sat_f64_s = 0xFC06,
-  I64__trunc_sat_f64_u = 0xFC07,
+  I32__trunc_sat_f32_s = 0xFC0000,
+  I32__trunc_sat_f32_u = 0xFC0001,
+  I32__trunc_sat_f64_s = 0xFC0002,
+  I32__trunc_sat_f64_u = 0xFC0003,
+  I64__trunc_sat_f32_s = 0xFC0004,
+  I64__trunc_sat_f32_u = 0xFC0005,
+  I64__trunc_sat_f64_s = 0xFC0006,
+  I64__trunc_sat_f64_u = 0xFC0007,
 
   // Memory Instructions (part 2)
-  Memory__init = 0xFC08,
-  Data__drop = 0xFC09,
-  Memory__copy = 0xFC0A,
-  Memory__fill = 0xFC0B,
+  Memory__init = 0xFC0008,
+  Data__drop = 0xFC0009,
+  Memory__copy = 0xFC000A,
+  Memory__fill = 0xFC000B,
 
   // Table Instructions (part 2)
-  Table__init = 0xFC0C,
-  Elem__drop = 0xFC0D,
-  Table__copy = 0xFC0E,
-  Table__grow = 0xFC0F,
-  Table__size = 0xFC10,
-  Table__fill = 0xFC11,
+  Table__init = 0xFC000C,
+  Elem__drop = 0xFC000D,
+  Table__copy = 0xFC000E,
+  Table__grow = 0xFC000F,
+  Table__size = 0xFC0010,
+  Table__fill = 0xFC0011,
 
   // SIMD Memory Instructions
-  V128__load = 0xFD00,
-  V128__load8x8_s = 0xFD01,
-  V128__load8x8_u = 0xFD02,
-  V128__load16x4_s = 0xFD03,
-  V128__load16x4_u = 0xFD04,
-  V128__load32x2_s = 0xFD05,
-  V128__load32x2_u = 0xFD06,
-  V128__load8_splat = 0xFD07,
-  V128__load16_splat = 0xFD08,
-  V128__load32_splat = 0xFD09,
-  V128__load64_splat = 0xFD0A,
-  V128__load32_zero = 0xFD5C,
-  V128__load64_zero = 0xFD5D,
-  V128__store = 0xFD0B,
-  V128__load8_lane = 0xFD54,
-  V128__load16_lane = 0xFD55,
-  V128__load32_lane = 0xFD56,
-  V128__load64_lane = 0xFD57,
-  V128__store8_lane = 0xFD58,
-  V128__store16_lane = 0xFD59,
-  V128__store32_lane = 0xFD5A,
-  V128__store64_lane = 0xFD5B,
+  V128__load = 0xFD0000,
+  V128__load8x8_s = 0xFD0001,
+  V128__load8x8_u = 0xFD0002,
+  V128__load16x4_s = 0xFD0003,
+  V128__load16x4_u = 0xFD0004,
+  V128__load32x2_s = 0xFD0005,
+  V128__load32x2_u = 0xFD0006,
+  V128__load8_splat = 0xFD0007,
+  V128__load16_splat = 0xFD0008,
+  V128__load32_splat = 0xFD0009,
+  V128__load64_splat = 0xFD000A,
+  V128__load32_zero = 0xFD005C,
+  V128__load64_zero = 0xFD005D,
+  V128__store = 0xFD000B,
+  V128__load8_lane = 0xFD0054,
+  V128__load16_lane = 0xFD0055,
+  V128__load32_lane = 0xFD0056,
+  V128__load64_lane = 0xFD0057,
+  V128__store8_lane = 0xFD0058,
+  V128__store16_lane = 0xFD0059,
+  V128__store32_lane = 0xFD005A,
+  V128__store64_lane = 0xFD005B,
 
   // SIMD Const Instructions
-  V128__const = 0xFD0C,
+  V128__const = 0xFD000C,
 
   // SIMD Shuffle Instructions
-  I8x16__shuffle = 0xFD0D,
+  I8x16__shuffle = 0xFD000D,
 
   // SIMD Lane Instructions
-  I8x16__extract_lane_s = 0xFD15,
-  I8x16__extract_lane_u = 0xFD16,
-  I8x16__replace_lane = 0xFD17,
-  I16x8__extract_lane_s = 0xFD18,
-  I16x8__extract_lane_u = 0xFD19,
-  I16x8__replace_lane = 0xFD1A,
-  I32x4__extract_lane = 0xFD1B,
-  I32x4__replace_lane = 0xFD1C,
-  I64x2__extract_lane = 0xFD1D,
-  I64x2__replace_lane = 0xFD1E,
-  F32x4__extract_lane = 0xFD1F,
-  F32x4__replace_lane = 0xFD20,
-  F64x2__extract_lane = 0xFD21,
-  F64x2__replace_lane = 0xFD22,
+  I8x16__extract_lane_s = 0xFD0015,
+  I8x16__extract_lane_u = 0xFD0016,
+  I8x16__replace_lane = 0xFD0017,
+  I16x8__extract_lane_s = 0xFD0018,
+  I16x8__extract_lane_u = 0xFD0019,
+  I16x8__replace_lane = 0xFD001A,
+  I32x4__extract_lane = 0xFD001B,
+  I32x4__replace_lane = 0xFD001C,
+  I64x2__extract_lane = 0xFD001D,
+  I64x2__replace_lane = 0xFD001E,
+  F32x4__extract_lane = 0xFD001F,
+  F32x4__replace_lane = 0xFD0020,
+  F64x2__extract_lane = 0xFD0021,
+  F64x2__replace_lane = 0xFD0022,
 
   // SIMD Numeric Instructions
-  I8x16__swizzle = 0xFD0E,
-  I8x16__splat = 0xFD0F,
-  I16x8__splat = 0xFD10,
-  I32x4__splat = 0xFD11,
-  I64x2__splat = 0xFD12,
-  F32x4__splat = 0xFD13,
-  F64x2__splat = 0xFD14,
-
-  I8x16__eq = 0xFD23,
-  I8x16__ne = 0xFD24,
-  I8x16__lt_s = 0xFD25,
-  I8x16__lt_u = 0xFD26,
-  I8x16__gt_s = 0xFD27,
-  I8x16__gt_u = 0xFD28,
-  I8x16__le_s = 0xFD29,
-  I8x16__le_u = 0xFD2A,
-  I8x16__ge_s = 0xFD2B,
-  I8x16__ge_u = 0xFD2C,
-
-  I16x8__eq = 0xFD2D,
-  I16x8__ne = 0xFD2E,
-  I16x8__lt_s = 0xFD2F,
-  I16x8__lt_u = 0xFD30,
-  I16x8__gt_s = 0xFD31,
-  I16x8__gt_u = 0xFD32,
-  I16x8__le_s = 0xFD33,
-  I16x8__le_u = 0xFD34,
-  I16x8__ge_s = 0xFD35,
-  I16x8__ge_u = 0xFD36,
-
-  I32x4__eq = 0xFD37,
-  I32x4__ne = 0xFD38,
-  I32x4__lt_s = 0xFD39,
-  I32x4__lt_u = 0xFD3A,
-  I32x4__gt_s = 0xFD3B,
-  I32x4__gt_u = 0xFD3C,
-  I32x4__le_s = 0xFD3D,
-  I32x4__le_u = 0xFD3E,
-  I32x4__ge_s = 0xFD3F,
-  I32x4__ge_u = 0xFD40,
-
-  I64x2__eq = 0xFDD6,
-  I64x2__ne = 0xFDD7,
-  I64x2__lt_s = 0xFDD8,
-  I64x2__gt_s = 0xFDD9,
-  I64x2__le_s = 0xFDDA,
-  I64x2__ge_s = 0xFDDB,
-
-  F32x4__eq = 0xFD41,
-  F32x4__ne = 0xFD42,
-  F32x4__lt = 0xFD43,
-  F32x4__gt = 0xFD44,
-  F32x4__le = 0xFD45,
-  F32x4__ge = 0xFD46,
-
-  F64x2__eq = 0xFD47,
-  F64x2__ne = 0xFD48,
-  F64x2__lt = 0xFD49,
-  F64x2__gt = 0xFD4A,
-  F64x2__le = 0xFD4B,
-  F64x2__ge = 0xFD4C,
-
-  V128__not = 0xFD4D,
-  V128__and = 0xFD4E,
-  V128__andnot = 0xFD4F,
-  V128__or = 0xFD50,
-  V128__xor = 0xFD51,
-  V128__bitselect = 0xFD52,
-  V128__any_true = 0xFD53,
-
-  I8x16__abs = 0xFD60,
-  I8x16__neg = 0xFD61,
-  I8x16__popcnt = 0xFD62,
-  I8x16__all_true = 0xFD63,
-  I8x16__bitmask = 0xFD64,
-  I8x16__narrow_i16x8_s = 0xFD65,
-  I8x16__narrow_i16x8_u = 0xFD66,
-  I8x16__shl = 0xFD6B,
-  I8x16__shr_s = 0xFD6C,
-  I8x16__shr_u = 0xFD6D,
-  I8x16__add = 0xFD6E,
-  I8x16__add_sat_s = 0xFD6F,
-  I8x16__add_sat_u = 0xFD70,
-  I8x16__sub = 0xFD71,
-  I8x16__sub_sat_s = 0xFD72,
-  I8x16__sub_sat_u = 0xFD73,
-  I8x16__min_s = 0xFD76,
-  I8x16__min_u = 0xFD77,
-  I8x16__max_s = 0xFD78,
-  I8x16__max_u = 0xFD79,
-  I8x16__avgr_u = 0xFD7B,
-
-  I16x8__abs = 0xFD80,
-  I16x8__neg = 0xFD81,
-  I16x8__all_true = 0xFD83,
-  I16x8__bitmask = 0xFD84,
-  I16x8__narrow_i32x4_s = 0xFD85,
-  I16x8__narrow_i32x4_u = 0xFD86,
-  I16x8__extend_low_i8x16_s = 0xFD87,
-  I16x8__extend_high_i8x16_s = 0xFD88,
-  I16x8__extend_low_i8x16_u = 0xFD89,
-  I16x8__extend_high_i8x16_u = 0xFD8A,
-  I16x8__shl = 0xFD8B,
-  I16x8__shr_s = 0xFD8C,
-  I16x8__shr_u = 0xFD8D,
-  I16x8__add = 0xFD8E,
-  I16x8__add_sat_s = 0xFD8F,
-  I16x8__add_sat_u = 0xFD90,
-  I16x8__sub = 0xFD91,
-  I16x8__sub_sat_s = 0xFD92,
-  I16x8__sub_sat_u = 0xFD93,
-  I16x8__mul = 0xFD95,
-  I16x8__min_s = 0xFD96,
-  I16x8__min_u = 0xFD97,
-  I16x8__max_s = 0xFD98,
-  I16x8__max_u = 0xFD99,
-  I16x8__avgr_u = 0xFD9B,
-  I16x8__extmul_low_i8x16_s = 0xFD9C,
-  I16x8__extmul_high_i8x16_s = 0xFD9D,
-  I16x8__extmul_low_i8x16_u = 0xFD9E,
-  I16x8__extmul_high_i8x16_u = 0xFD9F,
-  I16x8__q15mulr_sat_s = 0xFD82,
-  I16x8__extadd_pairwise_i8x16_s = 0xFD7C,
-  I16x8__extadd_pairwise_i8x16_u = 0xFD7D,
-
-  I32x4__abs = 0xFDA0,
-  I32x4__neg = 0xFDA1,
-  I32x4__all_true = 0xFDA3,
-  I32x4__bitmask = 0xFDA4,
-  I32x4__extend_low_i16x8_s = 0xFDA7,
-  I32x4__extend_high_i16x8_s = 0xFDA8,
-  I32x4__extend_low_i16x8_u = 0xFDA9,
-  I32x4__extend_high_i16x8_u = 0xFDAA,
-  I32x4__shl = 0xFDAB,
-  I32x4__shr_s = 0xFDAC,
-  I32x4__shr_u = 0xFDAD,
-  I32x4__add = 0xFDAE,
-  I32x4__sub = 0xFDB1,
-  I32x4__mul = 0xFDB5,
-  I32x4__min_s = 0xFDB6,
-  I32x4__min_u = 0xFDB7,
-  I32x4__max_s = 0xFDB8,
-  I32x4__max_u = 0xFDB9,
-  I32x4__dot_i16x8_s = 0xFDBA,
-  I32x4__extmul_low_i16x8_s = 0xFDBC,
-  I32x4__extmul_high_i16x8_s = 0xFDBD,
-  I32x4__extmul_low_i16x8_u = 0xFDBE,
-  I32x4__extmul_high_i16x8_u = 0xFDBF,
-  I32x4__extadd_pairwise_i16x8_s = 0xFD7E,
-  I32x4__extadd_pairwise_i16x8_u = 0xFD7F,
-
-  I64x2__abs = 0xFDC0,
-  I64x2__neg = 0xFDC1,
-  I64x2__all_true = 0xFDC3,
-  I64x2__bitmask = 0xFDC4,
-  I64x2__extend_low_i32x4_s = 0xFDC7,
-  I64x2__extend_high_i32x4_s = 0xFDC8,
-  I64x2__extend_low_i32x4_u = 0xFDC9,
-  I64x2__extend_high_i32x4_u = 0xFDCA,
-  I64x2__shl = 0xFDCB,
-  I64x2__shr_s = 0xFDCC,
-  I64x2__shr_u = 0xFDCD,
-  I64x2__add = 0xFDCE,
-  I64x2__sub = 0xFDD1,
-  I64x2__mul = 0xFDD5,
-  I64x2__extmul_low_i32x4_s = 0xFDDC,
-  I64x2__extmul_high_i32x4_s = 0xFDDD,
-  I64x2__extmul_low_i32x4_u = 0xFDDE,
-  I64x2__extmul_high_i32x4_u = 0xFDDF,
-
-  F32x4__abs = 0xFDE0,
-  F32x4__neg = 0xFDE1,
-  F32x4__sqrt = 0xFDE3,
-  F32x4__add = 0xFDE4,
-  F32x4__sub = 0xFDE5,
-  F32x4__mul = 0xFDE6,
-  F32x4__div = 0xFDE7,
-  F32x4__min = 0xFDE8,
-  F32x4__max = 0xFDE9,
-  F32x4__pmin = 0xFDEA,
-  F32x4__pmax = 0xFDEB,
-  F32x4__ceil = 0xFD67,
-  F32x4__floor = 0xFD68,
-  F32x4__trunc = 0xFD69,
-  F32x4__nearest = 0xFD6A,
-
-  F64x2__abs = 0xFDEC,
-  F64x2__neg = 0xFDED,
-  F64x2__sqrt = 0xFDEF,
-  F64x2__add = 0xFDF0,
-  F64x2__sub = 0xFDF1,
-  F64x2__mul = 0xFDF2,
-  F64x2__div = 0xFDF3,
-  F64x2__min = 0xFDF4,
-  F64x2__max = 0xFDF5,
-  F64x2__pmin = 0xFDF6,
-  F64x2__pmax = 0xFDF7,
-  F64x2__ceil = 0xFD74,
-  F64x2__floor = 0xFD75,
-  F64x2__trunc = 0xFD7A,
-  F64x2__nearest = 0xFD94,
-
-  I32x4__trunc_sat_f32x4_s = 0xFDF8,
-  I32x4__trunc_sat_f32x4_u = 0xFDF9,
-  F32x4__convert_i32x4_s = 0xFDFA,
-  F32x4__convert_i32x4_u = 0xFDFB,
-  I32x4__trunc_sat_f64x2_s_zero = 0xFDFC,
-  I32x4__trunc_sat_f64x2_u_zero = 0xFDFD,
-  F64x2__convert_low_i32x4_s = 0xFDFE,
-  F64x2__convert_low_i32x4_u = 0xFDFF,
-  F32x4__demote_f64x2_zero = 0xFD5E,
-  F64x2__promote_low_f32x4 = 0xFD5F
+  I8x16__swizzle = 0xFD000E,
+  I8x16__splat = 0xFD000F,
+  I16x8__splat = 0xFD0010,
+  I32x4__splat = 0xFD0011,
+  I64x2__splat = 0xFD0012,
+  F32x4__splat = 0xFD0013,
+  F64x2__splat = 0xFD0014,
+
+  I8x16__eq = 0xFD0023,
+  I8x16__ne = 0xFD0024,
+  I8x16__lt_s = 0xFD0025,
+  I8x16__lt_u = 0xFD0026,
+  I8x16__gt_s = 0xFD0027,
+  I8x16__gt_u = 0xFD0028,
+  I8x16__le_s = 0xFD0029,
+  I8x16__le_u = 0xFD002A,
+  I8x16__ge_s = 0xFD002B,
+  I8x16__ge_u = 0xFD002C,
+
+  I16x8__eq = 0xFD002D,
+  I16x8__ne = 0xFD002E,
+  I16x8__lt_s = 0xFD002F,
+  I16x8__lt_u = 0xFD0030,
+  I16x8__gt_s = 0xFD0031,
+  I16x8__gt_u = 0xFD0032,
+  I16x8__le_s = 0xFD0033,
+  I16x8__le_u = 0xFD0034,
+  I16x8__ge_s = 0xFD0035,
+  I16x8__ge_u = 0xFD0036,
+
+  I32x4__eq = 0xFD0037,
+  I32x4__ne = 0xFD0038,
+  I32x4__lt_s = 0xFD0039,
+  I32x4__lt_u = 0xFD003A,
+  I32x4__gt_s = 0xFD003B,
+  I32x4__gt_u = 0xFD003C,
+  I32x4__le_s = 0xFD003D,
+  I32x4__le_u = 0xFD003E,
+  I32x4__ge_s = 0xFD003F,
+  I32x4__ge_u = 0xFD0040,
+
+  I64x2__eq = 0xFD00D6,
+  I64x2__ne = 0xFD00D7,
+  I64x2__lt_s = 0xFD00D8,
+  I64x2__gt_s = 0xFD00D9,
+  I64x2__le_s = 0xFD00DA,
+  I64x2__ge_s = 0xFD00DB,
+
+  F32x4__eq = 0xFD0041,
+  F32x4__ne = 0xFD0042,
+  F32x4__lt = 0xFD0043,
+  F32x4__gt = 0xFD0044,
+  F32x4__le = 0xFD0045,
+  F32x4__ge = 0xFD0046,
+
+  F64x2__eq = 0xFD0047,
+  F64x2__ne = 0xFD0048,
+  F64x2__lt = 0xFD0049,
+  F64x2__gt = 0xFD004A,
+  F64x2__le = 0xFD004B,
+  F64x2__ge = 0xFD004C,
+
+  V128__not = 0xFD004D,
+  V128__and = 0xFD004E,
+  V128__andnot = 0xFD004F,
+  V128__or = 0xFD0050,
+  V128__xor = 0xFD0051,
+  V128__bitselect = 0xFD0052,
+  V128__any_true = 0xFD0053,
+
+  I8x16__abs = 0xFD0060,
+  I8x16__neg = 0xFD0061,
+  I8x16__popcnt = 0xFD0062,
+  I8x16__all_true = 0xFD0063,
+  I8x16__bitmask = 0xFD0064,
+  I8x16__narrow_i16x8_s = 0xFD0065,
+  I8x16__narrow_i16x8_u = 0xFD0066,
+  I8x16__shl = 0xFD006B,
+  I8x16__shr_s = 0xFD006C,
+  I8x16__shr_u = 0xFD006D,
+  I8x16__add = 0xFD006E,
+  I8x16__add_sat_s = 0xFD006F,
+  I8x16__add_sat_u = 0xFD0070,
+  I8x16__sub = 0xFD0071,
+  I8x16__sub_sat_s = 0xFD0072,
+  I8x16__sub_sat_u = 0xFD0073,
+  I8x16__min_s = 0xFD0076,
+  I8x16__min_u = 0xFD0077,
+  I8x16__max_s = 0xFD0078,
+  I8x16__max_u = 0xFD0079,
+  I8x16__avgr_u = 0xFD007B,
+
+  I16x8__abs = 0xFD0080,
+  I16x8__neg = 0xFD0081,
+  I16x8__all_true = 0xFD0083,
+  I16x8__bitmask = 0xFD0084,
+  I16x8__narrow_i32x4_s = 0xFD0085,
+  I16x8__narrow_i32x4_u = 0xFD0086,
+  I16x8__extend_low_i8x16_s = 0xFD0087,
+  I16x8__extend_high_i8x16_s = 0xFD0088,
+  I16x8__extend_low_i8x16_u = 0xFD0089,
+  I16x8__extend_high_i8x16_u = 0xFD008A,
+  I16x8__shl = 0xFD008B,
+  I16x8__shr_s = 0xFD008C,
+  I16x8__shr_u = 0xFD008D,
+  I16x8__add = 0xFD008E,
+  I16x8__add_sat_s = 0xFD008F,
+  I16x8__add_sat_u = 0xFD0090,
+  I16x8__sub = 0xFD0091,
+  I16x8__sub_sat_s = 0xFD0092,
+  I16x8__sub_sat_u = 0xFD0093,
+  I16x8__mul = 0xFD0095,
+  I16x8__min_s = 0xFD0096,
+  I16x8__min_u = 0xFD0097,
+  I16x8__max_s = 0xFD0098,
+  I16x8__max_u = 0xFD0099,
+  I16x8__avgr_u = 0xFD009B,
+  I16x8__extmul_low_i8x16_s = 0xFD009C,
+  I16x8__extmul_high_i8x16_s = 0xFD009D,
+  I16x8__extmul_low_i8x16_u = 0xFD009E,
+  I16x8__extmul_high_i8x16_u = 0xFD009F,
+  I16x8__q15mulr_sat_s = 0xFD0082,
+  I16x8__extadd_pairwise_i8x16_s = 0xFD007C,
+  I16x8__extadd_pairwise_i8x16_u = 0xFD007D,
+
+  I32x4__abs = 0xFD00A0,
+  I32x4__neg = 0xFD00A1,
+  I32x4__all_true = 0xFD00A3,
+  I32x4__bitmask = 0xFD00A4,
+  I32x4__extend_low_i16x8_s = 0xFD00A7,
+  I32x4__extend_high_i16x8_s = 0xFD00A8,
+  I32x4__extend_low_i16x8_u = 0xFD00A9,
+  I32x4__extend_high_i16x8_u = 0xFD00AA,
+  I32x4__shl = 0xFD00AB,
+  I32x4__shr_s = 0xFD00AC,
+  I32x4__shr_u = 0xFD00AD,
+  I32x4__add = 0xFD00AE,
+  I32x4__sub = 0xFD00B1,
+  I32x4__mul = 0xFD00B5,
+  I32x4__min_s = 0xFD00B6,
+  I32x4__min_u = 0xFD00B7,
+  I32x4__max_s = 0xFD00B8,
+  I32x4__max_u = 0xFD00B9,
+  I32x4__dot_i16x8_s = 0xFD00BA,
+  I32x4__extmul_low_i16x8_s = 0xFD00BC,
+  I32x4__extmul_high_i16x8_s = 0xFD00BD,
+  I32x4__extmul_low_i16x8_u = 0xFD00BE,
+  I32x4__extmul_high_i16x8_u = 0xFD00BF,
+  I32x4__extadd_pairwise_i16x8_s = 0xFD007E,
+  I32x4__extadd_pairwise_i16x8_u = 0xFD007F,
+
+  I64x2__abs = 0xFD00C0,
+  I64x2__neg = 0xFD00C1,
+  I64x2__all_true = 0xFD00C3,
+  I64x2__bitmask = 0xFD00C4,
+  I64x2__extend_low_i32x4_s = 0xFD00C7,
+  I64x2__extend_high_i32x4_s = 0xFD00C8,
+  I64x2__extend_low_i32x4_u = 0xFD00C9,
+  I64x2__extend_high_i32x4_u = 0xFD00CA,
+  I64x2__shl = 0xFD00CB,
+  I64x2__shr_s = 0xFD00CC,
+  I64x2__shr_u = 0xFD00CD,
+  I64x2__add = 0xFD00CE,
+  I64x2__sub = 0xFD00D1,
+  I64x2__mul = 0xFD00D5,
+  I64x2__extmul_low_i32x4_s = 0xFD00DC,
+  I64x2__extmul_high_i32x4_s = 0xFD00DD,
+  I64x2__extmul_low_i32x4_u = 0xFD00DE,
+  I64x2__extmul_high_i32x4_u = 0xFD00DF,
+
+  F32x4__abs = 0xFD00E0,
+  F32x4__neg = 0xFD00E1,
+  F32x4__sqrt = 0xFD00E3,
+  F32x4__add = 0xFD00E4,
+  F32x4__sub = 0xFD00E5,
+  F32x4__mul = 0xFD00E6,
+  F32x4__div = 0xFD00E7,
+  F32x4__min = 0xFD00E8,
+  F32x4__max = 0xFD00E9,
+  F32x4__pmin = 0xFD00EA,
+  F32x4__pmax = 0xFD00EB,
+  F32x4__ceil = 0xFD0067,
+  F32x4__floor = 0xFD0068,
+  F32x4__trunc = 0xFD0069,
+  F32x4__nearest = 0xFD006A,
+
+  F64x2__abs = 0xFD00EC,
+  F64x2__neg = 0xFD00ED,
+  F64x2__sqrt = 0xFD00EF,
+  F64x2__add = 0xFD00F0,
+  F64x2__sub = 0xFD00F1,
+  F64x2__mul = 0xFD00F2,
+  F64x2__div = 0xFD00F3,
+  F64x2__min = 0xFD00F4,
+  F64x2__max = 0xFD00F5,
+  F64x2__pmin = 0xFD00F6,
+  F64x2__pmax = 0xFD00F7,
+  F64x2__ceil = 0xFD0074,
+  F64x2__floor = 0xFD0075,
+  F64x2__trunc = 0xFD007A,
+  F64x2__nearest = 0xFD0094,
+
+  I32x4__trunc_sat_f32x4_s = 0xFD00F8,
+  I32x4__trunc_sat_f32x4_u = 0xFD00F9,
+  F32x4__convert_i32x4_s = 0xFD00FA,
+  F32x4__convert_i32x4_u = 0xFD00FB,
+  I32x4__trunc_sat_f64x2_s_zero = 0xFD00FC,
+  I32x4__trunc_sat_f64x2_u_zero = 0xFD00FD,
+  F64x2__convert_low_i32x4_s = 0xFD00FE,
+  F64x2__convert_low_i32x4_u = 0xFD00FF,
+  F32x4__demote_f64x2_zero = 0xFD005E,
+  F64x2__promote_low_f32x4 = 0xFD005F,
+
+  // Relaxed SIMD instructions
+  I8x16__relaxed_swizzle = 0xFD0100,
+  I32x4__relaxed_trunc_f32x4_s = 0xFD0101,
+  I32x4__relaxed_trunc_f32x4_u = 0xFD0102,
+  I32x4__relaxed_trunc_f64x2_s_zero = 0xFD0103,
+  I32x4__relaxed_trunc_f64x2_u_zero = 0xFD0104,
+  F32x4__relaxed_madd = 0xFD0105,
+  F32x4__relaxed_nmadd = 0xFD0106,
+  F64x2__relaxed_madd = 0xFD0107,
+  F64x2__relaxed_nmadd = 0xFD0108,
+  I8x16__relaxed_laneselect = 0xFD0109,
+  I16x8__relaxed_laneselect = 0xFD010A,
+  I32x4__relaxed_laneselect = 0xFD010B,
+  I64x2__relaxed_laneselect = 0xFD010C,
+  F32x4__relaxed_min = 0xFD010D,
+  F32x4__relaxed_max = 0xFD010E,
+  F64x2__relaxed_min = 0xFD010F,
+  F64x2__relaxed_max = 0xFD0110,
+  I16x8__relaxed_q15mulr_s = 0xFD0111,
+  I16x8__relaxed_dot_i8x16_i7x16_s = 0xFD0112,
+  I32x4__relaxed_dot_i8x16_i7x16_add_s = 0xFD0113
 };
 
 /// Instruction opcode enumeration string mapping.
@@ -581,6 +615,10 @@ static inline std::unordered_map<OpCode, std::string> OpCodeStr = {
     {OpCode::Loop, "loop"},
     {OpCode::If, "if"},
     {OpCode::Else, "else"},
+    {OpCode::Try, "try"},
+    {OpCode::Catch, "catch"},
+    {OpCode::Throw, "throw"},
+    {OpCode::Rethrow, "rethrow"},
     {OpCode::End, "end"},
     {OpCode::Br, "br"},
     {OpCode::Br_if, "br_if"},
@@ -588,11 +626,16 @@ static inline std::unordered_map<OpCode, std::string> OpCodeStr = {
     {OpCode::Return, "return"},
     {OpCode::Call, "call"},
     {OpCode::Call_indirect, "call_indirect"},
+    {OpCode::Call_ref, "call_ref"},
+    {OpCode::Delegate, "delegate"},
+    {OpCode::Catch_all, "catch_all"},
 
     // Reference Instructions
     {OpCode::Ref__null, "ref.null"},
     {OpCode::Ref__is_null, "ref.is_null"},
     {OpCode::Ref__func, "ref.func"},
+    {OpCode::Ref__as_non_null, "ref.as_non_null"},
+    {OpCode::Br_on_null, "br_on_null"},
 
     // Parametric Instructions
     {OpCode::Drop, "drop"},
@@ -1053,7 +1096,33 @@ static inline std::unordered_map<OpCode, std::string> OpCodeStr = {
     {OpCode::F64x2__convert_low_i32x4_s, "f64x2.convert_low_i32x4_s"},
     {OpCode::F64x2__convert_low_i32x4_u, "f64x2.convert_low_i32x4_u"},
     {OpCode::F32x4__demote_f64x2_zero, "f32x4.demote_f64x2_zero"},
-    {OpCode::F64x2__promote_low_f32x4, "f64x2.promote_low_f32x4"}};
+    {OpCode::F64x2__promote_low_f32x4, "f64x2.promote_low_f32x4"},
+
+    // Relaxed SIMD instructions
+    {OpCode::I8x16__relaxed_swizzle, "i8x16.relaxed_swizzle"},
+    {OpCode::I32x4__relaxed_trunc_f32x4_s, "i32x4.relaxed_trunc_f32x4_s"},
+    {OpCode::I32x4__relaxed_trunc_f32x4_u, "i32x4.relaxed_trunc_f32x4_u"},
+    {OpCode::I32x4__relaxed_trunc_f64x2_s_zero,
+     "i32x4.relaxed_trunc_f64x2_s_zero"},
+    {OpCode::I32x4__relaxed_trunc_f64x2_u_zero,
+     "i32x4.relaxed_trunc_f64x2_u_zero"},
+    {OpCode::F32x4__relaxed_madd, "f32x4.relaxed_madd"},
+    {OpCode::F32x4__relaxed_nmadd, "f32x4.relaxed_nmadd"},
+    {OpCode::F64x2__relaxed_madd, "f64x2.relaxed_madd"},
+    {OpCode::F64x2__relaxed_nmadd, "f64x2.relaxed_nmadd"},
+    {OpCode::I8x16__relaxed_laneselect, "i8x16.relaxed_laneselect"},
+    {OpCode::I16x8__relaxed_laneselect, "i16x8.relaxed_laneselect"},
+    {OpCode::I32x4__relaxed_laneselect, "i32x4.relaxed_laneselect"},
+    {OpCode::I64x2__relaxed_laneselect, "i64x2.relaxed_laneselect"},
+    {OpCode::F32x4__relaxed_min, "f32x4.relaxed_min"},
+    {OpCode::F32x4__relaxed_max, "f32x4.relaxed_max"},
+    {OpCode::F64x2__relaxed_min, "f64x2.relaxed_min"},
+    {OpCode::F64x2__relaxed_max, "f64x2.relaxed_max"},
+    {OpCode::I16x8__relaxed_q15mulr_s, "i16x8.relaxed_q15mulr_s"},
+    {OpCode::I16x8__relaxed_dot_i8x16_i7x16_s,
+     "i16x8.relaxed_dot_i8x16_i7x16_s"},
+    {OpCode::I32x4__relaxed_dot_i8x16_i7x16_add_s,
+     "i32x4.relaxed_dot_i8x16_i7x16_add_s"}};
 
 } // namespace WasmEdge
 
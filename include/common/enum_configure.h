@@ -42,6 +42,7 @@ enum class Proposal : uint8_t {
   ExceptionHandling,
   Threads,
   FunctionReferences,
+  RelaxedSIMD,
   Max
 };
 
@@ -64,6 +65,7 @@ static inline std::unordered_map<Proposal, std::string_view> ProposalStr = {
     {Proposal::ExceptionHandling, "Exception handling"sv},
     {Proposal::Threads, "Threads"sv},
     {Proposal::FunctionReferences, "Typed Function References"sv},
+    {Proposal::RelaxedSIMD, "Relaxed SIMD"sv},
 };
 
 } // namespace detail
@@ -88,7 +90,8 @@ enum WasmEdge_Proposal {
   WasmEdge_Proposal_Memory64,
   WasmEdge_Proposal_ExceptionHandling,
   WasmEdge_Proposal_Threads,
-  WasmEdge_Proposal_FunctionReferences
+  WasmEdge_Proposal_FunctionReferences,
+  WasmEdge_Proposal_RelaxedSIMD
 };
 
 #if (defined(__cplusplus) && __cplusplus > 201402L) ||                         \
@@ -96,7 +99,13 @@ enum WasmEdge_Proposal {
 namespace WasmEdge {
 
 /// Host Module Registration C++ enumeration class.
-enum class HostRegistration : uint8_t { Wasi = 0, WasmEdge_Process, Max };
+enum class HostRegistration : uint8_t {
+  Wasi = 0,
+  WasmEdge_Process,
+  WasmEdge_Memory,
+  WasmEdge_Fs,
+  Max
+};
 
 } // namespace WasmEdge
 #endif
@@ -104,7 +113,40 @@ enum class HostRegistration : uint8_t { Wasi = 0, WasmEdge_Process, Max };
 /// Host Module Registration C enumeration.
 enum WasmEdge_HostRegistration {
   WasmEdge_HostRegistration_Wasi = 0,
-  WasmEdge_HostRegistration_WasmEdge_Process
+  WasmEdge_HostRegistration_WasmEdge_Process,
+  WasmEdge_HostRegistration_WasmEdge_Memory,
+  WasmEdge_HostRegistration_WasmEdge_Fs
+};
+
+#if (defined(__cplusplus) && __cplusplus > 201402L) ||                         \
+    (defined(_MSVC_LANG) && _MSVC_LANG > 201402L)
+namespace WasmEdge {
+
+/// Host function work C++ enumeration class.
+enum class HostWork : uint8_t {
+  Bytes = 0,
+  DirEntries,
+  Subscriptions,
+  ThrottledOps,
+  ThrottledNanos,
+  Max
+};
+
+} // namespace WasmEdge
+#endif
+
+/// Host function work C enumeration.
+enum WasmEdge_HostWork {
+  // Bytes transferred between the memory and the host.
+  WasmEdge_HostWork_Bytes = 0,
+  // Directory entries or path attributes returned.
+  WasmEdge_HostWork_DirEntries,
+  // Poll subscriptions registered.
+  WasmEdge_HostWork_Subscriptions,
+  // I/O operations delayed or rejected by the WASI rate limit.
+  WasmEdge_HostWork_ThrottledOps,
+  // Nanoseconds waited for the WASI rate limit.
+  WasmEdge_HostWork_ThrottledNanos
 };
 
 /// AOT compiler optimization level C enumeration.
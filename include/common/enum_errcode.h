@@ -53,13 +53,14 @@ namespace WasmEdge {
 /// Error code C++ enumeration class.
 enum class ErrCode : uint8_t {
   Success = 0x00,
-  Terminated = 0x01,        // Exit and return success.
-  RuntimeError = 0x02,      // Generic runtime error.
-  CostLimitExceeded = 0x03, // Exceeded cost limit (out of gas).
-  WrongVMWorkflow = 0x04,   // Wrong VM's workflow
-  FuncNotFound = 0x05,      // Wasm function not found
-  AOTDisabled = 0x06,       // AOT runtime is disabled
-  Interrupted = 0x07,       // Execution interrupted
+  Terminated = 0x01,           // Exit and return success.
+  RuntimeError = 0x02,         // Generic runtime error.
+  CostLimitExceeded = 0x03,    // Exceeded cost limit (out of gas).
+  WrongVMWorkflow = 0x04,      // Wrong VM's workflow
+  FuncNotFound = 0x05,         // Wasm function not found
+  AOTDisabled = 0x06,          // AOT runtime is disabled
+  Interrupted = 0x07,          // Execution interrupted
+  CPUTimeLimitExceeded = 0x08, // Exceeded CPU time limit
 
   // Load phase
   IllegalPath = 0x20,           // File not found
@@ -89,28 +90,31 @@ enum class ErrCode : uint8_t {
   IllegalGrammar = 0x38,        // Parsing error
 
   // Validation phase
-  InvalidAlignment = 0x40,   // Alignment > natural
-  TypeCheckFailed = 0x41,    // Got unexpected type when checking
-  InvalidLabelIdx = 0x42,    // Branch to unknown label index
-  InvalidLocalIdx = 0x43,    // Access unknown local index
-  InvalidFuncTypeIdx = 0x44, // Type index not defined
-  InvalidFuncIdx = 0x45,     // Function index not defined
-  InvalidTableIdx = 0x46,    // Table index not defined
-  InvalidMemoryIdx = 0x47,   // Memory index not defined
-  InvalidGlobalIdx = 0x48,   // Global index not defined
-  InvalidElemIdx = 0x49,     // Element segment index not defined
-  InvalidDataIdx = 0x4A,     // Data segment index not defined
-  InvalidRefIdx = 0x4B,      // Undeclared reference
-  ConstExprRequired = 0x4C,  // Should be constant expression
-  DupExportName = 0x4D,      // Export name conflicted
-  ImmutableGlobal = 0x4E,    // Tried to store to const global value
-  InvalidResultArity = 0x4F, // Invalid result arity in select t* instruction
-  MultiTables = 0x50,        // #Tables > 1 (without Ref-types proposal)
-  MultiMemories = 0x51,      // #Memories > 1
-  InvalidLimit = 0x52,       // Invalid Limit grammar
-  InvalidMemPages = 0x53,    // Memory pages > 65536
-  InvalidStartFunc = 0x54,   // Invalid start function signature
-  InvalidLaneIdx = 0x55,     // Invalid lane index
+  InvalidAlignment = 0x40,    // Alignment > natural
+  TypeCheckFailed = 0x41,     // Got unexpected type when checking
+  InvalidLabelIdx = 0x42,     // Branch to unknown label index
+  InvalidLocalIdx = 0x43,     // Access unknown local index
+  InvalidFuncTypeIdx = 0x44,  // Type index not defined
+  InvalidFuncIdx = 0x45,      // Function index not defined
+  InvalidTableIdx = 0x46,     // Table index not defined
+  InvalidMemoryIdx = 0x47,    // Memory index not defined
+  InvalidGlobalIdx = 0x48,    // Global index not defined
+  InvalidElemIdx = 0x49,      // Element segment index not defined
+  InvalidDataIdx = 0x4A,      // Data segment index not defined
+  InvalidRefIdx = 0x4B,       // Undeclared reference
+  ConstExprRequired = 0x4C,   // Should be constant expression
+  DupExportName = 0x4D,       // Export name conflicted
+  ImmutableGlobal = 0x4E,     // Tried to store to const global value
+  InvalidResultArity = 0x4F,  // Invalid result arity in select t* instruction
+  MultiTables = 0x50,         // #Tables > 1 (without Ref-types proposal)
+  MultiMemories = 0x51,       // #Memories > 1
+  InvalidLimit = 0x52,        // Invalid Limit grammar
+  InvalidMemPages = 0x53,     // Memory pages > 65536
+  InvalidStartFunc = 0x54,    // Invalid start function signature
+  InvalidLaneIdx = 0x55,      // Invalid lane index
+  InvalidTagIdx = 0x56,       // Tag index not defined
+  InvalidTagResult = 0x57,    // Tag type with results
+  InvalidRethrowLabel = 0x58, // Rethrow to a label not of catch
 
   // Instantiation phase
   ModuleNameConflict = 0x60,     // Module name conflicted when importing.
@@ -134,7 +138,10 @@ enum class ErrCode : uint8_t {
   UndefinedElement = 0x8B,     // Access undefined element in table instances
   IndirectCallTypeMismatch = 0x8C, // Func type mismatch in call_indirect
   ExecutionFailed = 0x8D,          // Host function execution failed
-  RefTypeMismatch = 0x8E           // Reference type not match
+  RefTypeMismatch = 0x8E,          // Reference type not match
+  UncaughtException = 0x8F,        // Exception not caught in wasm
+  AccessNullFunc = 0x90,           // Call a null function reference
+  CastNullToNonNull = 0x91         // Cast a null reference to non-null
 };
 
 static inline std::unordered_map<ErrCode, std::string> ErrCodeStr = {
@@ -147,6 +154,7 @@ static inline std::unordered_map<ErrCode, std::string> ErrCodeStr = {
     {ErrCode::FuncNotFound, "wasm function not found"},
     {ErrCode::AOTDisabled, "AOT runtime is disabled in this build"},
     {ErrCode::Interrupted, "execution interrupted"},
+    {ErrCode::CPUTimeLimitExceeded, "CPU time limit exceeded"},
     // Load phase
     {ErrCode::IllegalPath, "invalid path"},
     {ErrCode::ReadError, "read error"},
@@ -199,6 +207,9 @@ static inline std::unordered_map<ErrCode, std::string> ErrCodeStr = {
      "memory size must be at most 65536 pages (4GiB)"},
     {ErrCode::InvalidStartFunc, "start function"},
     {ErrCode::InvalidLaneIdx, "invalid lane index"},
+    {ErrCode::InvalidTagIdx, "unknown tag"},
+    {ErrCode::InvalidTagResult, "non-empty tag result type"},
+    {ErrCode::InvalidRethrowLabel, "invalid rethrow label"},
     // Instantiation phase
     {ErrCode::ModuleNameConflict, "module name conflict"},
     {ErrCode::IncompatibleImportType, "incompatible import type"},
@@ -220,7 +231,10 @@ static inline std::unordered_map<ErrCode, std::string> ErrCodeStr = {
     {ErrCode::UndefinedElement, "undefined element"},
     {ErrCode::IndirectCallTypeMismatch, "indirect call type mismatch"},
     {ErrCode::ExecutionFailed, "host function failed"},
-    {ErrCode::RefTypeMismatch, "reference type mismatch"}};
+    {ErrCode::RefTypeMismatch, "reference type mismatch"},
+    {ErrCode::UncaughtException, "uncaught exception"},
+    {ErrCode::AccessNullFunc, "null function reference"},
+    {ErrCode::CastNullToNonNull, "null reference"}};
 
 } // namespace WasmEdge
 #endif
@@ -235,6 +249,7 @@ enum WasmEdge_ErrCode {
   WasmEdge_ErrCode_FuncNotFound = 0x05,
   WasmEdge_ErrCode_AOTDisabled = 0x06,
   WasmEdge_ErrCode_Interrupted = 0x07,
+  WasmEdge_ErrCode_CPUTimeLimitExceeded = 0x08,
 
   // Load phase
   WasmEdge_ErrCode_InvalidPath = 0x20,
@@ -286,6 +301,9 @@ enum WasmEdge_ErrCode {
   WasmEdge_ErrCode_InvalidMemPages = 0x53,
   WasmEdge_ErrCode_InvalidStartFunc = 0x54,
   WasmEdge_ErrCode_InvalidLaneIdx = 0x55,
+  WasmEdge_ErrCode_InvalidTagIdx = 0x56,
+  WasmEdge_ErrCode_InvalidTagResult = 0x57,
+  WasmEdge_ErrCode_InvalidRethrowLabel = 0x58,
 
   // Instantiation phase
   WasmEdge_ErrCode_ModuleNameConflict = 0x60,
@@ -309,7 +327,10 @@ enum WasmEdge_ErrCode {
   WasmEdge_ErrCode_UndefinedElement = 0x8B,
   WasmEdge_ErrCode_IndirectCallTypeMismatch = 0x8C,
   WasmEdge_ErrCode_ExecutionFailed = 0x8D,
-  WasmEdge_ErrCode_RefTypeMismatch = 0x8E
+  WasmEdge_ErrCode_RefTypeMismatch = 0x8E,
+  WasmEdge_ErrCode_UncaughtException = 0x8F,
+  WasmEdge_ErrCode_AccessNullFunc = 0x90,
+  WasmEdge_ErrCode_CastNullToNonNull = 0x91
 };
 
 #endif // WASMEDGE_C_API_ENUM_ERRCODE_H
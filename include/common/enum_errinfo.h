@@ -89,7 +89,8 @@ enum class IndexCategory : uint8_t {
   Global,
   Element,
   Data,
-  Lane
+  Lane,
+  Tag
 };
 
 static inline std::unordered_map<IndexCategory, std::string> IndexCategoryStr =
@@ -102,7 +103,8 @@ static inline std::unordered_map<IndexCategory, std::string> IndexCategoryStr =
      {IndexCategory::Global, "global"},
      {IndexCategory::Element, "element"},
      {IndexCategory::Data, "data"},
-     {IndexCategory::Lane, "lane"}};
+     {IndexCategory::Lane, "lane"},
+     {IndexCategory::Tag, "tag"}};
 
 } // namespace ErrInfo
 } // namespace WasmEdge
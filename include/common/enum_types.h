@@ -127,14 +127,16 @@ enum class ExternalType : uint8_t {
   Function = 0x00U,
   Table = 0x01U,
   Memory = 0x02U,
-  Global = 0x03U
+  Global = 0x03U,
+  Tag = 0x04U
 };
 
 static inline std::unordered_map<ExternalType, std::string> ExternalTypeStr = {
     {ExternalType::Function, "function"},
     {ExternalType::Table, "table"},
     {ExternalType::Memory, "memory"},
-    {ExternalType::Global, "global"}};
+    {ExternalType::Global, "global"},
+    {ExternalType::Tag, "tag"}};
 
 } // namespace WasmEdge
 #endif
@@ -144,7 +146,8 @@ enum WasmEdge_ExternalType {
   WasmEdge_ExternalType_Function = 0x00U,
   WasmEdge_ExternalType_Table = 0x01U,
   WasmEdge_ExternalType_Memory = 0x02U,
-  WasmEdge_ExternalType_Global = 0x03U
+  WasmEdge_ExternalType_Global = 0x03U,
+  WasmEdge_ExternalType_Tag = 0x04U
 };
 
 #endif // WASMEDGE_C_API_ENUM_TYPES_H
@@ -20,23 +20,70 @@
 #include "common/span.h"
 #include "common/timer.h"
 
-#include <vector>
+#include <array>
+#include <functional>
+#include <memory>
 
 namespace WasmEdge {
 namespace Statistics {
 
+/// Dense opcode ordinal layout of the cost table:
+///   [0x000, 0x100): single byte opcodes.
+///   [0x100, 0x120): 0xFC prefixed opcodes.
+///   [0x120, 0x240): 0xFD prefixed opcodes, including the relaxed SIMD ones
+///                   from 0x100.
+inline constexpr uint32_t kCostTableFCBase = 0x100;
+inline constexpr uint32_t kCostTableFDBase = 0x120;
+inline constexpr uint32_t kCostTableSize = 0x240;
+
+/// Map the opcode to the dense ordinal in the cost table.
+inline constexpr uint32_t getCostTableIndex(OpCode Code) noexcept {
+  const uint32_t Val = static_cast<uint32_t>(Code);
+  switch (Val >> 16) {
+  case 0x00:
+    return Val;
+  case 0xFC:
+    return kCostTableFCBase + (Val & 0x1FU);
+  case 0xFD:
+    return kCostTableFDBase + (Val & 0x1FFU);
+  default:
+    assumingUnreachable();
+  }
+}
+
+/// Map the dense ordinal in the cost table back to the opcode value.
+inline constexpr uint32_t getCostTableOpCode(uint32_t Index) noexcept {
+  if (Index < kCostTableFCBase) {
+    return Index;
+  } else if (Index < kCostTableFDBase) {
+    return 0xFC0000U + (Index - kCostTableFCBase);
+  } else {
+    return 0xFD0000U + (Index - kCostTableFDBase);
+  }
+}
+
+/// Immutable cost table indexed by the dense opcode ordinal. The tables are
+/// shared by reference between statistics and copied on write.
+using CostTable = std::array<uint64_t, kCostTableSize>;
+
+/// Cost model of the work done by host functions, returns the cost of the
+/// amount of the work.
+using HostCostModel = std::function<uint64_t(HostWork Kind, uint64_t Amount)>;
+
+/// Number of the calls and branches between the samples of the CPU time
+/// limit.
+inline constexpr uint32_t kCPUTimeCheckInterval = 1024;
+
 class Statistics {
 public:
   Statistics(const uint64_t Lim = UINT64_MAX)
-      : CostTab(UINT16_MAX + 1, 1ULL), InstrCnt(0), CostLimit(Lim), CostSum(0) {
-  }
+      : CostTab(getDefaultCostTable()), InstrCnt(0), CostLimit(Lim),
+        CostSum(0) {}
   Statistics(Span<const uint64_t> Tab, const uint64_t Lim = UINT64_MAX)
-      : CostTab(Tab.begin(), Tab.end()), InstrCnt(0), CostLimit(Lim),
-        CostSum(0) {
-    if (CostTab.size() < UINT16_MAX + 1) {
-      CostTab.resize(UINT16_MAX + 1, 0ULL);
-    }
-  }
+      : CostTab(genCostTable(Tab)), InstrCnt(0), CostLimit(Lim), CostSum(0) {}
+  Statistics(std::shared_ptr<const CostTable> Tab,
+             const uint64_t Lim = UINT64_MAX)
+      : CostTab(std::move(Tab)), InstrCnt(0), CostLimit(Lim), CostSum(0) {}
   ~Statistics() = default;
 
   /// Increment of instruction counter.
@@ -52,21 +99,35 @@ public:
            std::chrono::duration<double>(getWasmExecTime()).count();
   }
 
-  /// Setter and setter of cost table.
+  /// Setter of cost table. The input table is indexed by the opcode value.
   void setCostTable(Span<const uint64_t> NewTable) {
-    CostTab.assign(NewTable.begin(), NewTable.end());
-    if (unlikely(CostTab.size() < UINT16_MAX + 1)) {
-      CostTab.resize(UINT16_MAX + 1, 0ULL);
-    }
+    CostTab = genCostTable(NewTable);
+  }
+  /// Setter of cost table by sharing the existing dense table.
+  void setCostTable(std::shared_ptr<const CostTable> NewTable) noexcept {
+    CostTab = std::move(NewTable);
+  }
+  /// Setter of the cost of an instruction. The shared table is not modified.
+  void setInstrCost(OpCode Code, uint64_t Cost) {
+    auto NewTab = std::make_shared<CostTable>(*CostTab);
+    (*NewTab)[getCostTableIndex(Code)] = Cost;
+    CostTab = std::move(NewTab);
+  }
+  /// Getter of the dense cost table indexed by the opcode ordinal.
+  Span<const uint64_t> getCostTable() const noexcept { return *CostTab; }
+  const std::shared_ptr<const CostTable> &getSharedCostTable() const noexcept {
+    return CostTab;
+  }
+  /// Getter of the cost of an instruction.
+  uint64_t getInstrCost(OpCode Code) const noexcept {
+    return (*CostTab)[getCostTableIndex(Code)];
   }
-  Span<const uint64_t> getCostTable() const noexcept { return CostTab; }
-  Span<uint64_t> getCostTable() noexcept { return CostTab; }
 
   /// Adder of instruction costs.
-  bool addInstrCost(OpCode Code) { return addCost(CostTab[uint16_t(Code)]); }
+  bool addInstrCost(OpCode Code) { return addCost(getInstrCost(Code)); }
 
   /// Subber of instruction costs.
-  bool subInstrCost(OpCode Code) { return subCost(CostTab[uint16_t(Code)]); }
+  bool subInstrCost(OpCode Code) { return subCost(getInstrCost(Code)); }
 
   /// Getter of total gas cost.
   uint64_t getTotalCost() const { return CostSum; }
@@ -76,6 +137,25 @@ public:
   void setCostLimit(uint64_t Lim) { CostLimit = Lim; }
   uint64_t getCostLimit() const { return CostLimit; }
 
+  /// Setter of the cost model of the host function work. The work is free if
+  /// the model is empty.
+  void setHostCostModel(HostCostModel Model) { HostCost = std::move(Model); }
+
+  /// Add the cost of the work done by a host function and return false if
+  /// exceeded limit.
+  bool addHostWorkCost(HostWork Kind, uint64_t Amount) {
+    HostWorkCnt[static_cast<size_t>(Kind)] += Amount;
+    if (!HostCost || Amount == 0) {
+      return true;
+    }
+    return addCost(HostCost(Kind, Amount));
+  }
+
+  /// Getter of the total amount of the work done by host functions.
+  uint64_t getHostWorkCount(HostWork Kind) const noexcept {
+    return HostWorkCnt[static_cast<size_t>(Kind)];
+  }
+
   /// Add cost and return false if exceeded limit.
   bool addCost(const uint64_t &Cost) {
     CostSum += Cost;
@@ -102,6 +182,7 @@ public:
     TimeRecorder.reset();
     InstrCnt = 0;
     CostSum = 0;
+    HostWorkCnt.fill(0);
   }
 
   /// Start recording wasm time.
@@ -136,6 +217,79 @@ public:
            TimeRecorder.getRecord(Timer::TimerTag::HostFunc);
   }
 
+  /// Setter of CPU time measuring, which records the CPU time of the executing
+  /// thread along with the execution time.
+  void setCPUTimeMeasuring(bool IsMeasure) noexcept {
+    TimeRecorder.setCPUTiming(IsMeasure);
+  }
+  bool isCPUTimeMeasuring() const noexcept {
+    return TimeRecorder.isCPUTiming();
+  }
+
+  /// Getter of CPU time.
+  Timer::Timer::CPUClock::duration getWasmCPUTime() const noexcept {
+    return TimeRecorder.getCPURecord(Timer::TimerTag::Wasm);
+  }
+  Timer::Timer::CPUClock::duration getHostFuncCPUTime() const noexcept {
+    return TimeRecorder.getCPURecord(Timer::TimerTag::HostFunc);
+  }
+  Timer::Timer::CPUClock::duration getTotalCPUTime() const noexcept {
+    return TimeRecorder.getCPURecord(Timer::TimerTag::Wasm) +
+           TimeRecorder.getCPURecord(Timer::TimerTag::HostFunc);
+  }
+
+  /// Getter of the execution time off the CPU, such as blocking in host
+  /// functions or being preempted.
+  Timer::Timer::Clock::duration getBlockedTime() const noexcept {
+    const auto ExecTime = getTotalExecTime();
+    const auto CPUTime =
+        std::chrono::duration_cast<Timer::Timer::Clock::duration>(
+            getTotalCPUTime());
+    return ExecTime > CPUTime ? ExecTime - CPUTime
+                              : Timer::Timer::Clock::duration::zero();
+  }
+
+  /// Getter and setter of CPU time limit. Zero for no limit. Setting a limit
+  /// turns on CPU time measuring.
+  void setCPUTimeLimit(Timer::Timer::CPUClock::duration Lim) noexcept {
+    CPUTimeLimit = Lim;
+    if (Lim != Timer::Timer::CPUClock::duration::zero()) {
+      CPUTimeCheckCountdown = kCPUTimeCheckInterval;
+      TimeRecorder.setCPUTiming(true);
+    } else {
+      CPUTimeCheckCountdown = UINT32_MAX;
+    }
+  }
+  Timer::Timer::CPUClock::duration getCPUTimeLimit() const noexcept {
+    return CPUTimeLimit;
+  }
+
+  /// Getter of the countdown to the next CPU time check, which the compiled
+  /// code decrements on its own.
+  uint32_t &getCPUTimeCheckCountdownRef() noexcept {
+    return CPUTimeCheckCountdown;
+  }
+
+  /// Check the CPU time limit and return false if exceeded limit. Reading the
+  /// CPU clock is a system call, so the check is sampled once every
+  /// `kCPUTimeCheckInterval` calls unless forced.
+  bool checkCPUTime(bool Force = false) noexcept {
+    if (likely(CPUTimeLimit == Timer::Timer::CPUClock::duration::zero())) {
+      return true;
+    }
+    if (!Force && --CPUTimeCheckCountdown != 0) {
+      return true;
+    }
+    CPUTimeCheckCountdown = kCPUTimeCheckInterval;
+    if (unlikely(TimeRecorder.getCPURecordNow(Timer::TimerTag::Wasm) +
+                     TimeRecorder.getCPURecordNow(Timer::TimerTag::HostFunc) >
+                 CPUTimeLimit)) {
+      spdlog::error("CPU time exceeded limit. Force terminate the execution.");
+      return false;
+    }
+    return true;
+  }
+
   void dumpToLog(const Configure &Conf) const noexcept {
     auto Nano = [](auto &&Duration) {
       return std::chrono::nanoseconds(Duration).count();
@@ -151,6 +305,13 @@ public:
                    Nano(getWasmExecTime()));
       spdlog::info(" Host functions execution time: {} ns",
                    Nano(getHostFuncExecTime()));
+      if (isCPUTimeMeasuring()) {
+        spdlog::info(" Wasm instructions CPU time: {} ns",
+                     Nano(getWasmCPUTime()));
+        spdlog::info(" Host functions CPU time: {} ns",
+                     Nano(getHostFuncCPUTime()));
+        spdlog::info(" Blocked time: {} ns", Nano(getBlockedTime()));
+      }
     }
     if (StatConf.isInstructionCounting()) {
       spdlog::info(" Executed wasm instructions count: {}", getInstrCount());
@@ -169,10 +330,37 @@ public:
   }
 
 private:
-  std::vector<uint64_t> CostTab;
+  /// Get the shared default cost table with cost 1 for every instruction.
+  static const std::shared_ptr<const CostTable> &getDefaultCostTable() {
+    static const std::shared_ptr<const CostTable> DefaultTab = [] {
+      auto Tab = std::make_shared<CostTable>();
+      Tab->fill(1ULL);
+      return Tab;
+    }();
+    return DefaultTab;
+  }
+
+  /// Generate the dense cost table from the table indexed by opcode value.
+  /// The costs of the instructions out of the input table are set to 0.
+  static std::shared_ptr<const CostTable>
+  genCostTable(Span<const uint64_t> Tab) {
+    auto NewTab = std::make_shared<CostTable>();
+    for (uint32_t I = 0; I < kCostTableSize; ++I) {
+      const uint32_t Code = getCostTableOpCode(I);
+      (*NewTab)[I] = Code < Tab.size() ? Tab[Code] : 0ULL;
+    }
+    return NewTab;
+  }
+
+  std::shared_ptr<const CostTable> CostTab;
   uint64_t InstrCnt;
   uint64_t CostLimit;
   uint64_t CostSum;
+  HostCostModel HostCost;
+  std::array<uint64_t, static_cast<size_t>(HostWork::Max)> HostWorkCnt = {};
+  Timer::Timer::CPUClock::duration CPUTimeLimit =
+      Timer::Timer::CPUClock::duration::zero();
+  uint32_t CPUTimeCheckCountdown = UINT32_MAX;
   Timer::Timer TimeRecorder;
 };
 
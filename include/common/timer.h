@@ -25,16 +25,35 @@ namespace Timer {
 
 enum class TimerTag : uint32_t { Wasm, HostFunc, Max };
 
+/// Clock of the CPU time consumed by the calling thread.
+struct ThreadCPUClock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<ThreadCPUClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept;
+};
+
 class Timer {
 public:
   using Clock = std::chrono::steady_clock;
+  using CPUClock = ThreadCPUClock;
 
   constexpr Timer() noexcept { reset(); }
 
+  /// Record the CPU time of the current thread along with the wall time.
+  void setCPUTiming(bool Enable) noexcept { CPUTiming = Enable; }
+  constexpr bool isCPUTiming() const noexcept { return CPUTiming; }
+
   void startRecord(const TimerTag TT) noexcept {
     assuming(TT < TimerTag::Max);
     const uint32_t Index = uint32_t(TT);
     StartTime[Index].emplace(Clock::now());
+    if (CPUTiming) {
+      CPUStartTime[Index] = CPUClock::now();
+    }
   }
 
   void stopRecord(const TimerTag TT) noexcept {
@@ -44,6 +63,9 @@ public:
       const auto Diff = Clock::now() - *Start;
       RecTime[Index] += Diff;
       Start.reset();
+      if (CPUTiming) {
+        CPURecTime[Index] += CPUClock::now() - CPUStartTime[Index];
+      }
     }
   }
 
@@ -52,6 +74,7 @@ public:
     const uint32_t Index = uint32_t(TT);
     StartTime[Index].reset();
     RecTime[Index] = Clock::duration::zero();
+    CPURecTime[Index] = CPUClock::duration::zero();
   }
 
   constexpr Clock::duration getRecord(const TimerTag TT) const noexcept {
@@ -60,6 +83,22 @@ public:
     return RecTime[Index];
   }
 
+  constexpr CPUClock::duration getCPURecord(const TimerTag TT) const noexcept {
+    assuming(TT < TimerTag::Max);
+    const uint32_t Index = uint32_t(TT);
+    return CPURecTime[Index];
+  }
+
+  /// Get the CPU time of the tag including the running record.
+  CPUClock::duration getCPURecordNow(const TimerTag TT) const noexcept {
+    assuming(TT < TimerTag::Max);
+    const uint32_t Index = uint32_t(TT);
+    if (CPUTiming && StartTime[Index]) {
+      return CPURecTime[Index] + (CPUClock::now() - CPUStartTime[Index]);
+    }
+    return CPURecTime[Index];
+  }
+
   constexpr void reset() noexcept {
     for (auto &Start : StartTime) {
       Start.reset();
@@ -67,12 +106,18 @@ public:
     for (auto &Rec : RecTime) {
       Rec = Clock::duration::zero();
     }
+    for (auto &Rec : CPURecTime) {
+      Rec = CPUClock::duration::zero();
+    }
   }
 
 private:
   std::array<std::optional<Clock::time_point>, uint32_t(TimerTag::Max)>
       StartTime{};
   std::array<Clock::duration, uint32_t(TimerTag::Max)> RecTime{};
+  std::array<CPUClock::time_point, uint32_t(TimerTag::Max)> CPUStartTime{};
+  std::array<CPUClock::duration, uint32_t(TimerTag::Max)> CPURecTime{};
+  bool CPUTiming = false;
 };
 
 } // namespace Timer
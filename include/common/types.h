@@ -26,6 +26,12 @@
 
 namespace WasmEdge {
 
+namespace Runtime {
+namespace Instance {
+class FunctionInstance;
+} // namespace Instance
+} // namespace Runtime
+
 namespace {
 
 /// Remove const, reference, and volitile.
@@ -56,12 +62,31 @@ struct UnknownRef {
   UnknownRef() = default;
 };
 
-/// FuncRef definition.
+/// FuncRef definition. It points to the function instance, which never moves
+/// during the lifetime of its owner. The references created from the function
+/// addresses by the deprecated C API are tagged by the lowest bit and resolved
+/// by the store manager.
 struct FuncRef {
-  uint32_t NotNull = 0;
-  uint32_t Idx = 0;
+#if __INTPTR_WIDTH__ == 32
+  const uint32_t Padding = 0;
+#endif
+  const Runtime::Instance::FunctionInstance *Ptr = nullptr;
   FuncRef() = default;
-  FuncRef(uint32_t I) : NotNull(1), Idx(I) {}
+  FuncRef(const Runtime::Instance::FunctionInstance *P) : Ptr(P) {}
+
+  /// Create the reference of the function address in store manager.
+  static FuncRef fromAddr(const uint32_t Addr) noexcept {
+    return reinterpret_cast<const Runtime::Instance::FunctionInstance *>(
+        (static_cast<uintptr_t>(Addr) << 1) | uintptr_t(1));
+  }
+  /// Getter of checking is the reference of the function address.
+  bool isAddr() const noexcept {
+    return (reinterpret_cast<uintptr_t>(Ptr) & uintptr_t(1)) != 0;
+  }
+  /// Getter of the function address. Only valid if `isAddr()` is true.
+  uint32_t getAddr() const noexcept {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(Ptr) >> 1);
+  }
 };
 
 /// ExternRef definition.
@@ -82,9 +107,13 @@ using ValVariant =
             int16x8_t, uint8x16_t, int8x16_t, floatx4_t, doublex2_t, UnknownRef,
             FuncRef, ExternRef>;
 
-/// BlockType definition.
+/// BlockType definition. For the typed reference result of the function
+/// references proposal, the `IsTypedRef` is set and the `Data.Idx` is the
+/// function type index of the FuncRef result.
 struct BlockType {
   bool IsValType;
+  bool IsTypedRef;
+  bool IsNullable;
   union {
     ValType Type;
     uint32_t Idx;
@@ -94,10 +123,18 @@ struct BlockType {
   BlockType(uint32_t Idx) { setData(Idx); }
   void setData(ValType VType) {
     IsValType = true;
+    IsTypedRef = false;
     Data.Type = VType;
   }
   void setData(uint32_t Idx) {
     IsValType = false;
+    IsTypedRef = false;
+    Data.Idx = Idx;
+  }
+  void setTypedRef(uint32_t Idx, bool Nullable) {
+    IsValType = false;
+    IsTypedRef = true;
+    IsNullable = Nullable;
     Data.Idx = Idx;
   }
 };
@@ -280,14 +317,17 @@ inline constexpr bool isNullRef(const ValVariant &Val) {
 inline constexpr bool isNullRef(const RefVariant &Val) {
   return Val.get<UnknownRef>().Value == 0;
 }
-inline constexpr uint32_t retrieveFuncIdx(const ValVariant &Val) {
-  return Val.get<FuncRef>().Idx;
+inline constexpr const Runtime::Instance::FunctionInstance *
+retrieveFuncRef(const ValVariant &Val) {
+  return Val.get<FuncRef>().Ptr;
 }
-inline constexpr uint32_t retrieveFuncIdx(const RefVariant &Val) {
-  return Val.get<FuncRef>().Idx;
+inline constexpr const Runtime::Instance::FunctionInstance *
+retrieveFuncRef(const RefVariant &Val) {
+  return Val.get<FuncRef>().Ptr;
 }
-inline constexpr uint32_t retrieveFuncIdx(const FuncRef &Val) {
-  return Val.Idx;
+inline constexpr const Runtime::Instance::FunctionInstance *
+retrieveFuncRef(const FuncRef &Val) {
+  return Val.Ptr;
 }
 template <typename T> inline T &retrieveExternRef(const ValVariant &Val) {
   return *reinterpret_cast<T *>(Val.get<ExternRef>().Ptr);
@@ -490,6 +490,27 @@ Expect<void> Executor::runVectorAvgrOp(ValVariant &Val1,
   return {};
 }
 
+template <typename T>
+Expect<void> Executor::runVectorMAddOp(ValVariant &Val1, const ValVariant &Val2,
+                                       const ValVariant &Val3) const {
+  using VT [[gnu::vector_size(16)]] = T;
+  VT &V1 = Val1.get<VT>();
+  V1 = V1 * Val2.get<VT>() + Val3.get<VT>();
+
+  return {};
+}
+
+template <typename T>
+Expect<void> Executor::runVectorNMAddOp(ValVariant &Val1,
+                                        const ValVariant &Val2,
+                                        const ValVariant &Val3) const {
+  using VT [[gnu::vector_size(16)]] = T;
+  VT &V1 = Val1.get<VT>();
+  V1 = -(V1 * Val2.get<VT>()) + Val3.get<VT>();
+
+  return {};
+}
+
 template <typename TIn, typename TOut>
 Expect<void> Executor::runVectorExtMulLowOp(ValVariant &Val1,
                                             const ValVariant &Val2) const {
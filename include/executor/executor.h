@@ -22,10 +22,12 @@
 #include "runtime/importobj.h"
 #include "runtime/stackmgr.h"
 #include "runtime/storemgr.h"
+#include "system/profiler.h"
 
 #include <atomic>
 #include <csignal>
 #include <cstdint>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 #include <utility>
@@ -85,15 +87,20 @@ using TypeNN =
 /// Executor flow control class.
 class Executor {
 public:
-  Executor(const Configure &Conf, Statistics::Statistics *S = nullptr) noexcept
-      : Conf(Conf), Stat(S) {
+  Executor(const Configure &Conf, Statistics::Statistics *S = nullptr,
+           Profiler *P = nullptr) noexcept
+      : Conf(Conf), Stat(S), Prof(P) {
     assuming(This == nullptr);
     This = this;
     ExecutionContext.StopToken = &StopToken;
+    ExecutionContext.CPUTimeCountdown = &NoStatCPUTimeCountdown;
+    ExecutionContext.HasPendingException = &HasPendingException;
     if (Stat) {
       ExecutionContext.InstrCount = &Stat->getInstrCountRef();
       ExecutionContext.CostTable = Stat->getCostTable().data();
       ExecutionContext.Gas = &Stat->getTotalCostRef();
+      ExecutionContext.CPUTimeCountdown =
+          &Stat->getCPUTimeCheckCountdownRef();
       Stat->setCostLimit(Conf.getStatisticsConfigure().getCostLimit());
     }
   }
@@ -136,6 +143,12 @@ private:
                        const AST::InstrView::iterator Start,
                        const AST::InstrView::iterator End);
 
+  /// Thrown exception, which is identified by the tag address in store.
+  struct Exception {
+    uint32_t TagAddr;
+    std::vector<ValVariant> Values;
+  };
+
   /// \name Functions for instantiation.
   /// @{
   /// Instantiation of Module Instance.
@@ -168,6 +181,11 @@ private:
                            Runtime::Instance::ModuleInstance &ModInst,
                            const AST::MemorySection &MemSec);
 
+  /// Instantiation of Tag Instances.
+  Expect<void> instantiate(Runtime::StoreManager &StoreMgr,
+                           Runtime::Instance::ModuleInstance &ModInst,
+                           const AST::TagSection &TagSec);
+
   /// Instantiation of Element Instances.
   Expect<void> instantiate(Runtime::StoreManager &StoreMgr,
                            Runtime::Instance::ModuleInstance &ModInst,
@@ -192,6 +210,11 @@ private:
   Expect<void> instantiate(Runtime::StoreManager &StoreMgr,
                            Runtime::Instance::ModuleInstance &ModInst,
                            const AST::ExportSection &ExportSec);
+
+  /// Register the function names of a module instance to the profiler.
+  void registerProfileNames(Runtime::StoreManager &StoreMgr,
+                            const Runtime::Instance::ModuleInstance &ModInst,
+                            const AST::Module &Mod);
   /// @}
 
   /// \name Helper Functions for block controls.
@@ -202,10 +225,21 @@ private:
                 const Runtime::Instance::FunctionInstance &Func,
                 const AST::InstrView::iterator From);
 
+  /// Helper function for recording the pending profile samples with the
+  /// call stack and the leaf function which does not push a frame.
+  void recordProfile(const Runtime::Instance::FunctionInstance *Leaf);
+
   /// Helper function for branching to label.
   Expect<void> branchToLabel(Runtime::StoreManager &StoreMgr,
                              const uint32_t Cnt, AST::InstrView::iterator &PC);
 
+  /// Helper function for throwing an exception to the handler, which is
+  /// searched in the Try-blocks of the interpreted functions. If there is no
+  /// handler before the frame of a compiled function, the exception is passed
+  /// to the compiled function as the pending exception.
+  Expect<void> throwException(Runtime::StoreManager &StoreMgr, Exception Exc,
+                              AST::InstrView::iterator &PC);
+
   /// Helper function for getting arity from block type.
   std::pair<uint32_t, uint32_t> getBlockArity(Runtime::StoreManager &StoreMgr,
                                               const BlockType &BType);
@@ -262,6 +296,18 @@ private:
   Expect<void> runCallIndirectOp(Runtime::StoreManager &StoreMgr,
                                  const AST::Instruction &Instr,
                                  AST::InstrView::iterator &PC);
+  Expect<void> runCallRefOp(Runtime::StoreManager &StoreMgr,
+                            const AST::Instruction &Instr,
+                            AST::InstrView::iterator &PC);
+  Expect<void> runTryOp(Runtime::StoreManager &StoreMgr,
+                        const AST::Instruction &Instr,
+                        AST::InstrView::iterator &PC);
+  Expect<void> runThrowOp(Runtime::StoreManager &StoreMgr,
+                          const AST::Instruction &Instr,
+                          AST::InstrView::iterator &PC);
+  Expect<void> runRethrowOp(Runtime::StoreManager &StoreMgr,
+                            const AST::Instruction &Instr,
+                            AST::InstrView::iterator &PC);
   /// ======= Variable instructions =======
   Expect<void> runLocalGetOp(const uint32_t Idx);
   Expect<void> runLocalSetOp(const uint32_t Idx);
@@ -474,6 +520,12 @@ private:
   Expect<void> runVectorFMaxOp(ValVariant &Val1, const ValVariant &Val2) const;
   template <typename T, typename ET>
   Expect<void> runVectorAvgrOp(ValVariant &Val1, const ValVariant &Val2) const;
+  template <typename T>
+  Expect<void> runVectorMAddOp(ValVariant &Val1, const ValVariant &Val2,
+                               const ValVariant &Val3) const;
+  template <typename T>
+  Expect<void> runVectorNMAddOp(ValVariant &Val1, const ValVariant &Val2,
+                                const ValVariant &Val3) const;
   template <typename T> Expect<void> runVectorCeilOp(ValVariant &Val) const;
   template <typename T> Expect<void> runVectorFloorOp(ValVariant &Val) const;
   template <typename T> Expect<void> runVectorTruncOp(ValVariant &Val) const;
@@ -491,6 +543,9 @@ public:
                             const uint32_t TableIdx, const uint32_t FuncTypeIdx,
                             const uint32_t FuncIdx, const ValVariant *Args,
                             ValVariant *Rets) noexcept;
+  Expect<void> callRef(Runtime::StoreManager &StoreMgr,
+                       const uint32_t FuncTypeIdx, const RefVariant Ref,
+                       const ValVariant *Args, ValVariant *Rets) noexcept;
 
   Expect<uint32_t> memGrow(Runtime::StoreManager &StoreMgr,
                            const uint32_t MemIdx,
@@ -536,6 +591,19 @@ public:
                         const uint32_t ElemIdx) noexcept;
   Expect<RefVariant> refFunc(Runtime::StoreManager &StoreMgr,
                              const uint32_t FuncIdx) noexcept;
+  Expect<void> checkCPUTime(Runtime::StoreManager &StoreMgr) noexcept;
+  Expect<void> throwTag(Runtime::StoreManager &StoreMgr, const uint32_t TagIdx,
+                        const ValVariant *Args) noexcept;
+  Expect<void> rethrowException(Runtime::StoreManager &StoreMgr,
+                                const uint32_t Slot) noexcept;
+  Expect<uint32_t> catchTag(Runtime::StoreManager &StoreMgr,
+                            const uint32_t TagIdx, ValVariant *Vals,
+                            uint32_t *Slot) noexcept;
+  Expect<void> catchAll(Runtime::StoreManager &StoreMgr,
+                        uint32_t *Slot) noexcept;
+  Expect<void> releaseExceptions(Runtime::StoreManager &StoreMgr,
+                                 const uint32_t *Slots,
+                                 const uint32_t SlotsN) noexcept;
 
   template <typename FuncPtr> struct ProxyHelper;
 
@@ -549,10 +617,23 @@ private:
     uint8_t *const *Memories;
     ValVariant *const *Globals;
     uint64_t *InstrCount;
-    uint64_t *CostTable;
+    const uint64_t *CostTable;
     uint64_t *Gas;
     std::atomic_uint32_t *StopToken;
+    uint32_t *CPUTimeCountdown;
+    uint32_t *HasPendingException;
   } ExecutionContext;
+  /// CPU time check countdown of the compiled code without statistics
+  uint32_t NoStatCPUTimeCountdown = UINT32_MAX;
+  /// Exception thrown to the compiled functions and not caught yet. The
+  /// compiled functions check the flag after every call and jump to the
+  /// handlers or return to the callers.
+  std::optional<Exception> PendingException;
+  uint32_t HasPendingException = 0;
+  /// Exceptions caught in the compiled functions for rethrowing, which are
+  /// indexed by the slots in the frames of the compiled functions.
+  std::vector<Exception> CaughtSlots;
+  std::vector<uint32_t> FreeSlots;
   /// @}
 
 private:
@@ -566,6 +647,11 @@ private:
   Runtime::StackManager StackMgr;
   /// Executor statistics
   Statistics::Statistics *Stat;
+  /// Executor profiler
+  Profiler *Prof;
+  /// Exceptions caught by the labels for rethrowing, which are indexed from
+  /// the bottom of the label stack.
+  std::vector<std::pair<uint32_t, Exception>> CaughtExceptions;
 
 public:
   /// Callbacks for compiled modules;
@@ -8,6 +8,7 @@
 #include "common/span.h"
 #include "host/wasi/clock.h"
 #include "host/wasi/error.h"
+#include "host/wasi/ratelimit.h"
 #include "host/wasi/vfs.h"
 #include "host/wasi/vinode.h"
 #include "wasi/api.hpp"
@@ -44,6 +45,18 @@ public:
 
   void fini() noexcept;
 
+  /// Replace the standard input with the embedder-supplied stream after
+  /// initialized, or restore the system one if the callback is empty.
+  void setStdIn(VINode::ReadCallback Reader);
+
+  /// Replace the standard output with the embedder-supplied stream after
+  /// initialized, or restore the system one if the callback is empty.
+  void setStdOut(VINode::WriteCallback Writer);
+
+  /// Replace the standard error with the embedder-supplied stream after
+  /// initialized, or restore the system one if the callback is empty.
+  void setStdErr(VINode::WriteCallback Writer);
+
   WasiExpect<void> getAddrInfo(const char *Node, const char *Service,
                                const __wasi_addrinfo_t &Hint,
                                uint32_t MaxResLength,
@@ -73,6 +86,17 @@ public:
 
   constexpr __wasi_exitcode_t getExitCode() const noexcept { return ExitCode; }
 
+  /// Wake up the blocking calls from other threads. The blocking calls return
+  /// `errno::canceled` until the interruption is cleared.
+  void interrupt() const noexcept { StopWaker.wake(); }
+
+  /// Clear the interruption of the blocking calls.
+  void clearInterrupt() noexcept { StopWaker.clear(); }
+
+  /// Limit the bytes and operations per second of the reads, writes, and
+  /// socket transfers.
+  void setIOLimit(const IOLimit &Limit) noexcept { IOLimiter.setLimit(Limit); }
+
   /// Read command-line argument data.
   ///
   /// The size of the array should match that returned by `args_sizes_get`.
@@ -374,7 +398,9 @@ public:
     if (unlikely(!Node)) {
       return WasiUnexpect(__WASI_ERRNO_BADF);
     } else {
-      return Node->fdPread(IOVs, Offset, NRead);
+      return limitIO(IOVs, NRead, [&](Span<Span<uint8_t>> Limited) {
+        return Node->fdPread(Limited, Offset, NRead);
+      });
     }
   }
 
@@ -436,7 +462,10 @@ public:
     if (unlikely(!Node)) {
       return WasiUnexpect(__WASI_ERRNO_BADF);
     } else {
-      return Node->fdPwrite(IOVs, Offset, NWritten);
+      return limitIO(IOVs, NWritten,
+                     [&](Span<Span<const uint8_t>> Limited) {
+                       return Node->fdPwrite(Limited, Offset, NWritten);
+                     });
     }
   }
 
@@ -452,8 +481,12 @@ public:
     auto Node = getNodeOrNull(Fd);
     if (unlikely(!Node)) {
       return WasiUnexpect(__WASI_ERRNO_BADF);
+    } else if (auto Res = Node->waitReadable(StopWaker); unlikely(!Res)) {
+      return WasiUnexpect(Res);
     } else {
-      return Node->fdRead(IOVs, NRead);
+      return limitIO(IOVs, NRead, [&](Span<Span<uint8_t>> Limited) {
+        return Node->fdRead(Limited, NRead);
+      });
     }
   }
 
@@ -582,7 +615,10 @@ public:
     if (unlikely(!Node)) {
       return WasiUnexpect(__WASI_ERRNO_BADF);
     } else {
-      return Node->fdWrite(IOVs, NWritten);
+      return limitIO(IOVs, NWritten,
+                     [&](Span<Span<const uint8_t>> Limited) {
+                       return Node->fdWrite(Limited, NWritten);
+                     });
     }
   }
 
@@ -616,6 +652,28 @@ public:
     return VINode::pathFilestatGet(FS, std::move(Node), Path, Flags, Filestat);
   }
 
+  /// Walk a directory recursively and return the attributes of the entries.
+  ///
+  /// @param[in] Fd The working directory at which the resolution of the path
+  /// starts.
+  /// @param[in] Path The path of the directory to walk.
+  /// @param[in] Flags Flags determining the method of how the path is resolved.
+  /// @param[in] MaxDepth The deepest directory level to return, or 0 for no
+  /// limit.
+  /// @param[out] Buffer The buffer where the `WalkEntry` entries are stored.
+  /// @param[in] Cookie The location within the walk to start reading.
+  /// @param[out] Size The number of bytes stored in the buffer. If less than
+  /// the size of the buffer, the end of the walk has been reached.
+  /// @return Nothing or WASI error
+  WasiExpect<void> pathWalk(__wasi_fd_t Fd, std::string_view Path,
+                            __wasi_lookupflags_t Flags, uint32_t MaxDepth,
+                            Span<uint8_t> Buffer, __wasi_dircookie_t Cookie,
+                            __wasi_size_t &Size) {
+    auto Node = getNodeOrNull(Fd);
+    return VINode::pathWalk(FS, std::move(Node), Path, Flags, MaxDepth, Buffer,
+                            Cookie, Size);
+  }
+
   /// Adjust the timestamps of a file or directory.
   ///
   /// Note: This is similar to `utimensat` in POSIX.
@@ -885,6 +943,11 @@ public:
     auto Node = getNodeOrNull(Fd);
     std::shared_ptr<VINode> NewNode;
 
+    if (unlikely(!Node)) {
+      return WasiUnexpect(__WASI_ERRNO_BADF);
+    } else if (auto Res = Node->waitReadable(StopWaker); unlikely(!Res)) {
+      return WasiUnexpect(Res);
+    }
     if (auto Res = Node->sockAccept(); unlikely(!Res)) {
       return WasiUnexpect(Res);
     } else {
@@ -920,8 +983,12 @@ public:
     auto Node = getNodeOrNull(Fd);
     if (unlikely(!Node)) {
       return WasiUnexpect(__WASI_ERRNO_BADF);
+    } else if (auto Res = Node->waitReadable(StopWaker); unlikely(!Res)) {
+      return WasiUnexpect(Res);
     } else {
-      return Node->sockRecv(RiData, RiFlags, NRead, RoFlags);
+      return limitIO(RiData, NRead, [&](Span<Span<uint8_t>> Limited) {
+        return Node->sockRecv(Limited, RiFlags, NRead, RoFlags);
+      });
     }
   }
 
@@ -942,7 +1009,10 @@ public:
     if (unlikely(!Node)) {
       return WasiUnexpect(__WASI_ERRNO_BADF);
     } else {
-      return Node->sockSend(SiData, SiFlags, NWritten);
+      return limitIO(SiData, NWritten,
+                     [&](Span<Span<const uint8_t>> Limited) {
+                       return Node->sockSend(Limited, SiFlags, NWritten);
+                     });
     }
   }
 
@@ -1023,10 +1093,45 @@ public:
   }
 
 private:
+  /// Run the I/O operation within the rate limit, where the buffers are
+  /// truncated to the bytes granted by the limiter.
+  template <typename T, typename CallbackT>
+  WasiExpect<void> limitIO(Span<Span<T>> IOVs, __wasi_size_t &NDone,
+                           CallbackT &&Callback) const noexcept {
+    if (!IOLimiter.enabled()) {
+      return Callback(IOVs);
+    }
+    uint64_t Want = 0;
+    for (const auto &IOV : IOVs) {
+      Want += IOV.size();
+    }
+    uint64_t Granted;
+    if (auto Res = IOLimiter.acquire(Want, StopWaker); unlikely(!Res)) {
+      return WasiUnexpect(Res);
+    } else {
+      Granted = *Res;
+    }
+    if (Granted < Want) {
+      size_t Count = 0;
+      for (uint64_t Left = Granted; Left > 0; ++Count) {
+        if (IOVs[Count].size() > Left) {
+          IOVs[Count] = IOVs[Count].first(Left);
+        }
+        Left -= IOVs[Count].size();
+      }
+      IOVs = IOVs.first(Count);
+    }
+    auto Res = Callback(IOVs);
+    IOLimiter.release(Granted - (Res ? std::min<uint64_t>(NDone, Granted) : 0));
+    return Res;
+  }
+
   std::vector<std::string> Arguments;
   std::vector<std::string> EnvironVariables;
   VFS FS;
   __wasi_exitcode_t ExitCode = 0;
+  Waker StopWaker;
+  mutable RateLimiter IOLimiter;
 
   mutable std::shared_mutex FdMutex; ///< Protect FdMap
   std::unordered_map<__wasi_fd_t, std::shared_ptr<VINode>> FdMap;
@@ -1059,7 +1164,6 @@ private:
 class EVPoller : private VPoller {
 public:
   using VPoller::clock;
-  using VPoller::wait;
 
   EVPoller(VPoller &&P, Environ &E) : VPoller(std::move(P)), Env(E) {}
 
@@ -1088,6 +1192,14 @@ public:
     }
   }
 
+  template <typename CallbackT>
+  WasiExpect<void> wait(CallbackT &&Callback) noexcept {
+    if (auto Res = VPoller::waker(Env.StopWaker); unlikely(!Res)) {
+      return WasiUnexpect(Res);
+    }
+    return VPoller::wait(std::forward<CallbackT>(Callback));
+  }
+
 private:
   Environ &Env;
 };
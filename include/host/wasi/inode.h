@@ -6,6 +6,7 @@
 #include "common/defines.h"
 #include "common/span.h"
 #include "host/wasi/error.h"
+#include <chrono>
 #include <functional>
 #include <optional>
 #include <string_view>
@@ -146,6 +147,35 @@ struct HandleHolder {
 };
 #endif
 
+/// Wake up the blocking calls from other threads.
+class Waker
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+    : public FdHolder
+#endif
+{
+public:
+  Waker(const Waker &) = delete;
+  Waker &operator=(const Waker &) = delete;
+  Waker(Waker &&RHS) noexcept = default;
+  Waker &operator=(Waker &&RHS) noexcept = default;
+
+  Waker() noexcept;
+
+  /// Wake up the current and the following blocking calls until cleared.
+  void wake() const noexcept;
+
+  /// Stop waking up the blocking calls.
+  void clear() noexcept;
+
+  /// Sleep for the duration, or until woken up with the
+  /// `__WASI_ERRNO_CANCELED` error.
+  WasiExpect<void> sleep(std::chrono::nanoseconds Duration) const noexcept;
+
+#if WASMEDGE_OS_WINDOWS
+  constexpr bool ok() const noexcept { return false; }
+#endif
+};
+
 class Poller;
 
 class INode
@@ -161,6 +191,9 @@ public:
   INode(INode &&RHS) noexcept = default;
   INode &operator=(INode &&RHS) noexcept = default;
 
+  /// Create an INode without the system file.
+  INode() noexcept = default;
+
   static INode stdIn() noexcept;
 
   static INode stdOut() noexcept;
@@ -417,6 +450,29 @@ public:
                              __wasi_fdflags_t FdFlags,
                              uint8_t VFSFlags) const noexcept;
 
+  /// Open a directory beneath this directory in one resolution.
+  ///
+  /// The kernel rejects the resolution escaping this directory, crossing
+  /// symbolic links, or crossing magic links.
+  ///
+  /// Note: This is similar to `openat2` with `RESOLVE_BENEATH` in Linux.
+  ///
+  /// @param[in] Path The relative path of the directory to open.
+  /// @param[in] VFSFlags The method by which to open the directory.
+  /// @return The file descriptor of the directory that has been opened, or
+  /// WASI error. `errno::nosys` if the system does not support it.
+  WasiExpect<INode> pathOpenBeneath(std::string Path,
+                                    uint8_t VFSFlags) const noexcept;
+
+  /// Block until the file is readable or the waker is woken up.
+  ///
+  /// Returns at once for the files which never block on reading, such as the
+  /// regular files, or in the non-blocking mode.
+  ///
+  /// @param[in] W The waker to interrupt the waiting.
+  /// @return Nothing, `errno::canceled` if woken up, or WASI error.
+  WasiExpect<void> waitReadable(const Waker &W) const noexcept;
+
   /// Read the contents of a symbolic link.
   ///
   /// Note: This is similar to `readlinkat` in POSIX.
@@ -577,6 +633,10 @@ public:
 private:
   mutable std::optional<struct stat> Stat;
 
+  /// Whether the file is in the non-blocking mode, known from the open flags
+  /// or the last `fcntl`, so the reading calls need no system call to check.
+  mutable std::optional<bool> NonBlocking;
+
   DirHolder Dir;
 
   WasiExpect<void> updateStat() const noexcept;
@@ -612,6 +672,9 @@ public:
 
   WasiExpect<void> write(const INode &Fd, __wasi_userdata_t UserData) noexcept;
 
+  /// Let the waker interrupt the waiting with `errno::canceled`.
+  WasiExpect<void> waker(const Waker &W) noexcept;
+
   WasiExpect<void> wait(CallbackType Callback) noexcept;
 
 private:
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#pragma once
+
+#include "host/wasi/error.h"
+#include "host/wasi/inode.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace WasmEdge {
+namespace Host {
+namespace WASI {
+
+/// Token bucket limits of the I/O of a WASI instance.
+struct IOLimit {
+  /// Bytes transferred per second, or 0 for no limit.
+  uint64_t BytesPerSecond = 0;
+  /// Bytes which can be transferred at once, or 0 for one second of bytes.
+  uint64_t BytesBurst = 0;
+  /// Operations per second, or 0 for no limit.
+  uint64_t OpsPerSecond = 0;
+  /// Operations which can be issued at once, or 0 for one second of
+  /// operations.
+  uint64_t OpsBurst = 0;
+  /// Wait for the tokens if true, or fail with `__WASI_ERRNO_AGAIN`.
+  bool Blocking = true;
+};
+
+/// Rate limiter of the reads, writes, and socket transfers of a WASI instance.
+///
+/// Every operation takes one operation token and reserves the bytes it may
+/// transfer. The buffers are truncated to the reserved bytes, and the bytes
+/// not transferred are returned after the operation.
+class RateLimiter {
+public:
+  /// Replace the limits and refill the buckets.
+  void setLimit(const IOLimit &Limit) noexcept;
+
+  /// Check if any limit is set.
+  bool enabled() const noexcept { return Enabled; }
+
+  /// Take an operation token and reserve the bytes to transfer.
+  ///
+  /// The throttled operations and the waiting time are reported as the host
+  /// function work.
+  ///
+  /// @param[in] Want The bytes the operation wants to transfer.
+  /// @param[in] W The waker to interrupt the waiting.
+  /// @return The reserved bytes, which is between 1 and Want if Want is not 0,
+  /// or WASI error
+  WasiExpect<uint64_t> acquire(uint64_t Want, const Waker &W) noexcept;
+
+  /// Return the reserved bytes which are not transferred.
+  void release(uint64_t Unused) noexcept;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Bucket {
+    uint64_t Rate = 0;
+    double Burst = 0.0;
+    double Tokens = 0.0;
+
+    void refill(Clock::duration Elapsed) noexcept;
+    /// Time to wait until the tokens are available.
+    Clock::duration deficit(double Want) const noexcept;
+  };
+
+  std::mutex Mutex;
+  bool Enabled = false;
+  bool Blocking = true;
+  Bucket Bytes;
+  Bucket Ops;
+  Clock::time_point Last;
+};
+
+} // namespace WASI
+} // namespace Host
+} // namespace WasmEdge
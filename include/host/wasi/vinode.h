@@ -21,6 +21,22 @@ namespace WASI {
 
 class VFS;
 class VPoller;
+
+/// Header of an entry of the recursive directory walk, followed by `NameLen`
+/// bytes holding the path of the entry relative to the walk root.
+struct WalkEntry {
+  /// The cookie of the next entry.
+  __wasi_dircookie_t Next;
+  /// The attributes of the entry.
+  __wasi_filestat_t Stat;
+  /// The length of the path.
+  __wasi_size_t NameLen;
+  /// The directory level of the entry, which is 1 for the children of the
+  /// walk root.
+  uint32_t Depth;
+};
+static_assert(sizeof(WalkEntry) == 80, "WalkEntry is part of the guest ABI");
+
 class VINode : public std::enable_shared_from_this<VINode> {
 public:
   VINode(const VINode &) = delete;
@@ -28,12 +44,22 @@ public:
   VINode(VINode &&) = default;
   VINode &operator=(VINode &&) = default;
 
+  /// Embedder-supplied callback to fill the buffer, returns the number of
+  /// bytes filled, or 0 for the end of the stream.
+  using ReadCallback = std::function<WasiExpect<__wasi_size_t>(Span<uint8_t>)>;
+  /// Embedder-supplied callback to consume the buffer, returns the number of
+  /// bytes consumed.
+  using WriteCallback =
+      std::function<WasiExpect<__wasi_size_t>(Span<const uint8_t>)>;
+
   /// Create a VINode with a parent.
   ///
   /// @param[in] FS Filesystem.
   /// @param[in] Node System INode.
   /// @param[in] Parent Parent VINode.
-  VINode(VFS &FS, INode Node, std::shared_ptr<VINode> Parent);
+  /// @param[in] Depth Directory levels from the Parent to the Node.
+  VINode(VFS &FS, INode Node, std::shared_ptr<VINode> Parent,
+         uint32_t Depth = 1);
 
   /// Create a orphan VINode.
   ///
@@ -51,8 +77,31 @@ public:
   static std::shared_ptr<VINode> stdErr(VFS &FS, __wasi_rights_t FRB,
                                         __wasi_rights_t FRI);
 
+  /// Create a VINode of the embedder-supplied stream without the system file.
+  ///
+  /// @param[in] FS Filesystem.
+  /// @param[in] FRB The desired rights of the VINode.
+  /// @param[in] FRI The desired rights of the VINode.
+  /// @param[in] Reader The callback for reading, or empty.
+  /// @param[in] Writer The callback for writing, or empty.
+  static std::shared_ptr<VINode> stream(VFS &FS, __wasi_rights_t FRB,
+                                        __wasi_rights_t FRI,
+                                        ReadCallback Reader,
+                                        WriteCallback Writer);
+
   static std::string canonicalGuest(std::string_view Path);
 
+  /// Block until the file is readable or the waker is woken up.
+  ///
+  /// @param[in] W The waker to interrupt the waiting.
+  /// @return Nothing, `errno::canceled` if woken up, or WASI error.
+  WasiExpect<void> waitReadable(const Waker &W) const noexcept {
+    if (Stream) {
+      return {};
+    }
+    return Node.waitReadable(W);
+  }
+
   static WasiExpect<std::shared_ptr<VINode>> bind(VFS &FS, __wasi_rights_t FRB,
                                                   __wasi_rights_t FRI,
                                                   std::string Name,
@@ -116,6 +165,11 @@ public:
   WasiExpect<void> fdFdstatGet(__wasi_fdstat_t &FdStat) const noexcept {
     FdStat.fs_rights_base = FsRightsBase;
     FdStat.fs_rights_inheriting = FsRightsInheriting;
+    if (Stream) {
+      FdStat.fs_filetype = __WASI_FILETYPE_UNKNOWN;
+      FdStat.fs_flags = static_cast<__wasi_fdflags_t>(0);
+      return {};
+    }
     return Node.fdFdstatGet(FdStat);
   }
 
@@ -254,6 +308,9 @@ public:
     if (!can(__WASI_RIGHTS_FD_READ)) {
       return WasiUnexpect(__WASI_ERRNO_NOTCAPABLE);
     }
+    if (Stream) {
+      return streamRead(IOVs, NRead);
+    }
     return Node.fdRead(IOVs, NRead);
   }
 
@@ -339,6 +396,9 @@ public:
     if (!can(__WASI_RIGHTS_FD_WRITE)) {
       return WasiUnexpect(__WASI_ERRNO_NOTCAPABLE);
     }
+    if (Stream) {
+      return streamWrite(IOVs, NWritten);
+    }
     return Node.fdWrite(IOVs, NWritten);
   }
 
@@ -371,6 +431,39 @@ public:
                                           __wasi_lookupflags_t Flags,
                                           __wasi_filestat_t &Filestat);
 
+  /// Walk a directory recursively and return the attributes of the entries.
+  ///
+  /// When successful, the contents of the output buffer consist of a sequence
+  /// of `WalkEntry` objects, each followed by `WalkEntry::NameLen` bytes
+  /// holding the path of the entry relative to the walk root. The entries of a
+  /// directory are followed by the entries of its subdirectories. Symbolic
+  /// links are reported but not followed.
+  ///
+  /// Like `fdReaddir`, this function fills the output buffer as much as
+  /// possible, potentially truncating the last entry. The walk resumes from
+  /// the `WalkEntry::Next` cookie of the last complete entry, where the
+  /// directories are read again but only the remaining entries are
+  /// inspected.
+  ///
+  /// @param[in] FS The filesystem.
+  /// @param[in] Fd The working directory at which the resolution of the path
+  /// starts.
+  /// @param[in] Path The path of the directory to walk.
+  /// @param[in] Flags Flags determining the method of how the path is resolved.
+  /// @param[in] MaxDepth The deepest directory level to return, or 0 for no
+  /// limit.
+  /// @param[out] Buffer The buffer where the entries are stored.
+  /// @param[in] Cookie The location within the walk to start reading.
+  /// @param[out] Size The number of bytes stored in the buffer. If less than
+  /// the size of the buffer, the end of the walk has been reached.
+  /// @return Nothing or WASI error
+  static WasiExpect<void> pathWalk(VFS &FS, std::shared_ptr<VINode> Fd,
+                                   std::string_view Path,
+                                   __wasi_lookupflags_t Flags,
+                                   uint32_t MaxDepth, Span<uint8_t> Buffer,
+                                   __wasi_dircookie_t Cookie,
+                                   __wasi_size_t &Size);
+
   /// Adjust the timestamps of a file or directory.
   ///
   /// Note: This is similar to `utimensat` in POSIX.
@@ -661,10 +754,27 @@ private:
   __wasi_rights_t FsRightsBase;
   __wasi_rights_t FsRightsInheriting;
   std::shared_ptr<VINode> Parent;
+  /// Embedder-supplied callbacks replacing the system file.
+  struct StreamCallbacks {
+    ReadCallback Read;
+    WriteCallback Write;
+  };
+  std::shared_ptr<const StreamCallbacks> Stream;
+  /// Directory levels from the Parent, which are more than 1 if the kernel
+  /// resolved the intermediate directories in one step.
+  uint32_t Depth = 1;
   std::string Name;
 
   friend class VPoller;
 
+  /// Read from the embedder-supplied stream until a short read or an error.
+  WasiExpect<void> streamRead(Span<Span<uint8_t>> IOVs,
+                              __wasi_size_t &NRead) const noexcept;
+
+  /// Write to the embedder-supplied stream until a short write or an error.
+  WasiExpect<void> streamWrite(Span<Span<const uint8_t>> IOVs,
+                               __wasi_size_t &NWritten) const noexcept;
+
   /// Open path without resolve.
   /// @param Path Path, contains one element only.
   /// @param OpenFlags WASI open flags.
@@ -692,6 +802,7 @@ class VPoller : private Poller {
 public:
   using Poller::clock;
   using Poller::wait;
+  using Poller::waker;
 
   VPoller(Poller &&P) : Poller(std::move(P)) {}
 
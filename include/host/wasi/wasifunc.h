@@ -495,5 +495,25 @@ public:
                         uint32_t MaxResLength, uint32_t ResLengthPtr);
 };
 
+class WasiPathFilestatGetBatch : public Wasi<WasiPathFilestatGetBatch> {
+public:
+  WasiPathFilestatGetBatch(WASI::Environ &HostEnv) : Wasi(HostEnv) {}
+
+  Expect<uint32_t> body(Runtime::Instance::MemoryInstance *MemInst, int32_t Fd,
+                        uint32_t Flags, uint32_t PathsPtr, uint32_t PathsLen,
+                        uint32_t /* Out */ FilestatsPtr,
+                        uint32_t /* Out */ ErrnosPtr);
+};
+
+class WasiPathWalk : public Wasi<WasiPathWalk> {
+public:
+  WasiPathWalk(WASI::Environ &HostEnv) : Wasi(HostEnv) {}
+
+  Expect<uint32_t> body(Runtime::Instance::MemoryInstance *MemInst, int32_t Fd,
+                        uint32_t Flags, uint32_t PathPtr, uint32_t PathLen,
+                        uint32_t MaxDepth, uint32_t BufPtr, uint32_t BufLen,
+                        uint64_t Cookie, uint32_t /* Out */ NReadPtr);
+};
+
 } // namespace Host
 } // namespace WasmEdge
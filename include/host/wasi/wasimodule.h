@@ -19,5 +19,15 @@ private:
   WASI::Environ Env;
 };
 
+/// Extension of the WASI filesystem functions which inspect many paths in one
+/// call, sharing the environment of a WASI module.
+///
+/// `path_filestat_get_batch` inspects up to 4096 paths, and `path_walk` walks
+/// a directory recursively into a buffer of `WASI::WalkEntry` entries.
+class WasmEdgeFsModule : public Runtime::ImportObject {
+public:
+  WasmEdgeFsModule(WASI::Environ &Env);
+};
+
 } // namespace Host
 } // namespace WasmEdge
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#pragma once
+
+#include "common/errcode.h"
+#include "runtime/hostfunc.h"
+
+#include <cstdint>
+
+namespace WasmEdge {
+namespace Host {
+
+class WasmEdgeMemoryDiscard
+    : public Runtime::HostFunction<WasmEdgeMemoryDiscard> {
+public:
+  WasmEdgeMemoryDiscard() : Runtime::HostFunction<WasmEdgeMemoryDiscard>(0) {}
+  Expect<void> body(Runtime::Instance::MemoryInstance *MemInst,
+                    uint32_t Offset, uint32_t Length);
+};
+
+} // namespace Host
+} // namespace WasmEdge
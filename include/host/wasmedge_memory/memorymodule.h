@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#pragma once
+
+#include "runtime/importobj.h"
+
+namespace WasmEdge {
+namespace Host {
+
+class WasmEdgeMemoryModule : public Runtime::ImportObject {
+public:
+  WasmEdgeMemoryModule();
+};
+
+} // namespace Host
+} // namespace WasmEdge
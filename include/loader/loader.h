@@ -71,6 +71,9 @@ template <>
 inline ASTNodeAttr NodeAttrFromAST<AST::DataCountSection>() noexcept {
   return ASTNodeAttr::Sec_DataCount;
 }
+template <> inline ASTNodeAttr NodeAttrFromAST<AST::TagSection>() noexcept {
+  return ASTNodeAttr::Sec_Tag;
+}
 } // namespace
 
 /// Loader flow control class.
@@ -112,6 +115,9 @@ private:
                                         ASTNodeAttr Node);
   Expect<RefType> checkRefTypeProposals(RefType RType, uint64_t Off,
                                         ASTNodeAttr Node);
+  Expect<ValType> loadValType(AST::TypedRef &Ref, ASTNodeAttr Node);
+  Expect<ValType> loadHeapType(bool Nullable, AST::TypedRef &Ref,
+                               ASTNodeAttr Node);
   Expect<void> checkInstrProposals(OpCode Code, uint64_t Offset);
   /// @}
 
@@ -185,7 +191,10 @@ private:
   Expect<void> loadSection(AST::CodeSection &Sec);
   Expect<void> loadSection(AST::DataSection &Sec);
   Expect<void> loadSection(AST::DataCountSection &Sec);
+  Expect<void> loadSection(AST::TagSection &Sec);
   static Expect<void> loadSection(FileMgr &VecMgr, AST::AOTSection &Sec);
+  static Expect<void> loadBranchHintSection(FileMgr &VecMgr,
+                                            AST::Module &Mod);
   Expect<void> loadSegment(AST::GlobalSegment &GlobSeg);
   Expect<void> loadSegment(AST::ElementSegment &ElemSeg);
   Expect<void> loadSegment(AST::CodeSegment &CodeSeg);
@@ -97,6 +97,8 @@ private:
 
   uint8_t *Binary = nullptr;
   uint64_t BinarySize = 0;
+  uint8_t *EHFrameAddress = nullptr;
+  uint64_t EHFrameSize = 0;
   uint64_t IntrinsicsAddress = 0;
   std::vector<uintptr_t> TypesAddress;
   std::vector<uintptr_t> CodesAddress;
@@ -13,8 +13,10 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include "common/enum_configure.h"
 #include "runtime/instance/memory.h"
 
+#include <array>
 #include <memory>
 #include <tuple>
 #include <vector>
@@ -22,10 +24,18 @@
 namespace WasmEdge {
 namespace Runtime {
 
+/// Host function objects are created for every module instance, because the
+/// host functions bind to the environment of their VM, such as the WASI
+/// environment. Only the function types are shared between them.
 class HostFunctionBase {
 public:
   HostFunctionBase() = delete;
-  HostFunctionBase(const uint64_t FuncCost) : Cost(FuncCost) {}
+  /// Constructor with the function type, which should outlive this host
+  /// function.
+  HostFunctionBase(const uint64_t FuncCost, const AST::FunctionType &Type)
+      : Cost(FuncCost), DefType(&Type) {}
+  HostFunctionBase(const HostFunctionBase &) = delete;
+  HostFunctionBase &operator=(const HostFunctionBase &) = delete;
   virtual ~HostFunctionBase() = default;
 
   /// Run host function body.
@@ -36,20 +46,45 @@ public:
                            Span<ValVariant> Rets) = 0;
 
   /// Getter of function type.
-  const AST::FunctionType &getFuncType() const { return FuncType; }
+  const AST::FunctionType &getFuncType() const { return *DefType; }
 
   /// Getter of host function cost.
   uint64_t getCost() const { return Cost; }
 
+  /// Work amounts indexed by the HostWork kind.
+  using WorkRecord = std::array<uint64_t, static_cast<size_t>(HostWork::Max)>;
+
+  /// Report the work done in the current call on this thread. The executor
+  /// charges the work by the cost model of the statistics after the call.
+  static void addWork(HostWork Kind, uint64_t Amount) noexcept {
+    CallWork[static_cast<size_t>(Kind)] += Amount;
+  }
+
+  /// Take and reset the work reported on this thread.
+  static WorkRecord takeWork() noexcept {
+    WorkRecord Work = CallWork;
+    CallWork.fill(0);
+    return Work;
+  }
+
 protected:
-  AST::FunctionType FuncType;
   const uint64_t Cost;
+
+private:
+  const AST::FunctionType *DefType;
+  static inline thread_local WorkRecord CallWork = {};
 };
 
 template <typename T> class HostFunction : public HostFunctionBase {
 public:
-  HostFunction(const uint64_t FuncCost = 0) : HostFunctionBase(FuncCost) {
-    initializeFuncType();
+  HostFunction(const uint64_t FuncCost = 0)
+      : HostFunctionBase(FuncCost, getDefinedFuncType()) {}
+
+  /// Getter of the function type shared by all instances of the host function
+  /// in the process.
+  static const AST::FunctionType &getDefinedFuncType() {
+    static const AST::FunctionType Type = genFuncType();
+    return Type;
   }
 
   Expect<void> run(Instance::MemoryInstance *MemInst,
@@ -90,16 +125,18 @@ protected:
     return {};
   }
 
-  void initializeFuncType() {
+  static AST::FunctionType genFuncType() {
     using F = FuncTraits<decltype(&T::body)>;
     using ArgsT = typename F::ArgsT;
-    FuncType.getParamTypes().reserve(F::ArgsN);
-    pushValType<ArgsT>(std::make_index_sequence<F::ArgsN>());
+    AST::FunctionType Type;
+    Type.getParamTypes().reserve(F::ArgsN);
+    pushValType<ArgsT>(Type, std::make_index_sequence<F::ArgsN>());
     if constexpr (F::hasReturn) {
-      FuncType.getReturnTypes().reserve(F::RetsN);
+      Type.getReturnTypes().reserve(F::RetsN);
       using RetsT = typename F::RetsT;
-      pushRetType<RetsT>(std::make_index_sequence<F::RetsN>());
+      pushRetType<RetsT>(Type, std::make_index_sequence<F::RetsN>());
     }
+    return Type;
   }
 
 private:
@@ -140,15 +177,17 @@ private:
   }
 
   template <typename Tuple, std::size_t... Indices>
-  void pushValType(std::index_sequence<Indices...>) {
-    (FuncType.getParamTypes().push_back(
+  static void pushValType(AST::FunctionType &Type,
+                          std::index_sequence<Indices...>) {
+    (Type.getParamTypes().push_back(
          ValTypeFromType<std::tuple_element_t<Indices, Tuple>>()),
      ...);
   }
 
   template <typename Tuple, std::size_t... Indices>
-  void pushRetType(std::index_sequence<Indices...>) {
-    (FuncType.getReturnTypes().push_back(
+  static void pushRetType(AST::FunctionType &Type,
+                          std::index_sequence<Indices...>) {
+    (Type.getReturnTypes().push_back(
          ValTypeFromType<std::tuple_element_t<Indices, Tuple>>()),
      ...);
   }
@@ -33,7 +33,7 @@ public:
   FunctionInstance() = delete;
   /// Move constructor.
   FunctionInstance(FunctionInstance &&Inst) noexcept
-      : ModuleAddr(Inst.ModuleAddr), FuncType(Inst.FuncType),
+      : Addr(Inst.Addr), ModuleAddr(Inst.ModuleAddr), FuncType(Inst.FuncType),
         Data(std::move(Inst.Data)) {}
   /// Constructor for native function.
   FunctionInstance(const uint32_t ModAddr, const AST::FunctionType &Type,
@@ -99,17 +99,18 @@ public:
     return *std::get_if<std::unique_ptr<HostFunctionBase>>(&Data)->get();
   }
 
+  /// Function instance address in store manager.
+  uint32_t Addr = 0;
+
 private:
+  /// The locals and instructions are owned by the instantiation data shared
+  /// by the module instance, which outlives its function instances.
   struct WasmFunction {
-    const std::vector<std::pair<uint32_t, ValType>> Locals;
-    AST::InstrVec Instrs;
+    Span<const std::pair<uint32_t, ValType>> Locals;
+    AST::InstrView Instrs;
     WasmFunction(Span<const std::pair<uint32_t, ValType>> Locs,
                  AST::InstrView Expr) noexcept
-        : Locals(Locs.begin(), Locs.end()) {
-      // FIXME: Modify the capacity to prevent from connection of 2 vectors.
-      Instrs.reserve(Expr.size() + 1);
-      Instrs.assign(Expr.begin(), Expr.end());
-    }
+        : Locals(Locs), Instrs(Expr) {}
   };
 
   /// \name Data of function instance.
@@ -114,6 +114,24 @@ public:
     return true;
   }
 
+  /// Discard pages and return the physical memory back to the system.
+  ///
+  /// The memory size is not changed, and the discarded pages are read as
+  /// zeros afterwards.
+  ///
+  /// \param Start the index of the first page to discard.
+  /// \param Count the count of pages to discard.
+  ///
+  /// \returns true when success, false when out of bounds or failed.
+  bool discardPage(const uint32_t Start, const uint32_t Count) noexcept {
+    const uint64_t End =
+        static_cast<uint64_t>(Start) + static_cast<uint64_t>(Count);
+    if (End > MemType.getLimit().getMin()) {
+      return false;
+    }
+    return Allocator::discard(DataPtr, Start, Count);
+  }
+
   /// Get slice of Data[Offset : Offset + Length - 1]
   Expect<Span<Byte>> getBytes(const uint32_t Offset,
                               const uint32_t Length) const noexcept {
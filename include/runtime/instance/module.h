@@ -13,10 +13,11 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
-#include "ast/type.h"
+#include "ast/module.h"
 #include "common/errcode.h"
 
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -32,9 +33,13 @@ public:
 
   std::string_view getModuleName() const { return ModName; }
 
-  /// Copy the function types in type section to module instance.
-  void addFuncType(const AST::FunctionType &FuncType) {
-    FuncTypes.emplace_back(FuncType);
+  /// Share the immutable data of the module to module instance.
+  void setInstantiationData(
+      std::shared_ptr<const AST::Module::InstantiationData> Data) noexcept {
+    InstData = std::move(Data);
+  }
+  const AST::Module::InstantiationData *getInstantiationData() const noexcept {
+    return InstData.get();
   }
 
   /// Register module owns instances with address in Store.
@@ -44,6 +49,7 @@ public:
   void addGlobalAddr(const uint32_t GlobAddr) {
     GlobalAddrs.push_back(GlobAddr);
   }
+  void addTagAddr(const uint32_t TagAddr) { TagAddrs.push_back(TagAddr); }
   void addElemAddr(const uint32_t ElemAddr) { ElemAddrs.push_back(ElemAddr); }
   void addDataAddr(const uint32_t DataAddr) { DataAddrs.push_back(DataAddr); }
 
@@ -64,6 +70,10 @@ public:
     ImpGlobalNum++;
     addGlobalAddr(GlobAddr);
   }
+  void importTag(const uint32_t TagAddr) {
+    ImpTagNum++;
+    addTagAddr(TagAddr);
+  }
 
   /// Export instances.
   void exportFunction(std::string_view Name, const uint32_t Idx) {
@@ -78,12 +88,16 @@ public:
   void exportGlobal(std::string_view Name, const uint32_t Idx) {
     ExpGlobals.insert_or_assign(std::string(Name), GlobalAddrs[Idx]);
   }
+  void exportTag(std::string_view Name, const uint32_t Idx) {
+    ExpTags.insert_or_assign(std::string(Name), TagAddrs[Idx]);
+  }
 
   /// Get import nums.
   uint32_t getFuncImportNum() const { return ImpFuncNum; }
   uint32_t getTableImportNum() const { return ImpTableNum; }
   uint32_t getMemImportNum() const { return ImpMemNum; }
   uint32_t getGlobalImportNum() const { return ImpGlobalNum; }
+  uint32_t getTagImportNum() const { return ImpTagNum; }
 
   /// Get export maps.
   const std::map<std::string, uint32_t, std::less<>> &getFuncExports() const {
@@ -98,14 +112,28 @@ public:
   const std::map<std::string, uint32_t, std::less<>> &getGlobalExports() const {
     return ExpGlobals;
   }
+  const std::map<std::string, uint32_t, std::less<>> &getTagExports() const {
+    return ExpTags;
+  }
 
   /// Get function type by index.
   Expect<const AST::FunctionType *> getFuncType(const uint32_t Idx) const {
-    if (Idx >= FuncTypes.size()) {
+    if (!InstData || Idx >= InstData->FuncTypes.size()) {
       // Error logging need to be handled in caller.
       return Unexpect(ErrCode::WrongInstanceIndex);
     }
-    return &FuncTypes[Idx];
+    return &InstData->FuncTypes[Idx];
+  }
+  /// Get the global type with the typed reference resolved by the function
+  /// types of this module.
+  AST::GlobalType resolveGlobalType(const AST::GlobalType &GlobType) const {
+    AST::GlobalType Resolved = GlobType;
+    if (auto &Ref = Resolved.getRef(); Ref.hasTypeIdx()) {
+      if (auto FuncType = getFuncType(Ref.getTypeIdx())) {
+        Ref.setResolvedType(*FuncType);
+      }
+    }
+    return Resolved;
   }
   /// Get the external values by index. Addr will be address in Store.
   Expect<uint32_t> getFuncAddr(const uint32_t Idx) const {
@@ -136,6 +164,13 @@ public:
     }
     return GlobalAddrs[Idx];
   }
+  Expect<uint32_t> getTagAddr(const uint32_t Idx) const {
+    if (Idx >= TagAddrs.size()) {
+      // Error logging need to be handled in caller.
+      return Unexpect(ErrCode::WrongInstanceIndex);
+    }
+    return TagAddrs[Idx];
+  }
   Expect<uint32_t> getElemAddr(const uint32_t Idx) const {
     if (Idx >= ElemAddrs.size()) {
       // Error logging need to be handled in caller.
@@ -162,6 +197,7 @@ public:
   uint32_t getGlobalNum() const {
     return static_cast<uint32_t>(GlobalAddrs.size());
   }
+  uint32_t getTagNum() const { return static_cast<uint32_t>(TagAddrs.size()); }
   uint32_t getElemNum() const {
     return static_cast<uint32_t>(ElemAddrs.size());
   }
@@ -196,14 +232,15 @@ private:
   /// Module name.
   const std::string ModName;
 
-  /// Function types.
-  std::vector<AST::FunctionType> FuncTypes;
+  /// Shared immutable data, including function types and function bodies.
+  std::shared_ptr<const AST::Module::InstantiationData> InstData;
 
   /// Elements address index in this module in Store.
   std::vector<uint32_t> FuncAddrs;
   std::vector<uint32_t> TableAddrs;
   std::vector<uint32_t> MemAddrs;
   std::vector<uint32_t> GlobalAddrs;
+  std::vector<uint32_t> TagAddrs;
   std::vector<uint32_t> ElemAddrs;
   std::vector<uint32_t> DataAddrs;
 
@@ -212,12 +249,14 @@ private:
   uint32_t ImpTableNum = 0;
   uint32_t ImpMemNum = 0;
   uint32_t ImpGlobalNum = 0;
+  uint32_t ImpTagNum = 0;
 
   /// Exports.
   std::map<std::string, uint32_t, std::less<>> ExpFuncs;
   std::map<std::string, uint32_t, std::less<>> ExpTables;
   std::map<std::string, uint32_t, std::less<>> ExpMems;
   std::map<std::string, uint32_t, std::less<>> ExpGlobals;
+  std::map<std::string, uint32_t, std::less<>> ExpTags;
 
   /// Start function address
   bool HasStartFunc = false;
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/runtime/instance/tag.h - Tag Instance definition ---------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the tag instance definition in store manager.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "ast/type.h"
+
+namespace WasmEdge {
+namespace Runtime {
+namespace Instance {
+
+class TagInstance {
+public:
+  TagInstance() = delete;
+  TagInstance(const AST::FunctionType &Type) : TagType(Type) {}
+
+  /// Get the function type of the tag, which is the types of the exception
+  /// values.
+  const AST::FunctionType &getTagType() const noexcept { return TagType; }
+
+private:
+  /// \name Data of tag instance.
+  /// @{
+  const AST::FunctionType TagType;
+  /// @}
+};
+
+} // namespace Instance
+} // namespace Runtime
+} // namespace WasmEdge
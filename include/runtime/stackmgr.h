@@ -14,6 +14,7 @@
 #pragma once
 
 #include "ast/instruction.h"
+#include "common/span.h"
 
 #include <optional>
 #include <vector>
@@ -21,29 +22,39 @@
 namespace WasmEdge {
 namespace Runtime {
 
+namespace Instance {
+class FunctionInstance;
+} // namespace Instance
+
 class StackManager {
 public:
   struct Label {
     Label() = delete;
     Label(const uint32_t S, const uint32_t A, AST::InstrView::iterator FromIt,
-          std::optional<AST::InstrView::iterator> ContIt)
-        : VStackOff(S), Arity(A), From(FromIt), Cont(ContIt) {}
+          std::optional<AST::InstrView::iterator> ContIt,
+          std::optional<AST::InstrView::iterator> TryIt)
+        : VStackOff(S), Arity(A), From(FromIt), Cont(ContIt), Try(TryIt) {}
     uint32_t VStackOff;
     uint32_t Arity;
     AST::InstrView::iterator From;
     std::optional<AST::InstrView::iterator> Cont;
+    /// The Try instruction if the label is of a Try-block and not handling an
+    /// exception.
+    std::optional<AST::InstrView::iterator> Try;
   };
 
   struct Frame {
     Frame() = delete;
     Frame(const uint32_t Addr, const uint32_t VS, const uint32_t LS,
-          const uint32_t A, const bool Dummy = false)
-        : ModAddr(Addr), VStackOff(VS), LStackOff(LS), Arity(A),
+          const uint32_t A, const Instance::FunctionInstance *F,
+          const bool Dummy = false)
+        : ModAddr(Addr), VStackOff(VS), LStackOff(LS), Arity(A), Func(F),
           IsDummy(Dummy) {}
     uint32_t ModAddr;
     uint32_t VStackOff;
     uint32_t LStackOff;
     uint32_t Arity;
+    const Instance::FunctionInstance *Func;
     bool IsDummy;
   };
 
@@ -87,14 +98,16 @@ public:
 
   /// Push a new frame entry to stack.
   void pushFrame(const uint32_t ModuleAddr, const uint32_t LocalNum = 0,
-                 const uint32_t ArityNum = 0) {
+                 const uint32_t ArityNum = 0,
+                 const Instance::FunctionInstance *Func = nullptr) {
     FrameStack.emplace_back(ModuleAddr, ValueStack.size() - LocalNum,
-                            LabelStack.size(), ArityNum);
+                            LabelStack.size(), ArityNum, Func);
   }
 
   /// Push a dummy frame for invokation base.
   void pushDummyFrame() {
-    FrameStack.emplace_back(0, ValueStack.size(), LabelStack.size(), 0, true);
+    FrameStack.emplace_back(0, ValueStack.size(), LabelStack.size(), 0,
+                            nullptr, true);
   }
 
   /// Unsafe pop top frame.
@@ -112,8 +125,10 @@ public:
   /// Push a new label entry to stack.
   void pushLabel(const uint32_t LocalNum, const uint32_t ArityNum,
                  AST::InstrView::iterator From,
-                 std::optional<AST::InstrView::iterator> Cont = std::nullopt) {
-    LabelStack.emplace_back(ValueStack.size() - LocalNum, ArityNum, From, Cont);
+                 std::optional<AST::InstrView::iterator> Cont = std::nullopt,
+                 std::optional<AST::InstrView::iterator> Try = std::nullopt) {
+    LabelStack.emplace_back(ValueStack.size() - LocalNum, ArityNum, From, Cont,
+                            Try);
   }
 
   /// Unsafe pop top label.
@@ -140,6 +155,29 @@ public:
     return It;
   }
 
+  /// Unsafe unwind to the label by index from the bottom for handling an
+  /// exception. The frames and labels above it and the values in it are
+  /// popped, and the label leaves the Try state.
+  void unwindToLabel(const uint32_t Idx) {
+    while (FrameStack.back().LStackOff > Idx) {
+      FrameStack.pop_back();
+    }
+    LabelStack.erase(LabelStack.begin() + Idx + 1, LabelStack.end());
+    auto &L = LabelStack.back();
+    ValueStack.erase(ValueStack.begin() + L.VStackOff, ValueStack.end());
+    L.Try.reset();
+  }
+
+  /// Unsafe unwind to the frame by index from the bottom for passing an
+  /// exception to the compiled function of the frame. The frames above it and
+  /// their labels and values are popped.
+  void unwindToFrame(const uint32_t Idx) {
+    const auto &F = FrameStack[Idx + 1];
+    LabelStack.erase(LabelStack.begin() + F.LStackOff, LabelStack.end());
+    ValueStack.erase(ValueStack.begin() + F.VStackOff, ValueStack.end());
+    FrameStack.erase(FrameStack.begin() + Idx + 1, FrameStack.end());
+  }
+
   /// Unsafe getter of module address.
   uint32_t getModuleAddr() const { return FrameStack.back().ModAddr; }
 
@@ -158,6 +196,12 @@ public:
     return LabelStack[FrameStack.back().LStackOff];
   }
 
+  /// Getter of the frames from the bottom.
+  Span<const Frame> getFrames() const { return FrameStack; }
+
+  /// Getter of the labels from the bottom.
+  Span<const Label> getLabels() const { return LabelStack; }
+
   /// Unsafe checker of top frame is a dummy frame.
   bool isTopDummyFrame() { return FrameStack.back().IsDummy; }
 
@@ -20,9 +20,11 @@
 #include "runtime/instance/memory.h"
 #include "runtime/instance/module.h"
 #include "runtime/instance/table.h"
+#include "runtime/instance/tag.h"
 
 #include <memory>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 namespace WasmEdge {
@@ -35,7 +37,8 @@ inline constexpr const bool IsImportEntityV =
     std::is_same_v<T, Instance::FunctionInstance> ||
     std::is_same_v<T, Instance::TableInstance> ||
     std::is_same_v<T, Instance::MemoryInstance> ||
-    std::is_same_v<T, Instance::GlobalInstance>;
+    std::is_same_v<T, Instance::GlobalInstance> ||
+    std::is_same_v<T, Instance::TagInstance>;
 
 /// Return true if T is entities.
 template <typename T>
@@ -52,8 +55,8 @@ inline constexpr const bool IsInstanceV =
 class StoreManager {
 public:
   StoreManager()
-      : NumMod(0), NumFunc(0), NumTab(0), NumMem(0), NumGlob(0), NumElem(0),
-        NumData(0) {}
+      : NumMod(0), NumFunc(0), NumTab(0), NumMem(0), NumGlob(0), NumTag(0),
+        NumElem(0), NumData(0) {}
   ~StoreManager() = default;
 
   /// Import instances and move owner to store manager.
@@ -65,8 +68,8 @@ public:
     return ModAddr;
   }
   template <typename... Args> uint32_t importFunction(Args &&...Values) {
-    return importInstance(ImpFuncInsts, FuncInsts,
-                          std::forward<Args>(Values)...);
+    return addFunction(importInstance(ImpFuncInsts, FuncInsts,
+                                      std::forward<Args>(Values)...));
   }
   template <typename... Args> uint32_t importTable(Args &&...Values) {
     return importInstance(ImpTabInsts, TabInsts, std::forward<Args>(Values)...);
@@ -78,6 +81,9 @@ public:
     return importInstance(ImpGlobInsts, GlobInsts,
                           std::forward<Args>(Values)...);
   }
+  template <typename... Args> uint32_t importTag(Args &&...Values) {
+    return importInstance(ImpTagInsts, TagInsts, std::forward<Args>(Values)...);
+  }
   template <typename... Args> uint32_t importElement(Args &&...Values) {
     return importInstance(ImpElemInsts, ElemInsts,
                           std::forward<Args>(Values)...);
@@ -89,7 +95,7 @@ public:
 
   /// Import host instances but not move ownership.
   uint32_t importHostFunction(Instance::FunctionInstance &Func) {
-    return importHostInstance(Func, FuncInsts);
+    return addFunction(importHostInstance(Func, FuncInsts));
   }
   uint32_t importHostTable(Instance::TableInstance &Tab) {
     return importHostInstance(Tab, TabInsts);
@@ -111,8 +117,8 @@ public:
   }
   template <typename... Args> uint32_t pushFunction(Args &&...Values) {
     ++NumFunc;
-    return importInstance(ImpFuncInsts, FuncInsts,
-                          std::forward<Args>(Values)...);
+    return addFunction(importInstance(ImpFuncInsts, FuncInsts,
+                                      std::forward<Args>(Values)...));
   }
   template <typename... Args> uint32_t pushTable(Args &&...Values) {
     ++NumTab;
@@ -127,6 +133,10 @@ public:
     return importInstance(ImpGlobInsts, GlobInsts,
                           std::forward<Args>(Values)...);
   }
+  template <typename... Args> uint32_t pushTag(Args &&...Values) {
+    ++NumTag;
+    return importInstance(ImpTagInsts, TagInsts, std::forward<Args>(Values)...);
+  }
   template <typename... Args> uint32_t pushElement(Args &&...Values) {
     ++NumElem;
     return importInstance(ImpElemInsts, ElemInsts,
@@ -154,6 +164,23 @@ public:
   Expect<Instance::FunctionInstance *> getFunction(const uint32_t Addr) {
     return getInstance(Addr, FuncInsts);
   }
+  /// Get function instance from store manager by function reference. The
+  /// references to the instances not in this store, which belong to the other
+  /// stores or have been released, are rejected.
+  Expect<const Instance::FunctionInstance *> getFunction(const FuncRef &Ref) {
+    if (Ref.isAddr()) {
+      if (auto Res = getInstance(Ref.getAddr(), FuncInsts)) {
+        return *Res;
+      } else {
+        return Unexpect(Res);
+      }
+    }
+    if (FuncInstSet.count(Ref.Ptr) == 0) {
+      // Error logging need to be handled in caller.
+      return Unexpect(ErrCode::WrongInstanceAddress);
+    }
+    return Ref.Ptr;
+  }
   Expect<Instance::TableInstance *> getTable(const uint32_t Addr) {
     return getInstance(Addr, TabInsts);
   }
@@ -163,6 +190,9 @@ public:
   Expect<Instance::GlobalInstance *> getGlobal(const uint32_t Addr) {
     return getInstance(Addr, GlobInsts);
   }
+  Expect<Instance::TagInstance *> getTag(const uint32_t Addr) {
+    return getInstance(Addr, TagInsts);
+  }
   Expect<Instance::ElementInstance *> getElement(const uint32_t Addr) {
     return getInstance(Addr, ElemInsts);
   }
@@ -204,6 +234,7 @@ public:
       NumTab = 0;
       NumMem = 0;
       NumGlob = 0;
+      NumTag = 0;
       NumElem = 0;
       NumData = 0;
       ModInsts.clear();
@@ -211,6 +242,7 @@ public:
       TabInsts.clear();
       MemInsts.clear();
       GlobInsts.clear();
+      TagInsts.clear();
       ElemInsts.clear();
       DataInsts.clear();
       ImpModInsts.clear();
@@ -218,10 +250,15 @@ public:
       ImpTabInsts.clear();
       ImpMemInsts.clear();
       ImpGlobInsts.clear();
+      ImpTagInsts.clear();
       ImpElemInsts.clear();
       ImpDataInsts.clear();
       ModMap.clear();
+      FuncInstSet.clear();
     } else {
+      // Clear the references to the released function instances in the
+      // remaining tables and globals.
+      clearFuncRefs();
       while (NumMod > 0) {
         --NumMod;
         ImpModInsts.pop_back();
@@ -229,6 +266,7 @@ public:
       }
       while (NumFunc > 0) {
         --NumFunc;
+        FuncInstSet.erase(FuncInsts.back());
         ImpFuncInsts.pop_back();
         FuncInsts.pop_back();
       }
@@ -247,6 +285,11 @@ public:
         ImpGlobInsts.pop_back();
         GlobInsts.pop_back();
       }
+      while (NumTag > 0) {
+        --NumTag;
+        ImpTagInsts.pop_back();
+        TagInsts.pop_back();
+      }
       while (NumElem > 0) {
         --NumElem;
         ImpElemInsts.pop_back();
@@ -281,6 +324,45 @@ private:
     return Addr;
   }
 
+  /// Helper function for recording the function instance in this store.
+  uint32_t addFunction(const uint32_t Addr) {
+    FuncInsts[Addr]->Addr = Addr;
+    FuncInstSet.insert(FuncInsts[Addr]);
+    return Addr;
+  }
+
+  /// Helper function for clearing the references to the function instances
+  /// to be released in the remaining tables and globals.
+  void clearFuncRefs() {
+    if (NumFunc == 0) {
+      return;
+    }
+    const std::unordered_set<const Instance::FunctionInstance *> Released(
+        FuncInsts.end() - NumFunc, FuncInsts.end());
+    auto IsReleased = [&Released](const FuncRef &Ref) {
+      return Ref.Ptr != nullptr && Released.count(Ref.Ptr) > 0;
+    };
+    for (uint32_t I = 0; I < TabInsts.size() - NumTab; ++I) {
+      auto *TabInst = TabInsts[I];
+      if (TabInst->getTableType().getRefType() != RefType::FuncRef) {
+        continue;
+      }
+      const auto Refs = *TabInst->getRefs(0, TabInst->getSize());
+      for (uint32_t J = 0; J < Refs.size(); ++J) {
+        if (IsReleased(Refs[J].get<FuncRef>())) {
+          TabInst->setRefAddr(J, UnknownRef());
+        }
+      }
+    }
+    for (uint32_t I = 0; I < GlobInsts.size() - NumGlob; ++I) {
+      auto *GlobInst = GlobInsts[I];
+      if (GlobInst->getGlobalType().getValType() == ValType::FuncRef &&
+          IsReleased(GlobInst->getValue().get<FuncRef>())) {
+        GlobInst->getValue() = UnknownRef();
+      }
+    }
+  }
+
   /// Helper function for getting instance from instance vector.
   template <typename T>
   std::enable_if_t<IsInstanceV<T>, Expect<T *>>
@@ -299,6 +381,7 @@ private:
   std::vector<std::unique_ptr<Instance::TableInstance>> ImpTabInsts;
   std::vector<std::unique_ptr<Instance::MemoryInstance>> ImpMemInsts;
   std::vector<std::unique_ptr<Instance::GlobalInstance>> ImpGlobInsts;
+  std::vector<std::unique_ptr<Instance::TagInstance>> ImpTagInsts;
   std::vector<std::unique_ptr<Instance::ElementInstance>> ImpElemInsts;
   std::vector<std::unique_ptr<Instance::DataInstance>> ImpDataInsts;
   /// @}
@@ -310,10 +393,16 @@ private:
   std::vector<Instance::TableInstance *> TabInsts;
   std::vector<Instance::MemoryInstance *> MemInsts;
   std::vector<Instance::GlobalInstance *> GlobInsts;
+  std::vector<Instance::TagInstance *> TagInsts;
   std::vector<Instance::ElementInstance *> ElemInsts;
   std::vector<Instance::DataInstance *> DataInsts;
   /// @}
 
+  /// \name Function instances in this store for checking the references.
+  /// @{
+  std::unordered_set<const Instance::FunctionInstance *> FuncInstSet;
+  /// @}
+
   /// \name Data for instantiated module.
   /// @{
   uint32_t NumMod;
@@ -321,6 +410,7 @@ private:
   uint32_t NumTab;
   uint32_t NumMem;
   uint32_t NumGlob;
+  uint32_t NumTag;
   uint32_t NumElem;
   uint32_t NumData;
   /// @}
@@ -23,6 +23,8 @@ public:
   static uint8_t *resize(uint8_t *Pointer, uint32_t OldPageCount,
                          uint32_t NewPageCount) noexcept;
   static void release(uint8_t *Pointer, uint32_t PageCount) noexcept;
+  static bool discard(uint8_t *Pointer, uint32_t PageIndex,
+                      uint32_t PageCount) noexcept;
 
   static uint8_t *allocate_chunk(uint64_t Size) noexcept;
   static void release_chunk(uint8_t *Pointer, uint64_t Size) noexcept;
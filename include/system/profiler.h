@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/system/profiler.h - Sampling profiler --------------------===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file contains the sampling profiler, which attributes the CPU time to
+/// the wasm functions.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/defines.h"
+#include "common/span.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if WASMEDGE_OS_LINUX
+#include <time.h>
+#endif
+
+namespace WasmEdge {
+
+/// Sampling profiler of the wasm functions.
+///
+/// A SIGPROF timer ticks in the given interval of the CPU time consumed by the
+/// thread which starts the profiler. On Linux every profiler has its own timer
+/// signaling its own thread, so the profilers in different threads sample
+/// independently. Elsewhere the timer measures the whole process and only one
+/// profiler samples at a time.
+///
+/// The ticks in the interpreter are kept pending until the executor reaches a
+/// call or a branch, where the call stack of the functions is recorded. The
+/// ticks in the compiled code are counted by the program counter in the signal
+/// handler and attributed to the compiled function containing it, without the
+/// callers in the compiled code.
+///
+/// The functions are identified by opaque keys, such as the addresses of the
+/// function instances, and named by `setName`.
+class Profiler {
+public:
+  using Key = const void *;
+
+  Profiler() noexcept = default;
+  ~Profiler() noexcept {
+    if (Running) {
+      stop();
+    }
+  }
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+  /// Start sampling the calling thread.
+  ///
+  /// \param Interval the interval of the CPU time between the samples.
+  ///
+  /// \returns true if started, false if sampling is not supported or, except
+  /// on Linux, another profiler is sampling.
+  bool start(std::chrono::microseconds Interval) noexcept;
+
+  /// Stop sampling and collect the samples in the compiled code. Should be
+  /// called on the thread which started sampling.
+  void stop();
+
+  /// Check if the profiler is sampling.
+  bool isRunning() const noexcept { return Running; }
+
+  /// Set the name of a function in the output.
+  void setName(Key K, std::string Name);
+
+  /// Register the entry address of a compiled function.
+  void addCompiledFunction(const void *Entry, Key K);
+
+  /// Check if any samples are waiting for the call stack.
+  bool hasPendingSample() const noexcept {
+    return Pending.load(std::memory_order_relaxed) != 0;
+  }
+
+  /// Record the pending samples with the call stack.
+  ///
+  /// \param Stack the functions from the outermost to the innermost.
+  void recordSample(Span<const Key> Stack);
+
+  /// Set if the compiled code is executing and return the previous state.
+  bool setInCompiled(bool In) noexcept {
+    return InCompiled.exchange(In, std::memory_order_relaxed);
+  }
+
+  /// Getter of the number of the recorded samples.
+  uint64_t getSampleCount() const noexcept { return SampleCount; }
+
+  /// Getter of the number of the samples in the compiled code dropped by the
+  /// full table of the program counters.
+  uint64_t getDroppedCount() const noexcept {
+    return Dropped.load(std::memory_order_relaxed);
+  }
+
+  /// Clear the recorded samples. The names are kept.
+  void clear();
+
+  /// Write the samples in the folded stack format, which is one stack per line
+  /// with the function names separated by `;` and followed by the count.
+  void dumpFolded(std::ostream &OS);
+
+private:
+  /// Collect the program counters sampled in the compiled code.
+  void collectCompiled();
+
+  /// Get the name of a function.
+  std::string getName(Key K) const;
+
+  static void handleSignal(Profiler &P, uintptr_t PC) noexcept;
+  friend struct ProfilerSignal;
+
+  static inline constexpr uint32_t kPCTableSize = 4096;
+  static inline constexpr uint32_t kPCProbeLimit = 16;
+
+  /// Sample count of a program counter in the compiled code. Zero PC for
+  /// empty slots.
+  struct PCSlot {
+    std::atomic<uintptr_t> PC = 0;
+    std::atomic_uint64_t Count = 0;
+  };
+
+  bool Running = false;
+  std::atomic_uint32_t Pending = 0;
+  std::atomic_bool InCompiled = false;
+  /// Open addressing table of the program counters sampled in the compiled
+  /// code. The signal handler counts into it without allocation, so it needs
+  /// no draining while the compiled code runs.
+  std::array<PCSlot, kPCTableSize> PCTable = {};
+  std::atomic_uint64_t Dropped = 0;
+#if WASMEDGE_OS_LINUX
+  timer_t Timer = {};
+#endif
+
+  std::unordered_map<Key, std::string> Names;
+  std::map<uintptr_t, Key> CompiledEntries;
+  std::map<std::vector<Key>, uint64_t> Stacks;
+  uint64_t SampleCount = 0;
+};
+
+} // namespace WasmEdge
@@ -28,7 +28,10 @@
 namespace WasmEdge {
 namespace Validator {
 
-enum class VType : uint8_t {
+/// Value types in validation. The low byte is the type code. For the
+/// reference types of the function references proposal, the non-null flag and
+/// the function type index are encoded in the higher bits.
+enum class VType : uint64_t {
   Unknown,
   I32,
   I64,
@@ -39,13 +42,65 @@ enum class VType : uint8_t {
   ExternRef
 };
 
+static inline constexpr uint64_t VTypeNonNull = UINT64_C(1) << 8;
+static inline constexpr uint64_t VTypeHasIdx = UINT64_C(1) << 9;
+
+static inline constexpr VType getBaseType(const VType V) {
+  return static_cast<VType>(static_cast<uint64_t>(V) & UINT64_C(0xFF));
+}
+
+static inline constexpr bool isNullableRef(const VType V) {
+  return (static_cast<uint64_t>(V) & VTypeNonNull) == 0;
+}
+
+static inline constexpr bool hasTypeIdx(const VType V) {
+  return (static_cast<uint64_t>(V) & VTypeHasIdx) != 0;
+}
+
+static inline constexpr uint32_t getTypeIdx(const VType V) {
+  return static_cast<uint32_t>(static_cast<uint64_t>(V) >> 32);
+}
+
+static inline constexpr VType toNullableRef(const VType V, bool Nullable) {
+  return static_cast<VType>(Nullable
+                                ? static_cast<uint64_t>(V) & ~VTypeNonNull
+                                : static_cast<uint64_t>(V) | VTypeNonNull);
+}
+
+/// Typed reference `(ref null $t)` or `(ref $t)` of the type index.
+static inline constexpr VType makeTypedRef(const uint32_t TypeIdx,
+                                           bool Nullable) {
+  return toNullableRef(static_cast<VType>(static_cast<uint64_t>(VType::FuncRef) |
+                                          VTypeHasIdx |
+                                          (static_cast<uint64_t>(TypeIdx) << 32)),
+                       Nullable);
+}
+
 static inline constexpr bool isNumType(const VType V) {
   return V == VType::I32 || V == VType::I64 || V == VType::F32 ||
          V == VType::F64 || V == VType::V128 || V == VType::Unknown;
 }
 
 static inline constexpr bool isRefType(const VType V) {
-  return V == VType::FuncRef || V == VType::ExternRef || V == VType::Unknown;
+  return getBaseType(V) == VType::FuncRef ||
+         getBaseType(V) == VType::ExternRef || V == VType::Unknown;
+}
+
+/// Return true if the type `Got` is a subtype of the type `Exp`. The typed
+/// references are the subtypes of the FuncRef, and the non-null references are
+/// the subtypes of the nullable ones.
+static inline constexpr bool isSubType(const VType Got, const VType Exp) {
+  if (Got == Exp) {
+    return true;
+  }
+  if (getBaseType(Got) != getBaseType(Exp) || !isRefType(Exp)) {
+    return false;
+  }
+  if (!isNullableRef(Exp) && isNullableRef(Got)) {
+    return false;
+  }
+  return !hasTypeIdx(Exp) ||
+         (hasTypeIdx(Got) && getTypeIdx(Got) == getTypeIdx(Exp));
 }
 
 class FormChecker {
@@ -66,8 +121,9 @@ public:
   void addElem(const AST::ElementSegment &Elem);
   void addData(const AST::DataSegment &Data);
   void addRef(const uint32_t FuncIdx);
-  void addLocal(const ValType &V);
-  void addLocal(const VType &V);
+  void addTag(const uint32_t TypeIdx);
+  void addLocal(const ValType &V, const AST::TypedRef &Ref = {});
+  void addLocal(const VType &V, const bool IsParam = true);
 
   std::vector<VType> result() { return ValStack; }
   auto &getTypes() { return Types; }
@@ -75,11 +131,13 @@ public:
   auto &getTables() { return Tables; }
   auto &getMemories() { return Mems; }
   auto &getGlobals() { return Globals; }
+  auto &getTags() { return Tags; }
   uint32_t getNumImportFuncs() const { return NumImportFuncs; }
   uint32_t getNumImportGlobals() const { return NumImportGlobals; }
 
   /// Helper function
   VType ASTToVType(const ValType &V);
+  VType ASTToVType(const ValType &V, const AST::TypedRef &Ref);
   VType ASTToVType(const NumType &V);
   VType ASTToVType(const RefType &V);
   ValType VTypeToAST(const VType &V);
@@ -88,17 +146,20 @@ public:
     CtrlFrame() = default;
     CtrlFrame(struct CtrlFrame &&F)
         : StartTypes(std::move(F.StartTypes)), EndTypes(std::move(F.EndTypes)),
-          Height(F.Height), IsUnreachable(F.IsUnreachable), Code(F.Code) {}
+          Height(F.Height), InitHeight(F.InitHeight),
+          IsUnreachable(F.IsUnreachable), Code(F.Code) {}
     CtrlFrame(const struct CtrlFrame &F)
         : StartTypes(F.StartTypes), EndTypes(F.EndTypes), Height(F.Height),
-          IsUnreachable(F.IsUnreachable), Code(F.Code) {}
+          InitHeight(F.InitHeight), IsUnreachable(F.IsUnreachable),
+          Code(F.Code) {}
     CtrlFrame(Span<const VType> In, Span<const VType> Out, size_t H,
-              OpCode Op = OpCode::Unreachable)
+              size_t IH, OpCode Op = OpCode::Unreachable)
         : StartTypes(In.begin(), In.end()), EndTypes(Out.begin(), Out.end()),
-          Height(H), IsUnreachable(false), Code(Op) {}
+          Height(H), InitHeight(IH), IsUnreachable(false), Code(Op) {}
     std::vector<VType> StartTypes;
     std::vector<VType> EndTypes;
     size_t Height;
+    size_t InitHeight;
     bool IsUnreachable;
     OpCode Code;
   };
@@ -118,6 +179,7 @@ private:
   void pushTypes(Span<const VType> Input);
   Expect<VType> popType();
   Expect<VType> popType(VType E);
+  bool isTypeIdxMatched(VType Got, VType Exp) const;
   Expect<void> popTypes(Span<const VType> Input);
   void pushCtrl(Span<const VType> In, Span<const VType> Out,
                 OpCode Code = OpCode::Unreachable);
@@ -135,10 +197,15 @@ private:
   std::vector<RefType> Elems;
   std::vector<uint32_t> Datas;
   std::unordered_set<uint32_t> Refs;
+  std::vector<uint32_t> Tags;
   uint32_t NumImportFuncs = 0;
   uint32_t NumImportGlobals = 0;
   std::vector<VType> Locals;
   std::vector<VType> Returns;
+  /// Initialization of the non-nullable locals. The locals initialized in a
+  /// block are recorded in the stack, and are reset at the end of the block.
+  std::vector<bool> LocalInits;
+  std::vector<uint32_t> LocalInitStack;
 
   /// Running stack.
   std::vector<CtrlFrame> CtrlStack;
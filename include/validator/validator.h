@@ -38,7 +38,8 @@ private:
   Expect<void> validate(const AST::Limit &Lim);
   Expect<void> validate(const AST::TableType &Tab);
   Expect<void> validate(const AST::MemoryType &Mem);
-  /// GlobalType is always valid.
+  Expect<void> validate(const AST::TypedRef &Ref);
+  /// GlobalType is valid if its typed reference is valid.
 
   /// Validate AST::Segments
   Expect<void> validate(const AST::GlobalSegment &GlobSeg);
@@ -62,10 +63,11 @@ private:
   Expect<void> validate(const AST::DataSection &DataSec);
   Expect<void> validate(const AST::StartSection &StartSec);
   Expect<void> validate(const AST::ExportSection &ExportSec);
+  Expect<void> validate(const AST::TagSection &TagSec);
 
   /// Validate const expression
   Expect<void> validateConstExpr(AST::InstrView Instrs,
-                                 Span<const ValType> Returns);
+                                 Span<const VType> Returns);
 
   static inline const uint32_t LIMIT_MEMORYTYPE = 1U << 16;
   /// Proposal configure
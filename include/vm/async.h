@@ -15,8 +15,13 @@
 
 #include "vm.h"
 
+#include <condition_variable>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 namespace WasmEdge {
 namespace VM {
@@ -27,15 +32,16 @@ public:
   Async() noexcept = default;
   template <typename... FArgsT, typename... ArgsT>
   Async(T (VM::*FPtr)(FArgsT...), VM &TargetVM, ArgsT &&...Args)
-      : VMPtr(&TargetVM) {
+      : Notify(std::make_shared<Notifier>()), VMPtr(&TargetVM) {
     std::promise<T> Promise;
     Future = Promise.get_future();
     Thread =
-        std::thread([FPtr, P = std::move(Promise),
+        std::thread([FPtr, P = std::move(Promise), N = Notify,
                      Tuple = std::tuple(
                          &TargetVM, std::forward<ArgsT>(Args)...)]() mutable {
           std::get<0>(Tuple)->newThread();
           P.set_value(std::apply(FPtr, Tuple));
+          N->notify();
         });
     Thread.detach();
   }
@@ -51,15 +57,33 @@ public:
 
   T get() { return Future.get(); }
 
-  void wait() const { Future.wait(); }
+  /// Wait until the execution finished and the registered callbacks returned.
+  void wait() const {
+    if (likely(Notify != nullptr)) {
+      std::unique_lock Lock(Notify->Mutex);
+      Notify->Cond.wait(Lock, [this]() { return Notify->Done; });
+      return;
+    }
+    Future.wait();
+  }
 
   template <typename RT, typename PT>
   bool waitFor(const std::chrono::duration<RT, PT> &Timeout) const {
+    if (likely(Notify != nullptr)) {
+      std::unique_lock Lock(Notify->Mutex);
+      return Notify->Cond.wait_for(Lock, Timeout,
+                                   [this]() { return Notify->Done; });
+    }
     return Future.wait_for(Timeout) == std::future_status::ready;
   }
 
   template <typename CT, typename DT>
   bool waitUntil(const std::chrono::time_point<CT, DT> &Timeout) const {
+    if (likely(Notify != nullptr)) {
+      std::unique_lock Lock(Notify->Mutex);
+      return Notify->Cond.wait_until(Lock, Timeout,
+                                     [this]() { return Notify->Done; });
+    }
     return Future.wait_until(Timeout) == std::future_status::ready;
   }
 
@@ -67,9 +91,30 @@ public:
     using std::swap;
     swap(LHS.Future, RHS.Future);
     swap(LHS.Thread, RHS.Thread);
+    swap(LHS.Notify, RHS.Notify);
     swap(LHS.VMPtr, RHS.VMPtr);
   }
 
+  /// Register a callback invoked once after the execution finished.
+  ///
+  /// The callback is invoked in the execution thread after the result is
+  /// ready, or immediately in the calling thread if the execution has already
+  /// finished. The callbacks are invoked in the registration order, and must
+  /// not wait for this execution.
+  void onReady(std::function<void()> Callback) {
+    if (unlikely(!Notify)) {
+      return;
+    }
+    {
+      std::unique_lock Lock(Notify->Mutex);
+      if (!Notify->Done) {
+        Notify->Callbacks.push_back(std::move(Callback));
+        return;
+      }
+    }
+    Callback();
+  }
+
   void cancel() noexcept {
     if (likely(VMPtr)) {
       VMPtr->stop();
@@ -77,8 +122,33 @@ public:
   }
 
 private:
+  /// Completion state shared with the execution thread.
+  struct Notifier {
+    void notify() {
+      std::unique_lock Lock(Mutex);
+      // Callbacks registered while invoking the pending ones are queued to
+      // keep the registration order.
+      while (!Callbacks.empty()) {
+        std::vector<std::function<void()>> Pending;
+        Pending.swap(Callbacks);
+        Lock.unlock();
+        for (auto &Callback : Pending) {
+          Callback();
+        }
+        Lock.lock();
+      }
+      Done = true;
+      Cond.notify_all();
+    }
+    std::mutex Mutex;
+    std::condition_variable Cond;
+    bool Done = false;
+    std::vector<std::function<void()>> Callbacks;
+  };
+
   std::shared_future<T> Future;
   std::thread Thread;
+  std::shared_ptr<Notifier> Notify;
   VM *VMPtr;
 };
 
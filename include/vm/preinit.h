@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+//===-- wasmedge/vm/preinit.h - Module pre-initializer class definition ---===//
+//
+// Part of the WasmEdge Project.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file is the definition class of PreInitializer class, which runs the
+/// initialization function of a module ahead of time and snapshots the
+/// instantiated state into a new module.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common/configure.h"
+#include "common/errcode.h"
+#include "common/span.h"
+#include "common/types.h"
+
+#include <string_view>
+#include <vector>
+
+namespace WasmEdge {
+namespace VM {
+
+/// Module pre-initializer class.
+///
+/// The module is instantiated and the named initialization function is invoked
+/// once. The memories, tables, and globals are then encoded into the data
+/// segments, element segments, and global initializers of a new module, which
+/// produces the same state when instantiated without running the
+/// initialization function again. The start function section and the export of
+/// the initialization function are removed from the output.
+///
+/// The state of the host cannot be snapshotted. Therefore the modules which
+/// import tables, memories, or globals are rejected, and calling any imported
+/// function such as the WASI functions in the initialization function fails.
+class PreInitializer {
+public:
+  PreInitializer(const Configure &Conf) noexcept : Conf(Conf) {}
+
+  /// Run the initialization function and generate the pre-initialized module.
+  ///
+  /// \param Code the wasm binary of the module.
+  /// \param InitFunc the exported function name of the initialization function
+  /// with the `[] -> []` function type.
+  ///
+  /// \returns the pre-initialized wasm binary, ErrCode when failed.
+  Expect<std::vector<Byte>> preInitialize(Span<const Byte> Code,
+                                          std::string_view InitFunc);
+
+private:
+  const Configure Conf;
+};
+
+} // namespace VM
+} // namespace WasmEdge
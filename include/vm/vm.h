@@ -118,8 +118,8 @@ public:
 
   /// Register new thread
   void newThread() noexcept { ExecutorEngine.newThread(); }
-  /// Stop execution
-  void stop() noexcept { ExecutorEngine.stop(); }
+  /// Stop execution, including the blocking WASI calls.
+  void stop() noexcept;
 
   /// ======= Functions which are stageless. =======
   /// Clean up VM status
@@ -138,6 +138,9 @@ public:
   /// Getter of statistics.
   Statistics::Statistics &getStatistics() { return Stat; }
 
+  /// Getter of profiler. Nullptr if profiling is not configured.
+  Profiler *getProfiler() { return Prof.get(); }
+
 private:
   enum class VMStage : uint8_t { Inited, Loaded, Validated, Instantiated };
 
@@ -152,6 +155,7 @@ private:
   /// VM environment.
   const Configure Conf;
   Statistics::Statistics Stat;
+  std::unique_ptr<Profiler> Prof;
   VMStage Stage;
 
   /// VM runners.
@@ -5,8 +5,10 @@
 
 #include "aot/version.h"
 #include "common/defines.h"
+#include "common/errinfo.h"
 #include "common/filesystem.h"
 #include "common/log.h"
+#include "common/statistics.h"
 
 #include <algorithm>
 #include <array>
@@ -18,6 +20,7 @@
 #include <lld/Common/Driver.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/SubtargetFeature.h>
@@ -124,6 +127,8 @@ static std::vector<llvm::Value *> unpackStruct(llvm::IRBuilder<> &Builder,
                                                llvm::Value *Struct);
 static llvm::Value *createLikely(llvm::IRBuilder<> &Builder,
                                  llvm::Value *Value);
+static llvm::MDNode *createBranchHint(llvm::LLVMContext &LLContext,
+                                      const WasmEdge::AST::Instruction &Instr);
 class FunctionCompiler;
 
 // XXX: Misalignment handler not implemented yet, forcing unalignment
@@ -255,6 +260,12 @@ struct WasmEdge::AOT::Compiler::CompileContext {
 #else
   bool SupportSSE2 = false;
 #endif
+
+#if defined(__AVXVNNI__) || (defined(__AVX512VNNI__) && defined(__AVX512VL__))
+  bool SupportVNNI = true;
+#else
+  bool SupportVNNI = false;
+#endif
 #endif
 
 #if defined(__aarch64__)
@@ -271,6 +282,7 @@ struct WasmEdge::AOT::Compiler::CompileContext {
                          const WasmEdge::AST::CodeSegment *>>
       Functions;
   std::vector<llvm::Type *> Globals;
+  std::vector<const AST::FunctionType *> Tags;
   llvm::GlobalVariable *IntrinsicsTable;
   llvm::Function *Trap;
   CompileContext(llvm::Module &M, bool IsGenericBinary)
@@ -303,10 +315,15 @@ struct WasmEdge::AOT::Compiler::CompileContext {
             // InstrCount
             Int64PtrTy,
             // CostTable
-            llvm::ArrayType::get(Int64Ty, UINT16_MAX + 1)->getPointerTo(),
+            llvm::ArrayType::get(Int64Ty, Statistics::kCostTableSize)
+                ->getPointerTo(),
             // Gas
             Int64PtrTy,
             // StopToken
+            llvm::Type::getInt32PtrTy(LLContext),
+            // CPUTimeCountdown
+            llvm::Type::getInt32PtrTy(LLContext),
+            // HasPendingException
             llvm::Type::getInt32PtrTy(LLContext))),
         ExecCtxPtrTy(ExecCtxTy->getPointerTo()),
         IntrinsicsTableTy(llvm::ArrayType::get(
@@ -345,6 +362,11 @@ struct WasmEdge::AOT::Compiler::CompileContext {
           if (!SupportSSE2 && Feature.first() == "sse2") {
             SupportSSE2 = true;
           }
+          // The processors with AVX512-VNNI all have AVX512-VL.
+          if (!SupportVNNI && (Feature.first() == "avxvnni" ||
+                               Feature.first() == "avx512vnni")) {
+            SupportVNNI = true;
+          }
 #elif defined(__aarch64__)
           if (!SupportNEON && Feature.first() == "neon") {
             SupportNEON = true;
@@ -401,6 +423,14 @@ struct WasmEdge::AOT::Compiler::CompileContext {
                             llvm::LoadInst *ExecCtx) {
     return Builder.CreateExtractValue(ExecCtx, {5});
   }
+  llvm::Value *getCPUTimeCountdown(llvm::IRBuilder<> &Builder,
+                                   llvm::LoadInst *ExecCtx) {
+    return Builder.CreateExtractValue(ExecCtx, {6});
+  }
+  llvm::Value *getPendingException(llvm::IRBuilder<> &Builder,
+                                   llvm::LoadInst *ExecCtx) {
+    return Builder.CreateExtractValue(ExecCtx, {7});
+  }
   llvm::FunctionCallee getIntrinsic(llvm::IRBuilder<> &Builder,
                                     AST::Module::Intrinsics Index,
                                     llvm::FunctionType *Ty) {
@@ -423,6 +453,9 @@ struct WasmEdge::AOT::Compiler::CompileContext {
         return RetT{};
       }
       return RetT{{}, {BType.Data.Type}};
+    } else if (BType.IsTypedRef) {
+      // Typed reference case. The reference is a FuncRef value.
+      return RetT{{}, {ValType::FuncRef}};
     } else {
       // Type index case. t2* = type[index].returns
       const uint32_t TypeIdx = BType.Data.Idx;
@@ -531,9 +564,11 @@ class FunctionCompiler {
 public:
   FunctionCompiler(AOT::Compiler::CompileContext &Context, llvm::Function *F,
                    Span<const ValType> Locals, bool Interruptible,
-                   bool InstructionCounting, bool GasMeasuring, bool OptNone)
+                   bool InstructionCounting, bool GasMeasuring,
+                   bool ExceptionHandling, bool OptNone)
       : Context(Context), LLContext(Context.LLContext),
-        Interruptible(Interruptible), OptNone(OptNone), F(F),
+        Interruptible(Interruptible), ExceptionHandling(ExceptionHandling),
+        OptNone(OptNone), F(F),
         Builder(llvm::BasicBlock::Create(LLContext, "entry", F)) {
     if (F) {
       setIsFPConstrained(Builder);
@@ -585,6 +620,9 @@ public:
                std::pair<std::vector<ValType>, std::vector<ValType>> Type) {
     auto *RetBB = llvm::BasicBlock::Create(LLContext, "ret", F);
     Type.first.clear();
+    if (ExceptionHandling) {
+      prepareExceptions(Code.getExpr().getInstrs());
+    }
     enterBlock(RetBB, nullptr, nullptr, {}, std::move(Type));
     compile(Code.getExpr().getInstrs());
     assuming(ControlStack.empty());
@@ -604,7 +642,8 @@ public:
   void compile(AST::InstrView Instrs) {
     auto Dispatch = [this](const AST::Instruction &Instr) -> void {
       switch (Instr.getOpCode()) {
-      case OpCode::Block: {
+      case OpCode::Block:
+      case OpCode::Try: {
         auto *Block = llvm::BasicBlock::Create(LLContext, "block", F);
         auto *EndBlock = llvm::BasicBlock::Create(LLContext, "block.end", F);
         Builder.CreateBr(Block);
@@ -626,6 +665,12 @@ public:
         }
         enterBlock(EndBlock, nullptr, nullptr, std::move(Args),
                    std::move(Type));
+        if (Instr.getOpCode() == OpCode::Try) {
+          // The exceptions thrown in the try-block jump to the dispatch
+          // block, which tests the catch clauses in order.
+          ControlStack.back().DispatchBlock =
+              llvm::BasicBlock::Create(LLContext, "try.dispatch", F);
+        }
         checkStop();
         return;
       }
@@ -658,6 +703,7 @@ public:
         }
         enterBlock(Loop, EndLoop, nullptr, std::move(Args), std::move(Type));
         checkStop();
+        checkCPUTime();
         return;
       }
       case OpCode::If: {
@@ -670,7 +716,8 @@ public:
         } else {
           Cond = Builder.CreateICmpNE(stackPop(), Builder.getInt32(0));
         }
-        Builder.CreateCondBr(Cond, Then, Else);
+        Builder.CreateCondBr(Cond, Then, Else,
+                             createBranchHint(LLContext, Instr));
 
         Builder.SetInsertPoint(Then);
         auto Type = Context.resolveBlockType(Instr.getBlockType());
@@ -699,9 +746,81 @@ public:
                      std::move(Entry.Type), std::move(Entry.ReturnPHI));
           Entry = leaveBlock();
         }
+        if (Entry.DispatchBlock) {
+          // No catch clause matched, pass the exception to the outer ones.
+          llvm::IRBuilderBase::InsertPointGuard Guard(Builder);
+          Builder.SetInsertPoint(Entry.DispatchBlock);
+          Builder.CreateBr(getUnwindBlock(ControlStack.size()));
+        }
         buildPHI(Entry.Type.second, Entry.ReturnPHI);
         return;
       }
+      case OpCode::Delegate: {
+        auto Entry = leaveBlock();
+        {
+          // Pass the exception to the handlers of the target label.
+          const auto Label = Instr.getTargetIndex();
+          assuming(Label < ControlStack.size());
+          llvm::IRBuilderBase::InsertPointGuard Guard(Builder);
+          Builder.SetInsertPoint(Entry.DispatchBlock);
+          Builder.CreateBr(getUnwindBlock(ControlStack.size() - Label));
+        }
+        buildPHI(Entry.Type.second, Entry.ReturnPHI);
+        return;
+      }
+      case OpCode::Catch:
+      case OpCode::Catch_all: {
+        auto Entry = leaveBlock();
+        auto *Catch = llvm::BasicBlock::Create(LLContext, "catch", F);
+        Builder.SetInsertPoint(Entry.DispatchBlock);
+        auto *Slot = Builder.CreateConstInBoundsGEP1_64(
+            Context.Int32Ty, ExceptionSlots, NextExceptionSlot++);
+        if (Instr.getOpCode() == OpCode::Catch) {
+          auto *Next = llvm::BasicBlock::Create(LLContext, "catch.next", F);
+          auto *Matched = Builder.CreateCall(
+              Context.getIntrinsic(
+                  Builder, AST::Module::Intrinsics::kCatchTag,
+                  llvm::FunctionType::get(Context.Int32Ty,
+                                          {Context.Int32Ty, Context.Int8PtrTy,
+                                           Context.Int32PtrTy},
+                                          false)),
+              {Builder.getInt32(Instr.getTargetIndex()), ExceptionValues,
+               Slot});
+          Builder.CreateCondBr(
+              Builder.CreateICmpNE(Matched, Builder.getInt32(0)), Catch, Next);
+          Entry.DispatchBlock = Next;
+        } else {
+          Builder.CreateCall(
+              Context.getIntrinsic(
+                  Builder, AST::Module::Intrinsics::kCatchAll,
+                  llvm::FunctionType::get(Context.VoidTy, {Context.Int32PtrTy},
+                                          false)),
+              {Slot});
+          Builder.CreateBr(Catch);
+          Entry.DispatchBlock = nullptr;
+        }
+
+        Builder.SetInsertPoint(Catch);
+        Entry.Type.first.clear();
+        enterBlock(Entry.JumpBlock, nullptr, nullptr, {}, std::move(Entry.Type),
+                   std::move(Entry.ReturnPHI));
+        auto &Handler = ControlStack.back();
+        Handler.DispatchBlock = Entry.DispatchBlock;
+        Handler.ExceptionSlot = Slot;
+        Handler.InCatch = true;
+        if (Instr.getOpCode() == OpCode::Catch) {
+          const auto &TagType = *Context.Tags[Instr.getTargetIndex()];
+          const auto &ParamTypes = TagType.getParamTypes();
+          for (size_t I = 0; I < ParamTypes.size(); ++I) {
+            auto *Ty = toLLVMType(LLContext, ParamTypes[I]);
+            auto *VPtr = Builder.CreateConstInBoundsGEP1_64(
+                Context.Int8Ty, ExceptionValues, I * kValSize);
+            auto *Ptr = Builder.CreateBitCast(VPtr, Ty->getPointerTo());
+            stackPush(Builder.CreateLoad(Ty, Ptr));
+          }
+        }
+        return;
+      }
       case OpCode::Else: {
         auto Entry = leaveBlock();
         Builder.SetInsertPoint(Entry.ElseBlock);
@@ -746,8 +865,20 @@ public:
         auto *Cond = Builder.CreateICmpNE(stackPop(), Builder.getInt32(0));
         setLableJumpPHI(Label);
         auto *Next = llvm::BasicBlock::Create(LLContext, "br_if.end", F);
+        Builder.CreateCondBr(Cond, getLabel(Label), Next,
+                             createBranchHint(LLContext, Instr));
+        Builder.SetInsertPoint(Next);
+        break;
+      }
+      case OpCode::Br_on_null: {
+        const auto Label = Instr.getTargetIndex();
+        auto *Ref = stackPop();
+        auto *Cond = Builder.CreateICmpEQ(Ref, Builder.getInt64(0));
+        setLableJumpPHI(Label);
+        auto *Next = llvm::BasicBlock::Create(LLContext, "br_on_null.end", F);
         Builder.CreateCondBr(Cond, getLabel(Label), Next);
         Builder.SetInsertPoint(Next);
+        stackPush(Ref);
         break;
       }
       case OpCode::Br_table: {
@@ -768,6 +899,47 @@ public:
             llvm::BasicBlock::Create(LLContext, "br_table.end", F));
         break;
       }
+      case OpCode::Throw: {
+        const auto &TagType = *Context.Tags[Instr.getTargetIndex()];
+        const auto ParamSize = TagType.getParamTypes().size();
+        for (size_t I = 0; I < ParamSize; ++I) {
+          const size_t J = ParamSize - 1 - I;
+          auto *Arg = stackPop();
+          auto *Ptr = Builder.CreateConstInBoundsGEP1_64(
+              Context.Int8Ty, ExceptionValues, J * kValSize);
+          Builder.CreateStore(
+              Arg, Builder.CreateBitCast(Ptr, Arg->getType()->getPointerTo()));
+        }
+        updateInstrCount();
+        writeGas();
+        Builder.CreateCall(
+            Context.getIntrinsic(
+                Builder, AST::Module::Intrinsics::kThrow,
+                llvm::FunctionType::get(Context.VoidTy,
+                                        {Context.Int32Ty, Context.Int8PtrTy},
+                                        false)),
+            {Builder.getInt32(Instr.getTargetIndex()), ExceptionValues});
+        Builder.CreateBr(getUnwindBlock(ControlStack.size()));
+        setUnreachable();
+        Builder.SetInsertPoint(
+            llvm::BasicBlock::Create(LLContext, "throw.end", F));
+        break;
+      }
+      case OpCode::Rethrow: {
+        const auto &Handler = *(ControlStack.rbegin() + Instr.getTargetIndex());
+        updateInstrCount();
+        writeGas();
+        Builder.CreateCall(
+            Context.getIntrinsic(Builder, AST::Module::Intrinsics::kRethrow,
+                                 llvm::FunctionType::get(
+                                     Context.VoidTy, {Context.Int32Ty}, false)),
+            {Builder.CreateLoad(Context.Int32Ty, Handler.ExceptionSlot)});
+        Builder.CreateBr(getUnwindBlock(ControlStack.size()));
+        setUnreachable();
+        Builder.SetInsertPoint(
+            llvm::BasicBlock::Create(LLContext, "rethrow.end", F));
+        break;
+      }
       case OpCode::Call:
         updateInstrCount();
         writeGas();
@@ -778,6 +950,11 @@ public:
         writeGas();
         compileIndirectCallOp(Instr.getSourceIndex(), Instr.getTargetIndex());
         break;
+      case OpCode::Call_ref:
+        updateInstrCount();
+        writeGas();
+        compileCallRefOp(Instr.getTargetIndex());
+        break;
       case OpCode::Ref__null:
         stackPush(Builder.getInt64(0));
         break;
@@ -794,6 +971,15 @@ public:
                                                          false)),
             {Builder.getInt32(Instr.getTargetIndex())}));
         break;
+      case OpCode::Ref__as_non_null: {
+        auto *Next =
+            llvm::BasicBlock::Create(LLContext, "ref_as_non_null.ok", F);
+        Builder.CreateCondBr(
+            Builder.CreateICmpNE(Stack.back(), Builder.getInt64(0)), Next,
+            getTrapBB(ErrCode::CastNullToNonNull));
+        Builder.SetInsertPoint(Next);
+        break;
+      }
       case OpCode::Drop:
         stackPop();
         break;
@@ -1959,6 +2145,21 @@ public:
       case OpCode::F64x2__replace_lane:
         compileReplaceLaneOp(Context.Doublex2Ty, Instr.getMemoryLane());
         break;
+      case OpCode::I8x16__relaxed_swizzle:
+#if defined(__x86_64__)
+        if (Context.SupportSSSE3) {
+          // The indices out of range select zero or the lane of the index
+          // modulo 16, both of which are allowed.
+          auto *Index = Builder.CreateBitCast(stackPop(), Context.Int8x16Ty);
+          auto *Vector = Builder.CreateBitCast(stackPop(), Context.Int8x16Ty);
+          stackPush(Builder.CreateBitCast(
+              Builder.CreateIntrinsic(llvm::Intrinsic::x86_ssse3_pshuf_b_128,
+                                      {}, {Vector, Index}),
+              Context.Int64x2Ty));
+          break;
+        }
+#endif
+        [[fallthrough]];
       case OpCode::I8x16__swizzle: {
         auto *Index = Builder.CreateBitCast(stackPop(), Context.Int8x16Ty);
         auto *Vector = Builder.CreateBitCast(stackPop(), Context.Int8x16Ty);
@@ -2694,6 +2895,64 @@ public:
         compileVectorPromote();
         break;
 
+      case OpCode::I32x4__relaxed_trunc_f32x4_s:
+        compileVectorRelaxedTruncS(Context.Floatx4Ty, false);
+        break;
+      case OpCode::I32x4__relaxed_trunc_f32x4_u:
+        compileVectorTruncSatU(Context.Floatx4Ty, 32, false);
+        break;
+      case OpCode::I32x4__relaxed_trunc_f64x2_s_zero:
+        compileVectorRelaxedTruncS(Context.Doublex2Ty, true);
+        break;
+      case OpCode::I32x4__relaxed_trunc_f64x2_u_zero:
+        compileVectorTruncSatU(Context.Doublex2Ty, 32, true);
+        break;
+      case OpCode::F32x4__relaxed_madd:
+        compileVectorRelaxedMAdd(Context.Floatx4Ty, false);
+        break;
+      case OpCode::F32x4__relaxed_nmadd:
+        compileVectorRelaxedMAdd(Context.Floatx4Ty, true);
+        break;
+      case OpCode::F64x2__relaxed_madd:
+        compileVectorRelaxedMAdd(Context.Doublex2Ty, false);
+        break;
+      case OpCode::F64x2__relaxed_nmadd:
+        compileVectorRelaxedMAdd(Context.Doublex2Ty, true);
+        break;
+      case OpCode::I8x16__relaxed_laneselect:
+        compileVectorRelaxedLaneSelect(Context.Int8x16Ty);
+        break;
+      case OpCode::I16x8__relaxed_laneselect:
+        compileVectorRelaxedLaneSelect(Context.Int16x8Ty);
+        break;
+      case OpCode::I32x4__relaxed_laneselect:
+        compileVectorRelaxedLaneSelect(Context.Int32x4Ty);
+        break;
+      case OpCode::I64x2__relaxed_laneselect:
+        compileVectorRelaxedLaneSelect(Context.Int64x2Ty);
+        break;
+      case OpCode::F32x4__relaxed_min:
+        compileVectorVectorRelaxedFMin(Context.Floatx4Ty);
+        break;
+      case OpCode::F32x4__relaxed_max:
+        compileVectorVectorRelaxedFMax(Context.Floatx4Ty);
+        break;
+      case OpCode::F64x2__relaxed_min:
+        compileVectorVectorRelaxedFMin(Context.Doublex2Ty);
+        break;
+      case OpCode::F64x2__relaxed_max:
+        compileVectorVectorRelaxedFMax(Context.Doublex2Ty);
+        break;
+      case OpCode::I16x8__relaxed_q15mulr_s:
+        compileVectorVectorRelaxedQ15Mul();
+        break;
+      case OpCode::I16x8__relaxed_dot_i8x16_i7x16_s:
+        compileVectorVectorRelaxedDot();
+        break;
+      case OpCode::I32x4__relaxed_dot_i8x16_i7x16_add_s:
+        compileVectorVectorRelaxedDotAdd();
+        break;
+
       default:
         assumingUnreachable();
       }
@@ -2715,7 +2974,8 @@ public:
                                Builder.CreateConstInBoundsGEP2_64(
                                    Context.Int64PtrTy,
                                    Context.getCostTable(Builder, ExecCtx), 0,
-                                   uint16_t(Instr.getOpCode()))));
+                                   Statistics::getCostTableIndex(
+                                       Instr.getOpCode()))));
         Builder.CreateStore(NewGas, LocalGas);
       }
 
@@ -2879,6 +3139,7 @@ public:
   void compileReturn() {
     updateInstrCount();
     writeGas();
+    releaseExceptions();
     auto *Ty = F->getReturnType();
     if (Ty->isVoidTy()) {
       Builder.CreateRetVoid();
@@ -2949,11 +3210,35 @@ private:
     }
 
     readGas();
+    checkException();
   }
 
   void compileIndirectCallOp(const uint32_t TableIndex,
                              const uint32_t FuncTypeIndex) {
     llvm::Value *FuncIndex = stackPop();
+    compileProxyCallOp(FuncTypeIndex, AST::Module::Intrinsics::kCallIndirect,
+                       {Context.Int32Ty, Context.Int32Ty, Context.Int32Ty},
+                       {Builder.getInt32(TableIndex),
+                        Builder.getInt32(FuncTypeIndex), FuncIndex});
+  }
+
+  void compileCallRefOp(const uint32_t FuncTypeIndex) {
+    llvm::Value *Ref = stackPop();
+    auto *NotNull = llvm::BasicBlock::Create(LLContext, "call_ref.ok", F);
+    Builder.CreateCondBr(Builder.CreateICmpNE(Ref, Builder.getInt64(0)),
+                         NotNull, getTrapBB(ErrCode::AccessNullFunc));
+    Builder.SetInsertPoint(NotNull);
+    compileProxyCallOp(FuncTypeIndex, AST::Module::Intrinsics::kCallRef,
+                       {Context.Int32Ty, Context.Int64Ty},
+                       {Builder.getInt32(FuncTypeIndex), Ref});
+  }
+
+  /// Call the function through an intrinsic with the arguments and the
+  /// results in the buffers, which are appended to the intrinsic arguments.
+  void compileProxyCallOp(const uint32_t FuncTypeIndex,
+                          AST::Module::Intrinsics Intrinsic,
+                          std::vector<llvm::Type *> IntrinsicArgTypes,
+                          std::vector<llvm::Value *> IntrinsicArgs) {
     const auto &FuncType = *Context.FunctionTypes[FuncTypeIndex];
     auto *FTy = toLLVMType(Context.ExecCtxPtrTy, FuncType);
     auto *RTy = FTy->getReturnType();
@@ -2991,16 +3276,15 @@ private:
           Arg, Builder.CreateBitCast(Ptr, Arg->getType()->getPointerTo()));
     }
 
+    IntrinsicArgTypes.push_back(Context.Int8PtrTy);
+    IntrinsicArgTypes.push_back(Context.Int8PtrTy);
+    IntrinsicArgs.push_back(Args);
+    IntrinsicArgs.push_back(Rets);
     Builder.CreateCall(
-        Context.getIntrinsic(
-            Builder, AST::Module::Intrinsics::kCallIndirect,
-            llvm::FunctionType::get(Context.VoidTy,
-                                    {Context.Int32Ty, Context.Int32Ty,
-                                     Context.Int32Ty, Context.Int8PtrTy,
-                                     Context.Int8PtrTy},
-                                    false)),
-        {Builder.getInt32(TableIndex), Builder.getInt32(FuncTypeIndex),
-         FuncIndex, Args, Rets});
+        Context.getIntrinsic(Builder, Intrinsic,
+                             llvm::FunctionType::get(
+                                 Context.VoidTy, IntrinsicArgTypes, false)),
+        IntrinsicArgs);
 
     if (RetSize == 0) {
       // nothing to do
@@ -3019,6 +3303,7 @@ private:
     }
 
     readGas();
+    checkException();
   }
 
   void compileLoadOp(unsigned MemoryIndex, unsigned Offset, unsigned Alignment,
@@ -3616,6 +3901,189 @@ private:
       return Builder.CreateSelect(Cmp, RHS, LHS);
     });
   }
+  void compileVectorVectorRelaxedFMin(llvm::VectorType *VectorTy) {
+    compileVectorVectorOp(
+        VectorTy, [this, VectorTy](auto *LHS, auto *RHS) -> llvm::Value * {
+#if defined(__x86_64__)
+          if (Context.SupportSSE2) {
+            const auto ID = VectorTy == Context.Floatx4Ty
+                                ? llvm::Intrinsic::x86_sse_min_ps
+                                : llvm::Intrinsic::x86_sse2_min_pd;
+            return Builder.CreateIntrinsic(ID, {}, {LHS, RHS});
+          }
+#endif
+
+#if defined(__aarch64__)
+          if (Context.SupportNEON) {
+            return Builder.CreateBinaryIntrinsic(
+                llvm::Intrinsic::aarch64_neon_fmin, LHS, RHS);
+          }
+#endif
+
+          auto *Cmp = Builder.CreateFCmpOLT(RHS, LHS);
+          return Builder.CreateSelect(Cmp, RHS, LHS);
+        });
+  }
+  void compileVectorVectorRelaxedFMax(llvm::VectorType *VectorTy) {
+    compileVectorVectorOp(
+        VectorTy, [this, VectorTy](auto *LHS, auto *RHS) -> llvm::Value * {
+#if defined(__x86_64__)
+          if (Context.SupportSSE2) {
+            const auto ID = VectorTy == Context.Floatx4Ty
+                                ? llvm::Intrinsic::x86_sse_max_ps
+                                : llvm::Intrinsic::x86_sse2_max_pd;
+            return Builder.CreateIntrinsic(ID, {}, {LHS, RHS});
+          }
+#endif
+
+#if defined(__aarch64__)
+          if (Context.SupportNEON) {
+            return Builder.CreateBinaryIntrinsic(
+                llvm::Intrinsic::aarch64_neon_fmax, LHS, RHS);
+          }
+#endif
+
+          auto *Cmp = Builder.CreateFCmpOGT(RHS, LHS);
+          return Builder.CreateSelect(Cmp, RHS, LHS);
+        });
+  }
+  void compileVectorVectorRelaxedQ15Mul() {
+#if defined(__x86_64__)
+    if (Context.SupportSSSE3) {
+      // Only 0x8000 * 0x8000 overflows, into 0x8000, which is allowed.
+      compileVectorVectorOp(Context.Int16x8Ty, [this](auto *LHS, auto *RHS) {
+        return Builder.CreateIntrinsic(
+            llvm::Intrinsic::x86_ssse3_pmul_hr_sw_128, {}, {LHS, RHS});
+      });
+      return;
+    }
+#endif
+    compileVectorVectorQ15MulSat();
+  }
+  void compileVectorVectorRelaxedDot() {
+    compileVectorVectorOp(
+        Context.Int8x16Ty, [this](auto *LHS, auto *RHS) -> llvm::Value * {
+#if defined(__x86_64__)
+          if (Context.SupportSSSE3) {
+            // The second operand is taken as unsigned, and the sums are
+            // saturated, both of which are allowed.
+            return Builder.CreateIntrinsic(
+                llvm::Intrinsic::x86_ssse3_pmadd_ub_sw_128, {}, {RHS, LHS});
+          }
+#endif
+
+          auto *ExtendTy =
+              llvm::VectorType::getExtendedElementVectorType(Context.Int8x16Ty);
+          auto *Undef = llvm::UndefValue::get(ExtendTy);
+          auto *M = Builder.CreateMul(Builder.CreateSExt(LHS, ExtendTy),
+                                      Builder.CreateSExt(RHS, ExtendTy));
+          auto *L = Builder.CreateShuffleVector(
+              M, Undef,
+              std::array<ShuffleElement, 8>{0, 2, 4, 6, 8, 10, 12, 14});
+          auto *R = Builder.CreateShuffleVector(
+              M, Undef,
+              std::array<ShuffleElement, 8>{1, 3, 5, 7, 9, 11, 13, 15});
+          return Builder.CreateAdd(L, R);
+        });
+  }
+  void compileVectorVectorRelaxedDotAdd() {
+    auto *C = Builder.CreateBitCast(stackPop(), Context.Int32x4Ty);
+    auto *RHS = Builder.CreateBitCast(stackPop(), Context.Int8x16Ty);
+    auto *LHS = Builder.CreateBitCast(stackPop(), Context.Int8x16Ty);
+
+#if defined(__x86_64__)
+    if (Context.SupportVNNI) {
+      stackPush(Builder.CreateBitCast(
+          Builder.CreateIntrinsic(
+              llvm::Intrinsic::x86_avx512_vpdpbusd_128, {},
+              {C, Builder.CreateBitCast(RHS, Context.Int32x4Ty),
+               Builder.CreateBitCast(LHS, Context.Int32x4Ty)}),
+          Context.Int64x2Ty));
+      return;
+    }
+    if (Context.SupportSSSE3) {
+      auto *Dot = Builder.CreateIntrinsic(
+          llvm::Intrinsic::x86_ssse3_pmadd_ub_sw_128, {}, {RHS, LHS});
+      auto *One = Builder.CreateVectorSplat(8, Builder.getInt16(1));
+      auto *Sum = Builder.CreateIntrinsic(llvm::Intrinsic::x86_sse2_pmadd_wd,
+                                          {}, {Dot, One});
+      stackPush(Builder.CreateBitCast(Builder.CreateAdd(Sum, C),
+                                      Context.Int64x2Ty));
+      return;
+    }
+#endif
+
+    auto *ExtendTy = llvm::VectorType::get(Context.Int32Ty, 16, false);
+    auto *Undef = llvm::UndefValue::get(ExtendTy);
+    auto *M = Builder.CreateMul(Builder.CreateSExt(LHS, ExtendTy),
+                                Builder.CreateSExt(RHS, ExtendTy));
+    llvm::Value *Sum = C;
+    for (ShuffleElement I = 0; I < 4; ++I) {
+      Sum = Builder.CreateAdd(
+          Sum, Builder.CreateShuffleVector(
+                   M, Undef,
+                   std::array<ShuffleElement, 4>{I, I + 4, I + 8, I + 12}));
+    }
+    stackPush(Builder.CreateBitCast(Sum, Context.Int64x2Ty));
+  }
+  void compileVectorRelaxedMAdd(llvm::VectorType *VectorTy, bool Negate) {
+    auto *C = Builder.CreateBitCast(stackPop(), VectorTy);
+    auto *B = Builder.CreateBitCast(stackPop(), VectorTy);
+    auto *A = Builder.CreateBitCast(stackPop(), VectorTy);
+    if (Negate) {
+      A = Builder.CreateFNeg(A);
+    }
+    // Fused into one instruction if the target has FMA.
+    stackPush(Builder.CreateBitCast(
+        Builder.CreateIntrinsic(llvm::Intrinsic::fmuladd, {VectorTy},
+                                {A, B, C}),
+        Context.Int64x2Ty));
+  }
+  void compileVectorRelaxedLaneSelect(llvm::VectorType *VectorTy) {
+#if defined(__x86_64__)
+    // The blend instructions select by the top bit of each lane, which is
+    // allowed for the masks other than all ones or all zeros. There is no
+    // blend instruction of 16-bit lanes.
+    if (Context.SupportSSE4_1 && VectorTy != Context.Int16x8Ty) {
+      llvm::VectorType *BlendTy = Context.Int8x16Ty;
+      auto ID = llvm::Intrinsic::x86_sse41_pblendvb;
+      if (VectorTy == Context.Int32x4Ty) {
+        BlendTy = Context.Floatx4Ty;
+        ID = llvm::Intrinsic::x86_sse41_blendvps;
+      } else if (VectorTy == Context.Int64x2Ty) {
+        BlendTy = Context.Doublex2Ty;
+        ID = llvm::Intrinsic::x86_sse41_blendvpd;
+      }
+      auto *C = Builder.CreateBitCast(stackPop(), BlendTy);
+      auto *V2 = Builder.CreateBitCast(stackPop(), BlendTy);
+      auto *V1 = Builder.CreateBitCast(stackPop(), BlendTy);
+      stackPush(Builder.CreateBitCast(
+          Builder.CreateIntrinsic(ID, {}, {V2, V1, C}), Context.Int64x2Ty));
+      return;
+    }
+#endif
+    static_cast<void>(VectorTy);
+
+    auto *C = stackPop();
+    auto *V2 = stackPop();
+    auto *V1 = stackPop();
+    stackPush(Builder.CreateXor(
+        Builder.CreateAnd(Builder.CreateXor(V1, V2), C), V2));
+  }
+  void compileVectorRelaxedTruncS(llvm::VectorType *VectorTy, bool PadZero) {
+#if defined(__x86_64__)
+    if (Context.SupportSSE2) {
+      // The lanes out of range or NaN are INT32_MIN, which is allowed.
+      const auto ID = PadZero ? llvm::Intrinsic::x86_sse2_cvttpd2dq
+                              : llvm::Intrinsic::x86_sse2_cvttps2dq;
+      compileVectorOp(VectorTy, [this, ID](auto *V) {
+        return Builder.CreateIntrinsic(ID, {}, {V});
+      });
+      return;
+    }
+#endif
+    compileVectorTruncSatS(VectorTy, 32, PadZero);
+  }
   void compileVectorTruncSatS(llvm::VectorType *VectorTy, unsigned IntWidth,
                               bool PadZero) {
     compileVectorOp(VectorTy, [this, VectorTy, IntWidth, PadZero](auto *V) {
@@ -3781,6 +4249,130 @@ private:
     Builder.SetInsertPoint(NotStopBB);
   }
 
+  void checkCPUTime() {
+    // Reading the CPU clock is a system call, so the loops only count down
+    // and call into the executor when the countdown reaches zero.
+    if (!Interruptible && !LocalGas) {
+      return;
+    }
+    auto *CheckBB = llvm::BasicBlock::Create(LLContext, "cputime.check", F);
+    auto *OkBB = llvm::BasicBlock::Create(LLContext, "cputime.ok", F);
+    auto *Ptr = Context.getCPUTimeCountdown(Builder, ExecCtx);
+    auto *Countdown = Builder.CreateSub(
+        Builder.CreateLoad(Context.Int32Ty, Ptr), Builder.getInt32(1));
+    Builder.CreateStore(Countdown, Ptr);
+    auto *NotZero = createLikely(
+        Builder, Builder.CreateICmpNE(Countdown, Builder.getInt32(0)));
+    Builder.CreateCondBr(NotZero, OkBB, CheckBB);
+
+    Builder.SetInsertPoint(CheckBB);
+    updateInstrCount();
+    writeGas();
+    Builder.CreateCall(Context.getIntrinsic(
+        Builder, AST::Module::Intrinsics::kCheckCPUTime,
+        llvm::FunctionType::get(Context.VoidTy, {}, false)));
+    Builder.CreateBr(OkBB);
+
+    Builder.SetInsertPoint(OkBB);
+  }
+
+  /// Allocate the buffer of the exception values and the slots of the caught
+  /// exceptions in the entry block.
+  void prepareExceptions(AST::InstrView Instrs) {
+    size_t MaxParamSize = 0;
+    for (const auto &Instr : Instrs) {
+      switch (Instr.getOpCode()) {
+      case OpCode::Catch:
+      case OpCode::Throw:
+        MaxParamSize = std::max(
+            MaxParamSize,
+            Context.Tags[Instr.getTargetIndex()]->getParamTypes().size());
+        if (Instr.getOpCode() == OpCode::Throw) {
+          break;
+        }
+        [[fallthrough]];
+      case OpCode::Catch_all:
+        ++ExceptionSlotsN;
+        break;
+      default:
+        break;
+      }
+    }
+    if (MaxParamSize == 0) {
+      ExceptionValues = llvm::ConstantPointerNull::get(Context.Int8PtrTy);
+    } else {
+      auto *Alloca = Builder.CreateAlloca(
+          Context.Int8Ty, Builder.getInt64(MaxParamSize * kValSize));
+      Alloca->setAlignment(Align(kValSize));
+      ExceptionValues = Alloca;
+    }
+    if (ExceptionSlotsN > 0) {
+      ExceptionSlots = Builder.CreateAlloca(Context.Int32Ty,
+                                            Builder.getInt32(ExceptionSlotsN));
+      for (uint32_t I = 0; I < ExceptionSlotsN; ++I) {
+        Builder.CreateStore(
+            Builder.getInt32(UINT32_MAX),
+            Builder.CreateConstInBoundsGEP1_64(Context.Int32Ty, ExceptionSlots,
+                                               I));
+      }
+    }
+  }
+
+  /// Release the caught exceptions of the function before returning.
+  void releaseExceptions() {
+    if (ExceptionSlotsN == 0) {
+      return;
+    }
+    Builder.CreateCall(
+        Context.getIntrinsic(
+            Builder, AST::Module::Intrinsics::kReleaseExceptions,
+            llvm::FunctionType::get(Context.VoidTy,
+                                    {Context.Int32PtrTy, Context.Int32Ty},
+                                    false)),
+        {ExceptionSlots, Builder.getInt32(ExceptionSlotsN)});
+  }
+
+  /// Get the block to handle the exception thrown under the first Count
+  /// control frames, which is the dispatch block of the innermost try-block,
+  /// or the block returning to the caller with the pending exception.
+  llvm::BasicBlock *getUnwindBlock(size_t Count) {
+    assuming(Count <= ControlStack.size());
+    for (size_t I = Count; I > 0; --I) {
+      const auto &Entry = ControlStack[I - 1];
+      if (Entry.DispatchBlock && !Entry.InCatch) {
+        return Entry.DispatchBlock;
+      }
+    }
+    if (!PropagateBB) {
+      llvm::IRBuilderBase::InsertPointGuard Guard(Builder);
+      PropagateBB = llvm::BasicBlock::Create(LLContext, "propagate", F);
+      Builder.SetInsertPoint(PropagateBB);
+      releaseExceptions();
+      auto *Ty = F->getReturnType();
+      if (Ty->isVoidTy()) {
+        Builder.CreateRetVoid();
+      } else {
+        Builder.CreateRet(llvm::UndefValue::get(Ty));
+      }
+    }
+    return PropagateBB;
+  }
+
+  /// Check the pending exception after calls, which is thrown by the callee.
+  void checkException() {
+    if (!ExceptionHandling) {
+      return;
+    }
+    auto *NoException = llvm::BasicBlock::Create(LLContext, "call.ok", F);
+    auto *Pending = Builder.CreateLoad(
+        Context.Int32Ty, Context.getPendingException(Builder, ExecCtx));
+    Builder.CreateCondBr(
+        createLikely(Builder,
+                     Builder.CreateICmpEQ(Pending, Builder.getInt32(0))),
+        NoException, getUnwindBlock(ControlStack.size()));
+    Builder.SetInsertPoint(NoException);
+  }
+
   void setUnreachable() { IsUnreachable = true; }
 
   void clearUnreachable() { IsUnreachable = false; }
@@ -3871,7 +4463,13 @@ private:
   std::unordered_map<ErrCode, llvm::BasicBlock *> TrapBB;
   bool IsUnreachable = false;
   bool Interruptible = false;
+  bool ExceptionHandling = false;
   bool OptNone = false;
+  llvm::Value *ExceptionValues = nullptr;
+  llvm::Value *ExceptionSlots = nullptr;
+  uint32_t ExceptionSlotsN = 0;
+  uint32_t NextExceptionSlot = 0;
+  llvm::BasicBlock *PropagateBB = nullptr;
   struct Control {
     size_t StackSize;
     llvm::BasicBlock *JumpBlock;
@@ -3881,6 +4479,12 @@ private:
     std::pair<std::vector<ValType>, std::vector<ValType>> Type;
     std::vector<std::tuple<std::vector<llvm::Value *>, llvm::BasicBlock *>>
         ReturnPHI;
+    /// The dispatch block of the try-block, or the block testing the next
+    /// catch clause in the handlers.
+    llvm::BasicBlock *DispatchBlock = nullptr;
+    /// The slot of the exception caught by the handler for rethrowing.
+    llvm::Value *ExceptionSlot = nullptr;
+    bool InCatch = false;
     Control(
         size_t S, llvm::BasicBlock *J, llvm::BasicBlock *N, llvm::BasicBlock *E,
         std::vector<llvm::Value *> A,
@@ -3917,6 +4521,20 @@ static llvm::Value *createLikely(llvm::IRBuilder<> &Builder,
                                        Builder.getTrue());
 }
 
+// Branch weights of the taken and not taken branches from the branch hint
+// section, or nullptr if not hinted.
+static llvm::MDNode *createBranchHint(llvm::LLVMContext &LLContext,
+                                      const WasmEdge::AST::Instruction &Instr) {
+  if (!Instr.hasBranchHint()) {
+    return nullptr;
+  }
+  // The same weights as `__builtin_expect` in clang.
+  const uint32_t Likely = 2000, Unlikely = 1;
+  llvm::MDBuilder MDB(LLContext);
+  return Instr.isBranchLikely() ? MDB.createBranchWeights(Likely, Unlikely)
+                                : MDB.createBranchWeights(Unlikely, Likely);
+}
+
 // Write output object and link
 Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
                                  const llvm::SmallString<0> &OSVec) {
@@ -4015,6 +4633,16 @@ Expect<void> outputNativeLibrary(const std::filesystem::path &OutputPath,
   return {};
 }
 
+/// Check the section is the unwind table for registering to the unwinder.
+bool isEHFrameSection(const llvm::object::SectionRef &Section) noexcept {
+  if (auto Name = Section.getName(); unlikely(!Name)) {
+    llvm::consumeError(Name.takeError());
+    return false;
+  } else {
+    return *Name == ".eh_frame" || *Name == "__eh_frame";
+  }
+}
+
 Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
                                Span<const Byte> Data,
                                const llvm::SmallString<0> &OSVec) {
@@ -4171,7 +4799,8 @@ Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
       if (auto Res = Section.getContents(); unlikely(!Res)) {
         continue;
       }
-      if (!Section.isText() && !Section.isData() && !Section.isBSS()) {
+      if (!Section.isText() && !Section.isData() && !Section.isBSS() &&
+          !isEHFrameSection(Section)) {
         continue;
       }
       ++SectionCount;
@@ -4189,6 +4818,8 @@ Expect<void> outputWasmLibrary(const std::filesystem::path &OutputPath,
       }
       if (Section.isText()) {
         WriteByte(OS, UINT8_C(1));
+      } else if (isEHFrameSection(Section)) {
+        WriteByte(OS, UINT8_C(4));
       } else if (Section.isData()) {
         WriteByte(OS, UINT8_C(2));
       } else if (Section.isBSS()) {
@@ -4229,6 +4860,7 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
   using namespace std::literals;
 
   spdlog::info("compile start");
+
   std::filesystem::path LLPath(OutputPath);
   LLPath.replace_extension("ll"sv);
 
@@ -4259,6 +4891,8 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
   compile(Module.getTypeSection());
   // Compile ImportSection
   compile(Module.getImportSection());
+  // Compile TagSection
+  compile(Module.getTagSection());
   // Compile GlobalSection
   compile(Module.getGlobalSection());
   // Compile MemorySection (MemorySec, DataSec)
@@ -4286,6 +4920,39 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
     new llvm::GlobalVariable(
         LLModule, Int32Ty, false, llvm::GlobalValue::ExternalLinkage,
         llvm::ConstantInt::get(Int32Ty, Data.size()), "wasm.size");
+
+    // create types and codes tables, so the loader resolves all the function
+    // pointers with one symbol lookup for each table
+    auto *Int8PtrTy = Context->Int8PtrTy;
+    std::vector<llvm::Constant *> Types;
+    Types.reserve(Context->FunctionWrappers.size());
+    for (auto *F : Context->FunctionWrappers) {
+      Types.push_back(llvm::ConstantExpr::getBitCast(F, Int8PtrTy));
+    }
+    std::vector<llvm::Constant *> Codes;
+    Codes.reserve(Context->Functions.size());
+    for (const auto &Function : Context->Functions) {
+      if (std::get<2>(Function)) {
+        Codes.push_back(
+            llvm::ConstantExpr::getBitCast(std::get<1>(Function), Int8PtrTy));
+      }
+    }
+    auto *TypesTy = llvm::ArrayType::get(Int8PtrTy, Types.size());
+    new llvm::GlobalVariable(LLModule, TypesTy, true,
+                             llvm::GlobalValue::ExternalLinkage,
+                             llvm::ConstantArray::get(TypesTy, Types), "types");
+    auto *CodesTy = llvm::ArrayType::get(Int8PtrTy, Codes.size());
+    new llvm::GlobalVariable(LLModule, CodesTy, true,
+                             llvm::GlobalValue::ExternalLinkage,
+                             llvm::ConstantArray::get(CodesTy, Codes), "codes");
+    // and their lengths, so the loader never reads past the end of a table
+    // that does not belong to the embedded wasm.
+    new llvm::GlobalVariable(
+        LLModule, Int32Ty, true, llvm::GlobalValue::ExternalLinkage,
+        llvm::ConstantInt::get(Int32Ty, Types.size()), "types.size");
+    new llvm::GlobalVariable(
+        LLModule, Int32Ty, true, llvm::GlobalValue::ExternalLinkage,
+        llvm::ConstantInt::get(Int32Ty, Codes.size()), "codes.size");
   }
 
   // set dllexport
@@ -4296,6 +4963,20 @@ Expect<void> Compiler::compile(Span<const Byte> Data, const AST::Module &Module,
     }
   }
 
+  // Keep the frame pointers and the unwind tables, so profilers and debuggers
+  // can walk through the compiled functions to the host callers.
+  for (auto &F : LLModule.functions()) {
+    if (F.isDeclaration()) {
+      continue;
+    }
+    F.addFnAttr("frame-pointer", "all");
+#if LLVM_VERSION_MAJOR >= 15
+    F.setUWTableKind(llvm::UWTableKind::Async);
+#else
+    F.addFnAttr(llvm::Attribute::UWTable);
+#endif
+  }
+
   if (Conf.getCompilerConfigure().isDumpIR()) {
     int Fd;
     llvm::sys::fs::openFileForWrite("wasm.ll", Fd);
@@ -4645,12 +5326,27 @@ void Compiler::compile(const AST::ImportSection &ImportSec) {
       Context->Globals.push_back(Type);
       break;
     }
+    case ExternalType::Tag: // Tag type
+    {
+      // Get tag type index. External type checked in validation.
+      uint32_t TypeIdx = ImpDesc.getExternalTagTypeIdx();
+      assuming(TypeIdx < Context->FunctionTypes.size());
+      Context->Tags.push_back(Context->FunctionTypes[TypeIdx]);
+      break;
+    }
     default:
       break;
     }
   }
 }
 
+void Compiler::compile(const AST::TagSection &TagSec) {
+  for (const auto &TypeIdx : TagSec.getContent()) {
+    assuming(TypeIdx < Context->FunctionTypes.size());
+    Context->Tags.push_back(Context->FunctionTypes[TypeIdx]);
+  }
+}
+
 void Compiler::compile(const AST::ExportSection &) {}
 
 void Compiler::compile(const AST::GlobalSection &GlobalSec) {
@@ -4706,6 +5402,7 @@ void Compiler::compile(const AST::FunctionSection &FuncSec,
                         Conf.getCompilerConfigure().isInterruptible(),
                         Conf.getStatisticsConfigure().isInstructionCounting(),
                         Conf.getStatisticsConfigure().isCostMeasuring(),
+                        Conf.hasProposal(Proposal::ExceptionHandling),
                         Conf.getCompilerConfigure().getOptimizationLevel() ==
                             CompilerConfigure::OptimizationLevel::O0);
     auto Type = Context->resolveBlockType(T);
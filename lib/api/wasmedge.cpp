@@ -5,6 +5,7 @@
 
 #include "aot/compiler.h"
 #include "host/wasi/wasimodule.h"
+#include "host/wasmedge_memory/memorymodule.h"
 #include "host/wasmedge_process/processmodule.h"
 #include "vm/vm.h"
 
@@ -16,11 +17,20 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#if WASMEDGE_OS_LINUX
+#include <sys/eventfd.h>
+#include <unistd.h>
+#elif WASMEDGE_OS_MACOS
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // WasmEdge_ConfigureContext implementation.
 struct WasmEdge_ConfigureContext {
   WasmEdge::Configure Conf;
@@ -114,6 +124,32 @@ struct WasmEdge_Async {
   WasmEdge::VM::Async<WasmEdge::Expect<
       std::vector<std::pair<WasmEdge::ValVariant, WasmEdge::ValType>>>>
       Async;
+  // The file descriptors becoming readable after the execution finished. The
+  // completion callback shares the ownership to keep them open until written.
+  struct NotifyFd {
+    ~NotifyFd() noexcept {
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+      if (ReadFd >= 0) {
+        ::close(ReadFd);
+      }
+      if (WriteFd >= 0 && WriteFd != ReadFd) {
+        ::close(WriteFd);
+      }
+#endif
+    }
+    void notify() const noexcept {
+#if WASMEDGE_OS_LINUX
+      [[maybe_unused]] auto Res = ::eventfd_write(WriteFd, 1);
+#elif WASMEDGE_OS_MACOS
+      const uint8_t Byte = 0;
+      [[maybe_unused]] auto Res = ::write(WriteFd, &Byte, 1);
+#endif
+    }
+    int ReadFd = -1;
+    int WriteFd = -1;
+  };
+  std::once_flag FdFlag;
+  std::shared_ptr<NotifyFd> Fd;
 };
 
 // WasmEdge_VMContext implementation.
@@ -296,17 +332,17 @@ class CAPIHostFunc : public Runtime::HostFunctionBase {
 public:
   CAPIHostFunc(const AST::FunctionType *Type, WasmEdge_HostFunc_t FuncPtr,
                void *ExtData, const uint64_t FuncCost = 0) noexcept
-      : Runtime::HostFunctionBase(FuncCost), Func(FuncPtr), Wrap(nullptr),
-        Binding(nullptr), Data(ExtData) {
-    FuncType = *Type;
-  }
+      : Runtime::HostFunctionBase(FuncCost, FuncType),
+        FuncType(Type->getParamTypes(), Type->getReturnTypes(),
+                 Type->getSymbol()),
+        Func(FuncPtr), Wrap(nullptr), Binding(nullptr), Data(ExtData) {}
   CAPIHostFunc(const AST::FunctionType *Type, WasmEdge_WrapFunc_t WrapPtr,
                void *BindingPtr, void *ExtData,
                const uint64_t FuncCost = 0) noexcept
-      : Runtime::HostFunctionBase(FuncCost), Func(nullptr), Wrap(WrapPtr),
-        Binding(BindingPtr), Data(ExtData) {
-    FuncType = *Type;
-  }
+      : Runtime::HostFunctionBase(FuncCost, FuncType),
+        FuncType(Type->getParamTypes(), Type->getReturnTypes(),
+                 Type->getSymbol()),
+        Func(nullptr), Wrap(WrapPtr), Binding(BindingPtr), Data(ExtData) {}
   ~CAPIHostFunc() noexcept override = default;
 
   Expect<void> run(Runtime::Instance::MemoryInstance *MemInst,
@@ -342,6 +378,11 @@ public:
   }
 
 private:
+  /// The function type owned by this host function. The base class only keeps
+  /// the reference to it.
+  /// The host functions cannot promise the typed references, so the function
+  /// type is copied without them.
+  const AST::FunctionType FuncType;
   WasmEdge_HostFunc_t Func;
   WasmEdge_WrapFunc_t Wrap;
   void *Binding;
@@ -366,6 +407,7 @@ CONVTO(ImpType, AST::ImportDesc, ImportType, const)
 CONVTO(ExpType, AST::ExportDesc, ExportType, const)
 CONVTO(Store, Runtime::StoreManager, Store, )
 CONVTO(Func, Runtime::Instance::FunctionInstance, FunctionInstance, )
+CONVTO(Func, Runtime::Instance::FunctionInstance, FunctionInstance, const)
 CONVTO(Tab, Runtime::Instance::TableInstance, TableInstance, )
 CONVTO(Mem, Runtime::Instance::MemoryInstance, MemoryInstance, )
 CONVTO(Glob, Runtime::Instance::GlobalInstance, GlobalInstance, )
@@ -403,6 +445,25 @@ CONVFROM(ImpObj, Runtime::ImportObject, ImportObject, )
 CONVFROM(ImpObj, Runtime::ImportObject, ImportObject, const)
 #undef CONVFROM
 
+// Helper function for wrapping the WASI stdio callbacks. The negative return
+// value of the callback is converted into the I/O error.
+template <typename T, typename FuncT>
+inline std::function<Host::WASI::WasiExpect<__wasi_size_t>(Span<T>)>
+genWASIStream(FuncT Func, void *Data) noexcept {
+  if (!Func) {
+    return {};
+  }
+  return [Func, Data](Span<T> Buf) -> Host::WASI::WasiExpect<__wasi_size_t> {
+    const int64_t Res =
+        Func(Data, Buf.data(), static_cast<uint32_t>(Buf.size()));
+    if (Res < 0) {
+      return Host::WASI::WasiUnexpect(__WASI_ERRNO_IO);
+    }
+    return static_cast<__wasi_size_t>(
+        std::min(static_cast<uint64_t>(Res), uint64_t(Buf.size())));
+  };
+}
+
 } // namespace
 
 #ifdef __cplusplus
@@ -472,7 +533,14 @@ WasmEdge_ValueGenNullRef(const WasmEdge_RefType T) {
 
 WASMEDGE_CAPI_EXPORT WasmEdge_Value
 WasmEdge_ValueGenFuncRef(const uint32_t Index) {
-  return genWasmEdge_Value(WasmEdge::FuncRef(Index), WasmEdge_ValType_FuncRef);
+  return genWasmEdge_Value(WasmEdge::FuncRef::fromAddr(Index),
+                           WasmEdge_ValType_FuncRef);
+}
+
+WASMEDGE_CAPI_EXPORT WasmEdge_Value WasmEdge_ValueGenFuncRefFromInstance(
+    const WasmEdge_FunctionInstanceContext *Cxt) {
+  return genWasmEdge_Value(WasmEdge::FuncRef(fromFuncCxt(Cxt)),
+                           WasmEdge_ValType_FuncRef);
 }
 
 WASMEDGE_CAPI_EXPORT WasmEdge_Value WasmEdge_ValueGenExternRef(void *Ref) {
@@ -518,8 +586,24 @@ WASMEDGE_CAPI_EXPORT bool WasmEdge_ValueIsNullRef(const WasmEdge_Value Val) {
 
 WASMEDGE_CAPI_EXPORT uint32_t
 WasmEdge_ValueGetFuncIdx(const WasmEdge_Value Val) {
-  return WasmEdge::retrieveFuncIdx(WasmEdge::ValVariant::wrap<FuncRef>(
-      to_WasmEdge_128_t<WasmEdge::uint128_t>(Val.Value)));
+  const auto Ref = WasmEdge::ValVariant::wrap<FuncRef>(
+                       to_WasmEdge_128_t<WasmEdge::uint128_t>(Val.Value))
+                       .get<FuncRef>();
+  if (Ref.isAddr()) {
+    return Ref.getAddr();
+  }
+  return Ref.Ptr ? Ref.Ptr->Addr : 0U;
+}
+
+WASMEDGE_CAPI_EXPORT const WasmEdge_FunctionInstanceContext *
+WasmEdge_ValueGetFuncRef(const WasmEdge_Value Val) {
+  const auto Ref = WasmEdge::ValVariant::wrap<FuncRef>(
+                       to_WasmEdge_128_t<WasmEdge::uint128_t>(Val.Value))
+                       .get<FuncRef>();
+  if (Ref.isAddr()) {
+    return nullptr;
+  }
+  return toFuncCxt(Ref.Ptr);
 }
 
 WASMEDGE_CAPI_EXPORT void *
@@ -882,6 +966,73 @@ WasmEdge_StatisticsSetCostLimit(WasmEdge_StatisticsContext *Cxt,
   }
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_StatisticsSetHostCostModel(WasmEdge_StatisticsContext *Cxt,
+                                    WasmEdge_HostCostModel_t Func, void *Data) {
+  if (Cxt) {
+    WasmEdge::Statistics::HostCostModel Model;
+    if (Func) {
+      Model = [Func, Data](WasmEdge::HostWork Kind, uint64_t Amount) {
+        return Func(Data, static_cast<WasmEdge_HostWork>(Kind), Amount);
+      };
+    }
+    fromStatCxt(Cxt)->setHostCostModel(std::move(Model));
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t
+WasmEdge_StatisticsGetHostWorkCount(const WasmEdge_StatisticsContext *Cxt,
+                                    const enum WasmEdge_HostWork Kind) {
+  if (Cxt && static_cast<uint8_t>(Kind) <
+                 static_cast<uint8_t>(WasmEdge::HostWork::Max)) {
+    return fromStatCxt(Cxt)->getHostWorkCount(
+        static_cast<WasmEdge::HostWork>(Kind));
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_StatisticsSetCPUTimeMeasuring(WasmEdge_StatisticsContext *Cxt,
+                                       const bool IsMeasure) {
+  if (Cxt) {
+    fromStatCxt(Cxt)->setCPUTimeMeasuring(IsMeasure);
+  }
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t
+WasmEdge_StatisticsGetWasmCPUTime(const WasmEdge_StatisticsContext *Cxt) {
+  if (Cxt) {
+    return static_cast<uint64_t>(fromStatCxt(Cxt)->getWasmCPUTime().count());
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t
+WasmEdge_StatisticsGetHostFuncCPUTime(const WasmEdge_StatisticsContext *Cxt) {
+  if (Cxt) {
+    return static_cast<uint64_t>(
+        fromStatCxt(Cxt)->getHostFuncCPUTime().count());
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT uint64_t
+WasmEdge_StatisticsGetBlockedTime(const WasmEdge_StatisticsContext *Cxt) {
+  if (Cxt) {
+    return static_cast<uint64_t>(
+        std::chrono::nanoseconds(fromStatCxt(Cxt)->getBlockedTime()).count());
+  }
+  return 0;
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_StatisticsSetCPUTimeLimit(WasmEdge_StatisticsContext *Cxt,
+                                   const uint64_t Nanoseconds) {
+  if (Cxt) {
+    fromStatCxt(Cxt)->setCPUTimeLimit(std::chrono::nanoseconds(Nanoseconds));
+  }
+}
+
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_StatisticsDelete(WasmEdge_StatisticsContext *Cxt) {
   delete fromStatCxt(Cxt);
@@ -2103,6 +2254,21 @@ WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_MemoryInstanceGrowPage(
       EmptyThen, Cxt);
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_Result WasmEdge_MemoryInstanceDiscardPage(
+    WasmEdge_MemoryInstanceContext *Cxt, const uint32_t Start,
+    const uint32_t Page) {
+  return wrap(
+      [&]() -> WasmEdge::Expect<void> {
+        if (fromMemCxt(Cxt)->discardPage(Start, Page)) {
+          return {};
+        } else {
+          spdlog::error(WasmEdge::ErrCode::MemoryOutOfBounds);
+          return WasmEdge::Unexpect(WasmEdge::ErrCode::MemoryOutOfBounds);
+        }
+      },
+      EmptyThen, Cxt);
+}
+
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_MemoryInstanceDelete(WasmEdge_MemoryInstanceContext *Cxt) {
   delete fromMemCxt(Cxt);
@@ -2117,9 +2283,11 @@ WasmEdge_GlobalInstanceCreate(const WasmEdge_GlobalTypeContext *GlobType,
                               const WasmEdge_Value Value) {
   if (GlobType && Value.Type == static_cast<WasmEdge_ValType>(
                                     fromGlobTypeCxt(GlobType)->getValType())) {
+    // The value is not checked with the typed reference, so drop it.
+    WasmEdge::AST::GlobalType Type = *fromGlobTypeCxt(GlobType);
+    Type.setRef({});
     return toGlobCxt(new WasmEdge::Runtime::Instance::GlobalInstance(
-        *fromGlobTypeCxt(GlobType),
-        to_WasmEdge_128_t<WasmEdge::uint128_t>(Value.Value)));
+        Type, to_WasmEdge_128_t<WasmEdge::uint128_t>(Value.Value)));
   }
   return nullptr;
 }
@@ -2149,10 +2317,12 @@ WasmEdge_GlobalInstanceGetValue(const WasmEdge_GlobalInstanceContext *Cxt) {
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_GlobalInstanceSetValue(WasmEdge_GlobalInstanceContext *Cxt,
                                 const WasmEdge_Value Value) {
+  // The globals of typed references are only set in WebAssembly.
   if (Cxt &&
       fromGlobCxt(Cxt)->getGlobalType().getValMut() == WasmEdge::ValMut::Var &&
       static_cast<WasmEdge::ValType>(Value.Type) ==
-          fromGlobCxt(Cxt)->getGlobalType().getValType()) {
+          fromGlobCxt(Cxt)->getGlobalType().getValType() &&
+      fromGlobCxt(Cxt)->getGlobalType().getRef().isPlain()) {
     fromGlobCxt(Cxt)->getValue() =
         to_WasmEdge_128_t<WasmEdge::uint128_t>(Value.Value);
   }
@@ -2233,6 +2403,69 @@ WasmEdge_ImportObjectWASIGetExitCode(WasmEdge_ImportObjectContext *Cxt) {
   return WasiMod->getEnv().getExitCode();
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ImportObjectWASISetStdin(WasmEdge_ImportObjectContext *Cxt,
+                                  WasmEdge_WASIReadFunc_t Func, void *Data) {
+  if (!Cxt) {
+    return;
+  }
+  auto *WasiMod =
+      dynamic_cast<WasmEdge::Host::WasiModule *>(fromImpObjCxt(Cxt));
+  if (!WasiMod) {
+    return;
+  }
+  WasiMod->getEnv().setStdIn(genWASIStream<uint8_t>(Func, Data));
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ImportObjectWASISetStdout(WasmEdge_ImportObjectContext *Cxt,
+                                   WasmEdge_WASIWriteFunc_t Func, void *Data) {
+  if (!Cxt) {
+    return;
+  }
+  auto *WasiMod =
+      dynamic_cast<WasmEdge::Host::WasiModule *>(fromImpObjCxt(Cxt));
+  if (!WasiMod) {
+    return;
+  }
+  WasiMod->getEnv().setStdOut(genWASIStream<const uint8_t>(Func, Data));
+}
+
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_ImportObjectWASISetStderr(WasmEdge_ImportObjectContext *Cxt,
+                                   WasmEdge_WASIWriteFunc_t Func, void *Data) {
+  if (!Cxt) {
+    return;
+  }
+  auto *WasiMod =
+      dynamic_cast<WasmEdge::Host::WasiModule *>(fromImpObjCxt(Cxt));
+  if (!WasiMod) {
+    return;
+  }
+  WasiMod->getEnv().setStdErr(genWASIStream<const uint8_t>(Func, Data));
+}
+
+WASMEDGE_CAPI_EXPORT void WasmEdge_ImportObjectWASISetIOLimit(
+    WasmEdge_ImportObjectContext *Cxt, const uint64_t BytesPerSecond,
+    const uint64_t BytesBurst, const uint64_t OpsPerSecond,
+    const uint64_t OpsBurst, const bool Blocking) {
+  if (!Cxt) {
+    return;
+  }
+  auto *WasiMod =
+      dynamic_cast<WasmEdge::Host::WasiModule *>(fromImpObjCxt(Cxt));
+  if (!WasiMod) {
+    return;
+  }
+  WasmEdge::Host::WASI::IOLimit Limit;
+  Limit.BytesPerSecond = BytesPerSecond;
+  Limit.BytesBurst = BytesBurst;
+  Limit.OpsPerSecond = OpsPerSecond;
+  Limit.OpsBurst = OpsBurst;
+  Limit.Blocking = Blocking;
+  WasiMod->getEnv().setIOLimit(Limit);
+}
+
 WASMEDGE_CAPI_EXPORT WasmEdge_ImportObjectContext *
 WasmEdge_ImportObjectCreateWasmEdgeProcess(const char *const *AllowedCmds,
                                            const uint32_t CmdsLen,
@@ -2265,6 +2498,11 @@ WASMEDGE_CAPI_EXPORT void WasmEdge_ImportObjectInitWasmEdgeProcess(
   }
 }
 
+WASMEDGE_CAPI_EXPORT WasmEdge_ImportObjectContext *
+WasmEdge_ImportObjectCreateWasmEdgeMemory(void) {
+  return toImpObjCxt(new WasmEdge::Host::WasmEdgeMemoryModule());
+}
+
 WASMEDGE_CAPI_EXPORT void
 WasmEdge_ImportObjectAddFunction(WasmEdge_ImportObjectContext *Cxt,
                                  const WasmEdge_String Name,
@@ -2342,6 +2580,45 @@ WASMEDGE_CAPI_EXPORT void WasmEdge_AsyncCancel(WasmEdge_Async *Cxt) {
   }
 }
 
+WASMEDGE_CAPI_EXPORT void
+WasmEdge_AsyncSetCallback(WasmEdge_Async *Cxt, WasmEdge_AsyncCallback_t Func,
+                          void *Data) {
+  if (Cxt && Func) {
+    Cxt->Async.onReady([Func, Data]() { Func(Data); });
+  }
+}
+
+WASMEDGE_CAPI_EXPORT int WasmEdge_AsyncGetFd(WasmEdge_Async *Cxt) {
+  if (!Cxt) {
+    return -1;
+  }
+  std::call_once(Cxt->FdFlag, [Cxt]() {
+    auto Fd = std::make_shared<WasmEdge_Async::NotifyFd>();
+#if WASMEDGE_OS_LINUX
+    Fd->ReadFd = Fd->WriteFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (Fd->ReadFd < 0) {
+      return;
+    }
+#elif WASMEDGE_OS_MACOS
+    int Pipe[2];
+    if (::pipe(Pipe) != 0) {
+      return;
+    }
+    Fd->ReadFd = Pipe[0];
+    Fd->WriteFd = Pipe[1];
+    for (const int F : Pipe) {
+      ::fcntl(F, F_SETFD, FD_CLOEXEC);
+      ::fcntl(F, F_SETFL, ::fcntl(F, F_GETFL) | O_NONBLOCK);
+    }
+#else
+    return;
+#endif
+    Cxt->Fd = Fd;
+    Cxt->Async.onReady([Fd]() { Fd->notify(); });
+  });
+  return Cxt->Fd ? Cxt->Fd->ReadFd : -1;
+}
+
 WASMEDGE_CAPI_EXPORT uint32_t
 WasmEdge_AsyncGetReturnsLength(WasmEdge_Async *Cxt) {
   if (Cxt) {
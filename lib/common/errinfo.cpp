@@ -184,12 +184,12 @@ std::ostream &operator<<(std::ostream &OS, const struct InfoMismatch &Rhs) {
 }
 
 std::ostream &operator<<(std::ostream &OS, const struct InfoInstruction &Rhs) {
-  uint16_t Payload = static_cast<uint16_t>(Rhs.Code);
+  uint32_t Payload = static_cast<uint32_t>(Rhs.Code);
   OS << "    In instruction: " << OpCodeStr[Rhs.Code] << " (";
-  if ((Payload >> 8) >= static_cast<uint16_t>(0xFCU)) {
-    OS << convertUIntToHexStr(Payload >> 8, 2) << " ";
+  if ((Payload >> 16) >= UINT32_C(0xFC)) {
+    OS << convertUIntToHexStr(Payload >> 16, 2) << " ";
   }
-  OS << convertUIntToHexStr(Payload & 0xFFU, 2)
+  OS << convertUIntToHexStr(Payload & 0xFFFFU, 2)
      << ") , Bytecode offset: " << convertUIntToHexStr(Rhs.Offset);
   if (Rhs.Args.size() > 0) {
     OS << " , Args: [";
@@ -228,7 +228,7 @@ std::ostream &operator<<(std::ostream &OS, const struct InfoInstruction &Rhs) {
         if (isNullRef(Rhs.Args[I])) {
           OS << ":null";
         } else {
-          OS << ":" << retrieveFuncIdx(Rhs.Args[I]);
+          OS << ":" << retrieveFuncRef(Rhs.Args[I]);
         }
         break;
       case ValType::ExternRef:
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/timer.h"
+#include "common/defines.h"
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+#include <time.h>
+#elif WASMEDGE_OS_WINDOWS
+#include <boost/winapi/get_current_thread.hpp>
+#include <boost/winapi/get_thread_times.hpp>
+#endif
+
+namespace WasmEdge {
+namespace Timer {
+
+ThreadCPUClock::time_point ThreadCPUClock::now() noexcept {
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+  timespec Time;
+  if (unlikely(::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time) != 0)) {
+    return time_point();
+  }
+  return time_point(std::chrono::seconds(Time.tv_sec) +
+                    std::chrono::nanoseconds(Time.tv_nsec));
+#elif WASMEDGE_OS_WINDOWS
+  boost::winapi::FILETIME_ Creation, Exit, Kernel, User;
+  const auto Thread = boost::winapi::GetCurrentThread();
+  if (unlikely(!boost::winapi::GetThreadTimes(Thread, &Creation, &Exit,
+                                              &Kernel, &User))) {
+    return time_point();
+  }
+  // The thread times are in 100 nanoseconds.
+  const auto Ticks = [](const boost::winapi::FILETIME_ &Time) {
+    return (static_cast<uint64_t>(Time.dwHighDateTime) << 32) |
+           Time.dwLowDateTime;
+  };
+  return time_point(std::chrono::nanoseconds(
+      static_cast<rep>((Ticks(Kernel) + Ticks(User)) * 100)));
+#endif
+}
+
+} // namespace Timer
+} // namespace WasmEdge
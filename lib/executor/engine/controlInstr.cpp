@@ -3,6 +3,7 @@
 
 #include "executor/executor.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace WasmEdge {
@@ -62,6 +63,49 @@ Expect<void> Executor::runIfElseOp(Runtime::StoreManager &StoreMgr,
   return {};
 }
 
+Expect<void> Executor::runTryOp(Runtime::StoreManager &StoreMgr,
+                                const AST::Instruction &Instr,
+                                AST::InstrView::iterator &PC) {
+  // Get result type for arity.
+  auto BlockSig = getBlockArity(StoreMgr, Instr.getBlockType());
+  AST::InstrView::iterator Cont = PC + Instr.getJumpEnd();
+
+  // Create Label{ nothing } with the handlers of try-instruction and push.
+  StackMgr.pushLabel(BlockSig.first, BlockSig.second, Cont, std::nullopt, PC);
+  return {};
+}
+
+Expect<void> Executor::runThrowOp(Runtime::StoreManager &StoreMgr,
+                                  const AST::Instruction &Instr,
+                                  AST::InstrView::iterator &PC) {
+  // Get the tag type and pop the values of the exception.
+  const auto *ModInst = *StoreMgr.getModule(StackMgr.getModuleAddr());
+  const uint32_t TagAddr = *ModInst->getTagAddr(Instr.getTargetIndex());
+  const auto &TagType = (*StoreMgr.getTag(TagAddr))->getTagType();
+  const uint32_t ParamsN =
+      static_cast<uint32_t>(TagType.getParamTypes().size());
+  Span<ValVariant> Vals = StackMgr.getTopSpan(ParamsN);
+  Exception Exc{TagAddr, std::vector<ValVariant>(Vals.begin(), Vals.end())};
+  for (uint32_t I = 0; I < ParamsN; ++I) {
+    StackMgr.pop();
+  }
+  return throwException(StoreMgr, std::move(Exc), PC);
+}
+
+Expect<void> Executor::runRethrowOp(Runtime::StoreManager &StoreMgr,
+                                    const AST::Instruction &Instr,
+                                    AST::InstrView::iterator &PC) {
+  // Get the exception caught by the label, which is a catch label checked in
+  // validation.
+  const uint32_t Idx = static_cast<uint32_t>(StackMgr.getLabels().size()) -
+                       Instr.getTargetIndex() - 1;
+  auto It = std::find_if(
+      CaughtExceptions.rbegin(), CaughtExceptions.rend(),
+      [Idx](const auto &Caught) { return Caught.first == Idx; });
+  assuming(It != CaughtExceptions.rend());
+  return throwException(StoreMgr, It->second, PC);
+}
+
 Expect<void> Executor::runBrOp(Runtime::StoreManager &StoreMgr,
                                const AST::Instruction &Instr,
                                AST::InstrView::iterator &PC) {
@@ -134,7 +178,7 @@ Expect<void> Executor::runCallIndirectOp(Runtime::StoreManager &StoreMgr,
     return Unexpect(ErrCode::UndefinedElement);
   }
 
-  // Get function address.
+  // Get function instance.
   ValVariant Ref = TabInst->getRefAddr(Idx)->get<UnknownRef>();
   if (isNullRef(Ref)) {
     spdlog::error(ErrCode::UninitializedElement);
@@ -143,11 +187,17 @@ Expect<void> Executor::runCallIndirectOp(Runtime::StoreManager &StoreMgr,
                                            {ValTypeFromType<uint32_t>()}));
     return Unexpect(ErrCode::UninitializedElement);
   }
-  uint32_t FuncAddr = retrieveFuncIdx(Ref);
+  const auto FuncInst = StoreMgr.getFunction(Ref.get<FuncRef>());
+  if (!FuncInst) {
+    spdlog::error(FuncInst.error());
+    spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset(),
+                                           {Idx},
+                                           {ValTypeFromType<uint32_t>()}));
+    return Unexpect(FuncInst);
+  }
 
   // Check function type.
-  const auto *FuncInst = *StoreMgr.getFunction(FuncAddr);
-  const auto &FuncType = FuncInst->getFuncType();
+  const auto &FuncType = (*FuncInst)->getFuncType();
   if (*TargetFuncType != FuncType) {
     spdlog::error(ErrCode::IndirectCallTypeMismatch);
     spdlog::error(ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset(),
@@ -158,7 +208,34 @@ Expect<void> Executor::runCallIndirectOp(Runtime::StoreManager &StoreMgr,
         FuncType.getParamTypes(), FuncType.getReturnTypes()));
     return Unexpect(ErrCode::IndirectCallTypeMismatch);
   }
-  if (auto Res = enterFunction(StoreMgr, *FuncInst, PC + 1); !Res) {
+  if (auto Res = enterFunction(StoreMgr, **FuncInst, PC + 1); !Res) {
+    return Unexpect(Res);
+  } else {
+    PC = (*Res) - 1;
+  }
+  return {};
+}
+
+Expect<void> Executor::runCallRefOp(Runtime::StoreManager &StoreMgr,
+                                    const AST::Instruction &Instr,
+                                    AST::InstrView::iterator &PC) {
+  // Pop the function reference from the Stack. No table is accessed.
+  const ValVariant Ref = StackMgr.pop();
+  if (isNullRef(Ref)) {
+    spdlog::error(ErrCode::AccessNullFunc);
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(ErrCode::AccessNullFunc);
+  }
+  // The function type of the typed reference is proved in validation.
+  const auto FuncInst = StoreMgr.getFunction(Ref.get<FuncRef>());
+  if (!FuncInst) {
+    spdlog::error(FuncInst.error());
+    spdlog::error(
+        ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+    return Unexpect(FuncInst);
+  }
+  if (auto Res = enterFunction(StoreMgr, **FuncInst, PC + 1); !Res) {
     return Unexpect(Res);
   } else {
     PC = (*Res) - 1;
@@ -21,13 +21,24 @@ Executor::runFunction(Runtime::StoreManager &StoreMgr,
                       const Runtime::Instance::FunctionInstance &Func,
                       Span<const ValVariant> Params) {
   // Set start time.
-  if (Stat && Conf.getStatisticsConfigure().isTimeMeasuring()) {
+  if (Stat && (Conf.getStatisticsConfigure().isTimeMeasuring() ||
+               Stat->isCPUTimeMeasuring())) {
     Stat->startRecordWasm();
   }
 
+  // Start sampling if not sampling by the outer execution.
+  const bool Profiling =
+      Prof && !Prof->isRunning() &&
+      Prof->start(Conf.getStatisticsConfigure().getProfileInterval());
+
   // Reset and push a dummy frame into stack.
   StackMgr.reset();
   StackMgr.pushDummyFrame();
+  CaughtExceptions.clear();
+  PendingException.reset();
+  HasPendingException = 0;
+  CaughtSlots.clear();
+  FreeSlots.clear();
 
   // Push arguments.
   for (auto &Val : Params) {
@@ -39,6 +50,13 @@ Executor::runFunction(Runtime::StoreManager &StoreMgr,
   if (auto Res = enterFunction(StoreMgr, Func, Func.getInstrs().end())) {
     StartIt = *Res;
   } else {
+    if (Stat && (Conf.getStatisticsConfigure().isTimeMeasuring() ||
+                 Stat->isCPUTimeMeasuring())) {
+      Stat->stopRecordWasm();
+    }
+    if (Profiling) {
+      Prof->stop();
+    }
     return Unexpect(Res);
   }
   auto Res = execute(StoreMgr, StartIt, Func.getInstrs().end());
@@ -49,10 +67,15 @@ Executor::runFunction(Runtime::StoreManager &StoreMgr,
     spdlog::debug(" Terminated.");
   }
 
-  if (Stat && Conf.getStatisticsConfigure().isTimeMeasuring()) {
+  if (Stat && (Conf.getStatisticsConfigure().isTimeMeasuring() ||
+               Stat->isCPUTimeMeasuring())) {
     Stat->stopRecordWasm();
   }
 
+  if (Profiling) {
+    Prof->stop();
+  }
+
   // If Statistics is enabled, then dump it here.
   if (Stat) {
     Stat->dumpToLog(Conf);
@@ -102,6 +125,9 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
         }
       }
       [[fallthrough]];
+    case OpCode::Catch:
+    case OpCode::Catch_all:
+    case OpCode::Delegate:
     case OpCode::End:
       PC = StackMgr.leaveLabel();
       return {};
@@ -111,14 +137,32 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       return runBrIfOp(StoreMgr, Instr, PC);
     case OpCode::Br_table:
       return runBrTableOp(StoreMgr, Instr, PC);
+    case OpCode::Br_on_null:
+      if (isNullRef(StackMgr.getTop())) {
+        StackMgr.pop();
+        return runBrOp(StoreMgr, Instr, PC);
+      }
+      return {};
     case OpCode::Return:
       return runReturnOp(PC);
     case OpCode::Call:
       return runCallOp(StoreMgr, Instr, PC);
     case OpCode::Call_indirect:
       return runCallIndirectOp(StoreMgr, Instr, PC);
+    case OpCode::Call_ref:
+      return runCallRefOp(StoreMgr, Instr, PC);
+    case OpCode::Try:
+      return runTryOp(StoreMgr, Instr, PC);
+    case OpCode::Throw:
+      return runThrowOp(StoreMgr, Instr, PC);
+    case OpCode::Rethrow:
+      return runRethrowOp(StoreMgr, Instr, PC);
 
     // Reference Instructions
+    // The element segments are initialized by ref.func and ref.null
+    // expressions even without the ReferenceTypes proposal.
+#if WASMEDGE_BUILD_PROPOSAL_BULK_MEMORY_OPERATIONS ||                       \
+    WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES
     case OpCode::Ref__null:
       StackMgr.push(UnknownRef());
       return {};
@@ -131,19 +175,31 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       }
       return {};
     }
+#endif
     case OpCode::Ref__func: {
       const auto *ModInst = *StoreMgr.getModule(StackMgr.getModuleAddr());
       const uint32_t FuncAddr = *ModInst->getFuncAddr(Instr.getTargetIndex());
-      StackMgr.push(FuncRef(FuncAddr));
+      StackMgr.push(FuncRef(*StoreMgr.getFunction(FuncAddr)));
       return {};
     }
+    case OpCode::Ref__as_non_null:
+      if (isNullRef(StackMgr.getTop())) {
+        spdlog::error(ErrCode::CastNullToNonNull);
+        spdlog::error(
+            ErrInfo::InfoInstruction(Instr.getOpCode(), Instr.getOffset()));
+        return Unexpect(ErrCode::CastNullToNonNull);
+      }
+      return {};
 
     // Parametric Instructions
     case OpCode::Drop:
       StackMgr.pop();
       return {};
     case OpCode::Select:
-    case OpCode::Select_t: {
+#if WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES
+    case OpCode::Select_t:
+#endif
+    {
       // Pop the i32 value and select values from stack.
       ValVariant CondVal = StackMgr.pop();
       ValVariant Val2 = StackMgr.pop();
@@ -171,12 +227,16 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       return runGlobalSetOp(StoreMgr, Instr.getTargetIndex());
 
     // Table Instructions
+#if WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES
     case OpCode::Table__get:
       return runTableGetOp(*getTabInstByIdx(StoreMgr, Instr.getTargetIndex()),
                            Instr);
     case OpCode::Table__set:
       return runTableSetOp(*getTabInstByIdx(StoreMgr, Instr.getTargetIndex()),
                            Instr);
+#endif
+#if WASMEDGE_BUILD_PROPOSAL_BULK_MEMORY_OPERATIONS ||                       \
+    WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES
     case OpCode::Table__init:
       return runTableInitOp(*getTabInstByIdx(StoreMgr, Instr.getTargetIndex()),
                             *getElemInstByIdx(StoreMgr, Instr.getSourceIndex()),
@@ -187,6 +247,8 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       return runTableCopyOp(*getTabInstByIdx(StoreMgr, Instr.getTargetIndex()),
                             *getTabInstByIdx(StoreMgr, Instr.getSourceIndex()),
                             Instr);
+#endif
+#if WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES
     case OpCode::Table__grow:
       return runTableGrowOp(*getTabInstByIdx(StoreMgr, Instr.getTargetIndex()));
     case OpCode::Table__size:
@@ -194,6 +256,7 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
     case OpCode::Table__fill:
       return runTableFillOp(*getTabInstByIdx(StoreMgr, Instr.getTargetIndex()),
                             Instr);
+#endif
 
     // Memory Instructions
     case OpCode::I32__load:
@@ -271,6 +334,8 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
     case OpCode::Memory__size:
       return runMemorySizeOp(
           *getMemInstByIdx(StoreMgr, Instr.getTargetIndex()));
+#if WASMEDGE_BUILD_PROPOSAL_BULK_MEMORY_OPERATIONS ||                       \
+    WASMEDGE_BUILD_PROPOSAL_REFERENCE_TYPES
     case OpCode::Memory__init:
       return runMemoryInitOp(
           *getMemInstByIdx(StoreMgr, Instr.getTargetIndex()),
@@ -284,6 +349,7 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
     case OpCode::Memory__fill:
       return runMemoryFillOp(*getMemInstByIdx(StoreMgr, Instr.getTargetIndex()),
                              Instr);
+#endif
 
     // Const numeric instructions
     case OpCode::I32__const:
@@ -721,6 +787,7 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       return runCopysignOp<double>(StackMgr.getTop(), Rhs);
     }
 
+#if WASMEDGE_BUILD_PROPOSAL_SIMD
     // SIMD Memory Instructions
     case OpCode::V128__load:
       return runLoadOp<uint128_t>(
@@ -866,7 +933,8 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
     }
 
       // SIMD Numeric Instructions
-    case OpCode::I8x16__swizzle: {
+    case OpCode::I8x16__swizzle:
+    case OpCode::I8x16__relaxed_swizzle: {
       const ValVariant Val2 = StackMgr.pop();
       ValVariant &Val1 = StackMgr.getTop();
       const uint8x16_t &Index = Val2.get<uint8x16_t>();
@@ -1123,7 +1191,11 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       Val1.get<uint64x2_t>() ^= Val2.get<uint64x2_t>();
       return {};
     }
-    case OpCode::V128__bitselect: {
+    case OpCode::V128__bitselect:
+    case OpCode::I8x16__relaxed_laneselect:
+    case OpCode::I16x8__relaxed_laneselect:
+    case OpCode::I32x4__relaxed_laneselect:
+    case OpCode::I64x2__relaxed_laneselect: {
       const uint64x2_t C = StackMgr.pop().get<uint64x2_t>();
       const uint64x2_t Val2 = StackMgr.pop().get<uint64x2_t>();
       uint64x2_t &Val1 = StackMgr.getTop().get<uint64x2_t>();
@@ -1308,7 +1380,8 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       ValVariant Rhs = StackMgr.pop();
       return runVectorExtMulHighOp<uint8_t, uint16_t>(StackMgr.getTop(), Rhs);
     }
-    case OpCode::I16x8__q15mulr_sat_s: {
+    case OpCode::I16x8__q15mulr_sat_s:
+    case OpCode::I16x8__relaxed_q15mulr_s: {
       ValVariant Rhs = StackMgr.pop();
       return runVectorQ15MulSatOp(StackMgr.getTop(), Rhs);
     }
@@ -1481,11 +1554,13 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       ValVariant Rhs = StackMgr.pop();
       return runVectorFMaxOp<float>(StackMgr.getTop(), Rhs);
     }
-    case OpCode::F32x4__pmin: {
+    case OpCode::F32x4__pmin:
+    case OpCode::F32x4__relaxed_min: {
       ValVariant Rhs = StackMgr.pop();
       return runVectorMinOp<float>(StackMgr.getTop(), Rhs);
     }
-    case OpCode::F32x4__pmax: {
+    case OpCode::F32x4__pmax:
+    case OpCode::F32x4__relaxed_max: {
       ValVariant Rhs = StackMgr.pop();
       return runVectorMaxOp<float>(StackMgr.getTop(), Rhs);
     }
@@ -1520,26 +1595,32 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
       ValVariant Rhs = StackMgr.pop();
       return runVectorFMaxOp<double>(StackMgr.getTop(), Rhs);
     }
-    case OpCode::F64x2__pmin: {
+    case OpCode::F64x2__pmin:
+    case OpCode::F64x2__relaxed_min: {
       ValVariant Rhs = StackMgr.pop();
       return runVectorMinOp<double>(StackMgr.getTop(), Rhs);
     }
-    case OpCode::F64x2__pmax: {
+    case OpCode::F64x2__pmax:
+    case OpCode::F64x2__relaxed_max: {
       ValVariant Rhs = StackMgr.pop();
       return runVectorMaxOp<double>(StackMgr.getTop(), Rhs);
     }
 
     case OpCode::I32x4__trunc_sat_f32x4_s:
+    case OpCode::I32x4__relaxed_trunc_f32x4_s:
       return runVectorTruncSatOp<float, int32_t>(StackMgr.getTop());
     case OpCode::I32x4__trunc_sat_f32x4_u:
+    case OpCode::I32x4__relaxed_trunc_f32x4_u:
       return runVectorTruncSatOp<float, uint32_t>(StackMgr.getTop());
     case OpCode::F32x4__convert_i32x4_s:
       return runVectorConvertOp<int32_t, float>(StackMgr.getTop());
     case OpCode::F32x4__convert_i32x4_u:
       return runVectorConvertOp<uint32_t, float>(StackMgr.getTop());
     case OpCode::I32x4__trunc_sat_f64x2_s_zero:
+    case OpCode::I32x4__relaxed_trunc_f64x2_s_zero:
       return runVectorTruncSatOp<double, int32_t>(StackMgr.getTop());
     case OpCode::I32x4__trunc_sat_f64x2_u_zero:
+    case OpCode::I32x4__relaxed_trunc_f64x2_u_zero:
       return runVectorTruncSatOp<double, uint32_t>(StackMgr.getTop());
     case OpCode::F64x2__convert_low_i32x4_s:
       return runVectorConvertOp<int32_t, double>(StackMgr.getTop());
@@ -1582,6 +1663,70 @@ Expect<void> Executor::execute(Runtime::StoreManager &StoreMgr,
     case OpCode::F64x2__nearest:
       return runVectorNearestOp<double>(StackMgr.getTop());
 
+      // Relaxed SIMD Instructions
+      // The relaxed instructions not listed here share the results of the
+      // strict ones, which are in the allowed results.
+    case OpCode::F32x4__relaxed_madd: {
+      const ValVariant Val3 = StackMgr.pop();
+      const ValVariant Val2 = StackMgr.pop();
+      return runVectorMAddOp<float>(StackMgr.getTop(), Val2, Val3);
+    }
+    case OpCode::F32x4__relaxed_nmadd: {
+      const ValVariant Val3 = StackMgr.pop();
+      const ValVariant Val2 = StackMgr.pop();
+      return runVectorNMAddOp<float>(StackMgr.getTop(), Val2, Val3);
+    }
+    case OpCode::F64x2__relaxed_madd: {
+      const ValVariant Val3 = StackMgr.pop();
+      const ValVariant Val2 = StackMgr.pop();
+      return runVectorMAddOp<double>(StackMgr.getTop(), Val2, Val3);
+    }
+    case OpCode::F64x2__relaxed_nmadd: {
+      const ValVariant Val3 = StackMgr.pop();
+      const ValVariant Val2 = StackMgr.pop();
+      return runVectorNMAddOp<double>(StackMgr.getTop(), Val2, Val3);
+    }
+    case OpCode::I16x8__relaxed_dot_i8x16_i7x16_s: {
+      using int16x16_t [[gnu::vector_size(32)]] = int16_t;
+      using uint16x16_t [[gnu::vector_size(32)]] = uint16_t;
+      const ValVariant Val2 = StackMgr.pop();
+      ValVariant &Val1 = StackMgr.getTop();
+
+      auto &V2 = Val2.get<int8x16_t>();
+      auto &V1 = Val1.get<int8x16_t>();
+      // The products fit in 16 bits, and the sums wrap around.
+      const auto M = __builtin_convertvector(
+          __builtin_convertvector(V1, int16x16_t) *
+              __builtin_convertvector(V2, int16x16_t),
+          uint16x16_t);
+      const uint16x8_t L = {M[0], M[2], M[4],  M[6],
+                            M[8], M[10], M[12], M[14]};
+      const uint16x8_t R = {M[1], M[3], M[5],  M[7],
+                            M[9], M[11], M[13], M[15]};
+      Val1.emplace<uint16x8_t>(L + R);
+
+      return {};
+    }
+    case OpCode::I32x4__relaxed_dot_i8x16_i7x16_add_s: {
+      using int32x16_t [[gnu::vector_size(64)]] = int32_t;
+      const ValVariant Val3 = StackMgr.pop();
+      const ValVariant Val2 = StackMgr.pop();
+      ValVariant &Val1 = StackMgr.getTop();
+
+      auto &V2 = Val2.get<int8x16_t>();
+      auto &V1 = Val1.get<int8x16_t>();
+      const auto M = __builtin_convertvector(V1, int32x16_t) *
+                     __builtin_convertvector(V2, int32x16_t);
+      const int32x4_t S = {M[0] + M[1] + M[2] + M[3],
+                           M[4] + M[5] + M[6] + M[7],
+                           M[8] + M[9] + M[10] + M[11],
+                           M[12] + M[13] + M[14] + M[15]};
+      Val1.emplace<int32x4_t>(S + Val3.get<int32x4_t>());
+
+      return {};
+    }
+#endif
+
     default:
       return {};
     }
@@ -4,6 +4,7 @@
 #include "executor/executor.h"
 #include "system/fault.h"
 
+#include <algorithm>
 #include <cstdint>
 
 namespace WasmEdge {
@@ -23,6 +24,13 @@ struct Executor::ProxyHelper<Expect<RetT> (Executor::*)(Runtime::StoreManager &,
   {
     Expect<RetT> Res = (This->*Func)(*This->CurrentStore, Args...);
     if (unlikely(!Res)) {
+      if constexpr (std::is_void_v<RetT>) {
+        // The exception thrown by the callee is checked by the compiled
+        // function after the call returns.
+        if (This->HasPendingException) {
+          return;
+        }
+      }
       Fault::emitFault(Res.error());
     }
     if constexpr (std::is_same_v<RetT, RefVariant>) {
@@ -63,6 +71,13 @@ const AST::Module::IntrinsicsTable Executor::Intrinsics = {
     ENTRY(kTableInit, tableInit),
     ENTRY(kElemDrop, elemDrop),
     ENTRY(kRefFunc, refFunc),
+    ENTRY(kCallRef, callRef),
+    ENTRY(kCheckCPUTime, checkCPUTime),
+    ENTRY(kThrow, throwTag),
+    ENTRY(kRethrow, rethrowException),
+    ENTRY(kCatchTag, catchTag),
+    ENTRY(kCatchAll, catchAll),
+    ENTRY(kReleaseExceptions, releaseExceptions),
 #undef ENTRY
 };
 
@@ -125,15 +140,18 @@ Executor::callIndirect(Runtime::StoreManager &StoreMgr, const uint32_t TableIdx,
   if (unlikely(isNullRef(*Ref))) {
     return Unexpect(ErrCode::UninitializedElement);
   }
-  const auto FuncAddr = retrieveFuncIdx(*Ref);
+  const Runtime::Instance::FunctionInstance *FuncInst = nullptr;
+  if (auto Res = StoreMgr.getFunction(Ref->get<FuncRef>())) {
+    FuncInst = *Res;
+  } else {
+    return Unexpect(Res);
+  }
 
   const auto ModInst = StoreMgr.getModule(StackMgr.getModuleAddr());
   assuming(ModInst && *ModInst);
   const auto TargetFuncType = (*ModInst)->getFuncType(FuncTypeIdx);
   assuming(TargetFuncType && *TargetFuncType);
-  const auto FuncInst = StoreMgr.getFunction(FuncAddr);
-  assuming(FuncInst && *FuncInst);
-  const auto &FuncType = (*FuncInst)->getFuncType();
+  const auto &FuncType = FuncInst->getFuncType();
   if (unlikely(**TargetFuncType != FuncType)) {
     return Unexpect(ErrCode::IndirectCallTypeMismatch);
   }
@@ -147,9 +165,50 @@ Executor::callIndirect(Runtime::StoreManager &StoreMgr, const uint32_t TableIdx,
     StackMgr.push(Args[I]);
   }
 
-  auto Instrs = (*FuncInst)->getInstrs();
+  auto Instrs = FuncInst->getInstrs();
+  AST::InstrView::iterator StartIt;
+  if (auto Res = enterFunction(StoreMgr, *FuncInst, Instrs.end())) {
+    StartIt = *Res;
+  } else {
+    return Unexpect(Res);
+  }
+  if (auto Res = execute(StoreMgr, StartIt, Instrs.end()); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+
+  for (uint32_t I = 0; I < ReturnsSize; ++I) {
+    Rets[ReturnsSize - 1 - I] = StackMgr.pop();
+  }
+
+  return {};
+}
+
+Expect<void> Executor::callRef(Runtime::StoreManager &StoreMgr,
+                               const uint32_t, const RefVariant Ref,
+                               const ValVariant *Args,
+                               ValVariant *Rets) noexcept {
+  // The null reference is trapped in the compiled code, and the function type
+  // of the typed reference is proved in validation.
+  const Runtime::Instance::FunctionInstance *FuncInst = nullptr;
+  if (auto Res = StoreMgr.getFunction(Ref.get<FuncRef>())) {
+    FuncInst = *Res;
+  } else {
+    return Unexpect(Res);
+  }
+  const auto &FuncType = FuncInst->getFuncType();
+
+  const uint32_t ParamsSize =
+      static_cast<uint32_t>(FuncType.getParamTypes().size());
+  const uint32_t ReturnsSize =
+      static_cast<uint32_t>(FuncType.getReturnTypes().size());
+
+  for (uint32_t I = 0; I < ParamsSize; ++I) {
+    StackMgr.push(Args[I]);
+  }
+
+  auto Instrs = FuncInst->getInstrs();
   AST::InstrView::iterator StartIt;
-  if (auto Res = enterFunction(StoreMgr, **FuncInst, Instrs.end())) {
+  if (auto Res = enterFunction(StoreMgr, *FuncInst, Instrs.end())) {
     StartIt = *Res;
   } else {
     return Unexpect(Res);
@@ -356,7 +415,84 @@ Expect<RefVariant> Executor::refFunc(Runtime::StoreManager &StoreMgr,
   assuming(ModInst && *ModInst);
   const auto FuncAddr = (*ModInst)->getFuncAddr(FuncIdx);
   assuming(FuncAddr);
-  return FuncRef(*FuncAddr);
+  const auto FuncInst = StoreMgr.getFunction(*FuncAddr);
+  assuming(FuncInst);
+  return FuncRef(*FuncInst);
+}
+
+Expect<void> Executor::checkCPUTime(Runtime::StoreManager &) noexcept {
+  if (Stat && unlikely(!Stat->checkCPUTime(true))) {
+    return Unexpect(ErrCode::CPUTimeLimitExceeded);
+  }
+  return {};
+}
+
+Expect<void> Executor::throwTag(Runtime::StoreManager &StoreMgr,
+                                const uint32_t TagIdx,
+                                const ValVariant *Args) noexcept {
+  const auto *ModInst = *StoreMgr.getModule(StackMgr.getModuleAddr());
+  const uint32_t TagAddr = *ModInst->getTagAddr(TagIdx);
+  const auto &TagType = (*StoreMgr.getTag(TagAddr))->getTagType();
+  const size_t ParamsN = TagType.getParamTypes().size();
+  PendingException.emplace(
+      Exception{TagAddr, std::vector<ValVariant>(Args, Args + ParamsN)});
+  HasPendingException = 1;
+  return {};
+}
+
+Expect<void> Executor::rethrowException(Runtime::StoreManager &,
+                                        const uint32_t Slot) noexcept {
+  PendingException.emplace(CaughtSlots[Slot]);
+  HasPendingException = 1;
+  return {};
+}
+
+Expect<uint32_t> Executor::catchTag(Runtime::StoreManager &StoreMgr,
+                                    const uint32_t TagIdx, ValVariant *Vals,
+                                    uint32_t *Slot) noexcept {
+  const auto *ModInst = *StoreMgr.getModule(StackMgr.getModuleAddr());
+  if (*ModInst->getTagAddr(TagIdx) != PendingException->TagAddr) {
+    return 0;
+  }
+  std::copy(PendingException->Values.begin(), PendingException->Values.end(),
+            Vals);
+  if (auto Res = catchAll(StoreMgr, Slot); unlikely(!Res)) {
+    return Unexpect(Res);
+  }
+  return UINT32_C(1);
+}
+
+Expect<void> Executor::catchAll(Runtime::StoreManager &,
+                                uint32_t *Slot) noexcept {
+  // The slot is kept in the frame until the function returns, so the
+  // handlers in loops reuse the same slot.
+  if (*Slot == UINT32_MAX) {
+    if (FreeSlots.empty()) {
+      *Slot = static_cast<uint32_t>(CaughtSlots.size());
+      CaughtSlots.emplace_back(std::move(*PendingException));
+    } else {
+      *Slot = FreeSlots.back();
+      FreeSlots.pop_back();
+      CaughtSlots[*Slot] = std::move(*PendingException);
+    }
+  } else {
+    CaughtSlots[*Slot] = std::move(*PendingException);
+  }
+  PendingException.reset();
+  HasPendingException = 0;
+  return {};
+}
+
+Expect<void> Executor::releaseExceptions(Runtime::StoreManager &,
+                                         const uint32_t *Slots,
+                                         const uint32_t SlotsN) noexcept {
+  for (uint32_t I = 0; I < SlotsN; ++I) {
+    if (Slots[I] != UINT32_MAX) {
+      CaughtSlots[Slots[I]].Values.clear();
+      FreeSlots.push_back(Slots[I]);
+    }
+  }
+  return {};
 }
 
 } // namespace Executor
@@ -42,6 +42,10 @@ Expect<void> Executor::registerModule(Runtime::StoreManager &StoreMgr,
     uint32_t Addr = StoreMgr.importHostFunction(*Func.second.get());
     ModInst->addFuncAddr(Addr);
     ModInst->exportFunction(Func.first, ModInst->getFuncNum() - 1);
+    if (Prof) {
+      Prof->setName(*StoreMgr.getFunction(Addr),
+                    std::string(Obj.getModuleName()) + "::" + Func.first);
+    }
   }
   for (auto &Tab : Obj.getTables()) {
     uint32_t Addr = StoreMgr.importHostTable(*Tab.second.get());
@@ -103,6 +107,26 @@ Executor::invoke(Runtime::StoreManager &StoreMgr, const uint32_t FuncAddr,
     spdlog::error(ErrInfo::InfoMismatch(PTypes, RTypes, GotParamTypes, RTypes));
     return Unexpect(ErrCode::FuncSigMismatch);
   }
+  // Check the typed references, which are not checked in execution.
+  const auto &PRefs = FuncType.getParamRefs();
+  for (uint32_t I = 0; I < PRefs.size(); ++I) {
+    if (PRefs[I].isPlain()) {
+      continue;
+    }
+    bool IsMatched = !isNullRef(Params[I]);
+    if (IsMatched && PRefs[I].hasTypeIdx()) {
+      const auto *Type = PRefs[I].getResolvedType();
+      const auto RefInst = StoreMgr.getFunction(Params[I].get<FuncRef>());
+      IsMatched = Type && RefInst && (*RefInst)->getFuncType() == *Type;
+    } else if (!IsMatched) {
+      IsMatched = PRefs[I].isNullable();
+    }
+    if (!IsMatched) {
+      spdlog::error(ErrCode::FuncSigMismatch);
+      spdlog::error("    The reference of parameter {} is not matched.", I);
+      return Unexpect(ErrCode::FuncSigMismatch);
+    }
+  }
 
   // Call runFunction.
   if (auto Res = runFunction(StoreMgr, *FuncInst, Params); !Res) {
@@ -7,6 +7,8 @@
 #include "system/fault.h"
 
 #include <cstdint>
+#include <iterator>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -21,6 +23,15 @@ Executor::enterFunction(Runtime::StoreManager &StoreMgr,
     spdlog::error(ErrCode::Interrupted);
     return Unexpect(ErrCode::Interrupted);
   }
+  // Check CPU time limit
+  if (Stat && unlikely(!Stat->checkCPUTime())) {
+    spdlog::error(ErrCode::CPUTimeLimitExceeded);
+    return Unexpect(ErrCode::CPUTimeLimitExceeded);
+  }
+  // Take the pending profile samples
+  if (Prof && unlikely(Prof->hasPendingSample())) {
+    recordProfile(nullptr);
+  }
   // Get function type
   const auto &FuncType = Func.getFuncType();
   const uint32_t ArgsN = static_cast<uint32_t>(FuncType.getParamTypes().size());
@@ -50,17 +61,42 @@ Executor::enterFunction(Runtime::StoreManager &StoreMgr,
     // Run host function.
     Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN);
     std::vector<ValVariant> Rets(RetsN);
+    Runtime::HostFunctionBase::takeWork();
+    const bool InCompiled = Prof && Prof->setInCompiled(false);
     auto Ret = HostFunc.run(MemoryInst, std::move(Args), Rets);
+    const auto Work = Runtime::HostFunctionBase::takeWork();
+    if (Prof) {
+      if (unlikely(Prof->hasPendingSample())) {
+        recordProfile(&Func);
+      }
+      Prof->setInCompiled(InCompiled);
+    }
 
     if (Stat) {
       // Stop recording time of running host function.
       Stat->stopRecordHost();
       Stat->startRecordWasm();
+      // Charge the work done by the host function.
+      for (size_t I = 0; I < Work.size(); ++I) {
+        if (unlikely(!Stat->addHostWorkCost(static_cast<HostWork>(I),
+                                            Work[I]))) {
+          spdlog::error(ErrCode::CostLimitExceeded);
+          return Unexpect(ErrCode::CostLimitExceeded);
+        }
+      }
+      // The host function may take long, so always check CPU time limit.
+      if (unlikely(!Stat->checkCPUTime(true))) {
+        spdlog::error(ErrCode::CPUTimeLimitExceeded);
+        return Unexpect(ErrCode::CPUTimeLimitExceeded);
+      }
     }
 
     if (!Ret) {
       if (Ret.error() == ErrCode::ExecutionFailed) {
         spdlog::error(Ret.error());
+      } else if (Ret.error() == ErrCode::Interrupted) {
+        // The blocking host function is woken up by the stop request.
+        StopToken.store(0, std::memory_order_relaxed);
       }
       return Unexpect(Ret);
     }
@@ -79,7 +115,8 @@ Executor::enterFunction(Runtime::StoreManager &StoreMgr,
     // Compiled function case: Push frame with locals and args.
     StackMgr.pushFrame(Func.getModuleAddr(), // Module address
                        ArgsN,                // No Arguments in stack
-                       RetsN                 // Returns num
+                       RetsN,                // Returns num
+                       &Func                 // Function instance
     );
 
     Span<ValVariant> Args = StackMgr.getTopSpan(ArgsN);
@@ -94,12 +131,20 @@ Executor::enterFunction(Runtime::StoreManager &StoreMgr,
       }
       ExecutionContext.Memories = ModInst.MemoryPtrs.data();
       ExecutionContext.Globals = ModInst.GlobalPtrs.data();
+      if (Stat) {
+        // The cost table may be replaced after the executor constructed.
+        ExecutionContext.CostTable = Stat->getCostTable().data();
+      }
     }
 
     {
+      const bool InCompiled = Prof && Prof->setInCompiled(true);
       Fault FaultHandler;
       if (auto Err = PREPARE_FAULT(FaultHandler);
           unlikely(Err != ErrCode::Success)) {
+        if (Prof) {
+          Prof->setInCompiled(InCompiled);
+        }
         if (Err != ErrCode::Terminated) {
           spdlog::error(Err);
         }
@@ -108,6 +153,25 @@ Executor::enterFunction(Runtime::StoreManager &StoreMgr,
       auto &Wrapper = FuncType.getSymbol();
       Wrapper(&ExecutionContext, Func.getSymbol().get(), Args.data(),
               Rets.data());
+      if (Prof) {
+        Prof->setInCompiled(InCompiled);
+      }
+    }
+
+    if (unlikely(HasPendingException)) {
+      // The exception is not caught in the compiled function. Pop the frame
+      // and throw it to the caller.
+      HasPendingException = 0;
+      Exception Exc = std::move(*PendingException);
+      PendingException.reset();
+      StackMgr.unwindToFrame(
+          static_cast<uint32_t>(StackMgr.getFrames().size()) - 2);
+      AST::InstrView::iterator PC = From;
+      if (auto Res = throwException(StoreMgr, std::move(Exc), PC); !Res) {
+        return Unexpect(Res);
+      }
+      // Continue at the handler.
+      return PC + 1;
     }
 
     for (uint32_t I = 0; I < Rets.size(); ++I) {
@@ -121,7 +185,8 @@ Executor::enterFunction(Runtime::StoreManager &StoreMgr,
     // Native function case: Push frame with locals and args.
     StackMgr.pushFrame(Func.getModuleAddr(), // Module address
                        ArgsN,                // Arguments num
-                       RetsN                 // Returns num
+                       RetsN,                // Returns num
+                       &Func                 // Function instance
     );
 
     // Push local variables to stack.
@@ -145,6 +210,8 @@ Executor::getBlockArity(Runtime::StoreManager &StoreMgr,
   uint32_t Locals = 0, Arity = 0;
   if (BType.IsValType) {
     Arity = (BType.Data.Type == ValType::None) ? 0 : 1;
+  } else if (BType.IsTypedRef) {
+    Arity = 1;
   } else {
     // Get function type at index x.
     const auto *ModInst = *StoreMgr.getModule(StackMgr.getModuleAddr());
@@ -155,6 +222,20 @@ Executor::getBlockArity(Runtime::StoreManager &StoreMgr,
   return {Locals, Arity};
 }
 
+void Executor::recordProfile(
+    const Runtime::Instance::FunctionInstance *Leaf) {
+  std::vector<Profiler::Key> Stack;
+  for (const auto &Frame : StackMgr.getFrames()) {
+    if (Frame.Func) {
+      Stack.push_back(Frame.Func);
+    }
+  }
+  if (Leaf || Stack.empty()) {
+    Stack.push_back(Leaf);
+  }
+  Prof->recordSample(Stack);
+}
+
 Expect<void> Executor::branchToLabel(Runtime::StoreManager &StoreMgr,
                                      const uint32_t Cnt,
                                      AST::InstrView::iterator &PC) {
@@ -163,6 +244,15 @@ Expect<void> Executor::branchToLabel(Runtime::StoreManager &StoreMgr,
     spdlog::error(ErrCode::Interrupted);
     return Unexpect(ErrCode::Interrupted);
   }
+  // Check CPU time limit
+  if (Stat && unlikely(!Stat->checkCPUTime())) {
+    spdlog::error(ErrCode::CPUTimeLimitExceeded);
+    return Unexpect(ErrCode::CPUTimeLimitExceeded);
+  }
+  // Take the pending profile samples
+  if (Prof && unlikely(Prof->hasPendingSample())) {
+    recordProfile(nullptr);
+  }
 
   // Get the L-th label from top of stack and the continuation instruction.
   const auto ContIt = StackMgr.getLabelWithCount(Cnt).Cont;
@@ -184,6 +274,88 @@ Expect<void> Executor::branchToLabel(Runtime::StoreManager &StoreMgr,
   return {};
 }
 
+Expect<void> Executor::throwException(Runtime::StoreManager &StoreMgr,
+                                      Exception Exc,
+                                      AST::InstrView::iterator &PC) {
+  const auto Frames = StackMgr.getFrames();
+  const auto Labels = StackMgr.getLabels();
+
+  // The compiled functions and the outer executions handle the exceptions by
+  // themselves, so only the labels above the top dummy frame, compiled
+  // function frame, or expression frame are searched.
+  uint32_t Base = 0;
+  std::optional<uint32_t> CompiledFrameIdx;
+  for (auto It = Frames.rbegin(); It != Frames.rend(); ++It) {
+    if (It->IsDummy || !It->Func || It->Func->isCompiledFunction()) {
+      Base = It->LStackOff;
+      if (!It->IsDummy && It->Func) {
+        CompiledFrameIdx =
+            static_cast<uint32_t>(std::distance(It, Frames.rend())) - 1;
+      }
+      break;
+    }
+  }
+
+  size_t FrameIdx = Frames.size() - 1;
+  uint32_t Idx = static_cast<uint32_t>(Labels.size());
+  while (Idx > Base) {
+    --Idx;
+    const auto &L = Labels[Idx];
+    if (!L.Try) {
+      continue;
+    }
+    // Get the frame of the label for the module of the tags.
+    while (Frames[FrameIdx].LStackOff > Idx) {
+      --FrameIdx;
+    }
+    const auto TryIt = *L.Try;
+    const auto EndIt = TryIt + TryIt->getJumpEnd();
+    if (EndIt->getOpCode() == OpCode::Delegate) {
+      // Continue searching from the target label of the delegate, which is
+      // counted from the label out of the Try-block.
+      const uint32_t Skip = EndIt->getTargetIndex() + 1;
+      if (Skip > Idx - Base) {
+        break;
+      }
+      Idx = Idx - Skip + 1;
+      continue;
+    }
+    const auto *ModInst = *StoreMgr.getModule(Frames[FrameIdx].ModAddr);
+    for (auto It = TryIt + TryIt->getJumpElse(); It != EndIt;
+         It += It->getJumpCatch()) {
+      if (It->getOpCode() == OpCode::Catch &&
+          *ModInst->getTagAddr(It->getTargetIndex()) != Exc.TagAddr) {
+        continue;
+      }
+      // Unwind the stack to the label and jump to the handler.
+      StackMgr.unwindToLabel(Idx);
+      if (It->getOpCode() == OpCode::Catch) {
+        for (auto &V : Exc.Values) {
+          StackMgr.push(V);
+        }
+      }
+      // Keep the exception for rethrowing in the handler.
+      while (!CaughtExceptions.empty() &&
+             CaughtExceptions.back().first >= Idx) {
+        CaughtExceptions.pop_back();
+      }
+      CaughtExceptions.emplace_back(Idx, std::move(Exc));
+      PC = It;
+      return {};
+    }
+  }
+  if (CompiledFrameIdx) {
+    // Return to the compiled function with the pending exception, which is
+    // checked after the call.
+    StackMgr.unwindToFrame(*CompiledFrameIdx);
+    PendingException = std::move(Exc);
+    HasPendingException = 1;
+    return Unexpect(ErrCode::UncaughtException);
+  }
+  spdlog::error(ErrCode::UncaughtException);
+  return Unexpect(ErrCode::UncaughtException);
+}
+
 Runtime::Instance::TableInstance *
 Executor::getTabInstByIdx(Runtime::StoreManager &StoreMgr, const uint32_t Idx) {
   // When top frame is dummy frame, cannot find instance.
@@ -34,6 +34,9 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &,
     case ExternalType::Table:
       ModInst.exportTable(ExtName, ExtIdx);
       break;
+    case ExternalType::Tag:
+      ModInst.exportTag(ExtName, ExtIdx);
+      break;
     default:
       break;
     }
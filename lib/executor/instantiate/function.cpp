@@ -18,6 +18,8 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
   // Get the function type indices.
   auto TypeIdxs = FuncSec.getContent();
   auto CodeSegs = CodeSec.getContent();
+  // Get the function locals and instructions shared by module instances.
+  const auto &InstData = *ModInst.getInstantiationData();
 
   // Iterate through code segments to make function instances.
   for (uint32_t I = 0; I < CodeSegs.size(); ++I) {
@@ -30,8 +32,8 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
             StoreMgr.pushFunction(ModInst.Addr, *FuncType, std::move(Symbol));
       } else {
         NewFuncInstAddr = StoreMgr.pushFunction(
-            ModInst.Addr, *FuncType, CodeSegs[I].getLocals(),
-            CodeSegs[I].getExpr().getInstrs());
+            ModInst.Addr, *FuncType, InstData.FuncLocals[I],
+            InstData.FuncInstrs[I]);
       }
     } else {
       if (auto Symbol = CodeSegs[I].getSymbol()) {
@@ -39,8 +41,8 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
             StoreMgr.importFunction(ModInst.Addr, *FuncType, std::move(Symbol));
       } else {
         NewFuncInstAddr = StoreMgr.importFunction(
-            ModInst.Addr, *FuncType, CodeSegs[I].getLocals(),
-            CodeSegs[I].getExpr().getInstrs());
+            ModInst.Addr, *FuncType, InstData.FuncLocals[I],
+            InstData.FuncInstrs[I]);
       }
     }
     ModInst.addFuncAddr(NewFuncInstAddr);
@@ -26,10 +26,11 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
   for (const auto &GlobSeg : GlobSec.getContent()) {
     // Insert global instance to store manager.
     uint32_t NewGlobInstAddr;
+    auto GlobType = ModInst.resolveGlobalType(GlobSeg.getGlobalType());
     if (InsMode == InstantiateMode::Instantiate) {
-      NewGlobInstAddr = StoreMgr.pushGlobal(GlobSeg.getGlobalType());
+      NewGlobInstAddr = StoreMgr.pushGlobal(GlobType);
     } else {
-      NewGlobInstAddr = StoreMgr.importGlobal(GlobSeg.getGlobalType());
+      NewGlobInstAddr = StoreMgr.importGlobal(GlobType);
     }
     ModInst.GlobalPtrs[ModInst.getGlobalNum()] =
         &(*StoreMgr.getGlobal(NewGlobInstAddr))->getValue();
@@ -50,6 +50,7 @@ Expect<uint32_t> getImportAddr(std::string_view ModName,
   const auto &TabList = ModInst.getTableExports();
   const auto &MemList = ModInst.getMemExports();
   const auto &GlobList = ModInst.getGlobalExports();
+  const auto &TagList = ModInst.getTagExports();
 
   switch (ExtType) {
   case ExternalType::Function:
@@ -72,6 +73,11 @@ Expect<uint32_t> getImportAddr(std::string_view ModName,
       return GlobList.find(ExtName)->second;
     }
     break;
+  case ExternalType::Tag:
+    if (TagList.find(ExtName) != TagList.cend()) {
+      return TagList.find(ExtName)->second;
+    }
+    break;
   default:
     return logUnknownError(ModName, ExtName, ExtType, Node);
   }
@@ -93,6 +99,10 @@ Expect<uint32_t> getImportAddr(std::string_view ModName,
     return logMatchError(ModName, ExtName, ExtType, Node, ExtType,
                          ExternalType::Global);
   }
+  if (TagList.find(ExtName) != TagList.cend()) {
+    return logMatchError(ModName, ExtName, ExtType, Node, ExtType,
+                         ExternalType::Tag);
+  }
 
   return logUnknownError(ModName, ExtName, ExtType, Node);
 }
@@ -181,7 +191,8 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
     }
     case ExternalType::Global: {
       // Get global type. External type checked in validation.
-      const auto &GlobType = ImpDesc.getExternalGlobalType();
+      const auto GlobType =
+          ModInst.resolveGlobalType(ImpDesc.getExternalGlobalType());
       // Import matching.
       const auto *TargetInst = *StoreMgr.getGlobal(TargetAddr);
       const auto &TargetType = TargetInst->getGlobalType();
@@ -195,6 +206,23 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
       ModInst.importGlobal(TargetAddr);
       break;
     }
+    case ExternalType::Tag: {
+      // Get tag type index. External type checked in validation.
+      uint32_t TypeIdx = ImpDesc.getExternalTagTypeIdx();
+      // Import matching.
+      const auto *TargetInst = *StoreMgr.getTag(TargetAddr);
+      const auto &TargetType = TargetInst->getTagType();
+      const auto *TagType = *ModInst.getFuncType(TypeIdx);
+      if (TargetType != *TagType) {
+        return logMatchError(
+            ModName, ExtName, ExtType, ASTNodeAttr::Desc_Import,
+            TagType->getParamTypes(), TagType->getReturnTypes(),
+            TargetType.getParamTypes(), TargetType.getReturnTypes());
+      }
+      // Set the matched tag address to module instance.
+      ModInst.importTag(TargetAddr);
+      break;
+    }
     default:
       break;
     }
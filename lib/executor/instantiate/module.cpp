@@ -7,11 +7,71 @@
 #include "common/log.h"
 
 #include <cstdint>
+#include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace WasmEdge {
 namespace Executor {
 
+namespace {
+
+/// Read an unsigned LEB128 integer from the custom section content.
+bool readU32(Span<const Byte> Content, size_t &Off, uint32_t &Val) noexcept {
+  Val = 0;
+  for (uint32_t Shift = 0; Shift < 35; Shift += 7) {
+    if (Off >= Content.size()) {
+      return false;
+    }
+    const Byte B = Content[Off++];
+    Val |= static_cast<uint32_t>(B & 0x7FU) << Shift;
+    if ((B & 0x80U) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Parse the function names subsection of the name custom section. The
+/// malformed subsection is ignored as the custom sections are not validated.
+std::unordered_map<uint32_t, std::string>
+parseFunctionNames(Span<const Byte> Content) {
+  std::unordered_map<uint32_t, std::string> Names;
+  size_t Off = 0;
+  while (Off < Content.size()) {
+    const Byte Id = Content[Off++];
+    uint32_t Size;
+    if (!readU32(Content, Off, Size) || Size > Content.size() - Off) {
+      break;
+    }
+    if (Id != 0x01U) {
+      Off += Size;
+      continue;
+    }
+    auto Sub = Content.subspan(Off, Size);
+    size_t SubOff = 0;
+    uint32_t Count;
+    if (!readU32(Sub, SubOff, Count)) {
+      break;
+    }
+    for (uint32_t I = 0; I < Count; ++I) {
+      uint32_t Idx, Len;
+      if (!readU32(Sub, SubOff, Idx) || !readU32(Sub, SubOff, Len) ||
+          Len > Sub.size() - SubOff) {
+        break;
+      }
+      Names.emplace(Idx, std::string(reinterpret_cast<const char *>(
+                                         Sub.data() + SubOff),
+                                     Len));
+      SubOff += Len;
+    }
+    break;
+  }
+  return Names;
+}
+
+} // namespace
+
 // Instantiate module instance. See "include/executor/Executor.h".
 Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
                                    const AST::Module &Mod,
@@ -37,10 +97,8 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
   auto *ModInst = *StoreMgr.getModule(ModInstAddr);
 
   // Instantiate Function Types in Module Instance. (TypeSec)
-  for (auto &FuncType : Mod.getTypeSection().getContent()) {
-    // Copy param and return lists to module instance.
-    ModInst->addFuncType(FuncType);
-  }
+  // The function types and bodies are shared by the instances of the module.
+  ModInst->setInstantiationData(Mod.getInstantiationData());
 
   // Instantiate ImportSection and do import matching. (ImportSec)
   const AST::ImportSection &ImportSec = Mod.getImportSection();
@@ -75,6 +133,14 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
     return Unexpect(Res);
   }
 
+  // Instantiate TagSection (TagSec)
+  const AST::TagSection &TagSec = Mod.getTagSection();
+  if (auto Res = instantiate(StoreMgr, *ModInst, TagSec); !Res) {
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Tag));
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+    return Unexpect(Res);
+  }
+
   // Add a temp module to Store with only imported globals for initialization.
   uint32_t TmpModInstAddr = StoreMgr.pushModule("");
   auto *TmpModInst = *StoreMgr.getModule(TmpModInstAddr);
@@ -110,6 +176,11 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
     return Unexpect(Res);
   }
 
+  // Name the functions in the profile.
+  if (Prof) {
+    registerProfileNames(StoreMgr, *ModInst, Mod);
+  }
+
   // Push a new frame {ModInst, locals:none}
   StackMgr.pushFrame(ModInst->Addr, 0, 0);
 
@@ -174,5 +245,44 @@ Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
   return {};
 }
 
+// Register function names to profiler. See "include/executor/executor.h".
+void Executor::registerProfileNames(
+    Runtime::StoreManager &StoreMgr,
+    const Runtime::Instance::ModuleInstance &ModInst, const AST::Module &Mod) {
+  std::unordered_map<uint32_t, std::string> Names;
+  for (const auto &CustomSec : Mod.getCustomSections()) {
+    if (CustomSec.getName() == "name"sv) {
+      Names = parseFunctionNames(CustomSec.getContent());
+      break;
+    }
+  }
+  // Fall back to the export names for the stripped modules.
+  for (const auto &[ExpName, Idx] : ModInst.getFuncExports()) {
+    Names.try_emplace(Idx, ExpName);
+  }
+
+  std::string Prefix(ModInst.getModuleName());
+  if (!Prefix.empty()) {
+    Prefix += "::"sv;
+  }
+  // The imported functions are named by the modules defining them.
+  for (uint32_t I = ModInst.getFuncImportNum(); I < ModInst.getFuncNum();
+       ++I) {
+    const auto *FuncInst = *StoreMgr.getFunction(*ModInst.getFuncAddr(I));
+    std::string Name = Prefix;
+    if (auto It = Names.find(I); It != Names.end()) {
+      Name += It->second;
+    } else {
+      Name += "func["sv;
+      Name += std::to_string(I);
+      Name += ']';
+    }
+    Prof->setName(FuncInst, std::move(Name));
+    if (FuncInst->isCompiledFunction()) {
+      Prof->addCompiledFunction(FuncInst->getSymbol().get(), FuncInst);
+    }
+  }
+}
+
 } // namespace Executor
 } // namespace WasmEdge
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "executor/executor.h"
+
+#include <cstdint>
+
+namespace WasmEdge {
+namespace Executor {
+
+// Instantiate tag instance. See "include/executor/executor.h".
+Expect<void> Executor::instantiate(Runtime::StoreManager &StoreMgr,
+                                   Runtime::Instance::ModuleInstance &ModInst,
+                                   const AST::TagSection &TagSec) {
+  // Iterate and istantiate tag types.
+  for (const auto &TypeIdx : TagSec.getContent()) {
+    // Insert tag instance to store manager. The type index is checked in
+    // validation.
+    const auto *TagType = *ModInst.getFuncType(TypeIdx);
+    uint32_t NewTagInstAddr;
+    if (InsMode == InstantiateMode::Instantiate) {
+      NewTagInstAddr = StoreMgr.pushTag(*TagType);
+    } else {
+      NewTagInstAddr = StoreMgr.importTag(*TagType);
+    }
+    ModInst.addTagAddr(NewTagInstAddr);
+  }
+  return {};
+}
+
+} // namespace Executor
+} // namespace WasmEdge
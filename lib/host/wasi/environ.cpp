@@ -104,6 +104,36 @@ void Environ::init(Span<const std::string> Dirs, std::string ProgramName,
   ExitCode = 0;
 }
 
+void Environ::setStdIn(VINode::ReadCallback Reader) {
+  auto Node = Reader ? VINode::stream(FS, kStdInDefaultRights,
+                                      kNoInheritingRights, std::move(Reader),
+                                      nullptr)
+                     : VINode::stdIn(FS, kStdInDefaultRights,
+                                     kNoInheritingRights);
+  std::unique_lock<std::shared_mutex> Lock(FdMutex);
+  FdMap.insert_or_assign(0, std::move(Node));
+}
+
+void Environ::setStdOut(VINode::WriteCallback Writer) {
+  auto Node = Writer ? VINode::stream(FS, kStdOutDefaultRights,
+                                      kNoInheritingRights, nullptr,
+                                      std::move(Writer))
+                     : VINode::stdOut(FS, kStdOutDefaultRights,
+                                      kNoInheritingRights);
+  std::unique_lock<std::shared_mutex> Lock(FdMutex);
+  FdMap.insert_or_assign(1, std::move(Node));
+}
+
+void Environ::setStdErr(VINode::WriteCallback Writer) {
+  auto Node = Writer ? VINode::stream(FS, kStdErrDefaultRights,
+                                      kNoInheritingRights, nullptr,
+                                      std::move(Writer))
+                     : VINode::stdErr(FS, kStdErrDefaultRights,
+                                      kNoInheritingRights);
+  std::unique_lock<std::shared_mutex> Lock(FdMutex);
+  FdMap.insert_or_assign(2, std::move(Node));
+}
+
 void Environ::fini() noexcept {
   EnvironVariables.clear();
   Arguments.clear();
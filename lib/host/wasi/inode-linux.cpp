@@ -12,9 +12,12 @@
 #include "host/wasi/vfs.h"
 #include "linux.h"
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include <new>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace WasmEdge {
@@ -23,6 +26,10 @@ namespace WASI {
 
 namespace {
 
+/// Epoll user data of the waker, which is not an index of the events.
+inline constexpr const uint64_t kWakerIndex =
+    std::numeric_limits<uint64_t>::max();
+
 inline constexpr bool isSpecialFd(int Fd) noexcept {
   switch (Fd) {
   case STDIN_FILENO:
@@ -126,6 +133,47 @@ void TimerHolder::reset() noexcept {
   }
 }
 
+Waker::Waker() noexcept
+#if __GLIBC_PREREQ(2, 8)
+    : FdHolder(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+#endif
+{
+}
+
+void Waker::wake() const noexcept {
+  if (likely(ok())) {
+    const uint64_t One = 1;
+    [[maybe_unused]] auto Res = ::write(Fd, &One, sizeof(One));
+  }
+}
+
+void Waker::clear() noexcept {
+  if (likely(ok())) {
+    uint64_t Count;
+    [[maybe_unused]] auto Res = ::read(Fd, &Count, sizeof(Count));
+  }
+}
+
+WasiExpect<void>
+Waker::sleep(std::chrono::nanoseconds Duration) const noexcept {
+  if (unlikely(!ok())) {
+    std::this_thread::sleep_for(Duration);
+    return {};
+  }
+  pollfd PollFd = {Fd, POLLIN, 0};
+  const timespec Timeout = toTimespec(static_cast<__wasi_timestamp_t>(
+      std::max<std::chrono::nanoseconds::rep>(Duration.count(), 0)));
+  if (auto Res = ::ppoll(&PollFd, 1, &Timeout, nullptr); unlikely(Res < 0)) {
+    // Interrupted by signals, let the caller check the time again.
+    if (errno != EINTR) {
+      return WasiUnexpect(fromErrNo(errno));
+    }
+  } else if (Res > 0) {
+    return WasiUnexpect(__WASI_ERRNO_CANCELED);
+  }
+  return {};
+}
+
 void DirHolder::reset() noexcept {
   if (likely(Dir != nullptr)) {
     closedir(Dir);
@@ -154,6 +202,7 @@ WasiExpect<INode> INode::open(std::string Path, __wasi_oflags_t OpenFlags,
       return WasiUnexpect(fromErrNo(errno));
     }
 #endif
+    New.NonBlocking = (FdFlags & __WASI_FDFLAGS_NONBLOCK) != 0;
     return New;
   }
 }
@@ -196,6 +245,8 @@ WasiExpect<void> INode::fdFdstatGet(__wasi_fdstat_t &FdStat) const noexcept {
   } else {
     FdStat.fs_filetype = unsafeFiletype();
 
+    NonBlocking = (FdFlags & O_NONBLOCK) != 0;
+
     FdStat.fs_flags = static_cast<__wasi_fdflags_t>(0);
     if (FdFlags & O_APPEND) {
       FdStat.fs_flags |= __WASI_FDFLAGS_APPEND;
@@ -236,6 +287,7 @@ INode::fdFdstatSetFlags(__wasi_fdflags_t FdFlags) const noexcept {
   if (auto Res = ::fcntl(Fd, F_SETFL, SysFlag); unlikely(Res != 0)) {
     return WasiUnexpect(fromErrNo(errno));
   }
+  NonBlocking = (FdFlags & __WASI_FDFLAGS_NONBLOCK) != 0;
 
   return {};
 }
@@ -703,10 +755,74 @@ WasiExpect<INode> INode::pathOpen(std::string Path, __wasi_oflags_t OpenFlags,
       return WasiUnexpect(fromErrNo(errno));
     }
 #endif
+    New.NonBlocking = (FdFlags & __WASI_FDFLAGS_NONBLOCK) != 0;
     return New;
   }
 }
 
+WasiExpect<INode> INode::pathOpenBeneath(std::string Path,
+                                         uint8_t VFSFlags) const noexcept {
+#if defined(RESOLVE_BENEATH) && defined(SYS_openat2)
+  // Kernels before 5.6 or seccomp filters reject openat2, stop trying.
+  static std::atomic<bool> Unsupported = false;
+  if (Unsupported.load(std::memory_order_relaxed)) {
+    return WasiUnexpect(__WASI_ERRNO_NOSYS);
+  }
+
+  struct open_how How = {};
+  How.flags = static_cast<uint64_t>(openFlags(
+      __WASI_OFLAGS_DIRECTORY, static_cast<__wasi_fdflags_t>(0), VFSFlags));
+  How.resolve =
+      RESOLVE_BENEATH | RESOLVE_NO_MAGICLINKS | RESOLVE_NO_SYMLINKS;
+  if (auto NewFd = ::syscall(SYS_openat2, Fd, Path.c_str(), &How, sizeof(How));
+      unlikely(NewFd < 0)) {
+    if (errno == ENOSYS || errno == EPERM) {
+      Unsupported.store(true, std::memory_order_relaxed);
+    }
+    return WasiUnexpect(fromErrNo(errno));
+  } else {
+    return INode(static_cast<int>(NewFd));
+  }
+#else
+  static_cast<void>(Path);
+  static_cast<void>(VFSFlags);
+  return WasiUnexpect(__WASI_ERRNO_NOSYS);
+#endif
+}
+
+WasiExpect<void> INode::waitReadable(const Waker &W) const noexcept {
+  if (!W.ok()) {
+    return {};
+  }
+  if (auto Res = filetype(); unlikely(!Res)) {
+    return WasiUnexpect(Res);
+  } else if (*Res == __WASI_FILETYPE_REGULAR_FILE ||
+             *Res == __WASI_FILETYPE_DIRECTORY) {
+    return {};
+  }
+  if (!NonBlocking) {
+    if (const int Flags = ::fcntl(Fd, F_GETFL); unlikely(Flags < 0)) {
+      return {};
+    } else {
+      NonBlocking = (Flags & O_NONBLOCK) != 0;
+    }
+  }
+  if (*NonBlocking) {
+    return {};
+  }
+
+  pollfd PollFds[2] = {{Fd, POLLIN, 0}, {W.Fd, POLLIN, 0}};
+  while (unlikely(::poll(PollFds, 2, -1) < 0)) {
+    if (errno != EINTR) {
+      return WasiUnexpect(fromErrNo(errno));
+    }
+  }
+  if (PollFds[1].revents & POLLIN) {
+    return WasiUnexpect(__WASI_ERRNO_CANCELED);
+  }
+  return {};
+}
+
 WasiExpect<void> INode::pathReadlink(std::string Path, Span<char> Buffer,
                                      __wasi_size_t &NRead) const noexcept {
   if (auto Res = ::readlinkat(Fd, Path.c_str(), Buffer.data(), Buffer.size());
@@ -880,6 +996,7 @@ WasiExpect<INode> INode::sockOpen(__wasi_address_family_t AddressFamily,
     return WasiUnexpect(fromErrNo(errno));
   } else {
     INode New(NewFd);
+    New.NonBlocking = false;
     return New;
   }
 }
@@ -933,6 +1050,8 @@ WasiExpect<INode> INode::sockAccept() noexcept {
     return WasiUnexpect(fromErrNo(errno));
   } else {
     INode New(NewFd);
+    // The accepted socket does not inherit the file status flags.
+    New.NonBlocking = false;
     return New;
   }
 }
@@ -1396,10 +1515,26 @@ WasiExpect<void> Poller::write(const INode &Fd,
   return {};
 }
 
+WasiExpect<void> Poller::waker(const Waker &W) noexcept {
+  if (!W.ok()) {
+    return {};
+  }
+  epoll_event EPollEvent;
+  EPollEvent.events = EPOLLIN;
+  EPollEvent.data.u64 = kWakerIndex;
+
+  if (auto Res = ::epoll_ctl(this->Fd, EPOLL_CTL_ADD, W.Fd, &EPollEvent);
+      unlikely(Res < 0)) {
+    return WasiUnexpect(fromErrNo(errno));
+  }
+  return {};
+}
+
 WasiExpect<void> Poller::wait(CallbackType Callback) noexcept {
   std::vector<struct epoll_event> EPollEvents;
   try {
-    EPollEvents.resize(Events.size());
+    // One more for the waker.
+    EPollEvents.resize(Events.size() + 1);
   } catch (std::bad_alloc &) {
     return WasiUnexpect(__WASI_ERRNO_NOMEM);
   }
@@ -1408,6 +1543,12 @@ WasiExpect<void> Poller::wait(CallbackType Callback) noexcept {
   if (unlikely(Count < 0)) {
     return WasiUnexpect(fromErrNo(errno));
   }
+  if (std::any_of(EPollEvents.begin(), EPollEvents.begin() + Count,
+                  [](const epoll_event &EPollEvent) {
+                    return EPollEvent.data.u64 == kWakerIndex;
+                  })) {
+    return WasiUnexpect(__WASI_ERRNO_CANCELED);
+  }
   for (int I = 0; I < Count; ++I) {
     auto &EPollEvent = EPollEvents[I];
     const auto Index = EPollEvent.data.u64;
@@ -16,6 +16,7 @@
 #include <new>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <vector>
 
 namespace WasmEdge {
@@ -100,6 +101,18 @@ void FdHolder::reset() noexcept {
   }
 }
 
+Waker::Waker() noexcept = default;
+
+void Waker::wake() const noexcept {}
+
+void Waker::clear() noexcept {}
+
+WasiExpect<void>
+Waker::sleep(std::chrono::nanoseconds Duration) const noexcept {
+  std::this_thread::sleep_for(Duration);
+  return {};
+}
+
 void DirHolder::reset() noexcept {
   if (likely(Dir != nullptr)) {
     closedir(Dir);
@@ -668,6 +681,15 @@ WasiExpect<INode> INode::pathOpen(std::string Path, __wasi_oflags_t OpenFlags,
   }
 }
 
+WasiExpect<INode> INode::pathOpenBeneath(std::string,
+                                         uint8_t) const noexcept {
+  return WasiUnexpect(__WASI_ERRNO_NOSYS);
+}
+
+WasiExpect<void> INode::waitReadable(const Waker &) const noexcept {
+  return {};
+}
+
 WasiExpect<void> INode::pathReadlink(std::string Path, Span<char> Buffer,
                                      __wasi_size_t &NRead) const noexcept {
   if (auto Res = ::readlinkat(Fd, Path.c_str(), Buffer.data(), Buffer.size());
@@ -1094,6 +1116,8 @@ WasiExpect<void> Poller::write(const INode &Node,
   return {};
 }
 
+WasiExpect<void> Poller::waker(const Waker &) noexcept { return {}; }
+
 WasiExpect<void> Poller::wait(CallbackType Callback) noexcept {
   std::vector<struct kevent> KEvents;
   try {
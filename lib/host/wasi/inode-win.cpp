@@ -9,6 +9,7 @@
 #include "host/wasi/inode.h"
 #include "host/wasi/vfs.h"
 #include "win.h"
+#include <thread>
 
 namespace WasmEdge {
 namespace Host {
@@ -27,6 +28,18 @@ void HandleHolder::reset() noexcept {
   }
 }
 
+Waker::Waker() noexcept = default;
+
+void Waker::wake() const noexcept {}
+
+void Waker::clear() noexcept {}
+
+WasiExpect<void>
+Waker::sleep(std::chrono::nanoseconds Duration) const noexcept {
+  std::this_thread::sleep_for(Duration);
+  return {};
+}
+
 INode INode::stdIn() noexcept {
   return INode(winapi::GetStdHandle(winapi::STD_INPUT_HANDLE_));
 }
@@ -158,6 +171,15 @@ WasiExpect<INode> INode::pathOpen(std::string, __wasi_oflags_t,
   return WasiUnexpect(__WASI_ERRNO_NOSYS);
 }
 
+WasiExpect<INode> INode::pathOpenBeneath(std::string,
+                                         uint8_t) const noexcept {
+  return WasiUnexpect(__WASI_ERRNO_NOSYS);
+}
+
+WasiExpect<void> INode::waitReadable(const Waker &) const noexcept {
+  return {};
+}
+
 WasiExpect<void> INode::pathReadlink(std::string, Span<char>,
                                      __wasi_size_t &) const noexcept {
   return WasiUnexpect(__WASI_ERRNO_NOSYS);
@@ -280,6 +302,8 @@ WasiExpect<void> Poller::write(const INode &, __wasi_userdata_t) noexcept {
   return WasiUnexpect(__WASI_ERRNO_NOSYS);
 }
 
+WasiExpect<void> Poller::waker(const Waker &) noexcept { return {}; }
+
 WasiExpect<void> Poller::wait(CallbackType) noexcept {
   return WasiUnexpect(__WASI_ERRNO_NOSYS);
 }
@@ -19,6 +19,7 @@
 #include <ctime>
 #include <dirent.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sched.h>
 #include <sys/epoll.h>
 #include <sys/ioctl.h>
@@ -43,9 +44,15 @@
 #endif
 
 #if __GLIBC_PREREQ(2, 8)
+#include <sys/eventfd.h>
 #include <sys/timerfd.h>
 #endif
 
+#if __has_include(<linux/openat2.h>)
+#include <linux/openat2.h>
+#include <sys/syscall.h>
+#endif
+
 namespace WasmEdge {
 namespace Host {
 namespace WASI {
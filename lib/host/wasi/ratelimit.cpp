@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "host/wasi/ratelimit.h"
+#include "common/errcode.h"
+#include "runtime/hostfunc.h"
+#include <algorithm>
+
+namespace WasmEdge {
+namespace Host {
+namespace WASI {
+
+void RateLimiter::Bucket::refill(Clock::duration Elapsed) noexcept {
+  if (Rate == 0) {
+    return;
+  }
+  const double Seconds = std::chrono::duration<double>(Elapsed).count();
+  Tokens = std::min(Burst, Tokens + Seconds * static_cast<double>(Rate));
+}
+
+RateLimiter::Clock::duration
+RateLimiter::Bucket::deficit(double Want) const noexcept {
+  if (Rate == 0 || Tokens >= Want) {
+    return Clock::duration::zero();
+  }
+  return std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>((Want - Tokens) /
+                                    static_cast<double>(Rate)));
+}
+
+void RateLimiter::setLimit(const IOLimit &Limit) noexcept {
+  std::unique_lock Lock(Mutex);
+  const auto Init = [](Bucket &B, uint64_t Rate, uint64_t Burst) {
+    B.Rate = Rate;
+    B.Burst = static_cast<double>(std::max<uint64_t>(
+        Burst != 0 ? Burst : Rate, UINT64_C(1)));
+    B.Tokens = B.Burst;
+  };
+  Init(Bytes, Limit.BytesPerSecond, Limit.BytesBurst);
+  Init(Ops, Limit.OpsPerSecond, Limit.OpsBurst);
+  Enabled = Limit.BytesPerSecond != 0 || Limit.OpsPerSecond != 0;
+  Blocking = Limit.Blocking;
+  Last = Clock::now();
+}
+
+WasiExpect<uint64_t> RateLimiter::acquire(uint64_t Want,
+                                          const Waker &W) noexcept {
+  bool Throttled = false;
+  std::unique_lock Lock(Mutex);
+  while (true) {
+    const auto Now = Clock::now();
+    Bytes.refill(Now - Last);
+    Ops.refill(Now - Last);
+    Last = Now;
+
+    const double WantBytes = Want != 0 ? 1.0 : 0.0;
+    const auto Wait = std::max(Bytes.deficit(WantBytes), Ops.deficit(1.0));
+    if (Wait == Clock::duration::zero()) {
+      uint64_t Granted = Want;
+      if (Bytes.Rate != 0) {
+        Granted = std::min(Granted, static_cast<uint64_t>(Bytes.Tokens));
+        Bytes.Tokens -= static_cast<double>(Granted);
+      }
+      if (Ops.Rate != 0) {
+        Ops.Tokens -= 1.0;
+      }
+      return Granted;
+    }
+
+    if (!Throttled) {
+      Throttled = true;
+      Runtime::HostFunctionBase::addWork(HostWork::ThrottledOps, 1);
+    }
+    if (!Blocking) {
+      return WasiUnexpect(__WASI_ERRNO_AGAIN);
+    }
+
+    Lock.unlock();
+    const auto Start = Clock::now();
+    auto Res = W.sleep(Wait);
+    Runtime::HostFunctionBase::addWork(
+        HostWork::ThrottledNanos,
+        static_cast<uint64_t>(std::chrono::nanoseconds(Clock::now() - Start)
+                                  .count()));
+    if (unlikely(!Res)) {
+      return WasiUnexpect(Res);
+    }
+    Lock.lock();
+  }
+}
+
+void RateLimiter::release(uint64_t Unused) noexcept {
+  if (Unused == 0) {
+    return;
+  }
+  std::unique_lock Lock(Mutex);
+  if (Bytes.Rate != 0) {
+    Bytes.Tokens =
+        std::min(Bytes.Burst, Bytes.Tokens + static_cast<double>(Unused));
+  }
+}
+
+} // namespace WASI
+} // namespace Host
+} // namespace WasmEdge
@@ -8,6 +8,7 @@
 #include "host/wasi/vfs.h"
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <numeric>
 #include <string>
 
@@ -21,12 +22,74 @@ namespace {
 
 static inline constexpr const uint8_t kMaxNestedLinks = 8;
 
+/// Count the directory levels of the path, or 0 if the path contains the
+/// `.` or `..` parts which the kernel should not resolve.
+uint32_t countPlainParts(std::string_view Path) noexcept {
+  uint32_t Count = 0;
+  while (!Path.empty()) {
+    const auto Part = Path.substr(0, Path.find('/'));
+    if (Part == "."sv || Part == ".."sv) {
+      return 0;
+    }
+    if (!Part.empty()) {
+      ++Count;
+    }
+    Path = Path.substr(std::min(Part.size() + 1, Path.size()));
+  }
+  return Count;
 }
 
-VINode::VINode(VFS &FS, INode Node, std::shared_ptr<VINode> Parent)
+/// Directory entry collected for the recursive walk.
+struct WalkChild {
+  std::string Name;
+  __wasi_filetype_t Type;
+};
+
+/// Read all the entries of a directory except `.` and `..`.
+WasiExpect<std::vector<WalkChild>> readAllEntries(INode &Node) noexcept {
+  std::vector<WalkChild> Children;
+  std::vector<uint8_t> Buffer(4096);
+  __wasi_dircookie_t Cookie = 0;
+  while (true) {
+    __wasi_size_t Size;
+    if (auto Res = Node.fdReaddir(Buffer, Cookie, Size); unlikely(!Res)) {
+      return WasiUnexpect(Res);
+    }
+    size_t Offset = 0;
+    bool Progress = false;
+    while (Size - Offset >= sizeof(__wasi_dirent_t)) {
+      __wasi_dirent_t Dirent;
+      std::memcpy(&Dirent, Buffer.data() + Offset, sizeof(Dirent));
+      if (Size - Offset - sizeof(Dirent) < Dirent.d_namlen) {
+        break;
+      }
+      std::string_view Name(reinterpret_cast<const char *>(Buffer.data()) +
+                                Offset + sizeof(Dirent),
+                            Dirent.d_namlen);
+      if (Name != "."sv && Name != ".."sv) {
+        Children.push_back({std::string(Name), Dirent.d_type});
+      }
+      Offset += sizeof(Dirent) + Dirent.d_namlen;
+      Cookie = Dirent.d_next;
+      Progress = true;
+    }
+    if (Size < Buffer.size() && Offset == Size) {
+      return Children;
+    }
+    if (!Progress) {
+      // The entry is larger than the buffer.
+      Buffer.resize(Buffer.size() * 2);
+    }
+  }
+}
+
+}
+
+VINode::VINode(VFS &FS, INode Node, std::shared_ptr<VINode> Parent,
+               uint32_t Depth)
     : FS(FS), Node(std::move(Node)), FsRightsBase(Parent->FsRightsBase),
-      FsRightsInheriting(Parent->FsRightsInheriting),
-      Parent(std::move(Parent)) {}
+      FsRightsInheriting(Parent->FsRightsInheriting), Parent(std::move(Parent)),
+      Depth(Depth) {}
 
 VINode::VINode(VFS &FS, INode Node, __wasi_rights_t FRB, __wasi_rights_t FRI,
                std::string N)
@@ -51,6 +114,63 @@ std::shared_ptr<VINode> VINode::stdErr(VFS &FS, __wasi_rights_t FRB,
   return Node;
 }
 
+std::shared_ptr<VINode> VINode::stream(VFS &FS, __wasi_rights_t FRB,
+                                       __wasi_rights_t FRI, ReadCallback Reader,
+                                       WriteCallback Writer) {
+  auto Node = std::make_shared<VINode>(FS, INode(), FRB, FRI);
+  Node->Stream = std::make_shared<const StreamCallbacks>(
+      StreamCallbacks{std::move(Reader), std::move(Writer)});
+  return Node;
+}
+
+WasiExpect<void> VINode::streamRead(Span<Span<uint8_t>> IOVs,
+                                    __wasi_size_t &NRead) const noexcept {
+  if (unlikely(!Stream->Read)) {
+    return WasiUnexpect(__WASI_ERRNO_BADF);
+  }
+  NRead = 0;
+  for (auto &IOV : IOVs) {
+    if (auto Res = Stream->Read(IOV); unlikely(!Res)) {
+      // Like readv and writev, report the error only if nothing has been
+      // transferred yet.
+      if (NRead == 0) {
+        return WasiUnexpect(Res);
+      }
+      break;
+    } else {
+      NRead += *Res;
+      if (*Res < IOV.size()) {
+        break;
+      }
+    }
+  }
+  return {};
+}
+
+WasiExpect<void> VINode::streamWrite(Span<Span<const uint8_t>> IOVs,
+                                     __wasi_size_t &NWritten) const noexcept {
+  if (unlikely(!Stream->Write)) {
+    return WasiUnexpect(__WASI_ERRNO_BADF);
+  }
+  NWritten = 0;
+  for (auto &IOV : IOVs) {
+    if (auto Res = Stream->Write(IOV); unlikely(!Res)) {
+      // Like readv and writev, report the error only if nothing has been
+      // transferred yet.
+      if (NWritten == 0) {
+        return WasiUnexpect(Res);
+      }
+      break;
+    } else {
+      NWritten += *Res;
+      if (*Res < IOV.size()) {
+        break;
+      }
+    }
+  }
+  return {};
+}
+
 std::string VINode::canonicalGuest(std::string_view Path) {
   std::vector<std::string_view> Parts;
 
@@ -140,6 +260,98 @@ WasiExpect<void> VINode::pathFilestatGet(VFS &FS, std::shared_ptr<VINode> Fd,
   return Fd->Node.pathFilestatGet(std::string(Path), Filestat);
 }
 
+WasiExpect<void> VINode::pathWalk(VFS &FS, std::shared_ptr<VINode> Fd,
+                                  std::string_view Path,
+                                  __wasi_lookupflags_t Flags,
+                                  uint32_t MaxDepth, Span<uint8_t> Buffer,
+                                  __wasi_dircookie_t Cookie,
+                                  __wasi_size_t &Size) {
+  std::vector<char> PathBuffer;
+  if (auto Res = resolvePath(FS, Fd, Path, Flags); unlikely(!Res)) {
+    return WasiUnexpect(Res);
+  } else if (!Fd->can(__WASI_RIGHTS_PATH_OPEN,
+                      __WASI_RIGHTS_FD_READDIR |
+                          __WASI_RIGHTS_PATH_FILESTAT_GET)) {
+    return WasiUnexpect(__WASI_ERRNO_NOTCAPABLE);
+  } else {
+    PathBuffer = std::move(*Res);
+  }
+
+  struct Level {
+    INode Node;
+    std::string Prefix;
+    std::vector<WalkChild> Children;
+    size_t Next = 0;
+  };
+  std::vector<Level> Stack;
+  if (auto Res = Fd->Node.pathOpen(std::string(Path), __WASI_OFLAGS_DIRECTORY,
+                                   static_cast<__wasi_fdflags_t>(0), VFS::Read);
+      unlikely(!Res)) {
+    return WasiUnexpect(Res);
+  } else if (auto Children = readAllEntries(*Res); unlikely(!Children)) {
+    return WasiUnexpect(Children);
+  } else {
+    Stack.push_back({std::move(*Res), std::string(), std::move(*Children)});
+  }
+
+  const size_t BufferSize = Buffer.size();
+  __wasi_dircookie_t Index = 0;
+  while (!Stack.empty()) {
+    auto &Top = Stack.back();
+    if (Top.Next == Top.Children.size()) {
+      Stack.pop_back();
+      continue;
+    }
+    const auto &Child = Top.Children[Top.Next++];
+    const auto Depth = static_cast<uint32_t>(Stack.size());
+
+    if (++Index > Cookie) {
+      WalkEntry Entry;
+      if (auto Res = Top.Node.pathFilestatGet(Child.Name, Entry.Stat);
+          unlikely(!Res)) {
+        if (Res.error() == __WASI_ERRNO_NOENT) {
+          // Removed after the directory was read.
+          continue;
+        }
+        return WasiUnexpect(Res);
+      }
+      const std::string Name = Top.Prefix + Child.Name;
+      Entry.Next = Index;
+      Entry.NameLen = static_cast<__wasi_size_t>(Name.size());
+      Entry.Depth = Depth;
+
+      const auto *Header = reinterpret_cast<const uint8_t *>(&Entry);
+      const size_t HeaderSize = std::min(sizeof(Entry), Buffer.size());
+      std::copy_n(Header, HeaderSize, Buffer.begin());
+      Buffer = Buffer.subspan(HeaderSize);
+      const size_t NameSize = std::min(Name.size(), Buffer.size());
+      std::copy_n(Name.begin(), NameSize, Buffer.begin());
+      Buffer = Buffer.subspan(NameSize);
+      if (HeaderSize + NameSize < sizeof(Entry) + Name.size()) {
+        break;
+      }
+    }
+
+    if (Child.Type == __WASI_FILETYPE_DIRECTORY &&
+        (MaxDepth == 0 || Depth < MaxDepth)) {
+      // Skip the subdirectories which cannot be read.
+      if (auto Res = Top.Node.pathOpen(Child.Name, __WASI_OFLAGS_DIRECTORY,
+                                       static_cast<__wasi_fdflags_t>(0),
+                                       VFS::Read);
+          Res) {
+        if (auto Children = readAllEntries(*Res); Children) {
+          std::string Prefix = Top.Prefix + Child.Name + '/';
+          Stack.push_back(
+              {std::move(*Res), std::move(Prefix), std::move(*Children)});
+        }
+      }
+    }
+  }
+
+  Size = static_cast<__wasi_size_t>(BufferSize - Buffer.size());
+  return {};
+}
+
 WasiExpect<void>
 VINode::pathFilestatSetTimes(VFS &FS, std::shared_ptr<VINode> Fd,
                              std::string_view Path, __wasi_lookupflags_t Flags,
@@ -420,6 +632,21 @@ VINode::resolvePath(VFS &FS, std::shared_ptr<VINode> &Fd,
       return WasiUnexpect(__WASI_ERRNO_ACCES);
     }
 
+    // Let the kernel resolve the leading directories confined beneath Fd in
+    // one syscall. Fall back to the walk below for the symbolic links, the
+    // `..` parts, the errors, and the systems without the support.
+    if (const auto Slash = Path.rfind('/');
+        Slash != std::string_view::npos && Slash + 1 < Path.size()) {
+      const auto Prefix = Path.substr(0, Slash);
+      if (const auto Depth = countPlainParts(Prefix); Depth > 0) {
+        if (auto Res = Fd->Node.pathOpenBeneath(std::string(Prefix), VFSFlags);
+            Res) {
+          Fd = std::make_shared<VINode>(FS, std::move(*Res), Fd, Depth);
+          Path = Path.substr(Slash + 1);
+        }
+      }
+    }
+
     do {
       // check self type
       auto Slash = Path.find('/');
@@ -439,7 +666,18 @@ VINode::resolvePath(VFS &FS, std::shared_ptr<VINode> &Fd,
           continue;
         }
         if (Part.size() == 2 && Part[1] == '.') {
-          if (Fd->Parent) {
+          if (Fd->Depth > 1) {
+            // The intermediate directories are not opened, ask the kernel.
+            if (auto Res = Fd->Node.pathOpen(
+                    ".."s, __WASI_OFLAGS_DIRECTORY,
+                    static_cast<__wasi_fdflags_t>(0), VFSFlags);
+                unlikely(!Res)) {
+              return WasiUnexpect(Res);
+            } else {
+              Fd = std::make_shared<VINode>(FS, std::move(*Res), Fd->Parent,
+                                            Fd->Depth - 1);
+            }
+          } else if (Fd->Parent) {
             Fd = Fd->Parent;
           } else {
             return WasiUnexpect(__WASI_ERRNO_NOTCAPABLE);
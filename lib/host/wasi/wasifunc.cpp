@@ -8,6 +8,8 @@
 #include "runtime/instance/memory.h"
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstring>
 #include <limits>
 #include <numeric>
 #include <type_traits>
@@ -29,6 +31,38 @@ inline __wasi_size_t calculateBufferSize(const Container &Array) noexcept {
   return std::accumulate(Lengths.begin(), Lengths.end(), UINT32_C(0));
 }
 
+/// Count the entries whose headers of type `EntryT` are filled in the buffer.
+template <typename EntryT, typename NameLenT>
+inline uint64_t countEntries(Span<const uint8_t> Buf,
+                             size_t NameLenOffset) noexcept {
+  uint64_t Count = 0;
+  size_t Offset = 0;
+  while (Buf.size() - Offset >= sizeof(EntryT)) {
+    NameLenT NameLen;
+    std::memcpy(&NameLen, Buf.data() + Offset + NameLenOffset,
+                sizeof(NameLen));
+    ++Count;
+    Offset += sizeof(EntryT);
+    Offset += std::min<size_t>(NameLen, Buf.size() - Offset);
+  }
+  return Count;
+}
+
+/// Count the directory entries whose headers are filled in the buffer.
+inline uint64_t countDirEntries(Span<const uint8_t> Buf) noexcept {
+  return countEntries<__wasi_dirent_t, __wasi_dirnamlen_t>(
+      Buf, offsetof(__wasi_dirent_t, d_namlen));
+}
+
+/// Count the walk entries whose headers are filled in the buffer.
+inline uint64_t countWalkEntries(Span<const uint8_t> Buf) noexcept {
+  return countEntries<WASI::WalkEntry, __wasi_size_t>(
+      Buf, offsetof(WASI::WalkEntry, NameLen));
+}
+
+/// Maximum number of paths inspected in one batched call.
+static inline constexpr const uint32_t kFilestatBatchMax = 4096;
+
 template <typename T> struct WasiRawType {
   using Type = std::underlying_type_t<T>;
 };
@@ -39,6 +73,15 @@ template <> struct WasiRawType<uint64_t> { using Type = uint64_t; };
 
 template <typename T> using WasiRawTypeT = typename WasiRawType<T>::Type;
 
+/// Trap the blocking calls woken up by the stop request, or return the errno.
+inline Expect<uint32_t> blockingResult(__wasi_errno_t Errno) noexcept {
+  if (unlikely(Errno == __WASI_ERRNO_CANCELED)) {
+    spdlog::error(ErrCode::Interrupted);
+    return Unexpect(ErrCode::Interrupted);
+  }
+  return Errno;
+}
+
 template <typename T> WASI::WasiExpect<T> cast(uint64_t) noexcept;
 
 template <>
@@ -681,8 +724,9 @@ Expect<uint32_t> WasiFdPread::body(Runtime::Instance::MemoryInstance *MemInst,
   if (auto Res = Env.fdPread(WasiFd, {WasiIOVs.data(), WasiIOVsLen}, WasiOffset,
                              *NRead);
       unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   }
+  addWork(HostWork::Bytes, *NRead);
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -785,8 +829,9 @@ Expect<uint32_t> WasiFdPwrite::body(Runtime::Instance::MemoryInstance *MemInst,
   if (auto Res = Env.fdPwrite(WasiFd, {WasiIOVs.data(), WasiIOVsLen},
                               WasiOffset, *NWritten);
       unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   }
+  addWork(HostWork::Bytes, *NWritten);
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -841,8 +886,9 @@ Expect<uint32_t> WasiFdRead::body(Runtime::Instance::MemoryInstance *MemInst,
 
   if (auto Res = Env.fdRead(WasiFd, {WasiIOVs.data(), WasiIOVsLen}, *NRead);
       unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   }
+  addWork(HostWork::Bytes, *NRead);
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -875,6 +921,8 @@ Expect<uint32_t> WasiFdReadDir::body(Runtime::Instance::MemoryInstance *MemInst,
       unlikely(!Res)) {
     return Res.error();
   }
+  addWork(HostWork::DirEntries,
+          countDirEntries({Buf, std::min(*NRead, WasiBufLen)}));
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -1005,8 +1053,9 @@ Expect<uint32_t> WasiFdWrite::body(Runtime::Instance::MemoryInstance *MemInst,
 
   if (auto Res = Env.fdWrite(WasiFd, {WasiIOVs.data(), WasiIOVsLen}, *NWritten);
       unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   }
+  addWork(HostWork::Bytes, *NWritten);
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -1418,6 +1467,7 @@ WasiPollOneoff::body(Runtime::Instance::MemoryInstance *MemInst, uint32_t InPtr,
   }
 
   __wasi_size_t EventCount = 0;
+  addWork(HostWork::Subscriptions, WasiNSub);
 
   if (auto Poll = Env.pollOneoff(WasiNSub); unlikely(!Poll)) {
     return Poll.error();
@@ -1504,7 +1554,7 @@ WasiPollOneoff::body(Runtime::Instance::MemoryInstance *MemInst, uint32_t InPtr,
     }
 
     if (auto Res = Poll->wait(Record); unlikely(!Res)) {
-      return Res.error();
+      return blockingResult(Res.error());
     }
   }
 
@@ -1557,6 +1607,7 @@ Expect<uint32_t> WasiRandomGet::body(Runtime::Instance::MemoryInstance *MemInst,
   if (auto Res = Env.randomGet({Buf, WasiBufLen}); unlikely(!Res)) {
     return Res.error();
   }
+  addWork(HostWork::Bytes, WasiBufLen);
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -1656,7 +1707,7 @@ WasiSockAccept::body(Runtime::Instance::MemoryInstance *MemInst, int32_t Fd,
   const __wasi_fd_t WasiFd = Fd;
 
   if (auto Res = Env.sockAccept(WasiFd); unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   } else {
     *RoFd = *Res;
   }
@@ -1763,8 +1814,9 @@ Expect<uint32_t> WasiSockRecv::body(Runtime::Instance::MemoryInstance *MemInst,
   if (auto Res = Env.sockRecv(WasiFd, {WasiRiData.data(), WasiRiDataLen},
                               WasiRiFlags, *RoDataLen, *RoFlags);
       unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   }
+  addWork(HostWork::Bytes, *RoDataLen);
 
   return __WASI_ERRNO_SUCCESS;
 }
@@ -1829,8 +1881,9 @@ Expect<uint32_t> WasiSockSend::body(Runtime::Instance::MemoryInstance *MemInst,
   if (auto Res = Env.sockSend(WasiFd, {WasiSiData.data(), WasiSiDataLen},
                               WasiSiFlags, *SoDataLen);
       unlikely(!Res)) {
-    return Res.error();
+    return blockingResult(Res.error());
   }
+  addWork(HostWork::Bytes, *SoDataLen);
   return __WASI_ERRNO_SUCCESS;
 }
 
@@ -2083,5 +2136,112 @@ WasiSockGetPeerAddr::body(Runtime::Instance::MemoryInstance *MemInst,
   return __WASI_ERRNO_SUCCESS;
 }
 
+Expect<uint32_t> WasiPathFilestatGetBatch::body(
+    Runtime::Instance::MemoryInstance *MemInst, int32_t Fd, uint32_t Flags,
+    uint32_t PathsPtr, uint32_t PathsLen, uint32_t /* Out */ FilestatsPtr,
+    uint32_t /* Out */ ErrnosPtr) {
+  // Check memory instance from module.
+  if (MemInst == nullptr) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  __wasi_lookupflags_t WasiFlags;
+  if (auto Res = cast<__wasi_lookupflags_t>(Flags); unlikely(!Res)) {
+    return Res.error();
+  } else {
+    WasiFlags = *Res;
+  }
+
+  const __wasi_size_t WasiPathsLen = PathsLen;
+  if (unlikely(WasiPathsLen > kFilestatBatchMax)) {
+    return __WASI_ERRNO_INVAL;
+  }
+
+  auto *const Paths =
+      MemInst->getPointer<const __wasi_ciovec_t *>(PathsPtr, WasiPathsLen);
+  if (unlikely(Paths == nullptr)) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  auto *const Filestats =
+      MemInst->getPointer<__wasi_filestat_t *>(FilestatsPtr, WasiPathsLen);
+  if (unlikely(Filestats == nullptr)) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  auto *const Errnos =
+      MemInst->getPointer<__wasi_errno_t *>(ErrnosPtr, WasiPathsLen);
+  if (unlikely(Errnos == nullptr)) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  const __wasi_fd_t WasiFd = Fd;
+
+  for (__wasi_size_t I = 0; I < WasiPathsLen; ++I) {
+    const __wasi_size_t WasiPathLen = Paths[I].buf_len;
+    auto *const Path =
+        MemInst->getPointer<const char *>(Paths[I].buf, WasiPathLen);
+    if (unlikely(Path == nullptr)) {
+      Errnos[I] = __WASI_ERRNO_FAULT;
+    } else if (auto Res = Env.pathFilestatGet(WasiFd, {Path, WasiPathLen},
+                                              WasiFlags, Filestats[I]);
+               unlikely(!Res)) {
+      Errnos[I] = Res.error();
+    } else {
+      Errnos[I] = __WASI_ERRNO_SUCCESS;
+    }
+  }
+  addWork(HostWork::DirEntries, WasiPathsLen);
+  return __WASI_ERRNO_SUCCESS;
+}
+
+Expect<uint32_t> WasiPathWalk::body(Runtime::Instance::MemoryInstance *MemInst,
+                                    int32_t Fd, uint32_t Flags,
+                                    uint32_t PathPtr, uint32_t PathLen,
+                                    uint32_t MaxDepth, uint32_t BufPtr,
+                                    uint32_t BufLen, uint64_t Cookie,
+                                    uint32_t /* Out */ NReadPtr) {
+  // Check memory instance from module.
+  if (MemInst == nullptr) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  __wasi_lookupflags_t WasiFlags;
+  if (auto Res = cast<__wasi_lookupflags_t>(Flags); unlikely(!Res)) {
+    return Res.error();
+  } else {
+    WasiFlags = *Res;
+  }
+
+  const __wasi_size_t WasiPathLen = PathLen;
+  auto *const Path = MemInst->getPointer<const char *>(PathPtr, WasiPathLen);
+  if (unlikely(Path == nullptr)) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  const __wasi_size_t WasiBufLen = BufLen;
+  auto *const Buf = MemInst->getPointer<uint8_t *>(BufPtr, WasiBufLen);
+  if (unlikely(Buf == nullptr)) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  auto *const NRead = MemInst->getPointer<__wasi_size_t *>(NReadPtr);
+  if (unlikely(NRead == nullptr)) {
+    return __WASI_ERRNO_FAULT;
+  }
+
+  const __wasi_fd_t WasiFd = Fd;
+  const __wasi_dircookie_t WasiCookie = Cookie;
+
+  if (auto Res = Env.pathWalk(WasiFd, {Path, WasiPathLen}, WasiFlags, MaxDepth,
+                              {Buf, WasiBufLen}, WasiCookie, *NRead);
+      unlikely(!Res)) {
+    return Res.error();
+  }
+  addWork(HostWork::DirEntries,
+          countWalkEntries({Buf, std::min(*NRead, WasiBufLen)}));
+  return __WASI_ERRNO_SUCCESS;
+}
+
 } // namespace Host
 } // namespace WasmEdge
@@ -74,5 +74,12 @@ WasiModule::WasiModule() : ImportObject("wasi_snapshot_preview1") {
   addHostFunc("sock_getaddrinfo", std::make_unique<WasiGetAddrinfo>(Env));
 }
 
+WasmEdgeFsModule::WasmEdgeFsModule(WASI::Environ &Env)
+    : ImportObject("wasmedge_fs") {
+  addHostFunc("path_filestat_get_batch",
+              std::make_unique<WasiPathFilestatGetBatch>(Env));
+  addHostFunc("path_walk", std::make_unique<WasiPathWalk>(Env));
+}
+
 } // namespace Host
 } // namespace WasmEdge
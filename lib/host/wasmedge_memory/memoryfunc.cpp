@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "host/wasmedge_memory/memoryfunc.h"
+
+#include "common/log.h"
+#include "runtime/instance/memory.h"
+
+namespace WasmEdge {
+namespace Host {
+
+Expect<void>
+WasmEdgeMemoryDiscard::body(Runtime::Instance::MemoryInstance *MemInst,
+                            uint32_t Offset, uint32_t Length) {
+  using MemoryInstance = Runtime::Instance::MemoryInstance;
+  // Check memory instance from module.
+  if (MemInst == nullptr) {
+    return Unexpect(ErrCode::ExecutionFailed);
+  }
+
+  // As the memory-discard proposal, the range should be page aligned and in
+  // the memory boundary. Otherwise, trap.
+  if (Offset % MemoryInstance::kPageSize != 0 ||
+      Length % MemoryInstance::kPageSize != 0 ||
+      !MemInst->checkAccessBound(Offset, Length)) {
+    spdlog::error(ErrCode::MemoryOutOfBounds);
+    spdlog::error(
+        ErrInfo::InfoBoundary(Offset, Length, MemInst->getBoundIdx()));
+    return Unexpect(ErrCode::MemoryOutOfBounds);
+  }
+  if (!MemInst->discardPage(
+          static_cast<uint32_t>(Offset / MemoryInstance::kPageSize),
+          static_cast<uint32_t>(Length / MemoryInstance::kPageSize))) {
+    return Unexpect(ErrCode::ExecutionFailed);
+  }
+  return {};
+}
+
+} // namespace Host
+} // namespace WasmEdge
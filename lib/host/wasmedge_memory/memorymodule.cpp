@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "host/wasmedge_memory/memorymodule.h"
+
+#include "host/wasmedge_memory/memoryfunc.h"
+
+#include <memory>
+
+namespace WasmEdge {
+namespace Host {
+
+WasmEdgeMemoryModule::WasmEdgeMemoryModule()
+    : ImportObject("wasmedge_memory") {
+  addHostFunc("wasmedge_memory_discard",
+              std::make_unique<WasmEdgeMemoryDiscard>());
+}
+
+} // namespace Host
+} // namespace WasmEdge
@@ -66,6 +66,30 @@ Expect<void> Loader::loadDesc(AST::ImportDesc &ImpDesc) {
     }
     return {};
   }
+  case ExternalType::Tag: {
+    // Import the tags are for ExceptionHandling proposal.
+    if (unlikely(!Conf.hasProposal(Proposal::ExceptionHandling))) {
+      return logNeedProposal(ErrCode::MalformedImportKind,
+                             Proposal::ExceptionHandling, FMgr.getLastOffset(),
+                             ASTNodeAttr::Desc_Import);
+    }
+    // Read the attribute, which is always 0 for the exception tags.
+    if (auto Res = FMgr.readByte(); unlikely(!Res)) {
+      return logLoadError(Res.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Desc_Import);
+    } else if (*Res != UINT8_C(0)) {
+      return logLoadError(ErrCode::ExpectedZeroByte, FMgr.getLastOffset(),
+                          ASTNodeAttr::Desc_Import);
+    }
+    // Read the function type index.
+    if (auto Res = FMgr.readU32()) {
+      ImpDesc.setExternalTagTypeIdx(*Res);
+    } else {
+      return logLoadError(Res.error(), FMgr.getLastOffset(),
+                          ASTNodeAttr::Desc_Import);
+    }
+    break;
+  }
   default:
     return logLoadError(ErrCode::MalformedImportKind, FMgr.getLastOffset(),
                         ASTNodeAttr::Desc_Import);
@@ -96,6 +120,14 @@ Expect<void> Loader::loadDesc(AST::ExportDesc &ExpDesc) {
   case ExternalType::Memory:
   case ExternalType::Global:
     break;
+  case ExternalType::Tag:
+    // Export the tags are for ExceptionHandling proposal.
+    if (unlikely(!Conf.hasProposal(Proposal::ExceptionHandling))) {
+      return logNeedProposal(ErrCode::MalformedExportKind,
+                             Proposal::ExceptionHandling, FMgr.getLastOffset(),
+                             ASTNodeAttr::Desc_Export);
+    }
+    break;
   default:
     return logLoadError(ErrCode::MalformedExportKind, FMgr.getLastOffset(),
                         ASTNodeAttr::Desc_Export);
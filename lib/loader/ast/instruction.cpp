@@ -12,7 +12,7 @@ namespace Loader {
 
 // OpCode loader. See "include/loader/loader.h".
 Expect<OpCode> Loader::loadOpCode() {
-  uint16_t Payload;
+  uint32_t Payload;
   if (auto B1 = FMgr.readByte()) {
     Payload = (*B1);
   } else {
@@ -21,9 +21,13 @@ Expect<OpCode> Loader::loadOpCode() {
   }
 
   if (Payload == 0xFCU || Payload == 0xFDU) {
-    // 2-bytes OpCode case.
+    // Prefixed OpCode case.
     if (auto B2 = FMgr.readU32()) {
-      Payload <<= 8;
+      if (unlikely(*B2 > 0xFFFFU)) {
+        return logLoadError(ErrCode::IllegalOpCode, FMgr.getLastOffset(),
+                            ASTNodeAttr::Instruction);
+      }
+      Payload <<= 16;
       Payload += (*B2);
     } else {
       return logLoadError(B2.error(), FMgr.getLastOffset(),
@@ -33,6 +37,24 @@ Expect<OpCode> Loader::loadOpCode() {
   return static_cast<OpCode>(Payload);
 }
 
+namespace {
+
+// Link the last clause of the Try block at Pos to the instruction at Cnt,
+// which is the next Catch, Catch_all, or End instruction.
+void linkCatchClause(AST::InstrVec &Instrs, uint32_t Pos, uint32_t Cnt) {
+  if (Instrs[Pos].getJumpElse() == 0) {
+    Instrs[Pos].setJumpElse(Cnt - Pos);
+    return;
+  }
+  Pos += Instrs[Pos].getJumpElse();
+  while (Instrs[Pos].getJumpCatch() > 0) {
+    Pos += Instrs[Pos].getJumpCatch();
+  }
+  Instrs[Pos].setJumpCatch(Cnt - Pos);
+}
+
+} // namespace
+
 // Load instruction sequence. See "include/loader/loader.h".
 Expect<AST::InstrVec> Loader::loadInstrSeq() {
   OpCode Code;
@@ -56,7 +78,8 @@ Expect<AST::InstrVec> Loader::loadInstrSeq() {
     }
 
     // Process the instructions which contain a block.
-    if (Code == OpCode::Block || Code == OpCode::Loop || Code == OpCode::If) {
+    if (Code == OpCode::Block || Code == OpCode::Loop || Code == OpCode::If ||
+        Code == OpCode::Try) {
       BlockStack.push_back(std::make_pair(Code, Cnt));
     } else if (Code == OpCode::Else) {
       if (BlockStack.size() == 0 || BlockStack.back().first != OpCode::If) {
@@ -71,6 +94,28 @@ Expect<AST::InstrVec> Loader::loadInstrSeq() {
                             ASTNodeAttr::Instruction);
       }
       Instrs[Pos].setJumpElse(Cnt - Pos);
+    } else if (Code == OpCode::Catch || Code == OpCode::Catch_all) {
+      if (BlockStack.size() == 0 ||
+          (BlockStack.back().first != OpCode::Try &&
+           BlockStack.back().first != OpCode::Catch)) {
+        // A Catch instruction appeared outside the Try-block or after the
+        // Catch_all instruction.
+        return logLoadError(ErrCode::IllegalOpCode, Offset,
+                            ASTNodeAttr::Instruction);
+      }
+      linkCatchClause(Instrs, BlockStack.back().second, Cnt);
+      BlockStack.back().first = Code;
+    } else if (Code == OpCode::Delegate) {
+      if (BlockStack.size() == 0 || BlockStack.back().first != OpCode::Try) {
+        // A Delegate instruction appeared outside the Try-block or after the
+        // Catch instructions.
+        return logLoadError(ErrCode::IllegalOpCode, Offset,
+                            ASTNodeAttr::Instruction);
+      }
+      uint32_t Pos = BlockStack.back().second;
+      Instrs[Pos].setJumpEnd(Cnt - Pos);
+      Instrs[Pos].setJumpElse(Cnt - Pos);
+      BlockStack.pop_back();
     } else if (Code == OpCode::End) {
       if (BlockStack.size() > 0) {
         uint32_t Pos = BlockStack.back().second;
@@ -79,6 +124,11 @@ Expect<AST::InstrVec> Loader::loadInstrSeq() {
             Instrs[Pos].getJumpElse() == 0) {
           // If block without else. Set the else jump the same as end jump.
           Instrs[Pos].setJumpElse(Cnt - Pos);
+        } else if (BlockStack.back().first == OpCode::Try ||
+                   BlockStack.back().first == OpCode::Catch ||
+                   BlockStack.back().first == OpCode::Catch_all) {
+          // Link the last catch clause to the End instruction.
+          linkCatchClause(Instrs, Pos, Cnt);
         }
         BlockStack.pop_back();
       } else {
@@ -162,9 +212,24 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
   case OpCode::Block:
   case OpCode::Loop:
   case OpCode::If:
+  case OpCode::Try:
     // Read the block return type.
     if (auto Res = FMgr.readS32()) {
-      if (*Res < 0) {
+      if (*Res == -0x15 || *Res == -0x14) {
+        // Typed reference case. The abstract heap types are the reference
+        // types, and the non-null ones are loosened to the nullable ones.
+        AST::TypedRef Ref;
+        if (auto VType =
+                loadHeapType(*Res == -0x14, Ref, ASTNodeAttr::Instruction)) {
+          if (Ref.hasTypeIdx()) {
+            Instr.setBlockType(Ref.getTypeIdx(), Ref.isNullable());
+          } else {
+            Instr.setBlockType(*VType);
+          }
+        } else {
+          return Unexpect(VType);
+        }
+      } else if (*Res < 0) {
         // Value type case.
         ValType VType = static_cast<ValType>((*Res) & INT32_C(0x7F));
         if (auto Check = checkValTypeProposals(VType, FMgr.getLastOffset(),
@@ -190,8 +255,17 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
 
   case OpCode::Br:
   case OpCode::Br_if:
+  case OpCode::Br_on_null:
     return readU32(Instr.getTargetIndex());
 
+  case OpCode::Catch:
+  case OpCode::Throw:
+  case OpCode::Rethrow:
+  case OpCode::Delegate:
+    return readU32(Instr.getTargetIndex());
+  case OpCode::Catch_all:
+    return {};
+
   case OpCode::Br_table: {
     uint32_t VecCnt = 0;
     // Read the vector of labels.
@@ -212,6 +286,7 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
   }
 
   case OpCode::Call:
+  case OpCode::Call_ref:
     return readU32(Instr.getTargetIndex());
 
   case OpCode::Call_indirect: {
@@ -235,6 +310,19 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
 
   // Reference Instructions.
   case OpCode::Ref__null:
+    if (Conf.hasProposal(Proposal::FunctionReferences)) {
+      // The heap type can be a function type index.
+      AST::TypedRef Ref;
+      if (auto Res = loadHeapType(true, Ref, ASTNodeAttr::Instruction);
+          unlikely(!Res)) {
+        return Unexpect(Res);
+      } else if (Ref.hasTypeIdx()) {
+        Instr.setRefTypeIdx(Ref.getTypeIdx());
+      } else {
+        Instr.setRefType(static_cast<RefType>(*Res));
+      }
+      return {};
+    }
     if (auto Res = FMgr.readByte(); unlikely(!Res)) {
       return logLoadError(Res.error(), FMgr.getLastOffset(),
                           ASTNodeAttr::Instruction);
@@ -249,6 +337,7 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
     }
     return {};
   case OpCode::Ref__is_null:
+  case OpCode::Ref__as_non_null:
     return {};
   case OpCode::Ref__func:
     return readU32(Instr.getTargetIndex());
@@ -265,19 +354,14 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
     }
     Instr.setValTypeListSize(VecCnt);
     for (uint32_t I = 0; I < VecCnt; ++I) {
-      ValType VType;
-      if (auto T = FMgr.readByte(); unlikely(!T)) {
-        return logLoadError(T.error(), FMgr.getLastOffset(),
-                            ASTNodeAttr::Instruction);
+      // The typed references are loosened to the nullable reference types.
+      AST::TypedRef Ref;
+      if (auto VType = loadValType(Ref, ASTNodeAttr::Instruction);
+          unlikely(!VType)) {
+        return Unexpect(VType);
       } else {
-        VType = static_cast<ValType>(*T);
-      }
-      if (auto Check = checkValTypeProposals(VType, FMgr.getLastOffset(),
-                                             ASTNodeAttr::Instruction);
-          unlikely(!Check)) {
-        return Unexpect(Check);
+        Instr.getValTypeList()[I] = *VType;
       }
-      Instr.getValTypeList()[I] = VType;
     }
     return {};
   }
@@ -825,6 +909,27 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
   case OpCode::F64x2__floor:
   case OpCode::F64x2__trunc:
   case OpCode::F64x2__nearest:
+
+  case OpCode::I8x16__relaxed_swizzle:
+  case OpCode::I32x4__relaxed_trunc_f32x4_s:
+  case OpCode::I32x4__relaxed_trunc_f32x4_u:
+  case OpCode::I32x4__relaxed_trunc_f64x2_s_zero:
+  case OpCode::I32x4__relaxed_trunc_f64x2_u_zero:
+  case OpCode::F32x4__relaxed_madd:
+  case OpCode::F32x4__relaxed_nmadd:
+  case OpCode::F64x2__relaxed_madd:
+  case OpCode::F64x2__relaxed_nmadd:
+  case OpCode::I8x16__relaxed_laneselect:
+  case OpCode::I16x8__relaxed_laneselect:
+  case OpCode::I32x4__relaxed_laneselect:
+  case OpCode::I64x2__relaxed_laneselect:
+  case OpCode::F32x4__relaxed_min:
+  case OpCode::F32x4__relaxed_max:
+  case OpCode::F64x2__relaxed_min:
+  case OpCode::F64x2__relaxed_max:
+  case OpCode::I16x8__relaxed_q15mulr_s:
+  case OpCode::I16x8__relaxed_dot_i8x16_i7x16_s:
+  case OpCode::I32x4__relaxed_dot_i8x16_i7x16_add_s:
     return {};
 
   default:
@@ -834,8 +939,24 @@ Expect<void> Loader::loadInstruction(AST::Instruction &Instr) {
 }
 
 Expect<void> Loader::checkInstrProposals(OpCode Code, uint64_t Offset) {
-  if (Code >= OpCode::I32__trunc_sat_f32_s &&
-      Code <= OpCode::I64__trunc_sat_f64_u) {
+  if ((Code >= OpCode::Try && Code <= OpCode::Rethrow) ||
+      Code == OpCode::Delegate || Code == OpCode::Catch_all) {
+    // These instructions are for ExceptionHandling proposal.
+    if (unlikely(!Conf.hasProposal(Proposal::ExceptionHandling))) {
+      return logNeedProposal(ErrCode::IllegalOpCode,
+                             Proposal::ExceptionHandling, Offset,
+                             ASTNodeAttr::Instruction);
+    }
+  } else if (Code == OpCode::Call_ref || Code == OpCode::Ref__as_non_null ||
+             Code == OpCode::Br_on_null) {
+    // These instructions are for FunctionReferences proposal.
+    if (unlikely(!Conf.hasProposal(Proposal::FunctionReferences))) {
+      return logNeedProposal(ErrCode::IllegalOpCode,
+                             Proposal::FunctionReferences, Offset,
+                             ASTNodeAttr::Instruction);
+    }
+  } else if (Code >= OpCode::I32__trunc_sat_f32_s &&
+             Code <= OpCode::I64__trunc_sat_f64_u) {
     // These instructions are for NonTrapFloatToIntConversions proposal.
     if (unlikely(!Conf.hasProposal(Proposal::NonTrapFloatToIntConversions))) {
       return logNeedProposal(ErrCode::IllegalOpCode,
@@ -875,6 +996,13 @@ Expect<void> Loader::checkInstrProposals(OpCode Code, uint64_t Offset) {
       return logNeedProposal(ErrCode::IllegalOpCode, Proposal::SIMD, Offset,
                              ASTNodeAttr::Instruction);
     }
+  } else if (Code >= OpCode::I8x16__relaxed_swizzle &&
+             Code <= OpCode::I32x4__relaxed_dot_i8x16_i7x16_add_s) {
+    // These instructions are for RelaxedSIMD proposal.
+    if (!Conf.hasProposal(Proposal::RelaxedSIMD)) {
+      return logNeedProposal(ErrCode::IllegalOpCode, Proposal::RelaxedSIMD,
+                             Offset, ASTNodeAttr::Instruction);
+    }
   }
   return {};
 }
@@ -41,7 +41,7 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
 
   // Variables to record the loaded section types.
   HasDataSection = false;
-  std::bitset<0x0DU> Secs;
+  std::bitset<0x0EU> Secs;
 
   // Read Section index and create Section nodes.
   while (true) {
@@ -59,7 +59,7 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
     }
 
     // Sections except the custom section should be unique.
-    if (NewSectionId > 0x00U && NewSectionId < 0x0DU &&
+    if (NewSectionId > 0x00U && NewSectionId < 0x0EU &&
         Secs.test(NewSectionId)) {
       return logLoadError(ErrCode::JunkSection, FMgr.getLastOffset(),
                           ASTNodeAttr::Module);
@@ -165,6 +165,19 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
       HasDataSection = true;
       Secs.set(NewSectionId);
       break;
+    case 0x0D:
+      // This section is for ExceptionHandling proposal.
+      if (!Conf.hasProposal(Proposal::ExceptionHandling)) {
+        return logNeedProposal(ErrCode::MalformedSection,
+                               Proposal::ExceptionHandling,
+                               FMgr.getLastOffset(), ASTNodeAttr::Module);
+      }
+      if (auto Res = loadSection(Mod->getTagSection()); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+        return Unexpect(Res);
+      }
+      Secs.set(NewSectionId);
+      break;
     default:
       return logLoadError(ErrCode::MalformedSection, FMgr.getLastOffset(),
                           ASTNodeAttr::Module);
@@ -192,6 +205,16 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
   // Load Custom Sections
   for (const auto &CustomSec : Mod->getCustomSections()) {
     const auto &Name = CustomSec.getName();
+    if (Name == "metadata.code.branch_hint") {
+      // The branch hints do not affect the semantics. Keep the hints loaded
+      // before the malformed one and continue.
+      FileMgr VecMgr;
+      VecMgr.setCode(CustomSec.getContent());
+      if (auto Res = loadBranchHintSection(VecMgr, *Mod); unlikely(!Res)) {
+        spdlog::warn("branch hint section load failed:{}", Res.error());
+      }
+      continue;
+    }
     if (Name == "wasmedge") {
       {
         FileMgr VecMgr;
@@ -248,26 +271,32 @@ Expect<std::unique_ptr<AST::Module>> Loader::loadModule() {
 
 // Load compiled function from loadable manager. See "include/loader/loader.h".
 Expect<void> Loader::loadCompiled(AST::Module &Mod) {
+  // The compiled library exports the tables of the type wrappers and the
+  // defined functions in the index order, and the lengths of them.
+  auto Types = LMgr.getSymbol<AST::FunctionType::Wrapper *[]>("types");
+  auto Codes = LMgr.getSymbol<void *[]>("codes");
+  auto TypesSize = LMgr.getSymbol<uint32_t>("types.size");
+  auto CodesSize = LMgr.getSymbol<uint32_t>("codes.size");
+  if (unlikely(!Types || !Codes || !TypesSize || !CodesSize)) {
+    spdlog::error(ErrCode::IllegalGrammar);
+    spdlog::error("    function pointer tables not found");
+    return Unexpect(ErrCode::IllegalGrammar);
+  }
   auto &FuncTypes = Mod.getTypeSection().getContent();
-  for (size_t I = 0; I < FuncTypes.size(); ++I) {
-    const std::string Name = "t" + std::to_string(I);
-    if (auto Symbol =
-            LMgr.getSymbol<AST::FunctionType::Wrapper>(Name.c_str())) {
-      FuncTypes[I].setSymbol(std::move(Symbol));
-    }
+  auto &CodeSegs = Mod.getCodeSection().getContent();
+  if (unlikely(*TypesSize != FuncTypes.size() ||
+               *CodesSize != CodeSegs.size())) {
+    spdlog::error(ErrCode::IllegalGrammar);
+    spdlog::error("    function pointer tables not matching: types {} {}, "
+                  "codes {} {}",
+                  *TypesSize, FuncTypes.size(), *CodesSize, CodeSegs.size());
+    return Unexpect(ErrCode::IllegalGrammar);
   }
-  size_t Offset = 0;
-  for (const auto &ImpDesc : Mod.getImportSection().getContent()) {
-    if (ImpDesc.getExternalType() == ExternalType::Function) {
-      ++Offset;
-    }
+  for (size_t I = 0; I < FuncTypes.size(); ++I) {
+    FuncTypes[I].setSymbol(Types.index(I).deref());
   }
-  auto &CodeSegs = Mod.getCodeSection().getContent();
   for (size_t I = 0; I < CodeSegs.size(); ++I) {
-    const std::string Name = "f" + std::to_string(I + Offset);
-    if (auto Symbol = LMgr.getSymbol<void>(Name.c_str())) {
-      CodeSegs[I].setSymbol(std::move(Symbol));
-    }
+    CodeSegs[I].setSymbol(Codes.index(I).deref());
   }
   return {};
 }
@@ -5,6 +5,7 @@
 
 #include "aot/version.h"
 #include "common/defines.h"
+#include <algorithm>
 #include <cstdint>
 #include <tuple>
 #include <utility>
@@ -167,6 +168,31 @@ Expect<void> Loader::loadSection(AST::DataCountSection &Sec) {
   });
 }
 
+// Load vector of tag section. See "include/loader/loader.h".
+Expect<void> Loader::loadSection(AST::TagSection &Sec) {
+  return loadSectionContent(Sec, [this, &Sec]() {
+    return loadSectionContentVec(
+        Sec, [this](uint32_t &TypeIdx) -> Expect<void> {
+          // Read the attribute, which is always 0 for the exception tags.
+          if (auto Res = FMgr.readByte(); unlikely(!Res)) {
+            return logLoadError(Res.error(), FMgr.getLastOffset(),
+                                ASTNodeAttr::Sec_Tag);
+          } else if (*Res != UINT8_C(0)) {
+            return logLoadError(ErrCode::ExpectedZeroByte,
+                                FMgr.getLastOffset(), ASTNodeAttr::Sec_Tag);
+          }
+          // Read the function type index.
+          if (auto Res = FMgr.readU32()) {
+            TypeIdx = *Res;
+          } else {
+            return logLoadError(Res.error(), FMgr.getLastOffset(),
+                                ASTNodeAttr::Sec_Tag);
+          }
+          return {};
+        });
+  });
+}
+
 namespace {
 
 inline constexpr uint32_t HostVersion() noexcept {
@@ -335,5 +361,88 @@ Expect<void> Loader::loadSection(FileMgr &VecMgr, AST::AOTSection &Sec) {
   return {};
 }
 
+// Load the branch hints to instructions. See "include/loader/loader.h".
+Expect<void> Loader::loadBranchHintSection(FileMgr &VecMgr, AST::Module &Mod) {
+  uint32_t ImportFuncNum = 0;
+  for (const auto &ImpDesc : Mod.getImportSection().getContent()) {
+    if (ImpDesc.getExternalType() == ExternalType::Function) {
+      ++ImportFuncNum;
+    }
+  }
+  auto &CodeSegs = Mod.getCodeSection().getContent();
+
+  uint32_t FuncCnt = 0;
+  if (auto Res = VecMgr.readU32(); unlikely(!Res)) {
+    spdlog::warn("branch hint function count read error:{}", Res.error());
+    return Unexpect(Res);
+  } else {
+    FuncCnt = *Res;
+  }
+  for (uint32_t I = 0; I < FuncCnt; ++I) {
+    uint32_t FuncIdx = 0, HintCnt = 0;
+    if (auto Res = VecMgr.readU32(); unlikely(!Res)) {
+      spdlog::warn("branch hint function index read error:{}", Res.error());
+      return Unexpect(Res);
+    } else {
+      FuncIdx = *Res;
+    }
+    if (unlikely(FuncIdx < ImportFuncNum ||
+                 FuncIdx - ImportFuncNum >= CodeSegs.size())) {
+      spdlog::warn("branch hint function index out of range:{}", FuncIdx);
+      return Unexpect(ErrCode::MalformedSection);
+    }
+    auto &CodeSeg = CodeSegs[FuncIdx - ImportFuncNum];
+    auto &Instrs = CodeSeg.getExpr().getInstrs();
+    if (auto Res = VecMgr.readU32(); unlikely(!Res)) {
+      spdlog::warn("branch hint count read error:{}", Res.error());
+      return Unexpect(Res);
+    } else {
+      HintCnt = *Res;
+    }
+    for (uint32_t J = 0; J < HintCnt; ++J) {
+      uint32_t Offset = 0, Size = 0;
+      Byte Value = 0;
+      if (auto Res = VecMgr.readU32(); unlikely(!Res)) {
+        spdlog::warn("branch hint offset read error:{}", Res.error());
+        return Unexpect(Res);
+      } else {
+        Offset = *Res;
+      }
+      if (auto Res = VecMgr.readU32(); unlikely(!Res)) {
+        spdlog::warn("branch hint size read error:{}", Res.error());
+        return Unexpect(Res);
+      } else {
+        Size = *Res;
+      }
+      if (auto Res = VecMgr.readByte(); unlikely(!Res)) {
+        spdlog::warn("branch hint value read error:{}", Res.error());
+        return Unexpect(Res);
+      } else {
+        Value = *Res;
+      }
+      if (unlikely(Size != 1 || Value > 1)) {
+        spdlog::warn("branch hint malformed at offset:{}", Offset);
+        return Unexpect(ErrCode::MalformedSection);
+      }
+      // The offset is relative to the function body, and the instructions
+      // record the offsets in the binary in the ascending order.
+      const uint64_t Target = uint64_t(CodeSeg.getBodyOffset()) + Offset;
+      auto It = std::lower_bound(
+          Instrs.begin(), Instrs.end(), Target,
+          [](const AST::Instruction &Instr, uint64_t Off) {
+            return Instr.getOffset() < Off;
+          });
+      if (unlikely(It == Instrs.end() || It->getOffset() != Target ||
+                   (It->getOpCode() != OpCode::If &&
+                    It->getOpCode() != OpCode::Br_if))) {
+        spdlog::warn("branch hint not on a branch at offset:{}", Offset);
+        return Unexpect(ErrCode::MalformedSection);
+      }
+      It->setBranchHint(Value == 1);
+    }
+  }
+  return {};
+}
+
 } // namespace Loader
 } // namespace WasmEdge
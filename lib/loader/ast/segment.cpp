@@ -217,6 +217,7 @@ Expect<void> Loader::loadSegment(AST::CodeSegment &CodeSeg) {
   // Read the code segment size.
   if (auto Res = FMgr.readU32()) {
     CodeSeg.setSegSize(*Res);
+    CodeSeg.setBodyOffset(static_cast<uint32_t>(FMgr.getOffset()));
   } else {
     return logLoadError(Res.error(), FMgr.getLastOffset(),
                         ASTNodeAttr::Seg_Code);
@@ -248,16 +249,15 @@ Expect<void> Loader::loadSegment(AST::CodeSegment &CodeSeg) {
     }
     TotalLocalCnt += LocalCnt;
     // Read the number type.
-    if (auto Res = FMgr.readByte(); unlikely(!Res)) {
-      return logLoadError(Res.error(), FMgr.getLastOffset(),
-                          ASTNodeAttr::Seg_Code);
+    AST::TypedRef Ref;
+    if (auto Res = loadValType(Ref, ASTNodeAttr::Seg_Code); unlikely(!Res)) {
+      return Unexpect(Res);
     } else {
-      LocalType = static_cast<ValType>(*Res);
+      LocalType = *Res;
     }
-    if (auto Res = checkValTypeProposals(LocalType, FMgr.getLastOffset(),
-                                         ASTNodeAttr::Seg_Code);
-        unlikely(!Res)) {
-      return Unexpect(Res);
+    if (!Ref.isPlain()) {
+      CodeSeg.getLocalRefs().resize(VecCnt);
+      CodeSeg.getLocalRefs()[I] = Ref;
     }
     CodeSeg.getLocals().push_back(std::make_pair(LocalCnt, LocalType));
   }
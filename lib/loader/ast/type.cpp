@@ -76,17 +76,15 @@ Expect<void> Loader::loadType(AST::FunctionType &FuncType) {
                         ASTNodeAttr::Type_Function);
   }
   for (uint32_t I = 0; I < VecCnt; ++I) {
-    if (auto Res = FMgr.readByte()) {
-      ValType Type = static_cast<ValType>(*Res);
-      if (auto Check = checkValTypeProposals(Type, FMgr.getLastOffset(),
-                                             ASTNodeAttr::Type_Function);
-          !Check) {
-        return Unexpect(Check);
-      }
-      FuncType.getParamTypes().push_back(Type);
+    AST::TypedRef Ref;
+    if (auto Res = loadValType(Ref, ASTNodeAttr::Type_Function)) {
+      FuncType.getParamTypes().push_back(*Res);
     } else {
-      return logLoadError(Res.error(), FMgr.getLastOffset(),
-                          ASTNodeAttr::Type_Function);
+      return Unexpect(Res);
+    }
+    if (!Ref.isPlain()) {
+      FuncType.getParamRefs().resize(VecCnt);
+      FuncType.getParamRefs()[I] = Ref;
     }
   }
 
@@ -103,17 +101,15 @@ Expect<void> Loader::loadType(AST::FunctionType &FuncType) {
                            FMgr.getLastOffset(), ASTNodeAttr::Type_Function);
   }
   for (uint32_t I = 0; I < VecCnt; ++I) {
-    if (auto Res = FMgr.readByte()) {
-      ValType Type = static_cast<ValType>(*Res);
-      if (auto Check = checkValTypeProposals(Type, FMgr.getLastOffset(),
-                                             ASTNodeAttr::Type_Function);
-          !Check) {
-        return Unexpect(Check);
-      }
-      FuncType.getReturnTypes().push_back(Type);
+    AST::TypedRef Ref;
+    if (auto Res = loadValType(Ref, ASTNodeAttr::Type_Function)) {
+      FuncType.getReturnTypes().push_back(*Res);
     } else {
-      return logLoadError(Res.error(), FMgr.getLastOffset(),
-                          ASTNodeAttr::Type_Function);
+      return Unexpect(Res);
+    }
+    if (!Ref.isPlain()) {
+      FuncType.getReturnRefs().resize(VecCnt);
+      FuncType.getReturnRefs()[I] = Ref;
     }
   }
   return {};
@@ -156,17 +152,10 @@ Expect<void> Loader::loadType(AST::TableType &TabType) {
 // Load binary to construct GlobalType node. See "include/loader/loader.h".
 Expect<void> Loader::loadType(AST::GlobalType &GlobType) {
   // Read value type.
-  if (auto Res = FMgr.readByte()) {
-    GlobType.setValType(static_cast<ValType>(*Res));
-    if (auto Check =
-            checkValTypeProposals(GlobType.getValType(), FMgr.getLastOffset(),
-                                  ASTNodeAttr::Type_Global);
-        !Check) {
-      return Unexpect(Check);
-    }
+  if (auto Res = loadValType(GlobType.getRef(), ASTNodeAttr::Type_Global)) {
+    GlobType.setValType(*Res);
   } else {
-    return logLoadError(Res.error(), FMgr.getLastOffset(),
-                        ASTNodeAttr::Type_Global);
+    return Unexpect(Res);
   }
 
   // Read mutability.
@@ -178,6 +178,58 @@ Expect<ValType> Loader::checkValTypeProposals(ValType VType, uint64_t Off,
   }
 }
 
+// Helper function of reading the value types. The typed references of the
+// function references proposal are read with their heap types.
+Expect<ValType> Loader::loadValType(AST::TypedRef &Ref, ASTNodeAttr Node) {
+  Ref = AST::TypedRef();
+  Byte Code;
+  if (auto Res = FMgr.readByte()) {
+    Code = *Res;
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(), Node);
+  }
+  // The prefixes of the `(ref ht)` and `(ref null ht)` types.
+  if (Code == 0x6BU || Code == 0x6CU) {
+    return loadHeapType(Code == 0x6CU, Ref, Node);
+  }
+  return checkValTypeProposals(static_cast<ValType>(Code),
+                               FMgr.getLastOffset(), Node);
+}
+
+// Helper function of reading the heap types of the typed references.
+Expect<ValType> Loader::loadHeapType(bool Nullable, AST::TypedRef &Ref,
+                                     ASTNodeAttr Node) {
+  if (unlikely(!Conf.hasProposal(Proposal::FunctionReferences))) {
+    return logNeedProposal(ErrCode::MalformedValType,
+                           Proposal::FunctionReferences, FMgr.getLastOffset(),
+                           Node);
+  }
+  // The heap type is a s33 of the function type index or the abstract types.
+  int64_t HeapType;
+  if (auto Res = FMgr.readS64()) {
+    HeapType = *Res;
+  } else {
+    return logLoadError(Res.error(), FMgr.getLastOffset(), Node);
+  }
+  if (HeapType >= 0 &&
+      HeapType < static_cast<int64_t>(AST::TypedRef::AbstractIdx)) {
+    Ref = AST::TypedRef(static_cast<uint32_t>(HeapType), Nullable);
+    return ValType::FuncRef;
+  }
+  if (HeapType < 0 && HeapType >= INT64_C(-0x40)) {
+    const RefType RType = static_cast<RefType>(HeapType & INT64_C(0x7F));
+    if (RType == RefType::FuncRef || RType == RefType::ExternRef) {
+      if (auto Res = checkRefTypeProposals(RType, FMgr.getLastOffset(), Node);
+          unlikely(!Res)) {
+        return Unexpect(Res);
+      }
+      Ref = AST::TypedRef(AST::TypedRef::AbstractIdx, Nullable);
+      return ToValType(RType);
+    }
+  }
+  return logLoadError(ErrCode::MalformedRefType, FMgr.getLastOffset(), Node);
+}
+
 // Helper function of checking the valid reference types.
 Expect<RefType> Loader::checkRefTypeProposals(RefType RType, uint64_t Off,
                                               ASTNodeAttr Node) {
@@ -24,6 +24,13 @@ namespace winapi = boost::winapi;
 #error Unsupported os!
 #endif
 
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+extern "C" {
+extern void __register_frame(void *);
+extern void __deregister_frame(void *);
+}
+#endif
+
 namespace {
 inline constexpr uint64_t roundDownPageBoundary(const uint64_t Value) {
 #if WASMEDGE_OS_MACOS
@@ -39,6 +46,41 @@ inline constexpr uint64_t roundUpPageBoundary(const uint64_t Value) {
   return roundDownPageBoundary(Value + UINT64_C(4095));
 #endif
 }
+
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+/// Call the function on every frame description entry in the .eh_frame, or on
+/// the whole section for the unwinders which accept the section at once.
+template <typename FuncT>
+void forEachFrame(uint8_t *EHFrame, uint64_t Size, FuncT &&Func) noexcept {
+#if WASMEDGE_OS_MACOS
+  // The libunwind registers one FDE at a time and skips the CIEs.
+  uint8_t *const End = EHFrame + Size;
+  while (EHFrame + 8 <= End) {
+    uint32_t Length;
+    std::memcpy(&Length, EHFrame, sizeof(Length));
+    if (Length == 0) {
+      break;
+    }
+    uint64_t HeaderSize = 4;
+    uint64_t EntrySize = Length;
+    if (Length == UINT32_C(0xFFFFFFFF)) {
+      std::memcpy(&EntrySize, EHFrame + 4, sizeof(EntrySize));
+      HeaderSize = 12;
+    }
+    uint32_t CIEPointer;
+    std::memcpy(&CIEPointer, EHFrame + HeaderSize, sizeof(CIEPointer));
+    if (CIEPointer != 0) {
+      Func(EHFrame);
+    }
+    EHFrame += HeaderSize + EntrySize;
+  }
+#else
+  // The libgcc unwinder walks the whole section until the zero terminator.
+  static_cast<void>(Size);
+  Func(EHFrame);
+#endif
+}
+#endif
 } // namespace
 
 namespace WasmEdge {
@@ -80,8 +122,10 @@ Expect<void> SharedLibrary::load(const std::filesystem::path &Path) noexcept {
 Expect<void> SharedLibrary::load(const AST::AOTSection &AOTSec) noexcept {
   BinarySize = 0;
   for (const auto &Section : AOTSec.getSections()) {
-    BinarySize =
-        std::max(BinarySize, std::get<1>(Section) + std::get<2>(Section));
+    // Reserve the zero terminator after the unwind table.
+    const uint64_t Padding = std::get<0>(Section) == 4 ? 4 : 0;
+    BinarySize = std::max(BinarySize, std::get<1>(Section) +
+                                          std::get<2>(Section) + Padding);
   }
   BinarySize = roundUpPageBoundary(BinarySize);
 
@@ -108,6 +152,10 @@ Expect<void> SharedLibrary::load(const AST::AOTSection &AOTSec) noexcept {
       break;
     case 3: // BSS
       break;
+    case 4: // EHFrame
+      EHFrameAddress = Binary + Offset;
+      EHFrameSize = Size;
+      break;
     }
   }
 
@@ -119,6 +167,24 @@ Expect<void> SharedLibrary::load(const AST::AOTSection &AOTSec) noexcept {
     }
   }
 
+  if (EHFrameAddress) {
+    // The terminator must not be overwritten by the following sections. The
+    // table cannot be copied elsewhere because its entries refer to the code
+    // by relative offsets, so reject the binary instead of running the code
+    // without unwind information.
+    const uint8_t *const End = EHFrameAddress + EHFrameSize;
+    if (unlikely(!std::all_of(End, End + 4,
+                              [](uint8_t B) { return B == 0; }))) {
+      EHFrameAddress = nullptr;
+      spdlog::warn(ErrCode::IllegalGrammar);
+      spdlog::warn("    unterminated unwind table");
+      return Unexpect(ErrCode::IllegalGrammar);
+    }
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+    forEachFrame(EHFrameAddress, EHFrameSize, __register_frame);
+#endif
+  }
+
   IntrinsicsAddress = AOTSec.getIntrinsicsAddress();
   TypesAddress = AOTSec.getTypesAddress();
   CodesAddress = AOTSec.getCodesAddress();
@@ -127,6 +193,12 @@ Expect<void> SharedLibrary::load(const AST::AOTSection &AOTSec) noexcept {
 }
 
 void SharedLibrary::unload() noexcept {
+  if (EHFrameAddress) {
+#if WASMEDGE_OS_LINUX || WASMEDGE_OS_MACOS
+    forEachFrame(EHFrameAddress, EHFrameSize, __deregister_frame);
+#endif
+    EHFrameAddress = nullptr;
+  }
   if (Binary) {
     Allocator::set_chunk_readable_writable(Binary, BinarySize);
     Allocator::release_chunk(Binary, BinarySize);
@@ -34,10 +34,12 @@ using ::VirtualProtect;
 #if defined(BOOST_USE_WINDOWS_H)
 BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_COMMIT_ = MEM_COMMIT;
 BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_RESERVE_ = MEM_RESERVE;
+BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_DECOMMIT_ = MEM_DECOMMIT;
 BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_RELEASE_ = MEM_RELEASE;
 #else
 BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_COMMIT_ = 0x00001000;
 BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_RESERVE_ = 0x00002000;
+BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_DECOMMIT_ = 0x00004000;
 BOOST_CONSTEXPR_OR_CONST DWORD_ MEM_RELEASE_ = 0x00008000;
 #endif
 } // namespace winapi
@@ -55,6 +57,16 @@ static inline constexpr const uint64_t kPageSize = UINT64_C(65536);
 static inline constexpr const uint64_t k4G = UINT64_C(0x100000000);
 static inline constexpr const uint64_t k12G = UINT64_C(0x300000000);
 
+/// Get the page capacity of the heap buffer for the page count. The buffer
+/// grows geometrically to amortize the reallocation and copying.
+static inline uint64_t getCapacity(uint32_t PageCount) noexcept {
+  uint64_t Capacity = 1;
+  while (Capacity < PageCount) {
+    Capacity <<= 1;
+  }
+  return Capacity;
+}
+
 } // namespace
 
 uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
@@ -89,7 +101,8 @@ uint8_t *Allocator::allocate(uint32_t PageCount) noexcept {
   }
   return Pointer;
 #else
-  auto Result = reinterpret_cast<uint8_t *>(std::malloc(kPageSize * PageCount));
+  auto Result = reinterpret_cast<uint8_t *>(
+      std::malloc(kPageSize * getCapacity(PageCount)));
   if (Result == nullptr) {
     return nullptr;
   }
@@ -102,9 +115,13 @@ uint8_t *Allocator::resize(uint8_t *Pointer, uint32_t OldPageCount,
                            uint32_t NewPageCount) noexcept {
   assuming(NewPageCount > OldPageCount);
 #if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
-  if (mmap(Pointer + OldPageCount * kPageSize,
-           (NewPageCount - OldPageCount) * kPageSize, PROT_READ | PROT_WRITE,
-           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
+  // The pages are reserved in allocate(). Changing the protection instead of
+  // mapping new pages keeps the memory in a single mapping. The pages after
+  // the new page count must stay inaccessible for the compiled code, which
+  // relies on faults for the boundary checking.
+  if (mprotect(Pointer + OldPageCount * kPageSize,
+               (NewPageCount - OldPageCount) * kPageSize,
+               PROT_READ | PROT_WRITE) != 0) {
     return nullptr;
   }
   return Pointer;
@@ -117,10 +134,13 @@ uint8_t *Allocator::resize(uint8_t *Pointer, uint32_t OldPageCount,
   }
   return Pointer;
 #else
-  auto Result = reinterpret_cast<uint8_t *>(
-      std::realloc(Pointer, NewPageCount * kPageSize));
-  if (Result == nullptr) {
-    return nullptr;
+  auto Result = Pointer;
+  if (getCapacity(NewPageCount) > getCapacity(OldPageCount)) {
+    Result = reinterpret_cast<uint8_t *>(
+        std::realloc(Pointer, getCapacity(NewPageCount) * kPageSize));
+    if (Result == nullptr) {
+      return nullptr;
+    }
   }
   std::memset(Result + OldPageCount * kPageSize, 0,
               (NewPageCount - OldPageCount) * kPageSize);
@@ -141,6 +161,37 @@ void Allocator::release(uint8_t *Pointer, uint32_t) noexcept {
 #endif
 }
 
+bool Allocator::discard(uint8_t *Pointer, uint32_t PageIndex,
+                        uint32_t PageCount) noexcept {
+  if (PageCount == 0) {
+    return true;
+  }
+  uint8_t *Start = Pointer + PageIndex * kPageSize;
+  const uint64_t Size = PageCount * kPageSize;
+#if defined(HAVE_MMAP) && defined(__x86_64__) || defined(__aarch64__)
+#if WASMEDGE_OS_LINUX
+  // Private anonymous pages are refilled with zeros on the next access.
+  return madvise(Start, Size, MADV_DONTNEED) == 0;
+#else
+  // MADV_DONTNEED and MADV_FREE do not guarantee zero-filled pages on other
+  // systems. Replace the pages with a fresh anonymous mapping instead.
+  return mmap(Start, Size, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) != MAP_FAILED;
+#endif
+#elif WASMEDGE_OS_WINDOWS
+  // Decommitted pages are zero-filled when they are committed again.
+  if (boost::winapi::VirtualFree(Start, Size, boost::winapi::MEM_DECOMMIT_) ==
+      0) {
+    return false;
+  }
+  return boost::winapi::VirtualAlloc(Start, Size, boost::winapi::MEM_COMMIT_,
+                                     boost::winapi::PAGE_READWRITE_) != nullptr;
+#else
+  std::memset(Start, 0, Size);
+  return true;
+#endif
+}
+
 uint8_t *Allocator::allocate_chunk(uint64_t Size) noexcept {
 #if defined(HAVE_MMAP)
   if (auto Pointer = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
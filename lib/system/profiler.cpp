@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "system/profiler.h"
+
+#include "common/defines.h"
+#include "common/log.h"
+
+#include <algorithm>
+#include <csignal>
+#include <mutex>
+#include <sstream>
+
+#if defined(SA_SIGINFO)
+#include <dlfcn.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+#if WASMEDGE_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace WasmEdge {
+
+struct ProfilerSignal {
+#if defined(SA_SIGINFO)
+#if !WASMEDGE_OS_LINUX
+  /// The process-wide timer signals any thread, so only one profiler samples.
+  static inline std::atomic<Profiler *> Active = nullptr;
+#endif
+
+  static inline std::mutex Mutex;
+  static inline uint32_t Users = 0;
+  static inline struct sigaction OldAction {};
+
+  /// Install the signal handler for the first sampling profiler.
+  static void acquire() noexcept {
+    std::unique_lock Lock(Mutex);
+    if (Users++ == 0) {
+      struct sigaction Action {};
+      Action.sa_sigaction = &handler;
+      Action.sa_flags = SA_SIGINFO | SA_RESTART;
+      sigemptyset(&Action.sa_mask);
+      sigaction(SIGPROF, &Action, &OldAction);
+    }
+  }
+
+  /// Restore the signal handler after the last sampling profiler.
+  static void release() noexcept {
+    std::unique_lock Lock(Mutex);
+    if (--Users == 0) {
+      sigaction(SIGPROF, &OldAction, nullptr);
+    }
+  }
+
+  static uintptr_t getPC(void *Context) noexcept {
+    [[maybe_unused]] const auto *UContext =
+        reinterpret_cast<const ucontext_t *>(Context);
+#if WASMEDGE_OS_LINUX && defined(__x86_64__)
+    return static_cast<uintptr_t>(UContext->uc_mcontext.gregs[REG_RIP]);
+#elif WASMEDGE_OS_LINUX && defined(__aarch64__)
+    return static_cast<uintptr_t>(UContext->uc_mcontext.pc);
+#elif WASMEDGE_OS_MACOS && defined(__x86_64__)
+    return static_cast<uintptr_t>(UContext->uc_mcontext->__ss.__rip);
+#elif WASMEDGE_OS_MACOS && defined(__aarch64__)
+    return static_cast<uintptr_t>(UContext->uc_mcontext->__ss.__pc);
+#else
+    return 0;
+#endif
+  }
+
+  static void handler(int, siginfo_t *Info, void *Context) noexcept {
+#if WASMEDGE_OS_LINUX
+    // Every timer carries its profiler and signals the thread it measures.
+    if (Info->si_code != SI_TIMER) {
+      return;
+    }
+    auto *P = static_cast<Profiler *>(Info->si_value.sival_ptr);
+#else
+    static_cast<void>(Info);
+    auto *P = Active.load(std::memory_order_acquire);
+#endif
+    if (P) {
+      Profiler::handleSignal(*P, P->InCompiled.load(std::memory_order_relaxed)
+                                     ? getPC(Context)
+                                     : 0);
+    }
+  }
+#endif
+};
+
+void Profiler::handleSignal(Profiler &P, uintptr_t PC) noexcept {
+  if (PC == 0) {
+    P.Pending.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Probe from the Fibonacci hash of the program counter for its slot or an
+  // empty one.
+  const uint32_t Hash = static_cast<uint32_t>(
+      (static_cast<uint64_t>(PC) * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+  for (uint32_t I = 0; I < kPCProbeLimit; ++I) {
+    auto &Slot = P.PCTable[(Hash + I) % kPCTableSize];
+    uintptr_t Key = Slot.PC.load(std::memory_order_relaxed);
+    if (Key == 0 && Slot.PC.compare_exchange_strong(
+                        Key, PC, std::memory_order_relaxed)) {
+      Key = PC;
+    }
+    if (Key == PC) {
+      Slot.Count.fetch_add(1, std::memory_order_release);
+      return;
+    }
+  }
+  P.Dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Profiler::start(std::chrono::microseconds Interval) noexcept {
+#if defined(SA_SIGINFO)
+  if (Running) {
+    return true;
+  }
+  const auto Count =
+      std::max(Interval.count(), std::chrono::microseconds::rep{1});
+
+#if WASMEDGE_OS_LINUX
+  ProfilerSignal::acquire();
+  struct sigevent Event {};
+  Event.sigev_notify = SIGEV_THREAD_ID;
+  Event.sigev_signo = SIGPROF;
+  Event.sigev_value.sival_ptr = this;
+  Event.sigev_notify_thread_id = static_cast<pid_t>(::syscall(SYS_gettid));
+  struct itimerspec Spec {};
+  Spec.it_interval.tv_sec = static_cast<time_t>(Count / 1000000);
+  Spec.it_interval.tv_nsec = static_cast<long>(Count % 1000000) * 1000;
+  Spec.it_value = Spec.it_interval;
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &Event, &Timer) != 0) {
+    ProfilerSignal::release();
+    spdlog::warn("Failed to create the profiling timer.");
+    return false;
+  }
+  if (timer_settime(Timer, 0, &Spec, nullptr) != 0) {
+    timer_delete(Timer);
+    ProfilerSignal::release();
+    spdlog::warn("Failed to start the profiling timer.");
+    return false;
+  }
+#else
+  Profiler *Expected = nullptr;
+  if (!ProfilerSignal::Active.compare_exchange_strong(
+          Expected, this, std::memory_order_acq_rel)) {
+    spdlog::warn("Another profiler is sampling.");
+    return false;
+  }
+  ProfilerSignal::acquire();
+  struct itimerval Timer {};
+  Timer.it_interval.tv_sec = static_cast<time_t>(Count / 1000000);
+  Timer.it_interval.tv_usec = static_cast<suseconds_t>(Count % 1000000);
+  Timer.it_value = Timer.it_interval;
+  if (setitimer(ITIMER_PROF, &Timer, nullptr) != 0) {
+    ProfilerSignal::release();
+    ProfilerSignal::Active.store(nullptr, std::memory_order_release);
+    spdlog::warn("Failed to start the profiling timer.");
+    return false;
+  }
+#endif
+  Running = true;
+  return true;
+#else
+  static_cast<void>(Interval);
+  spdlog::warn("Profiling is not supported on this platform.");
+  return false;
+#endif
+}
+
+void Profiler::stop() {
+  if (!Running) {
+    return;
+  }
+#if WASMEDGE_OS_LINUX
+  timer_delete(Timer);
+  ProfilerSignal::release();
+#elif defined(SA_SIGINFO)
+  struct itimerval Timer {};
+  setitimer(ITIMER_PROF, &Timer, nullptr);
+  ProfilerSignal::release();
+  ProfilerSignal::Active.store(nullptr, std::memory_order_release);
+#endif
+  Running = false;
+  collectCompiled();
+  // The addresses may belong to other code in the next sampling.
+  for (auto &Slot : PCTable) {
+    Slot.PC.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Profiler::setName(Key K, std::string Name) {
+  Names.insert_or_assign(K, std::move(Name));
+}
+
+void Profiler::addCompiledFunction(const void *Entry, Key K) {
+  CompiledEntries.insert_or_assign(reinterpret_cast<uintptr_t>(Entry), K);
+}
+
+void Profiler::recordSample(Span<const Key> Stack) {
+  const uint32_t Count = Pending.exchange(0, std::memory_order_relaxed);
+  if (Count == 0) {
+    return;
+  }
+  Stacks[std::vector<Key>(Stack.begin(), Stack.end())] += Count;
+  SampleCount += Count;
+}
+
+void Profiler::collectCompiled() {
+  for (auto &Slot : PCTable) {
+    const uintptr_t PC = Slot.PC.load(std::memory_order_relaxed);
+    if (PC == 0) {
+      continue;
+    }
+    const uint64_t Count = Slot.Count.exchange(0, std::memory_order_acquire);
+    if (Count == 0) {
+      continue;
+    }
+    // The program counter outside the compiled code is in the runtime, such
+    // as the intrinsics called by the compiled code.
+    Key K = nullptr;
+    if (auto It = CompiledEntries.upper_bound(PC);
+        It != CompiledEntries.begin()) {
+      --It;
+#if defined(SA_SIGINFO)
+      Dl_info PCInfo, EntryInfo;
+      if (dladdr(reinterpret_cast<void *>(PC), &PCInfo) != 0 &&
+          dladdr(reinterpret_cast<void *>(It->first), &EntryInfo) != 0 &&
+          PCInfo.dli_fbase == EntryInfo.dli_fbase) {
+        K = It->second;
+      }
+#endif
+    }
+    Stacks[std::vector<Key>{K}] += Count;
+    SampleCount += Count;
+  }
+}
+
+void Profiler::clear() {
+  collectCompiled();
+  Stacks.clear();
+  SampleCount = 0;
+  Pending.store(0, std::memory_order_relaxed);
+  Dropped.store(0, std::memory_order_relaxed);
+}
+
+std::string Profiler::getName(Key K) const {
+  if (K == nullptr) {
+    return "[runtime]";
+  }
+  if (auto It = Names.find(K); It != Names.end()) {
+    return It->second;
+  }
+  std::ostringstream OS;
+  OS << "[function " << K << ']';
+  return OS.str();
+}
+
+void Profiler::dumpFolded(std::ostream &OS) {
+  collectCompiled();
+  for (const auto &[Stack, Count] : Stacks) {
+    const char *Sep = "";
+    for (const auto K : Stack) {
+      // The separators are not allowed in the names.
+      std::string Name = getName(K);
+      for (auto &C : Name) {
+        if (C == ';' || C == ' ' || C == '\n') {
+          C = '_';
+        }
+      }
+      OS << Sep << Name;
+      Sep = ";";
+    }
+    OS << ' ' << Count << '\n';
+  }
+}
+
+} // namespace WasmEdge
@@ -31,6 +31,8 @@ void FormChecker::reset(bool CleanGlobal) {
   CtrlStack.clear();
   Locals.clear();
   Returns.clear();
+  LocalInits.clear();
+  LocalInitStack.clear();
 
   if (CleanGlobal) {
     Types.clear();
@@ -41,6 +43,7 @@ void FormChecker::reset(bool CleanGlobal) {
     Datas.clear();
     Elems.clear();
     Refs.clear();
+    Tags.clear();
     NumImportFuncs = 0;
     NumImportGlobals = 0;
   }
@@ -66,11 +69,11 @@ void FormChecker::addType(const AST::FunctionType &Func) {
   std::vector<VType> Param, Ret;
   Param.reserve(Func.getParamTypes().size());
   Ret.reserve(Func.getReturnTypes().size());
-  for (auto Val : Func.getParamTypes()) {
-    Param.push_back(ASTToVType(Val));
+  for (size_t I = 0; I < Func.getParamTypes().size(); ++I) {
+    Param.push_back(ASTToVType(Func.getParamTypes()[I], Func.getParamRef(I)));
   }
-  for (auto Val : Func.getReturnTypes()) {
-    Ret.push_back(ASTToVType(Val));
+  for (size_t I = 0; I < Func.getReturnTypes().size(); ++I) {
+    Ret.push_back(ASTToVType(Func.getReturnTypes()[I], Func.getReturnRef(I)));
   }
   Types.emplace_back(std::move(Param), std::move(Ret));
 }
@@ -92,7 +95,8 @@ void FormChecker::addMemory(const AST::MemoryType &) { Mems++; }
 
 void FormChecker::addGlobal(const AST::GlobalType &Glob, const bool IsImport) {
   // Type in global is comfirmed in loading phase.
-  Globals.emplace_back(ASTToVType(Glob.getValType()), Glob.getValMut());
+  Globals.emplace_back(ASTToVType(Glob.getValType(), Glob.getRef()),
+                       Glob.getValMut());
   if (IsImport) {
     NumImportGlobals++;
   }
@@ -108,11 +112,17 @@ void FormChecker::addElem(const AST::ElementSegment &Elem) {
 
 void FormChecker::addRef(const uint32_t FuncIdx) { Refs.emplace(FuncIdx); }
 
-void FormChecker::addLocal(const ValType &V) {
-  Locals.push_back(ASTToVType(V));
+void FormChecker::addTag(const uint32_t TypeIdx) { Tags.push_back(TypeIdx); }
+
+void FormChecker::addLocal(const ValType &V, const AST::TypedRef &Ref) {
+  addLocal(ASTToVType(V, Ref), false);
 }
 
-void FormChecker::addLocal(const VType &V) { Locals.push_back(V); }
+void FormChecker::addLocal(const VType &V, const bool IsParam) {
+  Locals.push_back(V);
+  // The non-nullable locals should be set before getting.
+  LocalInits.push_back(IsParam || isNullableRef(V));
+}
 
 VType FormChecker::ASTToVType(const ValType &V) {
   switch (V) {
@@ -135,6 +145,13 @@ VType FormChecker::ASTToVType(const ValType &V) {
   }
 }
 
+VType FormChecker::ASTToVType(const ValType &V, const AST::TypedRef &Ref) {
+  if (Ref.hasTypeIdx()) {
+    return makeTypedRef(Ref.getTypeIdx(), Ref.isNullable());
+  }
+  return toNullableRef(ASTToVType(V), Ref.isNullable());
+}
+
 VType FormChecker::ASTToVType(const NumType &V) {
   switch (V) {
   case NumType::I32:
@@ -164,7 +181,7 @@ VType FormChecker::ASTToVType(const RefType &V) {
 }
 
 ValType FormChecker::VTypeToAST(const VType &V) {
-  switch (V) {
+  switch (getBaseType(V)) {
   case VType::I32:
     return ValType::I32;
   case VType::I64:
@@ -216,6 +233,17 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
         Buffer.push_back(ASTToVType(BType.Data.Type));
       }
       return ReturnType{{}, Buffer};
+    } else if (BType.IsTypedRef) {
+      // Typed reference case. t2* = (ref null? index)
+      const uint32_t TypeIdx = BType.Data.Idx;
+      if (TypeIdx >= Types.size()) {
+        return logOutOfRange(ErrCode::InvalidFuncTypeIdx,
+                             ErrInfo::IndexCategory::FunctionType, TypeIdx,
+                             static_cast<uint32_t>(Types.size()));
+      }
+      Buffer.clear();
+      Buffer.push_back(makeTypedRef(TypeIdx, BType.IsNullable));
+      return ReturnType{{}, Buffer};
     } else {
       // Type index case. t2* = type[index].returns
       const uint32_t TypeIdx = BType.Data.Idx;
@@ -324,7 +352,8 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     }
     [[fallthrough]];
   case OpCode::Block:
-  case OpCode::Loop: {
+  case OpCode::Loop:
+  case OpCode::Try: {
     // Get blocktype [t1*] -> [t2*]
     std::vector<VType> Buffer;
     Span<const VType> T1, T2;
@@ -364,6 +393,61 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     }
     return {};
 
+  case OpCode::Catch:
+  case OpCode::Catch_all: {
+    // The Catch and Catch_all instructions only appear in the Try-block, which
+    // is checked in loading phase.
+    const uint32_t TagIdx = Instr.getTargetIndex();
+    if (Instr.getOpCode() == OpCode::Catch && TagIdx >= Tags.size()) {
+      return logOutOfRange(ErrCode::InvalidTagIdx, ErrInfo::IndexCategory::Tag,
+                           TagIdx, static_cast<uint32_t>(Tags.size()));
+    }
+    if (auto Res = popCtrl()) {
+      pushCtrl((*Res).StartTypes, (*Res).EndTypes, Instr.getOpCode());
+    } else {
+      return Unexpect(Res);
+    }
+    if (Instr.getOpCode() == OpCode::Catch) {
+      // Push the parameters of the tag.
+      pushTypes(Types[Tags[TagIdx]].first);
+    }
+    return {};
+  }
+  case OpCode::Delegate:
+    if (auto Res = popCtrl()) {
+      // The label index is out of the Try-block.
+      if (auto D = checkCtrlStackDepth(Instr.getTargetIndex()); !D) {
+        return Unexpect(D);
+      }
+      pushTypes((*Res).EndTypes);
+    } else {
+      return Unexpect(Res);
+    }
+    return {};
+  case OpCode::Throw: {
+    const uint32_t TagIdx = Instr.getTargetIndex();
+    if (TagIdx >= Tags.size()) {
+      return logOutOfRange(ErrCode::InvalidTagIdx, ErrInfo::IndexCategory::Tag,
+                           TagIdx, static_cast<uint32_t>(Tags.size()));
+    }
+    if (auto Res = popTypes(Types[Tags[TagIdx]].first); !Res) {
+      return Unexpect(Res);
+    }
+    return unreachable();
+  }
+  case OpCode::Rethrow:
+    if (auto D = checkCtrlStackDepth(Instr.getTargetIndex())) {
+      // Only the exceptions caught by the Catch or Catch_all can be rethrown.
+      if (CtrlStack[*D].Code != OpCode::Catch &&
+          CtrlStack[*D].Code != OpCode::Catch_all) {
+        spdlog::error(ErrCode::InvalidRethrowLabel);
+        return Unexpect(ErrCode::InvalidRethrowLabel);
+      }
+      return unreachable();
+    } else {
+      return Unexpect(D);
+    }
+
   case OpCode::Br:
     if (auto D = checkCtrlStackDepth(Instr.getTargetIndex())) {
       // D is the last D element of control stack.
@@ -475,9 +559,34 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
     }
     return StackTrans(Types[N].first, Types[N].second);
   }
+  case OpCode::Call_ref: {
+    auto N = Instr.getTargetIndex();
+    // Check target function type index.
+    if (N >= Types.size()) {
+      return logOutOfRange(ErrCode::InvalidFuncTypeIdx,
+                           ErrInfo::IndexCategory::FunctionType, N,
+                           static_cast<uint32_t>(Types.size()));
+    }
+    // The operand is a typed reference of the function type, so the signature
+    // of the callee is proved here and not checked in execution.
+    if (auto Res = popType(makeTypedRef(N, true)); !Res) {
+      return Unexpect(Res);
+    }
+    return StackTrans(Types[N].first, Types[N].second);
+  }
 
   // Reference Instructions.
   case OpCode::Ref__null:
+    if (Instr.getRefTypeIdx() != AST::TypedRef::AbstractIdx) {
+      if (Instr.getRefTypeIdx() >= Types.size()) {
+        return logOutOfRange(ErrCode::InvalidFuncTypeIdx,
+                             ErrInfo::IndexCategory::FunctionType,
+                             Instr.getRefTypeIdx(),
+                             static_cast<uint32_t>(Types.size()));
+      }
+      return StackTrans({},
+                        std::array{makeTypedRef(Instr.getRefTypeIdx(), true)});
+    }
     return StackTrans({}, std::array{ASTToVType(Instr.getRefType())});
   case OpCode::Ref__is_null:
     if (auto Res = popType()) {
@@ -497,7 +606,40 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
       spdlog::error(ErrCode::InvalidRefIdx);
       return Unexpect(ErrCode::InvalidRefIdx);
     }
+    if (Instr.getTargetIndex() < Funcs.size()) {
+      // The reference is non-null and typed by the function type.
+      return StackTrans(
+          {}, std::array{makeTypedRef(Funcs[Instr.getTargetIndex()], false)});
+    }
     return StackTrans({}, std::array{VType::FuncRef});
+  case OpCode::Ref__as_non_null:
+  case OpCode::Br_on_null: {
+    VType T;
+    if (auto Res = popType()) {
+      T = *Res;
+    } else {
+      return Unexpect(Res);
+    }
+    if (!isRefType(T)) {
+      spdlog::error(ErrCode::TypeCheckFailed);
+      spdlog::error(ErrInfo::InfoMismatch(ValType::FuncRef, VTypeToAST(T)));
+      return Unexpect(ErrCode::TypeCheckFailed);
+    }
+    if (Instr.getOpCode() == OpCode::Br_on_null) {
+      if (auto D = checkCtrlStackDepth(Instr.getTargetIndex())) {
+        if (auto Res = popTypes(getLabelTypes(CtrlStack[*D]))) {
+          pushTypes(getLabelTypes(CtrlStack[*D]));
+        } else {
+          return Unexpect(Res);
+        }
+      } else {
+        return Unexpect(D);
+      }
+    }
+    // The reference is non-null after the instruction.
+    pushType(T == VType::Unknown ? T : toNullableRef(T, false));
+    return {};
+  }
 
   // Parametric Instructions.
   case OpCode::Drop:
@@ -567,10 +709,22 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
           ErrCode::InvalidLocalIdx, ErrInfo::IndexCategory::Local,
           Instr.getTargetIndex(), static_cast<uint32_t>(Locals.size()));
     }
-    VType TExpect = Locals[Instr.getTargetIndex()];
+    const uint32_t Idx = Instr.getTargetIndex();
+    VType TExpect = Locals[Idx];
     if (Instr.getOpCode() == OpCode::Local__get) {
+      if (!LocalInits[Idx]) {
+        // Get the uninitialized non-nullable local.
+        spdlog::error(ErrCode::TypeCheckFailed);
+        spdlog::error("    Uninitialized non-nullable local {}.", Idx);
+        return Unexpect(ErrCode::TypeCheckFailed);
+      }
       return StackTrans({}, std::array{TExpect});
-    } else if (Instr.getOpCode() == OpCode::Local__set) {
+    }
+    if (!LocalInits[Idx]) {
+      LocalInits[Idx] = true;
+      LocalInitStack.push_back(Idx);
+    }
+    if (Instr.getOpCode() == OpCode::Local__set) {
       return StackTrans(std::array{TExpect}, {});
     } else {
       return StackTrans(std::array{TExpect}, std::array{TExpect});
@@ -1118,6 +1272,10 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   case OpCode::F64x2__floor:
   case OpCode::F64x2__trunc:
   case OpCode::F64x2__nearest:
+  case OpCode::I32x4__relaxed_trunc_f32x4_s:
+  case OpCode::I32x4__relaxed_trunc_f32x4_u:
+  case OpCode::I32x4__relaxed_trunc_f64x2_s_zero:
+  case OpCode::I32x4__relaxed_trunc_f64x2_u_zero:
     return StackTrans(std::array{VType::V128}, std::array{VType::V128});
   case OpCode::I8x16__swizzle:
   case OpCode::I8x16__eq:
@@ -1239,9 +1397,25 @@ Expect<void> FormChecker::checkInstr(const AST::Instruction &Instr) {
   case OpCode::F64x2__pmin:
   case OpCode::F64x2__pmax:
   case OpCode::I32x4__dot_i16x8_s:
+  case OpCode::I8x16__relaxed_swizzle:
+  case OpCode::F32x4__relaxed_min:
+  case OpCode::F32x4__relaxed_max:
+  case OpCode::F64x2__relaxed_min:
+  case OpCode::F64x2__relaxed_max:
+  case OpCode::I16x8__relaxed_q15mulr_s:
+  case OpCode::I16x8__relaxed_dot_i8x16_i7x16_s:
     return StackTrans(std::array{VType::V128, VType::V128},
                       std::array{VType::V128});
   case OpCode::V128__bitselect:
+  case OpCode::F32x4__relaxed_madd:
+  case OpCode::F32x4__relaxed_nmadd:
+  case OpCode::F64x2__relaxed_madd:
+  case OpCode::F64x2__relaxed_nmadd:
+  case OpCode::I8x16__relaxed_laneselect:
+  case OpCode::I16x8__relaxed_laneselect:
+  case OpCode::I32x4__relaxed_laneselect:
+  case OpCode::I64x2__relaxed_laneselect:
+  case OpCode::I32x4__relaxed_dot_i8x16_i7x16_add_s:
     return StackTrans(std::array{VType::V128, VType::V128, VType::V128},
                       std::array{VType::V128});
   case OpCode::V128__any_true:
@@ -1308,7 +1482,7 @@ Expect<VType> FormChecker::popType(VType E) {
   if (E == VType::Unknown) {
     return *Res;
   }
-  if (*Res != E) {
+  if (!isSubType(*Res, E) && !isTypeIdxMatched(*Res, E)) {
     // Expect value on value stack is not matched
     spdlog::error(ErrCode::TypeCheckFailed);
     spdlog::error(ErrInfo::InfoMismatch(VTypeToAST(E), VTypeToAST(*Res)));
@@ -1317,6 +1491,18 @@ Expect<VType> FormChecker::popType(VType E) {
   return *Res;
 }
 
+bool FormChecker::isTypeIdxMatched(VType Got, VType Exp) const {
+  // The typed references of the different type indices are matched if the
+  // function types are the same.
+  if (!hasTypeIdx(Got) || !hasTypeIdx(Exp) ||
+      (!isNullableRef(Exp) && isNullableRef(Got))) {
+    return false;
+  }
+  const uint32_t GotIdx = getTypeIdx(Got), ExpIdx = getTypeIdx(Exp);
+  return GotIdx < Types.size() && ExpIdx < Types.size() &&
+         Types[GotIdx] == Types[ExpIdx];
+}
+
 Expect<void> FormChecker::popTypes(Span<const VType> Input) {
   for (auto Val = Input.rbegin(); Val != Input.rend(); ++Val) {
     if (auto Res = popType(*Val); !Res) {
@@ -1328,7 +1514,8 @@ Expect<void> FormChecker::popTypes(Span<const VType> Input) {
 
 void FormChecker::pushCtrl(Span<const VType> In, Span<const VType> Out,
                            OpCode Code) {
-  CtrlStack.emplace_back(In, Out, ValStack.size(), Code);
+  CtrlStack.emplace_back(In, Out, ValStack.size(), LocalInitStack.size(),
+                         Code);
   pushTypes(In);
 }
 
@@ -1350,6 +1537,11 @@ Expect<FormChecker::CtrlFrame> FormChecker::popCtrl() {
   }
   auto Head = std::move(CtrlStack.back());
   CtrlStack.pop_back();
+  // Reset the locals initialized in the block.
+  while (LocalInitStack.size() > Head.InitHeight) {
+    LocalInits[LocalInitStack.back()] = false;
+    LocalInitStack.pop_back();
+  }
   return Head;
 }
 
@@ -25,6 +25,26 @@ Expect<void> Validator::validate(const AST::Module &Mod) {
     Checker.addType(Type);
   }
 
+  // Check the type indices of the typed references in type definitions.
+  for (auto &Type : Mod.getTypeSection().getContent()) {
+    for (auto &Ref : Type.getParamRefs()) {
+      if (auto Res = validate(Ref); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Type_Function));
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Type));
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+        return Unexpect(Res);
+      }
+    }
+    for (auto &Ref : Type.getReturnRefs()) {
+      if (auto Res = validate(Ref); !Res) {
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Type_Function));
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Type));
+        spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+        return Unexpect(Res);
+      }
+    }
+  }
+
   // Validate and register import section into FormChecker.
   if (auto Res = validate(Mod.getImportSection()); !Res) {
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Import));
@@ -53,6 +73,13 @@ Expect<void> Validator::validate(const AST::Module &Mod) {
     return Unexpect(Res);
   }
 
+  // Validate tag section and register tags into FormChecker.
+  if (auto Res = validate(Mod.getTagSection()); !Res) {
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Tag));
+    spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Module));
+    return Unexpect(Res);
+  }
+
   // Validate global section and register globals into FormChecker.
   if (auto Res = validate(Mod.getGlobalSection()); !Res) {
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Sec_Global));
@@ -149,12 +176,30 @@ Expect<void> Validator::validate(const AST::MemoryType &Mem) {
   return {};
 }
 
+// Validate Typed reference. See "include/validator/validator.h".
+Expect<void> Validator::validate(const AST::TypedRef &Ref) {
+  // Function type index must exist in context.
+  if (Ref.hasTypeIdx() && Ref.getTypeIdx() >= Checker.getTypes().size()) {
+    spdlog::error(ErrCode::InvalidFuncTypeIdx);
+    spdlog::error(ErrInfo::InfoForbidIndex(
+        ErrInfo::IndexCategory::FunctionType, Ref.getTypeIdx(),
+        static_cast<uint32_t>(Checker.getTypes().size())));
+    return Unexpect(ErrCode::InvalidFuncTypeIdx);
+  }
+  return {};
+}
+
 // Validate Global segment. See "include/validator/validator.h".
 Expect<void> Validator::validate(const AST::GlobalSegment &GlobSeg) {
+  const auto &GlobType = GlobSeg.getGlobalType();
+  if (auto Res = validate(GlobType.getRef()); !Res) {
+    return Unexpect(Res);
+  }
   // Check global initialization is a const expression.
-  if (auto Res =
-          validateConstExpr(GlobSeg.getExpr().getInstrs(),
-                            std::array{GlobSeg.getGlobalType().getValType()});
+  if (auto Res = validateConstExpr(
+          GlobSeg.getExpr().getInstrs(),
+          std::array{Checker.ASTToVType(GlobType.getValType(),
+                                        GlobType.getRef())});
       !Res) {
     spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
     return Unexpect(Res);
@@ -167,7 +212,8 @@ Expect<void> Validator::validate(const AST::ElementSegment &ElemSeg) {
   // Check initialization expressions are const expressions.
   for (auto &Expr : ElemSeg.getInitExprs()) {
     if (auto Res = validateConstExpr(
-            Expr.getInstrs(), std::array{ToValType(ElemSeg.getRefType())});
+            Expr.getInstrs(),
+            std::array{Checker.ASTToVType(ElemSeg.getRefType())});
         !Res) {
       spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
       return Unexpect(Res);
@@ -192,7 +238,7 @@ Expect<void> Validator::validate(const AST::ElementSegment &ElemSeg) {
     }
     // Check table initialization is a const expression.
     if (auto Res = validateConstExpr(ElemSeg.getExpr().getInstrs(),
-                                     std::array{ValType::I32});
+                                     std::array{VType::I32});
         !Res) {
       spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
       return Unexpect(Res);
@@ -211,9 +257,18 @@ Expect<void> Validator::validate(const AST::CodeSegment &CodeSeg,
     Checker.addLocal(Val);
   }
   // Add locals into this frame.
-  for (auto Val : CodeSeg.getLocals()) {
-    for (uint32_t Cnt = 0; Cnt < Val.first; ++Cnt) {
-      Checker.addLocal(Val.second);
+  const auto &Locals = CodeSeg.getLocals();
+  const auto LocalRefs = CodeSeg.getLocalRefs();
+  for (size_t I = 0; I < Locals.size(); ++I) {
+    AST::TypedRef Ref;
+    if (I < LocalRefs.size()) {
+      Ref = LocalRefs[I];
+    }
+    if (auto Res = validate(Ref); !Res) {
+      return Unexpect(Res);
+    }
+    for (uint32_t Cnt = 0; Cnt < Locals[I].first; ++Cnt) {
+      Checker.addLocal(Locals[I].second, Ref);
     }
   }
   // Validate function body expression.
@@ -239,7 +294,7 @@ Expect<void> Validator::validate(const AST::DataSegment &DataSeg) {
     }
     // Check memory initialization is a const expression.
     if (auto Res = validateConstExpr(DataSeg.getExpr().getInstrs(),
-                                     std::array{ValType::I32});
+                                     std::array{VType::I32});
         !Res) {
       spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Expression));
       return Unexpect(Res);
@@ -289,9 +344,31 @@ Expect<void> Validator::validate(const AST::ImportDesc &ImpDesc) {
     return {};
   }
   case ExternalType::Global:
-    // Global type always is valid.
+    // Global type is valid if the typed reference is valid.
+    if (auto Res = validate(ImpDesc.getExternalGlobalType().getRef()); !Res) {
+      spdlog::error(ErrInfo::InfoAST(ASTNodeAttr::Type_Global));
+      return Unexpect(Res);
+    }
     Checker.addGlobal(ImpDesc.getExternalGlobalType(), true);
     return {};
+  case ExternalType::Tag: {
+    const auto TId = ImpDesc.getExternalTagTypeIdx();
+    const auto &TypeVec = Checker.getTypes();
+    // Tag type index must exist in context and has no results.
+    if (TId >= TypeVec.size()) {
+      spdlog::error(ErrCode::InvalidFuncTypeIdx);
+      spdlog::error(
+          ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::FunctionType, TId,
+                                   static_cast<uint32_t>(TypeVec.size())));
+      return Unexpect(ErrCode::InvalidFuncTypeIdx);
+    }
+    if (!TypeVec[TId].second.empty()) {
+      spdlog::error(ErrCode::InvalidTagResult);
+      return Unexpect(ErrCode::InvalidTagResult);
+    }
+    Checker.addTag(TId);
+    return {};
+  }
   default:
     break;
   }
@@ -338,6 +415,15 @@ Expect<void> Validator::validate(const AST::ExportDesc &ExpDesc) {
       return Unexpect(ErrCode::InvalidGlobalIdx);
     }
     return {};
+  case ExternalType::Tag:
+    if (Id >= Checker.getTags().size()) {
+      spdlog::error(ErrCode::InvalidTagIdx);
+      spdlog::error(ErrInfo::InfoForbidIndex(
+          ErrInfo::IndexCategory::Tag, Id,
+          static_cast<uint32_t>(Checker.getTags().size())));
+      return Unexpect(ErrCode::InvalidTagIdx);
+    }
+    return {};
   default:
     break;
   }
@@ -374,6 +460,28 @@ Expect<void> Validator::validate(const AST::FunctionSection &FuncSec) {
   return {};
 }
 
+// Validate Tag section. See "include/validator/validator.h".
+Expect<void> Validator::validate(const AST::TagSection &TagSec) {
+  const auto &TypeVec = Checker.getTypes();
+
+  // Check if type id of tag is valid in context and has no results.
+  for (auto &TId : TagSec.getContent()) {
+    if (TId >= TypeVec.size()) {
+      spdlog::error(ErrCode::InvalidFuncTypeIdx);
+      spdlog::error(
+          ErrInfo::InfoForbidIndex(ErrInfo::IndexCategory::FunctionType, TId,
+                                   static_cast<uint32_t>(TypeVec.size())));
+      return Unexpect(ErrCode::InvalidFuncTypeIdx);
+    }
+    if (!TypeVec[TId].second.empty()) {
+      spdlog::error(ErrCode::InvalidTagResult);
+      return Unexpect(ErrCode::InvalidTagResult);
+    }
+    Checker.addTag(TId);
+  }
+  return {};
+}
+
 // Validate Table section. See "include/validator/validator.h".
 Expect<void> Validator::validate(const AST::TableSection &TabSec) {
   for (auto &Tab : TabSec.getContent()) {
@@ -514,7 +622,7 @@ Expect<void> Validator::validate(const AST::ExportSection &ExportSec) {
 
 // Validate constant expression. See "include/validator/validator.h".
 Expect<void> Validator::validateConstExpr(AST::InstrView Instrs,
-                                          Span<const ValType> Returns) {
+                                          Span<const VType> Returns) {
   for (auto &Instr : Instrs) {
     // Only these 5 instructions are constant.
     switch (Instr.getOpCode()) {
@@ -0,0 +1,671 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "vm/preinit.h"
+
+#include "common/log.h"
+#include "executor/executor.h"
+#include "loader/loader.h"
+#include "runtime/importobj.h"
+#include "runtime/storemgr.h"
+#include "validator/validator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace WasmEdge {
+namespace VM {
+
+namespace {
+
+/// Zero bytes shorter than this gap are merged into one data segment to save
+/// the overhead of the segment headers.
+static inline constexpr const uint64_t kDataSegmentGap = 32;
+
+/// Host function to replace the imported functions. The host state cannot be
+/// snapshotted, so calling any of the imported functions during the
+/// initialization fails.
+class ImportStub : public Runtime::HostFunctionBase {
+public:
+  ImportStub(const AST::FunctionType &Type, std::string_view Mod,
+             std::string_view Func)
+      : Runtime::HostFunctionBase(0, FuncType), FuncType(Type), ModName(Mod),
+        FuncName(Func) {}
+
+  Expect<void> run(Runtime::Instance::MemoryInstance *, Span<const ValVariant>,
+                   Span<ValVariant>) override {
+    spdlog::error("Pre-initialization failed -- imported function \"{}\" of "
+                  "module \"{}\" is called, and the host state cannot be "
+                  "snapshotted.",
+                  FuncName, ModName);
+    return Unexpect(ErrCode::ExecutionFailed);
+  }
+
+private:
+  const AST::FunctionType FuncType;
+  const std::string ModName;
+  const std::string FuncName;
+};
+
+/// Raw section of wasm binary.
+struct RawSection {
+  uint8_t Id;
+  std::vector<Byte> Content;
+};
+
+/// Order of the non-custom sections in wasm binary.
+uint32_t getSectionOrder(uint8_t Id) noexcept {
+  switch (Id) {
+  case 12:
+    // Data count section is between the element and code sections.
+    return 10;
+  case 10:
+  case 11:
+    return Id + 1U;
+  default:
+    return Id;
+  }
+}
+
+void writeU32(std::vector<Byte> &Out, uint32_t Val) {
+  do {
+    Byte B = static_cast<Byte>(Val & 0x7FU);
+    Val >>= 7;
+    if (Val != 0) {
+      B |= 0x80U;
+    }
+    Out.push_back(B);
+  } while (Val != 0);
+}
+
+void writeS64(std::vector<Byte> &Out, int64_t Val) {
+  while (true) {
+    Byte B = static_cast<Byte>(Val & 0x7F);
+    Val >>= 7;
+    if ((Val == 0 && (B & 0x40U) == 0) || (Val == -1 && (B & 0x40U) != 0)) {
+      Out.push_back(B);
+      return;
+    }
+    Out.push_back(B | 0x80U);
+  }
+}
+
+void writeBytes(std::vector<Byte> &Out, const void *Ptr, size_t Size) {
+  const auto *Bytes = reinterpret_cast<const Byte *>(Ptr);
+  Out.insert(Out.end(), Bytes, Bytes + Size);
+}
+
+void writeVec(std::vector<Byte> &Out, Span<const Byte> Bytes) {
+  writeU32(Out, static_cast<uint32_t>(Bytes.size()));
+  Out.insert(Out.end(), Bytes.begin(), Bytes.end());
+}
+
+void writeLimit(std::vector<Byte> &Out, const AST::Limit &Lim) {
+  Out.push_back(Lim.hasMax() ? 0x01U : 0x00U);
+  writeU32(Out, Lim.getMin());
+  if (Lim.hasMax()) {
+    writeU32(Out, Lim.getMax());
+  }
+}
+
+void writeValType(std::vector<Byte> &Out, ValType Type,
+                  const AST::TypedRef &Ref) {
+  if (Ref.isPlain()) {
+    Out.push_back(static_cast<Byte>(Type));
+    return;
+  }
+  // The `(ref ht)` and `(ref null ht)` types of the function references.
+  Out.push_back(Ref.isNullable() ? 0x6CU : 0x6BU);
+  if (Ref.hasTypeIdx()) {
+    writeS64(Out, Ref.getTypeIdx());
+  } else {
+    Out.push_back(static_cast<Byte>(Type));
+  }
+}
+
+void writeOffsetExpr(std::vector<Byte> &Out, uint32_t Offset) {
+  Out.push_back(static_cast<Byte>(OpCode::I32__const));
+  writeS64(Out, static_cast<int32_t>(Offset));
+  Out.push_back(static_cast<Byte>(OpCode::End));
+}
+
+/// Read a LEB128 encoded uint32 from the validated wasm binary.
+Expect<uint32_t> readU32(Span<const Byte> Code, size_t &Pos) {
+  uint32_t Val = 0;
+  for (uint32_t Shift = 0; Shift < 35; Shift += 7) {
+    if (Pos >= Code.size()) {
+      return Unexpect(ErrCode::UnexpectedEnd);
+    }
+    const Byte B = Code[Pos++];
+    Val |= static_cast<uint32_t>(B & 0x7FU) << Shift;
+    if ((B & 0x80U) == 0) {
+      return Val;
+    }
+  }
+  return Unexpect(ErrCode::IntegerTooLong);
+}
+
+/// Split the wasm binary into the raw sections.
+Expect<std::vector<RawSection>> splitSections(Span<const Byte> Code) {
+  std::vector<RawSection> Sections;
+  size_t Pos = 8;
+  while (Pos < Code.size()) {
+    const uint8_t Id = Code[Pos++];
+    uint32_t Size;
+    if (auto Res = readU32(Code, Pos)) {
+      Size = *Res;
+    } else {
+      return Unexpect(Res);
+    }
+    if (Size > Code.size() - Pos) {
+      return Unexpect(ErrCode::UnexpectedEnd);
+    }
+    Sections.push_back(
+        {Id, std::vector<Byte>(Code.begin() + Pos, Code.begin() + Pos + Size)});
+    Pos += Size;
+  }
+  return Sections;
+}
+
+/// Encoder of the instantiated state into the module sections.
+class Snapshot {
+public:
+  Snapshot(const Configure &C, const AST::Module &M,
+           Runtime::StoreManager &S, const Runtime::Instance::ModuleInstance &I)
+      : Conf(C), Mod(M), StoreMgr(S), ModInst(I) {
+    for (uint32_t Idx = 0; Idx < ModInst.getFuncNum(); ++Idx) {
+      FuncIdxMap.emplace(*StoreMgr.getFunction(*ModInst.getFuncAddr(Idx)),
+                         Idx);
+    }
+  }
+
+  /// Encode the table section with the current table sizes.
+  std::vector<Byte> encodeTableSection() {
+    std::vector<Byte> Out;
+    writeU32(Out, ModInst.getTableNum());
+    for (uint32_t Idx = 0; Idx < ModInst.getTableNum(); ++Idx) {
+      const auto &TabType =
+          (*StoreMgr.getTable(*ModInst.getTableAddr(Idx)))->getTableType();
+      Out.push_back(static_cast<Byte>(TabType.getRefType()));
+      writeLimit(Out, TabType.getLimit());
+    }
+    return Out;
+  }
+
+  /// Encode the memory section with the current memory sizes.
+  std::vector<Byte> encodeMemorySection() {
+    std::vector<Byte> Out;
+    writeU32(Out, ModInst.getMemNum());
+    for (uint32_t Idx = 0; Idx < ModInst.getMemNum(); ++Idx) {
+      const auto &MemType =
+          (*StoreMgr.getMemory(*ModInst.getMemAddr(Idx)))->getMemoryType();
+      writeLimit(Out, MemType.getLimit());
+    }
+    return Out;
+  }
+
+  /// Encode the global section with the current global values.
+  Expect<std::vector<Byte>> encodeGlobalSection() {
+    std::vector<Byte> Out;
+    writeU32(Out, ModInst.getGlobalNum());
+    for (uint32_t Idx = 0; Idx < ModInst.getGlobalNum(); ++Idx) {
+      const auto *GlobInst = *StoreMgr.getGlobal(*ModInst.getGlobalAddr(Idx));
+      const auto &GlobType = GlobInst->getGlobalType();
+      const auto &Val = GlobInst->getValue();
+      writeValType(Out, GlobType.getValType(), GlobType.getRef());
+      Out.push_back(static_cast<Byte>(GlobType.getValMut()));
+      switch (GlobType.getValType()) {
+      case ValType::I32:
+        Out.push_back(static_cast<Byte>(OpCode::I32__const));
+        writeS64(Out, Val.get<int32_t>());
+        break;
+      case ValType::I64:
+        Out.push_back(static_cast<Byte>(OpCode::I64__const));
+        writeS64(Out, Val.get<int64_t>());
+        break;
+      case ValType::F32:
+        Out.push_back(static_cast<Byte>(OpCode::F32__const));
+        writeBytes(Out, &Val.get<float>(), sizeof(float));
+        break;
+      case ValType::F64:
+        Out.push_back(static_cast<Byte>(OpCode::F64__const));
+        writeBytes(Out, &Val.get<double>(), sizeof(double));
+        break;
+      case ValType::V128: {
+        const auto Code = static_cast<uint32_t>(OpCode::V128__const);
+        Out.push_back(static_cast<Byte>(Code >> 16));
+        writeU32(Out, Code & 0xFFFFU);
+        writeBytes(Out, &Val.get<uint128_t>(), sizeof(uint128_t));
+        break;
+      }
+      case ValType::FuncRef:
+      case ValType::ExternRef:
+        if (auto Res =
+                writeRef(Out, static_cast<RefType>(GlobType.getValType()),
+                         Val.get<UnknownRef>().Value, retrieveFuncRef(Val),
+                         GlobType.getRef().getTypeIdx());
+            !Res) {
+          return Unexpect(Res);
+        }
+        break;
+      default:
+        assumingUnreachable();
+      }
+      Out.push_back(static_cast<Byte>(OpCode::End));
+    }
+    return Out;
+  }
+
+  /// Encode the export section without the initialization function.
+  std::vector<Byte> encodeExportSection(std::string_view InitFunc) {
+    std::vector<Byte> Out;
+    const auto Exports = Mod.getExportSection().getContent();
+    std::vector<const AST::ExportDesc *> Kept;
+    for (const auto &ExpDesc : Exports) {
+      if (ExpDesc.getExternalType() != ExternalType::Function ||
+          ExpDesc.getExternalName() != InitFunc) {
+        Kept.push_back(&ExpDesc);
+      }
+    }
+    writeU32(Out, static_cast<uint32_t>(Kept.size()));
+    for (const auto *ExpDesc : Kept) {
+      const auto Name = ExpDesc->getExternalName();
+      writeVec(Out, Span<const Byte>(
+                        reinterpret_cast<const Byte *>(Name.data()),
+                        Name.size()));
+      Out.push_back(static_cast<Byte>(ExpDesc->getExternalType()));
+      writeU32(Out, ExpDesc->getExternalIndex());
+    }
+    return Out;
+  }
+
+  /// Encode the element section with the current table contents.
+  ///
+  /// When the element segment indices may be referenced by the instructions,
+  /// the original segments are kept in their current states: the non-dropped
+  /// passive segments become passive segments with the current references, and
+  /// the others become declarative segments to keep the function references
+  /// declared. The table contents are appended as active segments.
+  Expect<std::pair<std::vector<Byte>, uint32_t>> encodeElementSection() {
+    std::vector<Byte> Out;
+    uint32_t Count = 0;
+    if (Conf.hasProposal(Proposal::BulkMemoryOperations) &&
+        Conf.hasProposal(Proposal::ReferenceTypes)) {
+      const auto Segs = Mod.getElementSection().getContent();
+      for (uint32_t Idx = 0; Idx < Segs.size(); ++Idx) {
+        const auto *ElemInst = *StoreMgr.getElement(*ModInst.getElemAddr(Idx));
+        const auto Type = Segs[Idx].getRefType();
+        if (ElemInst->getRefs().size() > 0) {
+          // Passive segment with expressions.
+          Out.push_back(0x05U);
+          Out.push_back(static_cast<Byte>(Type));
+          writeU32(Out, static_cast<uint32_t>(ElemInst->getRefs().size()));
+          for (const auto &Ref : ElemInst->getRefs()) {
+            if (auto Res = writeRef(Out, Type, Ref.get<UnknownRef>().Value,
+                                    retrieveFuncRef(Ref));
+                !Res) {
+              return Unexpect(Res);
+            }
+            Out.push_back(static_cast<Byte>(OpCode::End));
+          }
+        } else {
+          // Declarative segment with the original expressions.
+          Out.push_back(0x07U);
+          Out.push_back(static_cast<Byte>(Type));
+          writeU32(Out, static_cast<uint32_t>(Segs[Idx].getInitExprs().size()));
+          for (const auto &Expr : Segs[Idx].getInitExprs()) {
+            if (auto Res = writeConstExpr(Out, Expr); !Res) {
+              return Unexpect(Res);
+            }
+          }
+        }
+        ++Count;
+      }
+    }
+
+    for (uint32_t Idx = 0; Idx < ModInst.getTableNum(); ++Idx) {
+      const auto *TabInst = *StoreMgr.getTable(*ModInst.getTableAddr(Idx));
+      const auto Refs = *TabInst->getRefs(0, TabInst->getSize());
+      uint32_t Pos = 0;
+      while (Pos < Refs.size()) {
+        if (isNullRef(Refs[Pos])) {
+          ++Pos;
+          continue;
+        }
+        if (TabInst->getTableType().getRefType() != RefType::FuncRef) {
+          spdlog::error("Pre-initialization failed -- external reference in "
+                        "table {} cannot be snapshotted.",
+                        Idx);
+          return Unexpect(ErrCode::RuntimeError);
+        }
+        uint32_t End = Pos;
+        while (End < Refs.size() && !isNullRef(Refs[End])) {
+          ++End;
+        }
+        if (Idx == 0) {
+          Out.push_back(0x00U);
+          writeOffsetExpr(Out, Pos);
+        } else {
+          Out.push_back(0x02U);
+          writeU32(Out, Idx);
+          writeOffsetExpr(Out, Pos);
+          // Element kind: funcref.
+          Out.push_back(0x00U);
+        }
+        writeU32(Out, End - Pos);
+        for (; Pos < End; ++Pos) {
+          if (auto Res = getFuncIdx(retrieveFuncRef(Refs[Pos]))) {
+            writeU32(Out, *Res);
+          } else {
+            return Unexpect(Res);
+          }
+        }
+        ++Count;
+      }
+    }
+
+    std::vector<Byte> Sec;
+    writeU32(Sec, Count);
+    Sec.insert(Sec.end(), Out.begin(), Out.end());
+    return std::make_pair(std::move(Sec), Count);
+  }
+
+  /// Encode the data section with the current memory contents.
+  ///
+  /// When the data count section exists, the data segment indices may be
+  /// referenced by the instructions. The original segments are kept as the
+  /// passive segments with their current data. The non-zero memory contents
+  /// are appended as active segments.
+  std::pair<std::vector<Byte>, uint32_t> encodeDataSection() {
+    std::vector<Byte> Out;
+    uint32_t Count = 0;
+    if (Mod.getDataCountSection().getContent().has_value()) {
+      for (uint32_t Idx = 0; Idx < ModInst.getDataNum(); ++Idx) {
+        const auto *DataInst = *StoreMgr.getData(*ModInst.getDataAddr(Idx));
+        Out.push_back(0x01U);
+        writeVec(Out, DataInst->getData());
+        ++Count;
+      }
+    }
+
+    for (uint32_t Idx = 0; Idx < ModInst.getMemNum(); ++Idx) {
+      const auto *MemInst = *StoreMgr.getMemory(*ModInst.getMemAddr(Idx));
+      const Byte *Data = MemInst->getDataPtr();
+      const uint64_t Size =
+          static_cast<uint64_t>(MemInst->getPageSize()) *
+          Runtime::Instance::MemoryInstance::kPageSize;
+      uint64_t Pos = 0;
+      while (Pos < Size) {
+        if (Data[Pos] == 0) {
+          ++Pos;
+          continue;
+        }
+        const uint64_t Start = Pos;
+        uint64_t End = Pos;
+        while (Pos < Size && Pos - End < kDataSegmentGap) {
+          if (Data[Pos++] != 0) {
+            End = Pos;
+          }
+        }
+        if (Idx == 0) {
+          Out.push_back(0x00U);
+        } else {
+          Out.push_back(0x02U);
+          writeU32(Out, Idx);
+        }
+        writeOffsetExpr(Out, static_cast<uint32_t>(Start));
+        writeVec(Out, Span<const Byte>(Data + Start, End - Start));
+        ++Count;
+      }
+    }
+
+    std::vector<Byte> Sec;
+    writeU32(Sec, Count);
+    Sec.insert(Sec.end(), Out.begin(), Out.end());
+    return std::make_pair(std::move(Sec), Count);
+  }
+
+private:
+  Expect<uint32_t>
+  getFuncIdx(const Runtime::Instance::FunctionInstance *FuncInst) const {
+    // Resolve the references of function addresses.
+    if (auto Res = StoreMgr.getFunction(FuncRef(FuncInst))) {
+      FuncInst = *Res;
+    }
+    if (auto It = FuncIdxMap.find(FuncInst); It != FuncIdxMap.end()) {
+      return It->second;
+    }
+    spdlog::error("Pre-initialization failed -- function reference to other "
+                  "modules cannot be snapshotted.");
+    return Unexpect(ErrCode::RuntimeError);
+  }
+
+  /// Write the `ref.null` or `ref.func` instruction of a reference.
+  Expect<void>
+  writeRef(std::vector<Byte> &Out, RefType Type, uint64_t Value,
+           const Runtime::Instance::FunctionInstance *FuncInst,
+           uint32_t TypeIdx = AST::TypedRef::AbstractIdx) const {
+    if (Value == 0) {
+      Out.push_back(static_cast<Byte>(OpCode::Ref__null));
+      if (TypeIdx != AST::TypedRef::AbstractIdx) {
+        writeS64(Out, TypeIdx);
+      } else {
+        Out.push_back(static_cast<Byte>(Type));
+      }
+      return {};
+    }
+    if (Type != RefType::FuncRef) {
+      spdlog::error("Pre-initialization failed -- external reference cannot "
+                    "be snapshotted.");
+      return Unexpect(ErrCode::RuntimeError);
+    }
+    if (auto Res = getFuncIdx(FuncInst)) {
+      Out.push_back(static_cast<Byte>(OpCode::Ref__func));
+      writeU32(Out, *Res);
+      return {};
+    } else {
+      return Unexpect(Res);
+    }
+  }
+
+  /// Write the constant expression of the element segments.
+  Expect<void> writeConstExpr(std::vector<Byte> &Out,
+                              const AST::Expression &Expr) const {
+    for (const auto &Instr : Expr.getInstrs()) {
+      switch (Instr.getOpCode()) {
+      case OpCode::Ref__null:
+        Out.push_back(static_cast<Byte>(OpCode::Ref__null));
+        Out.push_back(static_cast<Byte>(Instr.getRefType()));
+        break;
+      case OpCode::Ref__func:
+      case OpCode::Global__get:
+        Out.push_back(static_cast<Byte>(Instr.getOpCode()));
+        writeU32(Out, Instr.getTargetIndex());
+        break;
+      case OpCode::End:
+        Out.push_back(static_cast<Byte>(OpCode::End));
+        break;
+      default:
+        spdlog::error(ErrCode::ConstExprRequired);
+        return Unexpect(ErrCode::ConstExprRequired);
+      }
+    }
+    return {};
+  }
+
+  const Configure &Conf;
+  const AST::Module &Mod;
+  Runtime::StoreManager &StoreMgr;
+  const Runtime::Instance::ModuleInstance &ModInst;
+  std::unordered_map<const Runtime::Instance::FunctionInstance *, uint32_t>
+      FuncIdxMap;
+};
+
+} // namespace
+
+Expect<std::vector<Byte>>
+PreInitializer::preInitialize(Span<const Byte> Code,
+                              std::string_view InitFunc) {
+  // Load and validate the module.
+  Loader::Loader LoaderEngine(Conf);
+  std::unique_ptr<AST::Module> Mod;
+  if (auto Res = LoaderEngine.parseModule(Code)) {
+    Mod = std::move(*Res);
+  } else {
+    return Unexpect(Res);
+  }
+  if (auto Res = Validator::Validator(Conf).validate(*Mod); !Res) {
+    return Unexpect(Res);
+  }
+  std::vector<RawSection> Sections;
+  if (auto Res = splitSections(Code)) {
+    Sections = std::move(*Res);
+  } else {
+    return Unexpect(Res);
+  }
+
+  // Replace the imported functions with the stubs.
+  std::map<std::string, std::unique_ptr<Runtime::ImportObject>, std::less<>>
+      Stubs;
+  const auto FuncTypes = Mod->getTypeSection().getContent();
+  for (const auto &ImpDesc : Mod->getImportSection().getContent()) {
+    if (ImpDesc.getExternalType() != ExternalType::Function) {
+      spdlog::error("Pre-initialization failed -- imported {} \"{}\" of module "
+                    "\"{}\" cannot be snapshotted.",
+                    ExternalTypeStr[ImpDesc.getExternalType()],
+                    ImpDesc.getExternalName(), ImpDesc.getModuleName());
+      return Unexpect(ErrCode::RuntimeError);
+    }
+    auto &Stub = Stubs[std::string(ImpDesc.getModuleName())];
+    if (!Stub) {
+      Stub = std::make_unique<Runtime::ImportObject>(ImpDesc.getModuleName());
+    }
+    Stub->addHostFunc(ImpDesc.getExternalName(),
+                      std::make_unique<ImportStub>(
+                          FuncTypes[ImpDesc.getExternalFuncTypeIdx()],
+                          ImpDesc.getModuleName(), ImpDesc.getExternalName()));
+  }
+
+  // Instantiate the module and run the initialization function.
+  Runtime::StoreManager StoreMgr;
+  Executor::Executor ExecutorEngine(Conf);
+  for (const auto &Stub : Stubs) {
+    if (auto Res = ExecutorEngine.registerModule(StoreMgr, *Stub.second);
+        !Res) {
+      return Unexpect(Res);
+    }
+  }
+  if (auto Res = ExecutorEngine.instantiateModule(StoreMgr, *Mod); !Res) {
+    return Unexpect(Res);
+  }
+  const auto *ModInst = *StoreMgr.getActiveModule();
+  const auto &FuncExports = ModInst->getFuncExports();
+  const auto FuncIter = FuncExports.find(InitFunc);
+  if (FuncIter == FuncExports.cend()) {
+    spdlog::error(ErrCode::FuncNotFound);
+    spdlog::error(ErrInfo::InfoExecuting("", InitFunc));
+    return Unexpect(ErrCode::FuncNotFound);
+  }
+  const auto &FuncType =
+      (*StoreMgr.getFunction(FuncIter->second))->getFuncType();
+  if (!FuncType.getParamTypes().empty() || !FuncType.getReturnTypes().empty()) {
+    spdlog::error(ErrCode::FuncSigMismatch);
+    spdlog::error(ErrInfo::InfoMismatch(std::vector<ValType>{},
+                                        std::vector<ValType>{},
+                                        FuncType.getParamTypes(),
+                                        FuncType.getReturnTypes()));
+    return Unexpect(ErrCode::FuncSigMismatch);
+  }
+  if (auto Res = ExecutorEngine.invoke(StoreMgr, FuncIter->second, {}, {});
+      !Res) {
+    return Unexpect(Res);
+  }
+
+  // Snapshot the instantiated state into the sections.
+  Snapshot Snap(Conf, *Mod, StoreMgr, *ModInst);
+  auto ElemSec = Snap.encodeElementSection();
+  if (!ElemSec) {
+    return Unexpect(ElemSec);
+  }
+  auto DataSec = Snap.encodeDataSection();
+  bool HasElemSec = false, HasDataSec = false;
+  for (auto Iter = Sections.begin(); Iter != Sections.end();) {
+    switch (Iter->Id) {
+    case 4:
+      Iter->Content = Snap.encodeTableSection();
+      break;
+    case 5:
+      Iter->Content = Snap.encodeMemorySection();
+      break;
+    case 6:
+      if (auto Res = Snap.encodeGlobalSection()) {
+        Iter->Content = std::move(*Res);
+      } else {
+        return Unexpect(Res);
+      }
+      break;
+    case 7:
+      Iter->Content = Snap.encodeExportSection(InitFunc);
+      break;
+    case 8:
+      // The start function has been run in the instantiation.
+      Iter = Sections.erase(Iter);
+      continue;
+    case 9:
+      Iter->Content = std::move(ElemSec->first);
+      HasElemSec = true;
+      break;
+    case 11:
+      Iter->Content = std::move(DataSec.first);
+      HasDataSec = true;
+      break;
+    case 12:
+      Iter->Content.clear();
+      writeU32(Iter->Content, DataSec.second);
+      break;
+    default:
+      break;
+    }
+    ++Iter;
+  }
+  auto InsertSection = [&Sections](uint8_t Id, std::vector<Byte> Content) {
+    auto Iter =
+        std::find_if(Sections.begin(), Sections.end(), [Id](const auto &Sec) {
+          return Sec.Id != 0 && getSectionOrder(Sec.Id) > getSectionOrder(Id);
+        });
+    Sections.insert(Iter, {Id, std::move(Content)});
+  };
+  if (!HasElemSec && ElemSec->second > 0) {
+    InsertSection(9, std::move(ElemSec->first));
+  }
+  if (!HasDataSec && DataSec.second > 0) {
+    InsertSection(11, std::move(DataSec.first));
+  }
+
+  // Generate the wasm binary.
+  std::vector<Byte> Output(Code.begin(), Code.begin() + 8);
+  for (const auto &Sec : Sections) {
+    Output.push_back(Sec.Id);
+    writeVec(Output, Sec.Content);
+  }
+
+  // Check the generated module.
+  if (auto Res = LoaderEngine.parseModule(Output)) {
+    if (auto Check = Validator::Validator(Conf).validate(**Res); !Check) {
+      spdlog::error("Pre-initialization failed -- invalid output module.");
+      return Unexpect(Check);
+    }
+  } else {
+    spdlog::error("Pre-initialization failed -- malformed output module.");
+    return Unexpect(Res);
+  }
+  return Output;
+}
+
+} // namespace VM
+} // namespace WasmEdge
@@ -5,23 +5,33 @@
 #include "vm/async.h"
 
 #include "host/wasi/wasimodule.h"
+#include "host/wasmedge_memory/memorymodule.h"
 #include "host/wasmedge_process/processmodule.h"
 
 namespace WasmEdge {
 namespace VM {
 
 VM::VM(const Configure &Conf)
-    : Conf(Conf), Stage(VMStage::Inited),
+    : Conf(Conf),
+      Prof(Conf.getStatisticsConfigure().isProfiling()
+               ? std::make_unique<Profiler>()
+               : nullptr),
+      Stage(VMStage::Inited),
       LoaderEngine(Conf, &Executor::Executor::Intrinsics),
-      ValidatorEngine(Conf), ExecutorEngine(Conf, &Stat),
+      ValidatorEngine(Conf), ExecutorEngine(Conf, &Stat, Prof.get()),
       Store(std::make_unique<Runtime::StoreManager>()), StoreRef(*Store.get()) {
   initVM();
 }
 
 VM::VM(const Configure &Conf, Runtime::StoreManager &S)
-    : Conf(Conf), Stage(VMStage::Inited),
+    : Conf(Conf),
+      Prof(Conf.getStatisticsConfigure().isProfiling()
+               ? std::make_unique<Profiler>()
+               : nullptr),
+      Stage(VMStage::Inited),
       LoaderEngine(Conf, &Executor::Executor::Intrinsics),
-      ValidatorEngine(Conf), ExecutorEngine(Conf, &Stat), StoreRef(S) {
+      ValidatorEngine(Conf), ExecutorEngine(Conf, &Stat, Prof.get()),
+      StoreRef(S) {
   initVM();
 }
 
@@ -39,6 +49,22 @@ void VM::initVM() {
     ExecutorEngine.registerModule(StoreRef, *ProcMod.get());
     ImpObjs.insert({HostRegistration::WasmEdge_Process, std::move(ProcMod)});
   }
+  if (Conf.hasHostRegistration(HostRegistration::WasmEdge_Memory)) {
+    std::unique_ptr<Runtime::ImportObject> MemMod =
+        std::make_unique<Host::WasmEdgeMemoryModule>();
+    ExecutorEngine.registerModule(StoreRef, *MemMod.get());
+    ImpObjs.insert({HostRegistration::WasmEdge_Memory, std::move(MemMod)});
+  }
+  if (Conf.hasHostRegistration(HostRegistration::WasmEdge_Fs)) {
+    // The filesystem extension shares the environment of the WASI module.
+    if (auto It = ImpObjs.find(HostRegistration::Wasi); It != ImpObjs.end()) {
+      std::unique_ptr<Runtime::ImportObject> FsMod =
+          std::make_unique<Host::WasmEdgeFsModule>(
+              static_cast<Host::WasiModule *>(It->second.get())->getEnv());
+      ExecutorEngine.registerModule(StoreRef, *FsMod.get());
+      ImpObjs.insert({HostRegistration::WasmEdge_Fs, std::move(FsMod)});
+    }
+  }
 }
 
 Expect<void> VM::registerModule(std::string_view Name,
@@ -279,6 +305,13 @@ VM::execute(std::string_view ModName, std::string_view Func,
   }
 }
 
+void VM::stop() noexcept {
+  ExecutorEngine.stop();
+  if (auto It = ImpObjs.find(HostRegistration::Wasi); It != ImpObjs.end()) {
+    static_cast<Host::WasiModule *>(It->second.get())->getEnv().interrupt();
+  }
+}
+
 Expect<std::vector<std::pair<ValVariant, ValType>>>
 VM::execute(Runtime::Instance::ModuleInstance *ModInst, std::string_view Func,
             Span<const ValVariant> Params, Span<const ValType> ParamTypes) {
@@ -292,8 +325,16 @@ VM::execute(Runtime::Instance::ModuleInstance *ModInst, std::string_view Func,
   }
 
   // Execute function.
-  if (auto Res = ExecutorEngine.invoke(StoreRef, FuncIter->second, Params,
-                                       ParamTypes)) {
+  auto Res =
+      ExecutorEngine.invoke(StoreRef, FuncIter->second, Params, ParamTypes);
+  // The stop request during this execution should not wake up the blocking
+  // calls of the following executions.
+  if (auto It = ImpObjs.find(HostRegistration::Wasi); It != ImpObjs.end()) {
+    static_cast<Host::WasiModule *>(It->second.get())
+        ->getEnv()
+        .clearInterrupt();
+  }
+  if (Res) {
     return Res;
   } else {
     spdlog::error(ErrInfo::InfoExecuting(ModInst->getModuleName(), Func));
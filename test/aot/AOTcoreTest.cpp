@@ -22,10 +22,13 @@
 #include "../spec/hostfunc.h"
 #include "../spec/spectest.h"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cstdint>
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <gtest/gtest.h>
 #include <map>
 #include <memory>
@@ -445,6 +448,219 @@ TEST(AsyncExecute, CustomWasmInterruptTest) {
   std::filesystem::remove(Path);
 }
 
+TEST(CPUTimeLimit, NativeTest) {
+  WasmEdge::Configure Conf;
+  Conf.getCompilerConfigure().setInterruptible(true);
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Native);
+
+  WasmEdge::VM::VM VM(Conf);
+  std::array<WasmEdge::Byte, 46> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07,
+      0x0a, 0x01, 0x06, 0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x00, 0x0a,
+      0x09, 0x01, 0x07, 0x00, 0x03, 0x40, 0x0c, 0x00, 0x0b, 0x0b};
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator ValidatorEngine(Conf);
+  WasmEdge::AOT::Compiler Compiler(Conf);
+  auto Path = std::filesystem::temp_directory_path() /
+              std::filesystem::u8path("AOTcoreTest" EXTENSION);
+  auto Module = *Loader.parseModule(Wasm);
+  ASSERT_TRUE(ValidatorEngine.validate(*Module));
+  ASSERT_TRUE(Compiler.compile(Wasm, *Module, Path));
+  ASSERT_TRUE(VM.loadWasm(Path));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  // The compiled loop polls the CPU time limit without any host call.
+  VM.getStatistics().setCPUTimeLimit(std::chrono::milliseconds(50));
+  auto Result = VM.execute("_start");
+  EXPECT_FALSE(Result);
+  EXPECT_EQ(Result.error(), WasmEdge::ErrCode::CPUTimeLimitExceeded);
+  EXPECT_GE(VM.getStatistics().getWasmCPUTime(), std::chrono::milliseconds(50));
+  std::filesystem::remove(Path);
+}
+
+TEST(LoadCompiled, MismatchedTablesTest) {
+  WasmEdge::Configure Conf;
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Native);
+
+  // (module (func) (func))
+  std::array<WasmEdge::Byte, 28> Wasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04,
+      0x01, 0x60, 0x00, 0x00, 0x03, 0x03, 0x02, 0x00, 0x00, 0x0a,
+      0x07, 0x02, 0x02, 0x00, 0x0b, 0x02, 0x00, 0x0b};
+  // (module (func)) with a custom section padding it to the same size.
+  std::array<WasmEdge::Byte, 28> OtherWasm{
+      0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04,
+      0x01, 0x60, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x0a, 0x04,
+      0x01, 0x02, 0x00, 0x0b, 0x00, 0x02, 0x01, 0x78};
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator ValidatorEngine(Conf);
+  WasmEdge::AOT::Compiler Compiler(Conf);
+  auto Path = std::filesystem::temp_directory_path() /
+              std::filesystem::u8path("AOTcoreTest" EXTENSION);
+  auto Module = *Loader.parseModule(Wasm);
+  ASSERT_TRUE(ValidatorEngine.validate(*Module));
+  ASSERT_TRUE(Compiler.compile(Wasm, *Module, Path));
+  ASSERT_TRUE(Loader.parseModule(Path));
+
+  // Replace the embedded wasm with a module defining fewer functions than
+  // the compiled tables.
+  std::vector<char> Binary;
+  {
+    std::ifstream File(Path, std::ios::binary);
+    Binary.assign(std::istreambuf_iterator<char>(File),
+                  std::istreambuf_iterator<char>());
+  }
+  auto It = std::search(Binary.begin(), Binary.end(), Wasm.begin(), Wasm.end());
+  ASSERT_NE(It, Binary.end());
+  std::copy(OtherWasm.begin(), OtherWasm.end(), It);
+  {
+    std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+    File.write(Binary.data(), static_cast<std::streamsize>(Binary.size()));
+  }
+  auto Result = Loader.parseModule(Path);
+  EXPECT_FALSE(Result);
+  EXPECT_EQ(Result.error(), WasmEdge::ErrCode::IllegalGrammar);
+  std::filesystem::remove(Path);
+}
+
+TEST(ExceptionHandling, NativeTest) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Native);
+
+  // The exception handling test module of test/exception.
+  std::vector<WasmEdge::Byte> Wasm{
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x02, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x03, 0x08, 0x07, 0x00,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x0D, 0x03, 0x01, 0x00, 0x00, 0x07,
+    0x3C, 0x06, 0x05, 0x63, 0x61, 0x74, 0x63, 0x68, 0x00, 0x01, 0x09, 0x63,
+    0x61, 0x74, 0x63, 0x68, 0x5F, 0x61, 0x6C, 0x6C, 0x00, 0x02, 0x08, 0x64,
+    0x65, 0x6C, 0x65, 0x67, 0x61, 0x74, 0x65, 0x00, 0x03, 0x07, 0x72, 0x65,
+    0x74, 0x68, 0x72, 0x6F, 0x77, 0x00, 0x04, 0x08, 0x75, 0x6E, 0x63, 0x61,
+    0x75, 0x67, 0x68, 0x74, 0x00, 0x05, 0x04, 0x6C, 0x6F, 0x6F, 0x70, 0x00,
+    0x06, 0x0A, 0x8A, 0x01, 0x07, 0x06, 0x00, 0x20, 0x00, 0x08, 0x00, 0x0B,
+    0x10, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00, 0x07, 0x00,
+    0x41, 0x01, 0x6A, 0x0B, 0x0B, 0x0E, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10,
+    0x00, 0x41, 0x00, 0x19, 0x41, 0x2A, 0x0B, 0x0B, 0x15, 0x00, 0x06, 0x7F,
+    0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00, 0x18, 0x00, 0x07, 0x00,
+    0x41, 0xE4, 0x00, 0x6A, 0x0B, 0x0B, 0x19, 0x00, 0x06, 0x7F, 0x06, 0x40,
+    0x20, 0x00, 0x10, 0x00, 0x07, 0x00, 0x1A, 0x09, 0x00, 0x0B, 0x41, 0x00,
+    0x07, 0x00, 0x41, 0xE8, 0x07, 0x6A, 0x0B, 0x0B, 0x08, 0x00, 0x20, 0x00,
+    0x10, 0x00, 0x41, 0x00, 0x0B, 0x28, 0x01, 0x01, 0x7F, 0x02, 0x40, 0x03,
+    0x40, 0x20, 0x00, 0x45, 0x0D, 0x01, 0x06, 0x40, 0x20, 0x00, 0x10, 0x00,
+    0x07, 0x00, 0x20, 0x01, 0x6A, 0x21, 0x01, 0x0B, 0x20, 0x00, 0x41, 0x01,
+    0x6B, 0x21, 0x00, 0x0C, 0x00, 0x0B, 0x0B, 0x20, 0x01, 0x0B};
+  WasmEdge::VM::VM VM(Conf);
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator ValidatorEngine(Conf);
+  WasmEdge::AOT::Compiler Compiler(Conf);
+  auto Path = std::filesystem::temp_directory_path() /
+              std::filesystem::u8path("AOTcoreTest" EXTENSION);
+  auto Module = *Loader.parseModule(Wasm);
+  ASSERT_TRUE(ValidatorEngine.validate(*Module));
+  ASSERT_TRUE(Compiler.compile(Wasm, *Module, Path));
+  ASSERT_TRUE(VM.loadWasm(Path));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  const std::vector<WasmEdge::ValType> ParamTypes = {WasmEdge::ValType::I32};
+  auto Run = [&VM, &ParamTypes](std::string_view Name,
+                                uint32_t Arg) -> WasmEdge::Expect<uint32_t> {
+    const std::vector<WasmEdge::ValVariant> Params = {Arg};
+    if (auto Res = VM.execute(Name, Params, ParamTypes)) {
+      return (*Res)[0].first.get<uint32_t>();
+    } else {
+      return WasmEdge::Unexpect(Res);
+    }
+  };
+  auto Res = Run("catch", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+  Res = Run("catch_all", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 42U);
+  Res = Run("delegate", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 105U);
+  Res = Run("rethrow", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 1005U);
+  Res = Run("loop", 100);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 5050U);
+  Res = Run("uncaught", 5);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::UncaughtException);
+  Res = Run("catch", 7);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 8U);
+  std::filesystem::remove(Path);
+}
+
+TEST(ExceptionHandling, MixedModuleTest) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  Conf.getCompilerConfigure().setOutputFormat(
+      CompilerConfigure::OutputFormat::Native);
+
+  // The tag import and export test modules of test/exception.
+  std::vector<WasmEdge::Byte> LibWasm{
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+    0x01, 0x7F, 0x00, 0x03, 0x02, 0x01, 0x00, 0x0D, 0x03, 0x01, 0x00, 0x00,
+    0x07, 0x0D, 0x02, 0x01, 0x65, 0x04, 0x00, 0x05, 0x74, 0x68, 0x72, 0x6F,
+    0x77, 0x00, 0x00, 0x0A, 0x08, 0x01, 0x06, 0x00, 0x20, 0x00, 0x08, 0x00,
+    0x0B};
+  std::vector<WasmEdge::Byte> UserWasm{
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x02, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x02, 0x16, 0x02, 0x03,
+    0x6C, 0x69, 0x62, 0x01, 0x65, 0x04, 0x00, 0x00, 0x03, 0x6C, 0x69, 0x62,
+    0x05, 0x74, 0x68, 0x72, 0x6F, 0x77, 0x00, 0x00, 0x03, 0x02, 0x01, 0x01,
+    0x07, 0x09, 0x01, 0x05, 0x63, 0x61, 0x74, 0x63, 0x68, 0x00, 0x01, 0x0A,
+    0x15, 0x01, 0x13, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00,
+    0x07, 0x00, 0x41, 0x01, 0x6A, 0x19, 0x41, 0x2A, 0x0B, 0x0B};
+  WasmEdge::Loader::Loader Loader(Conf);
+  WasmEdge::Validator::Validator ValidatorEngine(Conf);
+  WasmEdge::AOT::Compiler Compiler(Conf);
+  auto LibPath = std::filesystem::temp_directory_path() /
+                 std::filesystem::u8path("AOTcoreTestLib" EXTENSION);
+  auto UserPath = std::filesystem::temp_directory_path() /
+                  std::filesystem::u8path("AOTcoreTestUser" EXTENSION);
+  {
+    auto Module = *Loader.parseModule(LibWasm);
+    ASSERT_TRUE(ValidatorEngine.validate(*Module));
+    ASSERT_TRUE(Compiler.compile(LibWasm, *Module, LibPath));
+  }
+  {
+    auto Module = *Loader.parseModule(UserWasm);
+    ASSERT_TRUE(ValidatorEngine.validate(*Module));
+    ASSERT_TRUE(Compiler.compile(UserWasm, *Module, UserPath));
+  }
+
+  // Exceptions cross the boundaries between the compiled and the interpreted
+  // functions in both directions.
+  auto Check = [&Conf](auto &&Lib, auto &&User) {
+    WasmEdge::VM::VM VM(Conf);
+    ASSERT_TRUE(VM.registerModule("lib", Lib));
+    ASSERT_TRUE(VM.loadWasm(User));
+    ASSERT_TRUE(VM.validate());
+    ASSERT_TRUE(VM.instantiate());
+    const std::vector<WasmEdge::ValVariant> Params = {UINT32_C(5)};
+    const std::vector<WasmEdge::ValType> ParamTypes = {WasmEdge::ValType::I32};
+    auto Res = VM.execute("catch", Params, ParamTypes);
+    ASSERT_TRUE(Res);
+    EXPECT_EQ((*Res)[0].first.get<uint32_t>(), 6U);
+  };
+  Check(LibPath, UserWasm);
+  Check(LibWasm, UserPath);
+  Check(LibPath, UserPath);
+  std::filesystem::remove(LibPath);
+  std::filesystem::remove(UserPath);
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
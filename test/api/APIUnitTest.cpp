@@ -4,6 +4,8 @@
 #include "wasmedge/wasmedge.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -13,6 +15,10 @@
 #include <string_view>
 #include <vector>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <poll.h>
+#endif
+
 namespace {
 
 std::vector<char> ArgsVec = {
@@ -302,8 +308,18 @@ TEST(APICoreTest, Value) {
 #endif
   Val = WasmEdge_ValueGenNullRef(WasmEdge_RefType_FuncRef);
   EXPECT_TRUE(WasmEdge_ValueIsNullRef(Val));
+  const auto *FuncCxt =
+      reinterpret_cast<const WasmEdge_FunctionInstanceContext *>(&Vec);
+  Val = WasmEdge_ValueGenFuncRefFromInstance(FuncCxt);
+  EXPECT_FALSE(WasmEdge_ValueIsNullRef(Val));
+  EXPECT_EQ(WasmEdge_ValueGetFuncRef(Val), FuncCxt);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
   Val = WasmEdge_ValueGenFuncRef(123U);
+  EXPECT_FALSE(WasmEdge_ValueIsNullRef(Val));
   EXPECT_EQ(WasmEdge_ValueGetFuncIdx(Val), 123U);
+  EXPECT_EQ(WasmEdge_ValueGetFuncRef(Val), nullptr);
+#pragma GCC diagnostic pop
   Val = WasmEdge_ValueGenExternRef(&Vec);
   EXPECT_EQ(
       static_cast<std::vector<uint32_t> *>(WasmEdge_ValueGetExternRef(Val))
@@ -1078,6 +1094,39 @@ TEST(APICoreTest, ExecutorWithStatistics) {
   WasmEdge_StatisticsSetCostLimit(nullptr, 1ULL);
   EXPECT_TRUE(true);
 
+  // Statistics set host cost model
+  WasmEdge_StatisticsSetHostCostModel(
+      Stat,
+      [](void *, const enum WasmEdge_HostWork, const uint64_t Amount)
+          -> uint64_t { return Amount; },
+      nullptr);
+  EXPECT_TRUE(true);
+  WasmEdge_StatisticsSetHostCostModel(Stat, nullptr, nullptr);
+  EXPECT_TRUE(true);
+  WasmEdge_StatisticsSetHostCostModel(nullptr, nullptr, nullptr);
+  EXPECT_TRUE(true);
+
+  // Statistics get host work count
+  EXPECT_EQ(WasmEdge_StatisticsGetHostWorkCount(
+                Stat, WasmEdge_HostWork_ThrottledOps),
+            0ULL);
+  EXPECT_EQ(WasmEdge_StatisticsGetHostWorkCount(nullptr,
+                                                WasmEdge_HostWork_Bytes),
+            0ULL);
+
+  // Statistics CPU time
+  WasmEdge_StatisticsSetCPUTimeMeasuring(Stat, true);
+  EXPECT_TRUE(true);
+  WasmEdge_StatisticsSetCPUTimeMeasuring(nullptr, true);
+  EXPECT_TRUE(true);
+  EXPECT_EQ(WasmEdge_StatisticsGetWasmCPUTime(Stat), 0ULL);
+  EXPECT_EQ(WasmEdge_StatisticsGetHostFuncCPUTime(nullptr), 0ULL);
+  EXPECT_EQ(WasmEdge_StatisticsGetBlockedTime(Stat), 0ULL);
+  WasmEdge_StatisticsSetCPUTimeLimit(Stat, 0ULL);
+  EXPECT_TRUE(true);
+  WasmEdge_StatisticsSetCPUTimeLimit(nullptr, 1ULL);
+  EXPECT_TRUE(true);
+
   // Executor creation and deletion
   WasmEdge_ExecutorContext *ExecCxt = WasmEdge_ExecutorCreate(nullptr, nullptr);
   EXPECT_NE(ExecCxt, nullptr);
@@ -1386,6 +1435,147 @@ TEST(APICoreTest, ExecutorWithStatistics) {
   WasmEdge_ImportObjectDelete(ImpObjWrap);
 }
 
+TEST(APICoreTest, StatisticsCostLimit) {
+  // (module
+  //   (func (export "add") (param i32 i32) (result i32)
+  //     (i32.add (local.get 0) (local.get 1))))
+  std::array<uint8_t, 41> AddWasm{
+      0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x60,
+      0x02, 0x7F, 0x7F, 0x01, 0x7F, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01,
+      0x03, 0x61, 0x64, 0x64, 0x00, 0x00, 0x0A, 0x09, 0x01, 0x07, 0x00, 0x20,
+      0x00, 0x20, 0x01, 0x6A, 0x0B};
+  // (module
+  //   (import "wasi_snapshot_preview1" "fd_write"
+  //     (func $fd_write (param i32 i32 i32 i32) (result i32)))
+  //   (memory 1)
+  //   (data (i32.const 0) "\10\00\00\00\05\00\00\00\00\00\00\00\00\00\00\00"
+  //     "hello")
+  //   (func (export "write") (result i32)
+  //     (call $fd_write (i32.const 1) (i32.const 0) (i32.const 1)
+  //       (i32.const 8))))
+  std::array<uint8_t, 125> WriteWasm{
+      0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0D, 0x02, 0x60,
+      0x04, 0x7F, 0x7F, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x01, 0x7F, 0x02,
+      0x23, 0x01, 0x16, 0x77, 0x61, 0x73, 0x69, 0x5F, 0x73, 0x6E, 0x61, 0x70,
+      0x73, 0x68, 0x6F, 0x74, 0x5F, 0x70, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77,
+      0x31, 0x08, 0x66, 0x64, 0x5F, 0x77, 0x72, 0x69, 0x74, 0x65, 0x00, 0x00,
+      0x03, 0x02, 0x01, 0x01, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x09, 0x01,
+      0x05, 0x77, 0x72, 0x69, 0x74, 0x65, 0x00, 0x01, 0x0A, 0x0E, 0x01, 0x0C,
+      0x00, 0x41, 0x01, 0x41, 0x00, 0x41, 0x01, 0x41, 0x08, 0x10, 0x00, 0x0B,
+      0x0B, 0x1B, 0x01, 0x00, 0x41, 0x00, 0x0B, 0x15, 0x10, 0x00, 0x00, 0x00,
+      0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x68, 0x65, 0x6C, 0x6C, 0x6F};
+
+  WasmEdge_ConfigureContext *Conf = WasmEdge_ConfigureCreate();
+  WasmEdge_ConfigureStatisticsSetCostMeasuring(Conf, true);
+  WasmEdge_ConfigureAddHostRegistration(Conf, WasmEdge_HostRegistration_Wasi);
+  WasmEdge_VMContext *VM = WasmEdge_VMCreate(Conf, nullptr);
+  WasmEdge_ConfigureDelete(Conf);
+  WasmEdge_StatisticsContext *Stat = WasmEdge_VMGetStatisticsContext(VM);
+  ASSERT_NE(Stat, nullptr);
+  WasmEdge_String FuncName;
+  WasmEdge_Value P[2], R[1];
+  uint64_t Cost;
+
+  // Instructions are charged by the cost table.
+  std::vector<uint64_t> CostTable(512, 0ULL);
+  CostTable[0x20] = 3ULL; // local.get
+  CostTable[0x6A] = 5ULL; // i32.add
+  CostTable[0x0B] = 7ULL; // end
+  WasmEdge_StatisticsSetCostTable(Stat, &CostTable[0], 512);
+  FuncName = WasmEdge_StringCreateByCString("add");
+  P[0] = WasmEdge_ValueGenI32(1);
+  P[1] = WasmEdge_ValueGenI32(2);
+  Cost = WasmEdge_StatisticsGetTotalCost(Stat);
+  EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_VMRunWasmFromBuffer(
+      VM, AddWasm.data(), static_cast<uint32_t>(AddWasm.size()), FuncName, P,
+      2, R, 1)));
+  EXPECT_EQ(WasmEdge_ValueGetI32(R[0]), 3);
+  EXPECT_EQ(WasmEdge_StatisticsGetTotalCost(Stat) - Cost, 3ULL + 3ULL + 5ULL +
+                                                              7ULL);
+
+  // The execution is aborted once the cost exceeds the limit.
+  Cost = WasmEdge_StatisticsGetTotalCost(Stat);
+  WasmEdge_StatisticsSetCostLimit(Stat, Cost + 17ULL);
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_CostLimitExceeded,
+                         WasmEdge_VMRunWasmFromBuffer(
+                             VM, AddWasm.data(),
+                             static_cast<uint32_t>(AddWasm.size()), FuncName,
+                             P, 2, R, 1)));
+  EXPECT_EQ(WasmEdge_StatisticsGetTotalCost(Stat), Cost + 17ULL);
+  WasmEdge_StringDelete(FuncName);
+
+  // The bytes written by the WASI host function are charged by the model.
+  std::string Output;
+  WasmEdge_ImportObjectContext *WasiMod =
+      WasmEdge_VMGetImportModuleContext(VM, WasmEdge_HostRegistration_Wasi);
+  WasmEdge_ImportObjectInitWASI(WasiMod, nullptr, 0, nullptr, 0, nullptr, 0);
+  WasmEdge_ImportObjectWASISetStdout(
+      WasiMod,
+      [](void *Data, const uint8_t *Buf, uint32_t Len) -> int64_t {
+        static_cast<std::string *>(Data)->append(
+            reinterpret_cast<const char *>(Buf), Len);
+        return Len;
+      },
+      &Output);
+  std::fill(CostTable.begin(), CostTable.end(), 0ULL);
+  WasmEdge_StatisticsSetCostTable(Stat, &CostTable[0], 512);
+  WasmEdge_StatisticsSetCostLimit(Stat, UINT64_MAX);
+  WasmEdge_StatisticsSetHostCostModel(
+      Stat,
+      [](void *, const enum WasmEdge_HostWork Kind,
+         const uint64_t Amount) -> uint64_t {
+        return Kind == WasmEdge_HostWork_Bytes ? Amount * 10ULL : 0ULL;
+      },
+      nullptr);
+  FuncName = WasmEdge_StringCreateByCString("write");
+  Cost = WasmEdge_StatisticsGetTotalCost(Stat);
+  EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_VMRunWasmFromBuffer(
+      VM, WriteWasm.data(), static_cast<uint32_t>(WriteWasm.size()), FuncName,
+      nullptr, 0, R, 1)));
+  EXPECT_EQ(WasmEdge_ValueGetI32(R[0]), 0);
+  EXPECT_EQ(Output, "hello");
+  EXPECT_EQ(WasmEdge_StatisticsGetTotalCost(Stat) - Cost, 50ULL);
+
+  // The host function call is aborted once the work exceeds the limit.
+  Cost = WasmEdge_StatisticsGetTotalCost(Stat);
+  WasmEdge_StatisticsSetCostLimit(Stat, Cost + 49ULL);
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_CostLimitExceeded,
+                         WasmEdge_VMRunWasmFromBuffer(
+                             VM, WriteWasm.data(),
+                             static_cast<uint32_t>(WriteWasm.size()), FuncName,
+                             nullptr, 0, R, 1)));
+  WasmEdge_StringDelete(FuncName);
+  WasmEdge_VMDelete(VM);
+}
+
+TEST(APICoreTest, StatisticsCPUTimeLimit) {
+  // (module
+  //   (memory 1)
+  //   (func (export "_start") (loop (br 0))))
+  std::array<uint8_t, 46> LoopWasm{
+      0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+      0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07,
+      0x0A, 0x01, 0x06, 0x5F, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x00, 0x0A,
+      0x09, 0x01, 0x07, 0x00, 0x03, 0x40, 0x0C, 0x00, 0x0B, 0x0B};
+
+  WasmEdge_VMContext *VM = WasmEdge_VMCreate(nullptr, nullptr);
+  WasmEdge_StatisticsContext *Stat = WasmEdge_VMGetStatisticsContext(VM);
+  ASSERT_NE(Stat, nullptr);
+  WasmEdge_String FuncName = WasmEdge_StringCreateByCString("_start");
+
+  // The infinite loop is aborted once the CPU time exceeds the limit.
+  WasmEdge_StatisticsSetCPUTimeLimit(Stat, 50000000ULL);
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_CPUTimeLimitExceeded,
+                         WasmEdge_VMRunWasmFromBuffer(
+                             VM, LoopWasm.data(),
+                             static_cast<uint32_t>(LoopWasm.size()), FuncName,
+                             nullptr, 0, nullptr, 0)));
+  EXPECT_GE(WasmEdge_StatisticsGetWasmCPUTime(Stat), 50000000ULL);
+  WasmEdge_StringDelete(FuncName);
+  WasmEdge_VMDelete(VM);
+}
+
 TEST(APICoreTest, Store) {
   // Create contexts
   WasmEdge_ConfigureContext *Conf = WasmEdge_ConfigureCreate();
@@ -1711,7 +1901,8 @@ TEST(APICoreTest, Instance) {
 
   // Table instance set data
   Val = WasmEdge_ValueGenExternRef(&TabCxt);
-  TmpVal = WasmEdge_ValueGenFuncRef(2);
+  TmpVal = WasmEdge_ValueGenFuncRefFromInstance(
+      reinterpret_cast<const WasmEdge_FunctionInstanceContext *>(&TabCxt));
   EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_TableInstanceSetData(TabCxt, Val, 5)));
   EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_RefTypeMismatch,
                          WasmEdge_TableInstanceSetData(TabCxt, TmpVal, 6)));
@@ -1862,6 +2053,18 @@ TEST(APICoreTest, Instance) {
       WasmEdge_MemoryInstanceGetData(MemCxt, DataGet.data(), 70000, 10)));
   EXPECT_EQ(DataGet, DataSet);
 
+  // Memory instance discard page
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_WrongVMWorkflow,
+                         WasmEdge_MemoryInstanceDiscardPage(nullptr, 0, 1)));
+  EXPECT_TRUE(isErrMatch(WasmEdge_ErrCode_MemoryOutOfBounds,
+                         WasmEdge_MemoryInstanceDiscardPage(MemCxt, 1, 2)));
+  EXPECT_TRUE(
+      WasmEdge_ResultOK(WasmEdge_MemoryInstanceDiscardPage(MemCxt, 1, 1)));
+  EXPECT_TRUE(WasmEdge_ResultOK(
+      WasmEdge_MemoryInstanceGetData(MemCxt, DataGet.data(), 70000, 10)));
+  EXPECT_EQ(DataGet, std::vector<uint8_t>(10, 0));
+  EXPECT_EQ(WasmEdge_MemoryInstanceGetPageSize(MemCxt), 2U);
+
   // Memory instance deletion
   WasmEdge_MemoryInstanceDelete(nullptr);
   EXPECT_TRUE(true);
@@ -2078,6 +2281,25 @@ TEST(APICoreTest, ImportObject) {
   // Get WASI exit code.
   EXPECT_EQ(WasmEdge_ImportObjectWASIGetExitCode(ImpObj), EXIT_SUCCESS);
   EXPECT_EQ(WasmEdge_ImportObjectWASIGetExitCode(nullptr), EXIT_FAILURE);
+  // Replace and restore WASI stdio.
+  WasmEdge_ImportObjectWASISetStdin(nullptr, nullptr, nullptr);
+  EXPECT_TRUE(true);
+  WasmEdge_ImportObjectWASISetStdout(
+      ImpObj,
+      [](void *, const uint8_t *, const uint32_t Length) -> int64_t {
+        return Length;
+      },
+      nullptr);
+  EXPECT_TRUE(true);
+  WasmEdge_ImportObjectWASISetStdout(ImpObj, nullptr, nullptr);
+  EXPECT_TRUE(true);
+  // Set and clear WASI I/O limit.
+  WasmEdge_ImportObjectWASISetIOLimit(nullptr, 1, 0, 0, 0, true);
+  EXPECT_TRUE(true);
+  WasmEdge_ImportObjectWASISetIOLimit(ImpObj, 1024, 0, 10, 0, false);
+  EXPECT_TRUE(true);
+  WasmEdge_ImportObjectWASISetIOLimit(ImpObj, 0, 0, 0, 0, true);
+  EXPECT_TRUE(true);
   WasmEdge_VMDelete(VM);
 
   // Create wasmedge_process.
@@ -2108,6 +2330,21 @@ TEST(APICoreTest, ImportObject) {
   WasmEdge_ImportObjectInitWasmEdgeProcess(ImpObj, Args, 2, false);
   EXPECT_TRUE(true);
   WasmEdge_VMDelete(VM);
+  // Create wasmedge_memory.
+  ImpObj = WasmEdge_ImportObjectCreateWasmEdgeMemory();
+  EXPECT_NE(ImpObj, nullptr);
+  WasmEdge_ImportObjectDelete(ImpObj);
+
+  // Initialize wasmedge_memory in VM.
+  Conf = WasmEdge_ConfigureCreate();
+  WasmEdge_ConfigureAddHostRegistration(
+      Conf, WasmEdge_HostRegistration_WasmEdge_Memory);
+  VM = WasmEdge_VMCreate(Conf, nullptr);
+  WasmEdge_ConfigureDelete(Conf);
+  ImpObj = WasmEdge_VMGetImportModuleContext(
+      VM, WasmEdge_HostRegistration_WasmEdge_Memory);
+  EXPECT_NE(ImpObj, nullptr);
+  WasmEdge_VMDelete(VM);
 }
 
 TEST(APICoreTest, Async) {
@@ -2147,6 +2384,11 @@ TEST(APICoreTest, Async) {
   WasmEdge_AsyncCancel(nullptr);
   EXPECT_TRUE(true);
 
+  // Async completion callback and file descriptor
+  WasmEdge_AsyncSetCallback(nullptr, nullptr, nullptr);
+  EXPECT_TRUE(true);
+  EXPECT_EQ(WasmEdge_AsyncGetFd(nullptr), -1);
+
   // Async get returns length
   EXPECT_EQ(WasmEdge_AsyncGetReturnsLength(nullptr), 0);
 
@@ -2156,7 +2398,32 @@ TEST(APICoreTest, Async) {
   // Success case
   Async = WasmEdge_VMAsyncRunWasmFromFile(VM, TPath, FuncName, P, 2);
   EXPECT_NE(Async, nullptr);
-  WasmEdge_AsyncWait(Async);
+  {
+    // The callback registered before finished is invoked once.
+    std::atomic_uint32_t Called = 0;
+    WasmEdge_AsyncSetCallback(
+        Async,
+        [](void *Data) { ++*static_cast<std::atomic_uint32_t *>(Data); },
+        &Called);
+#if defined(__linux__) || defined(__APPLE__)
+    // The file descriptor becomes readable after finished.
+    const int Fd = WasmEdge_AsyncGetFd(Async);
+    EXPECT_GE(Fd, 0);
+    EXPECT_EQ(WasmEdge_AsyncGetFd(Async), Fd);
+    struct pollfd PollFd = {Fd, POLLIN, 0};
+    EXPECT_EQ(poll(&PollFd, 1, 10000), 1);
+    EXPECT_TRUE(PollFd.revents & POLLIN);
+#endif
+    WasmEdge_AsyncWait(Async);
+    EXPECT_EQ(Called.load(), 1U);
+  }
+  {
+    // The callback registered after finished is invoked immediately.
+    uint32_t Called = 0;
+    WasmEdge_AsyncSetCallback(
+        Async, [](void *Data) { ++*static_cast<uint32_t *>(Data); }, &Called);
+    EXPECT_EQ(Called, 1U);
+  }
   EXPECT_EQ(WasmEdge_AsyncGetReturnsLength(Async), 2);
   EXPECT_TRUE(WasmEdge_ResultOK(WasmEdge_AsyncGet(Async, R, 2)));
   EXPECT_EQ(246, WasmEdge_ValueGetI32(R[0]));
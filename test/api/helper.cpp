@@ -26,7 +26,7 @@ static Proposal ProposalList[] = {
     Proposal::TailCall,          Proposal::MultiMemories,
     Proposal::Annotations,       Proposal::Memory64,
     Proposal::ExceptionHandling, Proposal::Threads,
-    Proposal::FunctionReferences};
+    Proposal::FunctionReferences, Proposal::RelaxedSIMD};
 
 WasmEdge_ConfigureContext *createConf(const Configure &Conf) {
   auto *Cxt = WasmEdge_ConfigureCreate();
@@ -126,7 +126,10 @@ TEST(ErrInfoTest, Info__Mismatch) {
 }
 
 TEST(ErrInfoTest, Info__Instruction) {
-  std::vector<WasmEdge::ValVariant> Args = {0, 1000, WasmEdge::FuncRef(100)};
+  const auto *Func =
+      reinterpret_cast<const WasmEdge::Runtime::Instance::FunctionInstance *>(
+          static_cast<uintptr_t>(100));
+  std::vector<WasmEdge::ValVariant> Args = {0, 1000, WasmEdge::FuncRef(Func)};
   WasmEdge::ErrInfo::InfoInstruction Info1(WasmEdge::OpCode::Block, 255, Args,
                                            {WasmEdge::ValType::None,
                                             WasmEdge::ValType::None,
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/configure.h"
+#include "common/log.h"
+#include "vm/vm.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// (module
+//   (tag $e (param i32))
+//   (func $throw (param i32) (throw $e (local.get 0)))
+//   (func (export "catch") (param i32) (result i32)
+//     (try (result i32)
+//       (do (call $throw (local.get 0)) (i32.const 0))
+//       (catch $e (i32.add (i32.const 1)))))
+//   (func (export "catch_all") (param i32) (result i32)
+//     (try (result i32)
+//       (do (call $throw (local.get 0)) (i32.const 0))
+//       (catch_all (i32.const 42))))
+//   (func (export "delegate") (param i32) (result i32)
+//     (try (result i32)
+//       (do (try (result i32)
+//             (do (call $throw (local.get 0)) (i32.const 0))
+//             (delegate 0)))
+//       (catch $e (i32.add (i32.const 100)))))
+//   (func (export "rethrow") (param i32) (result i32)
+//     (try (result i32)
+//       (do (try (do (call $throw (local.get 0)))
+//                (catch $e (drop) (rethrow 0)))
+//           (i32.const 0))
+//       (catch $e (i32.add (i32.const 1000)))))
+//   (func (export "uncaught") (param i32) (result i32)
+//     (call $throw (local.get 0)) (i32.const 0))
+//   (func (export "loop") (param i32) (result i32) (local i32)
+//     (block (loop
+//       (br_if 1 (i32.eqz (local.get 0)))
+//       (try (do (call $throw (local.get 0)))
+//            (catch $e (local.set 1 (i32.add (local.get 1)))))
+//       (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+//       (br 0)))
+//     (local.get 1)))
+std::vector<WasmEdge::Byte> ExceptionWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x02, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x03, 0x08, 0x07, 0x00,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x0D, 0x03, 0x01, 0x00, 0x00, 0x07,
+    0x3C, 0x06, 0x05, 0x63, 0x61, 0x74, 0x63, 0x68, 0x00, 0x01, 0x09, 0x63,
+    0x61, 0x74, 0x63, 0x68, 0x5F, 0x61, 0x6C, 0x6C, 0x00, 0x02, 0x08, 0x64,
+    0x65, 0x6C, 0x65, 0x67, 0x61, 0x74, 0x65, 0x00, 0x03, 0x07, 0x72, 0x65,
+    0x74, 0x68, 0x72, 0x6F, 0x77, 0x00, 0x04, 0x08, 0x75, 0x6E, 0x63, 0x61,
+    0x75, 0x67, 0x68, 0x74, 0x00, 0x05, 0x04, 0x6C, 0x6F, 0x6F, 0x70, 0x00,
+    0x06, 0x0A, 0x8A, 0x01, 0x07, 0x06, 0x00, 0x20, 0x00, 0x08, 0x00, 0x0B,
+    0x10, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00, 0x07, 0x00,
+    0x41, 0x01, 0x6A, 0x0B, 0x0B, 0x0E, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10,
+    0x00, 0x41, 0x00, 0x19, 0x41, 0x2A, 0x0B, 0x0B, 0x15, 0x00, 0x06, 0x7F,
+    0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00, 0x18, 0x00, 0x07, 0x00,
+    0x41, 0xE4, 0x00, 0x6A, 0x0B, 0x0B, 0x19, 0x00, 0x06, 0x7F, 0x06, 0x40,
+    0x20, 0x00, 0x10, 0x00, 0x07, 0x00, 0x1A, 0x09, 0x00, 0x0B, 0x41, 0x00,
+    0x07, 0x00, 0x41, 0xE8, 0x07, 0x6A, 0x0B, 0x0B, 0x08, 0x00, 0x20, 0x00,
+    0x10, 0x00, 0x41, 0x00, 0x0B, 0x28, 0x01, 0x01, 0x7F, 0x02, 0x40, 0x03,
+    0x40, 0x20, 0x00, 0x45, 0x0D, 0x01, 0x06, 0x40, 0x20, 0x00, 0x10, 0x00,
+    0x07, 0x00, 0x20, 0x01, 0x6A, 0x21, 0x01, 0x0B, 0x20, 0x00, 0x41, 0x01,
+    0x6B, 0x21, 0x00, 0x0C, 0x00, 0x0B, 0x0B, 0x20, 0x01, 0x0B};
+
+// (module
+//   (tag $e (export "e") (param i32))
+//   (func (export "throw") (param i32) (throw $e (local.get 0))))
+std::vector<WasmEdge::Byte> TagLibWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+    0x01, 0x7F, 0x00, 0x03, 0x02, 0x01, 0x00, 0x0D, 0x03, 0x01, 0x00, 0x00,
+    0x07, 0x0D, 0x02, 0x01, 0x65, 0x04, 0x00, 0x05, 0x74, 0x68, 0x72, 0x6F,
+    0x77, 0x00, 0x00, 0x0A, 0x08, 0x01, 0x06, 0x00, 0x20, 0x00, 0x08, 0x00,
+    0x0B};
+
+// (module
+//   (import "lib" "e" (tag $e (param i32)))
+//   (import "lib" "throw" (func $throw (param i32)))
+//   (func (export "catch") (param i32) (result i32)
+//     (try (result i32)
+//       (do (call $throw (local.get 0)) (i32.const 0))
+//       (catch $e (i32.add (i32.const 1)))
+//       (catch_all (i32.const 42)))))
+std::vector<WasmEdge::Byte> TagUserWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x02, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x02, 0x16, 0x02, 0x03,
+    0x6C, 0x69, 0x62, 0x01, 0x65, 0x04, 0x00, 0x00, 0x03, 0x6C, 0x69, 0x62,
+    0x05, 0x74, 0x68, 0x72, 0x6F, 0x77, 0x00, 0x00, 0x03, 0x02, 0x01, 0x01,
+    0x07, 0x09, 0x01, 0x05, 0x63, 0x61, 0x74, 0x63, 0x68, 0x00, 0x01, 0x0A,
+    0x15, 0x01, 0x13, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41, 0x00,
+    0x07, 0x00, 0x41, 0x01, 0x6A, 0x19, 0x41, 0x2A, 0x0B, 0x0B};
+
+// The same module as above, but importing the function from "lib2".
+std::vector<WasmEdge::Byte> TagOtherUserWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x02, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x02, 0x17, 0x02, 0x03,
+    0x6C, 0x69, 0x62, 0x01, 0x65, 0x04, 0x00, 0x00, 0x04, 0x6C, 0x69, 0x62,
+    0x32, 0x05, 0x74, 0x68, 0x72, 0x6F, 0x77, 0x00, 0x00, 0x03, 0x02, 0x01,
+    0x01, 0x07, 0x09, 0x01, 0x05, 0x63, 0x61, 0x74, 0x63, 0x68, 0x00, 0x01,
+    0x0A, 0x15, 0x01, 0x13, 0x00, 0x06, 0x7F, 0x20, 0x00, 0x10, 0x00, 0x41,
+    0x00, 0x07, 0x00, 0x41, 0x01, 0x6A, 0x19, 0x41, 0x2A, 0x0B, 0x0B};
+
+// (module (import "lib" "e" (tag (param i64))))
+std::vector<WasmEdge::Byte> TagTypeMismatchWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+    0x01, 0x7E, 0x00, 0x02, 0x0A, 0x01, 0x03, 0x6C, 0x69, 0x62, 0x01, 0x65,
+    0x04, 0x00, 0x00};
+
+// (module (import "lib" "throw" (tag (param i32))))
+std::vector<WasmEdge::Byte> TagKindMismatchWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+    0x01, 0x7F, 0x00, 0x02, 0x0E, 0x01, 0x03, 0x6C, 0x69, 0x62, 0x05, 0x74,
+    0x68, 0x72, 0x6F, 0x77, 0x04, 0x00, 0x00};
+
+WasmEdge::Expect<uint32_t> run(WasmEdge::VM::VM &VM, std::string_view Name,
+                               uint32_t Arg) {
+  const std::vector<WasmEdge::ValVariant> Params = {Arg};
+  const std::vector<WasmEdge::ValType> ParamTypes = {WasmEdge::ValType::I32};
+  if (auto Res = VM.execute(Name, Params, ParamTypes)) {
+    return (*Res)[0].first.get<uint32_t>();
+  } else {
+    return WasmEdge::Unexpect(Res);
+  }
+}
+
+TEST(ExceptionTest, ThrowAndCatch) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(ExceptionWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  auto Res = run(VM, "catch", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+  Res = run(VM, "catch_all", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 42U);
+  Res = run(VM, "delegate", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 105U);
+  Res = run(VM, "rethrow", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 1005U);
+  Res = run(VM, "loop", 100);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 5050U);
+
+  Res = run(VM, "uncaught", 5);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::UncaughtException);
+  // The stack is reset after the uncaught exception.
+  Res = run(VM, "catch", 7);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 8U);
+}
+
+TEST(ExceptionTest, NeedProposal) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::VM VM(Conf);
+  EXPECT_FALSE(VM.loadWasm(ExceptionWasm));
+}
+
+TEST(ExceptionTest, ImportExportTag) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.registerModule("lib", TagLibWasm));
+  ASSERT_TRUE(VM.loadWasm(TagUserWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  // The exception of the imported tag is caught by the importing module.
+  auto Res = run(VM, "catch", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+}
+
+TEST(ExceptionTest, TagIdentity) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.registerModule("lib", TagLibWasm));
+  ASSERT_TRUE(VM.registerModule("lib2", TagLibWasm));
+  ASSERT_TRUE(VM.loadWasm(TagOtherUserWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  // The tags of the different module instances are different, even if they
+  // are defined by the same module.
+  auto Res = run(VM, "catch", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 42U);
+}
+
+TEST(ExceptionTest, ImportTagMismatch) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.registerModule("lib", TagLibWasm));
+
+  ASSERT_TRUE(VM.loadWasm(TagTypeMismatchWasm));
+  ASSERT_TRUE(VM.validate());
+  auto Res = VM.instantiate();
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::IncompatibleImportType);
+
+  ASSERT_TRUE(VM.loadWasm(TagKindMismatchWasm));
+  ASSERT_TRUE(VM.validate());
+  Res = VM.instantiate();
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::IncompatibleImportType);
+}
+
+TEST(ExceptionTest, ImportExportTagNeedProposal) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::VM VM(Conf);
+  EXPECT_FALSE(VM.loadWasm(TagUserWasm));
+  EXPECT_FALSE(VM.loadWasm(TagTypeMismatchWasm));
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/configure.h"
+#include "common/log.h"
+#include "vm/vm.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// (module
+//   (type $t (func (param i32) (result i32)))
+//   (type (func))
+//   (type (func (param i32 (ref null $t)) (result i32)))
+//   (type (func (param i32 (ref $t)) (result i32)))
+//   (type $t2 (func (param i32) (result i32)))
+//   (func $inc (type $t) (i32.add (local.get 0) (i32.const 1)))
+//   (func $nop)
+//   (func (export "call") (type $t)
+//     (call_ref $t (local.get 0) (ref.func $inc)))
+//   (func (export "call_null") (type $t)
+//     (call_ref $t (local.get 0) (ref.null $t)))
+//   (func (export "as_non_null") (type $t)
+//     (ref.is_null (ref.as_non_null
+//       (if (result funcref) (local.get 0)
+//         (then (ref.func $inc)) (else (ref.null func))))))
+//   (func (export "br_on_null") (type $t)
+//     (block (result i32)
+//       (i32.const 7)
+//       (br_on_null 0 (if (result funcref) (local.get 0)
+//         (then (ref.func $inc)) (else (ref.null func))))
+//       (drop) (drop) (i32.const 1)))
+//   (func (export "call_local") (type $t) (local $f (ref null $t))
+//     (local.set $f (ref.func $inc))
+//     (call_ref $t (local.get 0) (local.get $f)))
+//   (func $call_param (export "call_param")
+//     (param i32 (ref null $t)) (result i32)
+//     (call_ref $t (local.get 0) (local.get 1)))
+//   (func (export "call_global") (type $t)
+//     (call_ref $t (local.get 0)
+//       (block (result (ref $t)) (ref.as_non_null (global.get $g)))))
+//   (func (export "call_non_null") (param i32 (ref $t)) (result i32)
+//     (call_ref $t (local.get 0) (local.get 1)))
+//   (func (export "pass_param") (type $t)
+//     (call $call_param (local.get 0) (ref.func $inc)))
+//   (func $inc2 (type $t2) (i32.add (local.get 0) (i32.const 2)))
+//   (func (export "call_equiv") (type $t)
+//     (call_ref $t (local.get 0) (ref.func $inc2)))
+//   (global $g (ref null $t) (ref.func $inc))
+//   (elem declare func $inc $nop $inc2))
+std::vector<WasmEdge::Byte> FuncRefWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x1C, 0x05, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x00, 0x60, 0x02, 0x7F, 0x6C, 0x00,
+    0x01, 0x7F, 0x60, 0x02, 0x7F, 0x6B, 0x00, 0x01, 0x7F, 0x60, 0x01, 0x7F,
+    0x01, 0x7F, 0x03, 0x0E, 0x0D, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x03, 0x00, 0x04, 0x00, 0x06, 0x07, 0x01, 0x6C, 0x00, 0x00,
+    0xD2, 0x00, 0x0B, 0x07, 0x81, 0x01, 0x0A, 0x04, 0x63, 0x61, 0x6C, 0x6C,
+    0x00, 0x02, 0x09, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x6E, 0x75, 0x6C, 0x6C,
+    0x00, 0x03, 0x0B, 0x61, 0x73, 0x5F, 0x6E, 0x6F, 0x6E, 0x5F, 0x6E, 0x75,
+    0x6C, 0x6C, 0x00, 0x04, 0x0A, 0x62, 0x72, 0x5F, 0x6F, 0x6E, 0x5F, 0x6E,
+    0x75, 0x6C, 0x6C, 0x00, 0x05, 0x0A, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x6C,
+    0x6F, 0x63, 0x61, 0x6C, 0x00, 0x06, 0x0A, 0x63, 0x61, 0x6C, 0x6C, 0x5F,
+    0x70, 0x61, 0x72, 0x61, 0x6D, 0x00, 0x07, 0x0B, 0x63, 0x61, 0x6C, 0x6C,
+    0x5F, 0x67, 0x6C, 0x6F, 0x62, 0x61, 0x6C, 0x00, 0x08, 0x0D, 0x63, 0x61,
+    0x6C, 0x6C, 0x5F, 0x6E, 0x6F, 0x6E, 0x5F, 0x6E, 0x75, 0x6C, 0x6C, 0x00,
+    0x09, 0x0A, 0x70, 0x61, 0x73, 0x73, 0x5F, 0x70, 0x61, 0x72, 0x61, 0x6D,
+    0x00, 0x0A, 0x0A, 0x63, 0x61, 0x6C, 0x6C, 0x5F, 0x65, 0x71, 0x75, 0x69,
+    0x76, 0x00, 0x0C, 0x09, 0x07, 0x01, 0x03, 0x00, 0x03, 0x00, 0x01, 0x0B,
+    0x0A, 0x8F, 0x01, 0x0D, 0x07, 0x00, 0x20, 0x00, 0x41, 0x01, 0x6A, 0x0B,
+    0x02, 0x00, 0x0B, 0x08, 0x00, 0x20, 0x00, 0xD2, 0x00, 0x14, 0x00, 0x0B,
+    0x08, 0x00, 0x20, 0x00, 0xD0, 0x00, 0x14, 0x00, 0x0B, 0x0E, 0x00, 0x20,
+    0x00, 0x04, 0x70, 0xD2, 0x00, 0x05, 0xD0, 0x70, 0x0B, 0xD4, 0xD1, 0x0B,
+    0x17, 0x00, 0x02, 0x7F, 0x41, 0x07, 0x20, 0x00, 0x04, 0x70, 0xD2, 0x00,
+    0x05, 0xD0, 0x70, 0x0B, 0xD5, 0x00, 0x1A, 0x1A, 0x41, 0x01, 0x0B, 0x0B,
+    0x0F, 0x01, 0x01, 0x6C, 0x00, 0xD2, 0x00, 0x21, 0x01, 0x20, 0x00, 0x20,
+    0x01, 0x14, 0x00, 0x0B, 0x08, 0x00, 0x20, 0x00, 0x20, 0x01, 0x14, 0x00,
+    0x0B, 0x0D, 0x00, 0x20, 0x00, 0x02, 0x6B, 0x00, 0x23, 0x00, 0xD4, 0x0B,
+    0x14, 0x00, 0x0B, 0x08, 0x00, 0x20, 0x00, 0x20, 0x01, 0x14, 0x00, 0x0B,
+    0x08, 0x00, 0x20, 0x00, 0xD2, 0x00, 0x10, 0x07, 0x0B, 0x07, 0x00, 0x20,
+    0x00, 0x41, 0x02, 0x6A, 0x0B, 0x08, 0x00, 0x20, 0x00, 0xD2, 0x0B, 0x14,
+    0x00, 0x0B};
+
+// The modules below are invalid in validation. Each of them has the types
+// `$t (func (param i32) (result i32))` and `(func)`, and the last function is:
+// Calling the reference of the other function type:
+//   (func (type $t) (call_ref $t (local.get 0) (ref.func $nop)))
+std::vector<WasmEdge::Byte> MismatchWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x09, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01, 0x00,
+    0x09, 0x05, 0x01, 0x03, 0x00, 0x01, 0x00, 0x0A, 0x0D, 0x02, 0x02, 0x00,
+    0x0B, 0x08, 0x00, 0x20, 0x00, 0xD2, 0x00, 0x14, 0x00, 0x0B};
+// Calling the reference without the function type:
+//   (func (type $t) (local funcref) (call_ref $t (local.get 0) (local.get 1)))
+std::vector<WasmEdge::Byte> UntypedWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x09, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01, 0x00,
+    0x09, 0x05, 0x01, 0x03, 0x00, 0x01, 0x00, 0x0A, 0x0F, 0x02, 0x02, 0x00,
+    0x0B, 0x0A, 0x01, 0x01, 0x70, 0x20, 0x00, 0x20, 0x01, 0x14, 0x00, 0x0B};
+// Getting the non-nullable local before setting:
+//   (func (type $t) (local (ref $t)) (call_ref $t (local.get 0) (local.get 1)))
+std::vector<WasmEdge::Byte> UninitWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x09, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01, 0x00,
+    0x09, 0x05, 0x01, 0x03, 0x00, 0x01, 0x00, 0x0A, 0x10, 0x02, 0x02, 0x00,
+    0x0B, 0x0B, 0x01, 0x01, 0x6B, 0x00, 0x20, 0x00, 0x20, 0x01, 0x14, 0x00,
+    0x0B};
+// Getting the non-nullable local out of the block setting it:
+//   (func (type $t) (local (ref $t))
+//     (block (local.set 1 (ref.func 0)))
+//     (call_ref $t (local.get 0) (local.get 1)))
+std::vector<WasmEdge::Byte> ScopedInitWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x09, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x00, 0x03, 0x03, 0x02, 0x00, 0x00,
+    0x09, 0x05, 0x01, 0x03, 0x00, 0x01, 0x00, 0x0A, 0x19, 0x02, 0x04, 0x00,
+    0x20, 0x00, 0x0B, 0x12, 0x01, 0x01, 0x6B, 0x00, 0x02, 0x40, 0xD2, 0x00,
+    0x21, 0x01, 0x0B, 0x20, 0x00, 0x20, 0x01, 0x14, 0x00, 0x0B};
+// The local of the unknown function type:
+//   (func (type $t) (local (ref null 5)) (local.get 0))
+std::vector<WasmEdge::Byte> UnknownTypeWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x09, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x00, 0x03, 0x03, 0x02, 0x01, 0x00,
+    0x09, 0x05, 0x01, 0x03, 0x00, 0x01, 0x00, 0x0A, 0x0C, 0x02, 0x02, 0x00,
+    0x0B, 0x07, 0x01, 0x01, 0x6C, 0x05, 0x20, 0x00, 0x0B};
+
+WasmEdge::Expect<uint32_t> run(WasmEdge::VM::VM &VM, std::string_view Name,
+                               uint32_t Arg) {
+  const std::vector<WasmEdge::ValVariant> Params = {Arg};
+  const std::vector<WasmEdge::ValType> ParamTypes = {WasmEdge::ValType::I32};
+  if (auto Res = VM.execute(Name, Params, ParamTypes)) {
+    return (*Res)[0].first.get<uint32_t>();
+  } else {
+    return WasmEdge::Unexpect(Res);
+  }
+}
+
+TEST(FuncRefTest, CallRef) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::FunctionReferences);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(FuncRefWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  auto Res = run(VM, "call", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+  Res = run(VM, "call_null", 5);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::AccessNullFunc);
+  Res = run(VM, "call_equiv", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 7U);
+}
+
+TEST(FuncRefTest, TypedReference) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::FunctionReferences);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(FuncRefWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  auto Res = run(VM, "call_local", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+  Res = run(VM, "call_global", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+  Res = run(VM, "pass_param", 5);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 6U);
+
+  // The typed references from the host are checked when invoking.
+  const std::vector<WasmEdge::ValVariant> Params = {UINT32_C(5),
+                                                    WasmEdge::FuncRef()};
+  const std::vector<WasmEdge::ValType> ParamTypes = {
+      WasmEdge::ValType::I32, WasmEdge::ValType::FuncRef};
+  auto Ret = VM.execute("call_param", Params, ParamTypes);
+  ASSERT_FALSE(Ret);
+  EXPECT_EQ(Ret.error(), WasmEdge::ErrCode::AccessNullFunc);
+  Ret = VM.execute("call_non_null", Params, ParamTypes);
+  ASSERT_FALSE(Ret);
+  EXPECT_EQ(Ret.error(), WasmEdge::ErrCode::FuncSigMismatch);
+}
+
+TEST(FuncRefTest, TypeCheck) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::FunctionReferences);
+  auto Validate = [&Conf](const std::vector<WasmEdge::Byte> &Wasm) {
+    WasmEdge::VM::VM VM(Conf);
+    EXPECT_TRUE(VM.loadWasm(Wasm));
+    return VM.validate();
+  };
+
+  auto Res = Validate(MismatchWasm);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::TypeCheckFailed);
+  Res = Validate(UntypedWasm);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::TypeCheckFailed);
+  Res = Validate(UninitWasm);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::TypeCheckFailed);
+  Res = Validate(ScopedInitWasm);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::TypeCheckFailed);
+  Res = Validate(UnknownTypeWasm);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::InvalidFuncTypeIdx);
+}
+
+TEST(FuncRefTest, NullReference) {
+  WasmEdge::Configure Conf;
+  Conf.addProposal(WasmEdge::Proposal::FunctionReferences);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(FuncRefWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  auto Res = run(VM, "as_non_null", 1);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 0U);
+  Res = run(VM, "as_non_null", 0);
+  ASSERT_FALSE(Res);
+  EXPECT_EQ(Res.error(), WasmEdge::ErrCode::CastNullToNonNull);
+  Res = run(VM, "br_on_null", 1);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 1U);
+  Res = run(VM, "br_on_null", 0);
+  ASSERT_TRUE(Res);
+  EXPECT_EQ(*Res, 7U);
+}
+
+TEST(FuncRefTest, NeedProposal) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::VM VM(Conf);
+  EXPECT_FALSE(VM.loadWasm(FuncRefWasm));
+  // The typed reference value types need the proposal.
+  EXPECT_FALSE(VM.loadWasm(UninitWasm));
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -11,11 +11,14 @@
 #include <algorithm>
 #include <array>
 #include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 using namespace std::literals;
 
@@ -869,6 +872,467 @@ TEST(WasiTest, Directory) {
     EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
     Env.fini();
   }
+
+  // create nested directories, resolve parents across them and remove
+  {
+    Env.init(std::array{"/:."s}, "test"s, {}, {});
+    const auto Run = [&](auto &Func, std::string_view Path) {
+      writeString(MemInst, Path, PathPtr);
+      EXPECT_TRUE(Func.run(&MemInst,
+                           std::array<WasmEdge::ValVariant, 3>{
+                               Fd, PathPtr, static_cast<uint32_t>(Path.size())},
+                           Errno));
+      return Errno[0].get<int32_t>();
+    };
+    EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp"sv), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/a"sv), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/a/b"sv), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/a/b/c"sv),
+              __WASI_ERRNO_SUCCESS);
+
+    const uint32_t FilestatPtr = 256;
+    for (const auto Path : {"tmp/a/b/c"sv, "tmp//a/b/../b/c"sv,
+                            "tmp/a/b/c/../../../a/b"sv}) {
+      writeString(MemInst, Path, PathPtr);
+      EXPECT_TRUE(WasiPathFilestatGet.run(
+          &MemInst,
+          std::array<WasmEdge::ValVariant, 5>{
+              Fd, static_cast<uint32_t>(__WASI_LOOKUPFLAGS_SYMLINK_FOLLOW),
+              PathPtr, static_cast<uint32_t>(Path.size()), FilestatPtr},
+          Errno));
+      EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+      const auto &Filestat =
+          *MemInst.getPointer<const __wasi_filestat_t *>(FilestatPtr);
+      EXPECT_EQ(Filestat.filetype, __WASI_FILETYPE_DIRECTORY);
+    }
+    EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/a/b/c/../../../../.."sv),
+              __WASI_ERRNO_NOTCAPABLE);
+    EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/a/x/c"sv), __WASI_ERRNO_NOENT);
+
+    EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/a/b/c"sv),
+              __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/a/b"sv), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/a"sv), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp"sv), __WASI_ERRNO_SUCCESS);
+    Env.fini();
+  }
+}
+
+TEST(WasiTest, Interrupt) {
+  WasmEdge::Host::WASI::Environ Env;
+  WasmEdge::Runtime::Instance::MemoryInstance MemInst(
+      WasmEdge::AST::MemoryType(1));
+
+  WasmEdge::Host::WasiPollOneoff WasiPollOneoff(Env);
+  std::array<WasmEdge::ValVariant, 1> Errno = {UINT32_C(0)};
+
+  const uint32_t SubscriptionPtr = 0;
+  const uint32_t EventPtr = 256;
+  const uint32_t NEventsPtr = 512;
+  auto &Subscription =
+      *MemInst.getPointer<__wasi_subscription_t *>(SubscriptionPtr);
+  Subscription.userdata = UINT64_C(1);
+  Subscription.u.tag = __WASI_EVENTTYPE_CLOCK;
+  Subscription.u.u.clock.id = __WASI_CLOCKID_MONOTONIC;
+  Subscription.u.u.clock.precision = 0;
+  Subscription.u.u.clock.flags = static_cast<__wasi_subclockflags_t>(0);
+
+  Env.init(std::array{"/:."s}, "test"s, {}, {});
+
+  // interrupted long sleep
+  {
+    Subscription.u.u.clock.timeout = UINT64_C(60000000000);
+    Env.interrupt();
+    auto Res = WasiPollOneoff.run(&MemInst,
+                                  std::array<WasmEdge::ValVariant, 4>{
+                                      SubscriptionPtr, EventPtr, UINT32_C(1),
+                                      NEventsPtr},
+                                  Errno);
+    ASSERT_FALSE(Res);
+    EXPECT_EQ(Res.error(), WasmEdge::ErrCode::Interrupted);
+  }
+
+  // cleared interruption
+  {
+    Subscription.u.u.clock.timeout = UINT64_C(1000000);
+    Env.clearInterrupt();
+    EXPECT_TRUE(WasiPollOneoff.run(&MemInst,
+                                   std::array<WasmEdge::ValVariant, 4>{
+                                       SubscriptionPtr, EventPtr, UINT32_C(1),
+                                       NEventsPtr},
+                                   Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NEventsPtr), UINT32_C(1));
+  }
+
+  Env.fini();
+}
+
+TEST(WasiTest, Stream) {
+  WasmEdge::Host::WASI::Environ Env;
+  WasmEdge::Runtime::Instance::MemoryInstance MemInst(
+      WasmEdge::AST::MemoryType(1));
+
+  WasmEdge::Host::WasiFdRead WasiFdRead(Env);
+  WasmEdge::Host::WasiFdWrite WasiFdWrite(Env);
+  WasmEdge::Host::WasiFdFdstatGet WasiFdFdstatGet(Env);
+  std::array<WasmEdge::ValVariant, 1> Errno = {UINT32_C(0)};
+
+  const uint32_t IOVSPtr = 0;
+  const uint32_t NPtr = 16;
+  const uint32_t FdStatPtr = 32;
+  const uint32_t BufPtr = 64;
+  auto *IOVS = MemInst.getPointer<__wasi_iovec_t *>(IOVSPtr, 2);
+  IOVS[0].buf = BufPtr;
+  IOVS[0].buf_len = 4;
+  IOVS[1].buf = BufPtr + 4;
+  IOVS[1].buf_len = 4;
+
+  Env.init({}, "test"s, {}, {});
+
+  std::string Input = "hello"s;
+  std::string Output;
+  Env.setStdIn([&Input](WasmEdge::Span<uint8_t> Buf)
+                   -> WasmEdge::Host::WASI::WasiExpect<__wasi_size_t> {
+    const auto Size = std::min(Input.size(), Buf.size());
+    std::copy_n(Input.begin(), Size, Buf.begin());
+    Input.erase(0, Size);
+    return static_cast<__wasi_size_t>(Size);
+  });
+  Env.setStdOut([&Output](WasmEdge::Span<const uint8_t> Buf)
+                    -> WasmEdge::Host::WASI::WasiExpect<__wasi_size_t> {
+    Output.append(Buf.begin(), Buf.end());
+    return static_cast<__wasi_size_t>(Buf.size());
+  });
+  uint32_t ErrAccepted = 0;
+  Env.setStdErr([&ErrAccepted](WasmEdge::Span<const uint8_t> Buf)
+                    -> WasmEdge::Host::WASI::WasiExpect<__wasi_size_t> {
+    if (ErrAccepted == 0) {
+      return WasmEdge::Host::WASI::WasiUnexpect(__WASI_ERRNO_IO);
+    }
+    --ErrAccepted;
+    return static_cast<__wasi_size_t>(Buf.size());
+  });
+
+  // stdin stops at the short read
+  {
+    EXPECT_TRUE(WasiFdRead.run(&MemInst,
+                               std::array<WasmEdge::ValVariant, 4>{
+                                   UINT32_C(0), IOVSPtr, UINT32_C(2), NPtr},
+                               Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(5));
+    EXPECT_EQ(std::string_view(MemInst.getPointer<const char *>(BufPtr), 5),
+              "hello"sv);
+  }
+
+  // stdin reaches the end of the stream
+  {
+    EXPECT_TRUE(WasiFdRead.run(&MemInst,
+                               std::array<WasmEdge::ValVariant, 4>{
+                                   UINT32_C(0), IOVSPtr, UINT32_C(2), NPtr},
+                               Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(0));
+  }
+
+  // stdout gathers all buffers
+  {
+    writeString(MemInst, "wasmedge"sv, BufPtr);
+    WasmEdge::Runtime::HostFunctionBase::takeWork();
+    EXPECT_TRUE(WasiFdWrite.run(&MemInst,
+                                std::array<WasmEdge::ValVariant, 4>{
+                                    UINT32_C(1), IOVSPtr, UINT32_C(2), NPtr},
+                                Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(8));
+    EXPECT_EQ(Output, "wasmedge"s);
+    // The transferred bytes are reported for the dynamic cost.
+    const auto Work = WasmEdge::Runtime::HostFunctionBase::takeWork();
+    EXPECT_EQ(Work[static_cast<size_t>(WasmEdge::HostWork::Bytes)], 8U);
+  }
+
+  // stdout is not readable
+  {
+    EXPECT_TRUE(WasiFdRead.run(&MemInst,
+                               std::array<WasmEdge::ValVariant, 4>{
+                                   UINT32_C(1), IOVSPtr, UINT32_C(2), NPtr},
+                               Errno));
+    EXPECT_NE(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+  }
+
+  // stderr reports the error of the callback
+  {
+    EXPECT_TRUE(WasiFdWrite.run(&MemInst,
+                                std::array<WasmEdge::ValVariant, 4>{
+                                    UINT32_C(2), IOVSPtr, UINT32_C(2), NPtr},
+                                Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_IO);
+  }
+
+  // stderr reports the partial write before the error of the callback
+  {
+    ErrAccepted = 1;
+    EXPECT_TRUE(WasiFdWrite.run(&MemInst,
+                                std::array<WasmEdge::ValVariant, 4>{
+                                    UINT32_C(2), IOVSPtr, UINT32_C(2), NPtr},
+                                Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(4));
+  }
+
+  // stream fdstat
+  {
+    EXPECT_TRUE(WasiFdFdstatGet.run(
+        &MemInst, std::array<WasmEdge::ValVariant, 2>{UINT32_C(1), FdStatPtr},
+        Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    const auto &FdStat =
+        *MemInst.getPointer<const __wasi_fdstat_t *>(FdStatPtr);
+    EXPECT_EQ(FdStat.fs_filetype, __WASI_FILETYPE_UNKNOWN);
+  }
+
+  // restore the system stream
+  {
+    Env.setStdErr({});
+    IOVS[0].buf_len = 0;
+    EXPECT_TRUE(WasiFdWrite.run(&MemInst,
+                                std::array<WasmEdge::ValVariant, 4>{
+                                    UINT32_C(2), IOVSPtr, UINT32_C(1), NPtr},
+                                Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(0));
+  }
+
+  Env.fini();
+}
+
+TEST(WasiTest, IOLimit) {
+  WasmEdge::Host::WASI::Environ Env;
+  WasmEdge::Runtime::Instance::MemoryInstance MemInst(
+      WasmEdge::AST::MemoryType(1));
+
+  WasmEdge::Host::WasiFdWrite WasiFdWrite(Env);
+  std::array<WasmEdge::ValVariant, 1> Errno = {UINT32_C(0)};
+
+  const uint32_t IOVSPtr = 0;
+  const uint32_t NPtr = 16;
+  const uint32_t BufPtr = 64;
+  auto *IOVS = MemInst.getPointer<__wasi_iovec_t *>(IOVSPtr, 1);
+  IOVS[0].buf = BufPtr;
+  IOVS[0].buf_len = 300;
+
+  Env.init(std::array{"/:."s}, "test"s, {}, {});
+  const auto Rights = static_cast<__wasi_rights_t>(__WASI_RIGHTS_FD_WRITE);
+  const auto Fd = Env.pathOpen(
+      3, "tmp"sv, static_cast<__wasi_lookupflags_t>(0),
+      static_cast<__wasi_oflags_t>(__WASI_OFLAGS_CREAT | __WASI_OFLAGS_TRUNC),
+      Rights, Rights, static_cast<__wasi_fdflags_t>(0));
+  ASSERT_TRUE(Fd);
+
+  const auto Write = [&]() {
+    EXPECT_TRUE(WasiFdWrite.run(&MemInst,
+                                std::array<WasmEdge::ValVariant, 4>{
+                                    *Fd, IOVSPtr, UINT32_C(1), NPtr},
+                                Errno));
+    return Errno[0].get<int32_t>();
+  };
+  const auto Work = [](WasmEdge::HostWork Kind) {
+    return WasmEdge::Runtime::HostFunctionBase::takeWork()[static_cast<size_t>(
+        Kind)];
+  };
+  WasmEdge::Host::WASI::IOLimit Limit;
+
+  // the buffers are truncated to the bytes burst, then rejected
+  {
+    Limit.BytesPerSecond = 1000;
+    Limit.BytesBurst = 100;
+    Limit.Blocking = false;
+    Env.setIOLimit(Limit);
+    EXPECT_EQ(Write(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(100));
+    EXPECT_EQ(Write(), __WASI_ERRNO_AGAIN);
+    EXPECT_EQ(Work(WasmEdge::HostWork::ThrottledOps), UINT64_C(1));
+  }
+
+  // the operations wait for the tokens
+  {
+    Limit = {};
+    Limit.OpsPerSecond = 100;
+    Limit.OpsBurst = 1;
+    Env.setIOLimit(Limit);
+    const auto Start = std::chrono::steady_clock::now();
+    for (int I = 0; I < 3; ++I) {
+      EXPECT_EQ(Write(), __WASI_ERRNO_SUCCESS);
+      EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(300));
+    }
+    EXPECT_GE(std::chrono::steady_clock::now() - Start, 15ms);
+    WasmEdge::Runtime::HostFunctionBase::takeWork();
+  }
+
+  // the waiting is woken up by the stop request
+  {
+    Limit.OpsPerSecond = 1;
+    Env.setIOLimit(Limit);
+    EXPECT_EQ(Write(), __WASI_ERRNO_SUCCESS);
+    Env.interrupt();
+    EXPECT_FALSE(WasiFdWrite.run(&MemInst,
+                                 std::array<WasmEdge::ValVariant, 4>{
+                                     *Fd, IOVSPtr, UINT32_C(1), NPtr},
+                                 Errno));
+    Env.clearInterrupt();
+  }
+
+  // no limit
+  {
+    Env.setIOLimit({});
+    EXPECT_EQ(Write(), __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(*MemInst.getPointer<const uint32_t *>(NPtr), UINT32_C(300));
+  }
+
+  EXPECT_TRUE(Env.fdClose(*Fd));
+  EXPECT_TRUE(Env.pathUnlinkFile(3, "tmp"sv));
+  Env.fini();
+}
+
+TEST(WasiTest, FilestatBatchAndWalk) {
+  WasmEdge::Host::WASI::Environ Env;
+  WasmEdge::Runtime::Instance::MemoryInstance MemInst(
+      WasmEdge::AST::MemoryType(1));
+
+  WasmEdge::Host::WasiPathCreateDirectory WasiPathCreateDirectory(Env);
+  WasmEdge::Host::WasiPathRemoveDirectory WasiPathRemoveDirectory(Env);
+  WasmEdge::Host::WasiPathSymlink WasiPathSymlink(Env);
+  WasmEdge::Host::WasiPathUnlinkFile WasiPathUnlinkFile(Env);
+  WasmEdge::Host::WasiPathFilestatGetBatch WasiPathFilestatGetBatch(Env);
+  WasmEdge::Host::WasiPathWalk WasiPathWalk(Env);
+  std::array<WasmEdge::ValVariant, 1> Errno = {UINT32_C(0)};
+
+  const uint32_t Fd = 3;
+  const uint32_t PathPtr = 0;
+  const uint32_t PathsPtr = 1024;
+  const uint32_t FilestatsPtr = 2048;
+  const uint32_t ErrnosPtr = 4096;
+  const uint32_t BufPtr = 8192;
+  const uint32_t NReadPtr = 16384;
+  Env.init(std::array{"/:."s}, "test"s, {}, {});
+
+  const auto Run = [&](auto &Func, std::string_view Path) {
+    writeString(MemInst, Path, PathPtr);
+    EXPECT_TRUE(Func.run(&MemInst,
+                         std::array<WasmEdge::ValVariant, 3>{
+                             Fd, PathPtr, static_cast<uint32_t>(Path.size())},
+                         Errno));
+    return Errno[0].get<int32_t>();
+  };
+  EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/a"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/a/b"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathCreateDirectory, "tmp/c"sv), __WASI_ERRNO_SUCCESS);
+  {
+    const auto OldPath = "a"sv;
+    const auto NewPath = "tmp/l"sv;
+    writeString(MemInst, OldPath, PathPtr);
+    writeString(MemInst, NewPath, PathPtr + 16);
+    EXPECT_TRUE(WasiPathSymlink.run(
+        &MemInst,
+        std::array<WasmEdge::ValVariant, 5>{
+            PathPtr, static_cast<uint32_t>(OldPath.size()), Fd,
+            PathPtr + 16, static_cast<uint32_t>(NewPath.size())},
+        Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+  }
+
+  // inspect the paths in one call
+  {
+    const std::array Paths = {"tmp/a"sv, "tmp/x"sv, "tmp/l"sv};
+    auto *IOVs = MemInst.getPointer<__wasi_ciovec_t *>(PathsPtr, Paths.size());
+    uint32_t Ptr = PathPtr;
+    for (size_t I = 0; I < Paths.size(); ++I) {
+      writeString(MemInst, Paths[I], Ptr);
+      IOVs[I].buf = Ptr;
+      IOVs[I].buf_len = static_cast<uint32_t>(Paths[I].size());
+      Ptr += IOVs[I].buf_len;
+    }
+    EXPECT_TRUE(WasiPathFilestatGetBatch.run(
+        &MemInst,
+        std::array<WasmEdge::ValVariant, 6>{
+            Fd, UINT32_C(0), PathsPtr, static_cast<uint32_t>(Paths.size()),
+            FilestatsPtr, ErrnosPtr},
+        Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+    const auto *Filestats =
+        MemInst.getPointer<const __wasi_filestat_t *>(FilestatsPtr, 3);
+    const auto *Errnos =
+        MemInst.getPointer<const __wasi_errno_t *>(ErrnosPtr, 3);
+    EXPECT_EQ(Errnos[0], __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Filestats[0].filetype, __WASI_FILETYPE_DIRECTORY);
+    EXPECT_EQ(Errnos[1], __WASI_ERRNO_NOENT);
+    EXPECT_EQ(Errnos[2], __WASI_ERRNO_SUCCESS);
+    EXPECT_EQ(Filestats[2].filetype, __WASI_FILETYPE_SYMBOLIC_LINK);
+
+    // too many paths
+    EXPECT_TRUE(WasiPathFilestatGetBatch.run(
+        &MemInst,
+        std::array<WasmEdge::ValVariant, 6>{Fd, UINT32_C(0), PathsPtr,
+                                            UINT32_C(4097), FilestatsPtr,
+                                            ErrnosPtr},
+        Errno));
+    EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_INVAL);
+  }
+
+  // walk the directory, resuming from the cookie of the last entry
+  const auto Walk = [&](uint32_t MaxDepth, uint32_t BufLen) {
+    std::vector<std::pair<std::string, uint32_t>> Entries;
+    const auto Path = "tmp"sv;
+    writeString(MemInst, Path, PathPtr);
+    uint64_t Cookie = 0;
+    while (true) {
+      EXPECT_TRUE(WasiPathWalk.run(
+          &MemInst,
+          std::array<WasmEdge::ValVariant, 9>{
+              Fd, static_cast<uint32_t>(__WASI_LOOKUPFLAGS_SYMLINK_FOLLOW),
+              PathPtr, static_cast<uint32_t>(Path.size()), MaxDepth, BufPtr,
+              BufLen, Cookie, NReadPtr},
+          Errno));
+      EXPECT_EQ(Errno[0].get<int32_t>(), __WASI_ERRNO_SUCCESS);
+      const uint32_t NRead = *MemInst.getPointer<const uint32_t *>(NReadPtr);
+      const auto *Buf = MemInst.getPointer<const uint8_t *>(BufPtr, NRead);
+      uint32_t Offset = 0;
+      while (NRead - Offset >= sizeof(WasmEdge::Host::WASI::WalkEntry)) {
+        WasmEdge::Host::WASI::WalkEntry Entry;
+        std::memcpy(&Entry, Buf + Offset, sizeof(Entry));
+        Offset += sizeof(Entry);
+        if (NRead - Offset < Entry.NameLen) {
+          break;
+        }
+        Entries.emplace_back(
+            std::string(reinterpret_cast<const char *>(Buf) + Offset,
+                        Entry.NameLen),
+            Entry.Depth);
+        Offset += Entry.NameLen;
+        Cookie = Entry.Next;
+      }
+      if (NRead < BufLen) {
+        break;
+      }
+    }
+    std::sort(Entries.begin(), Entries.end());
+    return Entries;
+  };
+  using EntryList = std::vector<std::pair<std::string, uint32_t>>;
+  EXPECT_EQ(Walk(0, 4096),
+            (EntryList{{"a"s, 1}, {"a/b"s, 2}, {"c"s, 1}, {"l"s, 1}}));
+  EXPECT_EQ(Walk(1, 4096), (EntryList{{"a"s, 1}, {"c"s, 1}, {"l"s, 1}}));
+  EXPECT_EQ(Walk(0, 100),
+            (EntryList{{"a"s, 1}, {"a/b"s, 2}, {"c"s, 1}, {"l"s, 1}}));
+
+  EXPECT_EQ(Run(WasiPathUnlinkFile, "tmp/l"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/c"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/a/b"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp/a"sv), __WASI_ERRNO_SUCCESS);
+  EXPECT_EQ(Run(WasiPathRemoveDirectory, "tmp"sv), __WASI_ERRNO_SUCCESS);
+  Env.fini();
 }
 
 TEST(WasiTest, SymbolicLink) {
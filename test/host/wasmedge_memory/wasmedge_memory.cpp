@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "host/wasmedge_memory/memoryfunc.h"
+#include "host/wasmedge_memory/memorymodule.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace {
+void fillMemContent(WasmEdge::Runtime::Instance::MemoryInstance &MemInst,
+                    uint32_t Offset, uint32_t Cnt, uint8_t C = 0) noexcept {
+  std::fill_n(MemInst.getPointer<uint8_t *>(Offset), Cnt, C);
+}
+bool isMemZero(WasmEdge::Runtime::Instance::MemoryInstance &MemInst,
+               uint32_t Offset, uint32_t Cnt) noexcept {
+  const uint8_t *Buf = MemInst.getPointer<uint8_t *>(Offset);
+  return std::all_of(Buf, Buf + Cnt, [](uint8_t C) { return C == 0; });
+}
+} // namespace
+
+TEST(WasmEdgeMemoryTest, Discard) {
+  WasmEdge::Runtime::Instance::MemoryInstance MemInst(
+      WasmEdge::AST::MemoryType(3));
+  WasmEdge::Host::WasmEdgeMemoryDiscard WasmEdgeMemoryDiscard;
+  fillMemContent(MemInst, 0, 3 * 65536, UINT8_C(0xA5));
+
+  // Discard the second page.
+  EXPECT_TRUE(WasmEdgeMemoryDiscard.run(
+      &MemInst,
+      std::array<WasmEdge::ValVariant, 2>{UINT32_C(65536), UINT32_C(65536)},
+      {}));
+  EXPECT_FALSE(isMemZero(MemInst, 0, 65536));
+  EXPECT_TRUE(isMemZero(MemInst, 65536, 65536));
+  EXPECT_FALSE(isMemZero(MemInst, 131072, 65536));
+  EXPECT_EQ(MemInst.getPageSize(), 3U);
+
+  // Discarded pages are still writable.
+  fillMemContent(MemInst, 65536, 16, UINT8_C(0xA5));
+  EXPECT_FALSE(isMemZero(MemInst, 65536, 16));
+
+  // Discard nothing.
+  EXPECT_TRUE(WasmEdgeMemoryDiscard.run(
+      &MemInst, std::array<WasmEdge::ValVariant, 2>{UINT32_C(0), UINT32_C(0)},
+      {}));
+
+  // Unaligned range.
+  EXPECT_FALSE(WasmEdgeMemoryDiscard.run(
+      &MemInst,
+      std::array<WasmEdge::ValVariant, 2>{UINT32_C(1), UINT32_C(65536)}, {}));
+  EXPECT_FALSE(WasmEdgeMemoryDiscard.run(
+      &MemInst, std::array<WasmEdge::ValVariant, 2>{UINT32_C(0), UINT32_C(100)},
+      {}));
+
+  // Out of bounds.
+  EXPECT_FALSE(WasmEdgeMemoryDiscard.run(
+      &MemInst,
+      std::array<WasmEdge::ValVariant, 2>{UINT32_C(131072), UINT32_C(131072)},
+      {}));
+
+  // No memory instance.
+  EXPECT_FALSE(WasmEdgeMemoryDiscard.run(
+      nullptr, std::array<WasmEdge::ValVariant, 2>{UINT32_C(0), UINT32_C(0)},
+      {}));
+}
+
+TEST(WasmEdgeMemoryTest, Module) {
+  WasmEdge::Host::WasmEdgeMemoryModule Mod;
+  EXPECT_EQ(Mod.getFuncs().size(), 1U);
+  EXPECT_NE(Mod.getFuncs().find("wasmedge_memory_discard"),
+            Mod.getFuncs().end());
+}
+
+GTEST_API_ int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
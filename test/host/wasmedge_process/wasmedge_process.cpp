@@ -266,6 +266,14 @@ TEST(WasmEdgeProcessTest, Module) {
   EXPECT_NE(FuncMap.find("wasmedge_process_get_stdout"), FuncMap.end());
   EXPECT_NE(FuncMap.find("wasmedge_process_get_stderr_len"), FuncMap.end());
   EXPECT_NE(FuncMap.find("wasmedge_process_get_stderr"), FuncMap.end());
+
+  // The function types are shared between the module instances.
+  WasmEdge::Host::WasmEdgeProcessModule Mod2;
+  const auto &FuncMap2 = Mod2.getFuncs();
+  EXPECT_EQ(&FuncMap.find("wasmedge_process_run")->second->getFuncType(),
+            &FuncMap2.find("wasmedge_process_run")->second->getFuncType());
+  EXPECT_NE(&FuncMap.find("wasmedge_process_run")->second->getHostFunc(),
+            &FuncMap2.find("wasmedge_process_run")->second->getHostFunc());
 }
 
 GTEST_API_ int main(int argc, char **argv) {
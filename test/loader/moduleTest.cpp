@@ -220,6 +220,47 @@ TEST(ModuleTest, LoadDupSecModule) {
   EXPECT_FALSE(Ldr.parseModule(Vec));
 }
 
+TEST(ModuleTest, LoadBranchHintSecModule) {
+  // (func (param i32)
+  //   (block (br_if 0 (local.get 0)))
+  //   (if (local.get 0) (then)))
+  std::vector<uint8_t> Vec = {
+      0x00U, 0x61U, 0x73U, 0x6DU,                      // Magic
+      0x01U, 0x00U, 0x00U, 0x00U,                      // Version
+      0x01U, 0x05U, 0x01U, 0x60U, 0x01U, 0x7FU, 0x00U, // Type section
+      0x03U, 0x02U, 0x01U, 0x00U,                      // Function section
+      0x00U, 0x23U, 0x19U,                             // Custom section
+      0x6DU, 0x65U, 0x74U, 0x61U, 0x64U, 0x61U, 0x74U, // "metadat"
+      0x61U, 0x2EU, 0x63U, 0x6FU, 0x64U, 0x65U, 0x2EU, // "a.code."
+      0x62U, 0x72U, 0x61U, 0x6EU, 0x63U, 0x68U, 0x5FU, // "branch_"
+      0x68U, 0x69U, 0x6EU, 0x74U,                      // "hint"
+      0x01U, 0x00U, 0x02U,                             // Function 0
+      0x05U, 0x01U, 0x00U,                             // br_if unlikely
+      0x0AU, 0x01U, 0x01U,                             // if likely
+      0x0AU, 0x10U, 0x01U, 0x0EU, 0x00U,               // Code section
+      0x02U, 0x40U, 0x20U, 0x00U, 0x0DU, 0x00U, 0x0BU, // block
+      0x20U, 0x00U, 0x04U, 0x40U, 0x0BU, 0x0BU         // if
+  };
+  auto Mod = Ldr.parseModule(Vec);
+  ASSERT_TRUE(Mod);
+  auto Instrs =
+      (*Mod)->getCodeSection().getContent()[0].getExpr().getInstrs();
+  ASSERT_EQ(Instrs.size(), 8U);
+  EXPECT_FALSE(Instrs[1].hasBranchHint());
+  EXPECT_TRUE(Instrs[2].hasBranchHint());
+  EXPECT_FALSE(Instrs[2].isBranchLikely());
+  EXPECT_TRUE(Instrs[5].hasBranchHint());
+  EXPECT_TRUE(Instrs[5].isBranchLikely());
+
+  // The hint not on a branch instruction is ignored.
+  Vec[50] = 0x03U;
+  Mod = Ldr.parseModule(Vec);
+  ASSERT_TRUE(Mod);
+  Instrs = (*Mod)->getCodeSection().getContent()[0].getExpr().getInstrs();
+  EXPECT_FALSE(Instrs[1].hasBranchHint());
+  EXPECT_FALSE(Instrs[2].hasBranchHint());
+}
+
 } // namespace
 
 GTEST_API_ int main(int argc, char **argv) {
@@ -597,4 +597,47 @@ TEST(SectionTest, LoadDataCountSection) {
   };
   EXPECT_FALSE(LdrNoRefType.parseModule(prefixedVec(Vec)));
 }
+
+TEST(SectionTest, LoadTagSection) {
+  std::vector<uint8_t> Vec;
+
+  WasmEdge::Configure ConfEH;
+  ConfEH.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  WasmEdge::Loader::Loader LdrEH(ConfEH);
+
+  // 14. Test load tag section.
+  //
+  //   1.  Load invalid empty section.
+  //   2.  Load tag section with contents.
+  //   3.  Load tag section with non-zero attribute.
+  //   4.  Load tag section without Exception-Handling proposal.
+
+  Vec = {0x0DU};
+  EXPECT_FALSE(LdrEH.parseModule(prefixedVec(Vec)));
+
+  Vec = {
+      0x0DU,        // Tag section
+      0x05U,        // Content size = 5
+      0x02U,        // Vector length = 2
+      0x00U, 0x00U, // Attribute and type index
+      0x00U, 0x01U  // Attribute and type index
+  };
+  EXPECT_TRUE(LdrEH.parseModule(prefixedVec(Vec)));
+
+  Vec = {
+      0x0DU,       // Tag section
+      0x03U,       // Content size = 3
+      0x01U,       // Vector length = 1
+      0x01U, 0x00U // Attribute and type index
+  };
+  EXPECT_FALSE(LdrEH.parseModule(prefixedVec(Vec)));
+
+  Vec = {
+      0x0DU,       // Tag section
+      0x03U,       // Content size = 3
+      0x01U,       // Vector length = 1
+      0x00U, 0x00U // Attribute and type index
+  };
+  EXPECT_FALSE(Ldr.parseModule(prefixedVec(Vec)));
+}
 } // namespace
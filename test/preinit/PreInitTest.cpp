@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/configure.h"
+#include "vm/preinit.h"
+#include "vm/vm.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// (module
+//   (import "wasi_snapshot_preview1" "proc_exit" (func $exit (param i32)))
+//   (table 2 funcref)
+//   (memory 1)
+//   (global $g (mut i32) (i32.const 0))
+//   (elem declare func $get)
+//   (func $init (export "init")
+//     (i32.store (i32.const 16) (i32.const 42))
+//     (global.set $g (i32.const 7))
+//     (drop (memory.grow (i32.const 1)))
+//     (i32.store8 (i32.const 70000) (i32.const 99))
+//     (table.set (i32.const 1) (ref.func $get)))
+//   (func $get (export "get") (result i32)
+//     (i32.add (i32.load (i32.const 16)) (global.get $g)))
+//   (func $bad (export "bad") (call $exit (i32.const 0)))
+//   (func $call (export "call") (result i32)
+//     (call_indirect (result i32) (i32.const 1)))
+//   (func $peek (export "peek") (result i32)
+//     (i32.load8_u (i32.const 70000)))
+//   (func $size (export "size") (result i32) (memory.size)))
+std::vector<WasmEdge::Byte> PreInitWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0C, 0x03, 0x60,
+    0x00, 0x00, 0x60, 0x00, 0x01, 0x7F, 0x60, 0x01, 0x7F, 0x00, 0x02, 0x24,
+    0x01, 0x16, 0x77, 0x61, 0x73, 0x69, 0x5F, 0x73, 0x6E, 0x61, 0x70, 0x73,
+    0x68, 0x6F, 0x74, 0x5F, 0x70, 0x72, 0x65, 0x76, 0x69, 0x65, 0x77, 0x31,
+    0x09, 0x70, 0x72, 0x6F, 0x63, 0x5F, 0x65, 0x78, 0x69, 0x74, 0x00, 0x02,
+    0x03, 0x07, 0x06, 0x00, 0x01, 0x00, 0x01, 0x01, 0x01, 0x04, 0x04, 0x01,
+    0x70, 0x00, 0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06, 0x06, 0x01, 0x7F,
+    0x01, 0x41, 0x00, 0x0B, 0x07, 0x29, 0x06, 0x04, 0x69, 0x6E, 0x69, 0x74,
+    0x00, 0x01, 0x03, 0x67, 0x65, 0x74, 0x00, 0x02, 0x03, 0x62, 0x61, 0x64,
+    0x00, 0x03, 0x04, 0x63, 0x61, 0x6C, 0x6C, 0x00, 0x04, 0x04, 0x70, 0x65,
+    0x65, 0x6B, 0x00, 0x05, 0x04, 0x73, 0x69, 0x7A, 0x65, 0x00, 0x06, 0x09,
+    0x05, 0x01, 0x03, 0x00, 0x01, 0x02, 0x0A, 0x4D, 0x06, 0x22, 0x00, 0x41,
+    0x10, 0x41, 0x2A, 0x36, 0x02, 0x00, 0x41, 0x07, 0x24, 0x00, 0x41, 0x01,
+    0x40, 0x00, 0x1A, 0x41, 0xF0, 0xA2, 0x04, 0x41, 0xE3, 0x00, 0x3A, 0x00,
+    0x00, 0x41, 0x01, 0xD2, 0x02, 0x26, 0x00, 0x0B, 0x0A, 0x00, 0x41, 0x10,
+    0x28, 0x02, 0x00, 0x23, 0x00, 0x6A, 0x0B, 0x06, 0x00, 0x41, 0x00, 0x10,
+    0x00, 0x0B, 0x07, 0x00, 0x41, 0x01, 0x11, 0x01, 0x00, 0x0B, 0x09, 0x00,
+    0x41, 0xF0, 0xA2, 0x04, 0x2D, 0x00, 0x00, 0x0B, 0x04, 0x00, 0x3F, 0x00,
+    0x0B};
+
+uint32_t executeI32(WasmEdge::VM::VM &VM, std::string_view Func) {
+  auto Res = VM.execute(Func);
+  EXPECT_TRUE(Res);
+  if (!Res || Res->size() != 1) {
+    return UINT32_C(0);
+  }
+  return (*Res)[0].first.get<uint32_t>();
+}
+
+TEST(PreInitTest, Snapshot) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::PreInitializer PreInit(Conf);
+  auto Res = PreInit.preInitialize(PreInitWasm, "init");
+  ASSERT_TRUE(Res);
+
+  Conf.addHostRegistration(WasmEdge::HostRegistration::Wasi);
+  WasmEdge::VM::VM VM(Conf);
+  ASSERT_TRUE(VM.loadWasm(*Res));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+  EXPECT_EQ(executeI32(VM, "get"), 49U);
+  EXPECT_EQ(executeI32(VM, "call"), 49U);
+  EXPECT_EQ(executeI32(VM, "peek"), 99U);
+  EXPECT_EQ(executeI32(VM, "size"), 2U);
+  // The initialization function is not exported anymore.
+  EXPECT_FALSE(VM.execute("init"));
+}
+
+TEST(PreInitTest, Reject) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::PreInitializer PreInit(Conf);
+  // Calling the imported WASI function.
+  EXPECT_FALSE(PreInit.preInitialize(PreInitWasm, "bad"));
+  // Function not found.
+  EXPECT_FALSE(PreInit.preInitialize(PreInitWasm, "nothing"));
+  // Function type not matched.
+  EXPECT_FALSE(PreInit.preInitialize(PreInitWasm, "get"));
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/configure.h"
+#include "common/defines.h"
+#include "common/log.h"
+#include "system/profiler.h"
+#include "vm/vm.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// (module
+//   (func $spin (param i32) (result i32)
+//     (loop $l
+//       (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+//       (br_if $l (local.get 0)))
+//     (local.get 0))
+//   (func $run (export "run") (param i32) (result i32)
+//     (call $spin (local.get 0))))
+std::vector<WasmEdge::Byte> SpinWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x03, 0x03, 0x02, 0x00, 0x00, 0x07, 0x07, 0x01,
+    0x03, 0x72, 0x75, 0x6E, 0x00, 0x01, 0x0A, 0x1B, 0x02, 0x12, 0x00, 0x03,
+    0x40, 0x20, 0x00, 0x41, 0x01, 0x6B, 0x21, 0x00, 0x20, 0x00, 0x0D, 0x00,
+    0x0B, 0x20, 0x00, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x00, 0x0B, 0x00,
+    0x13, 0x04, 0x6E, 0x61, 0x6D, 0x65, 0x01, 0x0C, 0x02, 0x00, 0x04, 0x73,
+    0x70, 0x69, 0x6E, 0x01, 0x03, 0x72, 0x75, 0x6E};
+
+TEST(ProfilerTest, FunctionNames) {
+  WasmEdge::Configure Conf;
+  Conf.getStatisticsConfigure().setProfiling(true);
+  Conf.getStatisticsConfigure().setProfileInterval(
+      std::chrono::milliseconds(1));
+  WasmEdge::VM::VM VM(Conf);
+  auto *Prof = VM.getProfiler();
+  ASSERT_NE(Prof, nullptr);
+  ASSERT_TRUE(VM.loadWasm(SpinWasm));
+  ASSERT_TRUE(VM.validate());
+  ASSERT_TRUE(VM.instantiate());
+
+  const std::vector<WasmEdge::ValVariant> Params = {UINT32_C(1000000)};
+  const std::vector<WasmEdge::ValType> ParamTypes = {WasmEdge::ValType::I32};
+  for (uint32_t I = 0; I < 100 && Prof->getSampleCount() == 0; ++I) {
+    ASSERT_TRUE(VM.execute("run", Params, ParamTypes));
+  }
+  EXPECT_FALSE(Prof->isRunning());
+  ASSERT_GT(Prof->getSampleCount(), 0U);
+
+  std::ostringstream OS;
+  Prof->dumpFolded(OS);
+  EXPECT_NE(OS.str().find("run;spin "), std::string::npos);
+
+  Prof->clear();
+  EXPECT_EQ(Prof->getSampleCount(), 0U);
+}
+
+#if WASMEDGE_OS_LINUX
+TEST(ProfilerTest, ThreadSamplers) {
+  // Every thread samples its own execution with its own profiler.
+  auto Run = [](uint64_t &Count, std::string &Folded) {
+    WasmEdge::Configure Conf;
+    Conf.getStatisticsConfigure().setProfiling(true);
+    Conf.getStatisticsConfigure().setProfileInterval(
+        std::chrono::milliseconds(1));
+    WasmEdge::VM::VM VM(Conf);
+    auto *Prof = VM.getProfiler();
+    if (!Prof || !VM.loadWasm(SpinWasm) || !VM.validate() ||
+        !VM.instantiate()) {
+      return;
+    }
+    const std::vector<WasmEdge::ValVariant> Params = {UINT32_C(1000000)};
+    const std::vector<WasmEdge::ValType> ParamTypes = {WasmEdge::ValType::I32};
+    for (uint32_t I = 0; I < 100 && Prof->getSampleCount() == 0; ++I) {
+      if (!VM.execute("run", Params, ParamTypes)) {
+        return;
+      }
+    }
+    Count = Prof->getSampleCount();
+    std::ostringstream OS;
+    Prof->dumpFolded(OS);
+    Folded = OS.str();
+  };
+  uint64_t Count1 = 0, Count2 = 0;
+  std::string Folded1, Folded2;
+  std::thread T1(Run, std::ref(Count1), std::ref(Folded1));
+  std::thread T2(Run, std::ref(Count2), std::ref(Folded2));
+  T1.join();
+  T2.join();
+  EXPECT_GT(Count1, 0U);
+  EXPECT_GT(Count2, 0U);
+  EXPECT_NE(Folded1.find("run;spin "), std::string::npos);
+  EXPECT_NE(Folded2.find("run;spin "), std::string::npos);
+}
+#else
+TEST(ProfilerTest, SingleSampler) {
+  WasmEdge::Profiler First, Second;
+  ASSERT_TRUE(First.start(std::chrono::milliseconds(10)));
+  EXPECT_TRUE(First.isRunning());
+  EXPECT_FALSE(Second.start(std::chrono::milliseconds(10)));
+  First.stop();
+  EXPECT_FALSE(First.isRunning());
+  EXPECT_TRUE(Second.start(std::chrono::milliseconds(10)));
+  Second.stop();
+}
+#endif
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+// SPDX-FileCopyrightText: 2019-2022 Second State INC
+
+#include "common/configure.h"
+#include "common/log.h"
+#include "vm/vm.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// (module
+//   (func (export "madd") (param f32 f32 f32) (result f32)
+//     (f32x4.extract_lane 0 (f32x4.relaxed_madd (f32x4.splat (local.get 0))
+//       (f32x4.splat (local.get 1)) (f32x4.splat (local.get 2)))))
+//   (func (export "nmadd") (param f32 f32 f32) (result f32)
+//     (f32x4.extract_lane 0 (f32x4.relaxed_nmadd (f32x4.splat (local.get 0))
+//       (f32x4.splat (local.get 1)) (f32x4.splat (local.get 2)))))
+//   (func (export "dot") (param i32 i32) (result i32)
+//     (i16x8.extract_lane_s 0 (i16x8.relaxed_dot_i8x16_i7x16_s
+//       (i8x16.splat (local.get 0)) (i8x16.splat (local.get 1)))))
+//   (func (export "dot_add") (param i32 i32 i32) (result i32)
+//     (i32x4.extract_lane 0 (i32x4.relaxed_dot_i8x16_i7x16_add_s
+//       (i8x16.splat (local.get 0)) (i8x16.splat (local.get 1))
+//       (i32x4.splat (local.get 2)))))
+//   (func (export "swizzle") (param i32) (result i32)
+//     (i8x16.extract_lane_u 0 (i8x16.relaxed_swizzle
+//       (v128.const i8x16 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25)
+//       (i8x16.splat (local.get 0)))))
+//   (func (export "laneselect") (param i32 i32 i32) (result i32)
+//     (i32x4.extract_lane 0 (i32x4.relaxed_laneselect
+//       (i32x4.splat (local.get 0)) (i32x4.splat (local.get 1))
+//       (i32x4.splat (local.get 2)))))
+//   (func (export "min") (param f32 f32) (result f32)
+//     (f32x4.extract_lane 0 (f32x4.relaxed_min (f32x4.splat (local.get 0))
+//       (f32x4.splat (local.get 1)))))
+//   (func (export "trunc") (param f32) (result i32)
+//     (i32x4.extract_lane 0 (i32x4.relaxed_trunc_f32x4_s
+//       (f32x4.splat (local.get 0)))))
+//   (func (export "q15mulr") (param i32 i32) (result i32)
+//     (i16x8.extract_lane_s 0 (i16x8.relaxed_q15mulr_s
+//       (i16x8.splat (local.get 0)) (i16x8.splat (local.get 1))))))
+std::vector<WasmEdge::Byte> RelaxedSIMDWasm = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x25, 0x06, 0x60,
+    0x03, 0x7D, 0x7D, 0x7D, 0x01, 0x7D, 0x60, 0x02, 0x7F, 0x7F, 0x01, 0x7F,
+    0x60, 0x03, 0x7F, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x01, 0x7F, 0x01, 0x7F,
+    0x60, 0x02, 0x7D, 0x7D, 0x01, 0x7D, 0x60, 0x01, 0x7D, 0x01, 0x7F, 0x03,
+    0x0A, 0x09, 0x00, 0x00, 0x01, 0x02, 0x03, 0x02, 0x04, 0x05, 0x01, 0x07,
+    0x4F, 0x09, 0x04, 0x6D, 0x61, 0x64, 0x64, 0x00, 0x00, 0x05, 0x6E, 0x6D,
+    0x61, 0x64, 0x64, 0x00, 0x01, 0x03, 0x64, 0x6F, 0x74, 0x00, 0x02, 0x07,
+    0x64, 0x6F, 0x74, 0x5F, 0x61, 0x64, 0x64, 0x00, 0x03, 0x07, 0x73, 0x77,
+    0x69, 0x7A, 0x7A, 0x6C, 0x65, 0x00, 0x04, 0x0A, 0x6C, 0x61, 0x6E, 0x65,
+    0x73, 0x65, 0x6C, 0x65, 0x63, 0x74, 0x00, 0x05, 0x03, 0x6D, 0x69, 0x6E,
+    0x00, 0x06, 0x05, 0x74, 0x72, 0x75, 0x6E, 0x63, 0x00, 0x07, 0x07, 0x71,
+    0x31, 0x35, 0x6D, 0x75, 0x6C, 0x72, 0x00, 0x08, 0x0A, 0xB4, 0x01, 0x09,
+    0x14, 0x00, 0x20, 0x00, 0xFD, 0x13, 0x20, 0x01, 0xFD, 0x13, 0x20, 0x02,
+    0xFD, 0x13, 0xFD, 0x85, 0x02, 0xFD, 0x1F, 0x00, 0x0B, 0x14, 0x00, 0x20,
+    0x00, 0xFD, 0x13, 0x20, 0x01, 0xFD, 0x13, 0x20, 0x02, 0xFD, 0x13, 0xFD,
+    0x86, 0x02, 0xFD, 0x1F, 0x00, 0x0B, 0x10, 0x00, 0x20, 0x00, 0xFD, 0x0F,
+    0x20, 0x01, 0xFD, 0x0F, 0xFD, 0x92, 0x02, 0xFD, 0x18, 0x00, 0x0B, 0x14,
+    0x00, 0x20, 0x00, 0xFD, 0x0F, 0x20, 0x01, 0xFD, 0x0F, 0x20, 0x02, 0xFD,
+    0x11, 0xFD, 0x93, 0x02, 0xFD, 0x1B, 0x00, 0x0B, 0x1E, 0x00, 0xFD, 0x0C,
+    0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+    0x16, 0x17, 0x18, 0x19, 0x20, 0x00, 0xFD, 0x0F, 0xFD, 0x80, 0x02, 0xFD,
+    0x16, 0x00, 0x0B, 0x14, 0x00, 0x20, 0x00, 0xFD, 0x11, 0x20, 0x01, 0xFD,
+    0x11, 0x20, 0x02, 0xFD, 0x11, 0xFD, 0x8B, 0x02, 0xFD, 0x1B, 0x00, 0x0B,
+    0x10, 0x00, 0x20, 0x00, 0xFD, 0x13, 0x20, 0x01, 0xFD, 0x13, 0xFD, 0x8D,
+    0x02, 0xFD, 0x1F, 0x00, 0x0B, 0x0C, 0x00, 0x20, 0x00, 0xFD, 0x13, 0xFD,
+    0x81, 0x02, 0xFD, 0x1B, 0x00, 0x0B, 0x10, 0x00, 0x20, 0x00, 0xFD, 0x10,
+    0x20, 0x01, 0xFD, 0x10, 0xFD, 0x91, 0x02, 0xFD, 0x18, 0x00, 0x0B};
+
+class RelaxedSIMDTest : public testing::Test {
+protected:
+  void SetUp() override {
+    Conf.addProposal(WasmEdge::Proposal::RelaxedSIMD);
+    VM = std::make_unique<WasmEdge::VM::VM>(Conf);
+    ASSERT_TRUE(VM->loadWasm(RelaxedSIMDWasm));
+    ASSERT_TRUE(VM->validate());
+    ASSERT_TRUE(VM->instantiate());
+  }
+
+  template <typename R, typename... T> R run(std::string_view Name, T... Args) {
+    const std::vector<WasmEdge::ValVariant> Params = {Args...};
+    const std::vector<WasmEdge::ValType> ParamTypes = {
+        (std::is_same_v<T, float> ? WasmEdge::ValType::F32
+                                  : WasmEdge::ValType::I32)...};
+    auto Res = VM->execute(Name, Params, ParamTypes);
+    EXPECT_TRUE(Res);
+    return Res ? (*Res)[0].first.get<R>() : R{};
+  }
+
+  WasmEdge::Configure Conf;
+  std::unique_ptr<WasmEdge::VM::VM> VM;
+};
+
+TEST_F(RelaxedSIMDTest, MultiplyAdd) {
+  EXPECT_EQ(run<float>("madd", 2.0f, 3.0f, 4.0f), 10.0f);
+  EXPECT_EQ(run<float>("nmadd", 2.0f, 3.0f, 4.0f), -2.0f);
+}
+
+TEST_F(RelaxedSIMDTest, DotProduct) {
+  EXPECT_EQ(run<int32_t>("dot", -3, 5), -30);
+  EXPECT_EQ(run<int32_t>("dot_add", -3, 5, 7), -53);
+}
+
+TEST_F(RelaxedSIMDTest, Deterministic) {
+  // Only the inputs with the deterministic results are checked.
+  EXPECT_EQ(run<uint32_t>("swizzle", 3), 13U);
+  EXPECT_EQ(run<uint32_t>("swizzle", 200), 0U);
+  EXPECT_EQ(run<int32_t>("laneselect", 1, 2, -1), 1);
+  EXPECT_EQ(run<int32_t>("laneselect", 1, 2, 0), 2);
+  EXPECT_EQ(run<float>("min", 1.0f, 2.0f), 1.0f);
+  EXPECT_EQ(run<int32_t>("trunc", -2.5f), -2);
+  EXPECT_EQ(run<int32_t>("q15mulr", 0x4000, 0x4000), 0x2000);
+}
+
+TEST(RelaxedSIMDProposalTest, NeedProposal) {
+  WasmEdge::Configure Conf;
+  WasmEdge::VM::VM VM(Conf);
+  EXPECT_FALSE(VM.loadWasm(RelaxedSIMDWasm));
+}
+
+} // namespace
+
+GTEST_API_ int main(int argc, char **argv) {
+  WasmEdge::Log::setErrorLoggingLevel();
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -8,6 +8,7 @@
 #include "loader/loader.h"
 #include "po/argument_parser.h"
 #include "validator/validator.h"
+#include "vm/preinit.h"
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -38,6 +39,11 @@ int main(int Argc, const char *Argv[]) {
   PO::Option<PO::Toggle> ConfInterruptible(
       PO::Description("Generate a interruptible binary"sv));
 
+  PO::Option<std::string> PreInitFunc(
+      PO::Description(
+          "Run the exported function with the `[] -> []` type once at compile time, and snapshot the memories, tables, and globals into the output. Calling imported functions such as WASI in the function fails the compilation."sv),
+      PO::MetaVar("FUNCTION"sv));
+
   PO::Option<PO::Toggle> ConfEnableInstructionCounting(PO::Description(
       "Enable generating code for counting Wasm instructions executed."sv));
   PO::Option<PO::Toggle> ConfEnableGasMeasuring(PO::Description(
@@ -62,6 +68,8 @@ int main(int Argc, const char *Argv[]) {
   PO::Option<PO::Toggle> PropSIMD(PO::Description("Disable SIMD proposal"sv));
   PO::Option<PO::Toggle> PropMultiMem(
       PO::Description("Enable Multiple memories proposal"sv));
+  PO::Option<PO::Toggle> PropRelaxedSIMD(
+      PO::Description("Enable Relaxed SIMD proposal"sv));
   PO::Option<PO::Toggle> PropAll(PO::Description("Enable all features"sv));
 
   auto Parser = PO::ArgumentParser();
@@ -69,6 +77,7 @@ int main(int Argc, const char *Argv[]) {
            .add_option(SoName)
            .add_option("dump"sv, ConfDumpIR)
            .add_option("interruptible"sv, ConfInterruptible)
+           .add_option("pre-initialize"sv, PreInitFunc)
            .add_option("enable-instruction-count"sv,
                        ConfEnableInstructionCounting)
            .add_option("enable-gas-measuring"sv, ConfEnableGasMeasuring)
@@ -83,6 +92,7 @@ int main(int Argc, const char *Argv[]) {
            .add_option("disable-reference-types"sv, PropRefTypes)
            .add_option("disable-simd"sv, PropSIMD)
            .add_option("enable-multi-memory"sv, PropMultiMem)
+           .add_option("enable-relaxed-simd"sv, PropRelaxedSIMD)
            .add_option("enable-all"sv, PropAll)
            .parse(Argc, Argv)) {
     return EXIT_FAILURE;
@@ -117,8 +127,12 @@ int main(int Argc, const char *Argv[]) {
   if (PropMultiMem.value()) {
     Conf.addProposal(WasmEdge::Proposal::MultiMemories);
   }
+  if (PropRelaxedSIMD.value()) {
+    Conf.addProposal(WasmEdge::Proposal::RelaxedSIMD);
+  }
   if (PropAll.value()) {
     Conf.addProposal(WasmEdge::Proposal::MultiMemories);
+    Conf.addProposal(WasmEdge::Proposal::RelaxedSIMD);
   }
 
   std::filesystem::path InputPath = std::filesystem::absolute(WasmName.value());
@@ -134,6 +148,17 @@ int main(int Argc, const char *Argv[]) {
     return EXIT_FAILURE;
   }
 
+  if (!PreInitFunc.value().empty()) {
+    WasmEdge::VM::PreInitializer PreInit(Conf);
+    if (auto Res = PreInit.preInitialize(Data, PreInitFunc.value())) {
+      Data = std::move(*Res);
+    } else {
+      const auto Err = static_cast<uint32_t>(Res.error());
+      spdlog::error("Pre-initialization failed. Error code: {}", Err);
+      return EXIT_FAILURE;
+    }
+  }
+
   std::unique_ptr<WasmEdge::AST::Module> Module;
   if (auto Res = Loader.parseModule(Data)) {
     Module = std::move(*Res);
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <optional>
 #include <string>
@@ -62,6 +63,12 @@ int main(int Argc, const char *Argv[]) {
   PO::Option<PO::Toggle> PropSIMD(PO::Description("Disable SIMD proposal"sv));
   PO::Option<PO::Toggle> PropMultiMem(
       PO::Description("Enable Multiple memories proposal"sv));
+  PO::Option<PO::Toggle> PropExceptionHandling(
+      PO::Description("Enable Exception handling proposal"sv));
+  PO::Option<PO::Toggle> PropFunctionReferences(
+      PO::Description("Enable Typed function references proposal"sv));
+  PO::Option<PO::Toggle> PropRelaxedSIMD(
+      PO::Description("Enable Relaxed SIMD proposal"sv));
   PO::Option<PO::Toggle> PropAll(PO::Description("Enable all features"sv));
 
   PO::Option<PO::Toggle> ConfEnableInstructionCounting(PO::Description(
@@ -78,6 +85,20 @@ int main(int Argc, const char *Argv[]) {
           "Limitation of maximum time(in milliseconds) for execution, default value is 0 for no limitations"sv),
       PO::MetaVar("TIMEOUT"sv), PO::DefaultValue<uint64_t>(0));
 
+  PO::Option<uint64_t> CPUTimeLim(
+      PO::Description(
+          "Limitation of maximum CPU time(in milliseconds) for execution, default value is 0 for no limitations"sv),
+      PO::MetaVar("CPU_TIMEOUT"sv), PO::DefaultValue<uint64_t>(0));
+
+  PO::Option<std::string> ProfileOut(
+      PO::Description(
+          "Write the sampled profile of the wasm functions in the folded stack format to `PROFILE_FILE`."sv),
+      PO::MetaVar("PROFILE_FILE"sv), PO::DefaultValue<std::string>(""));
+  PO::Option<uint64_t> ProfileInterval(
+      PO::Description(
+          "Interval of CPU time(in microseconds) between profile samples, default value is 10000"sv),
+      PO::MetaVar("INTERVAL"sv), PO::DefaultValue<uint64_t>(10000));
+
   PO::List<int> GasLim(
       PO::Description(
           "Limitation of execution gas. Upper bound can be specified as --gas-limit `GAS_LIMIT`."sv),
@@ -114,8 +135,14 @@ int main(int Argc, const char *Argv[]) {
            .add_option("disable-reference-types"sv, PropRefTypes)
            .add_option("disable-simd"sv, PropSIMD)
            .add_option("enable-multi-memory"sv, PropMultiMem)
+           .add_option("enable-exception-handling"sv, PropExceptionHandling)
+           .add_option("enable-function-references"sv, PropFunctionReferences)
+           .add_option("enable-relaxed-simd"sv, PropRelaxedSIMD)
            .add_option("enable-all"sv, PropAll)
            .add_option("time-limit"sv, TimeLim)
+           .add_option("cpu-time-limit"sv, CPUTimeLim)
+           .add_option("profile"sv, ProfileOut)
+           .add_option("profile-interval"sv, ProfileInterval)
            .add_option("gas-limit"sv, GasLim)
            .add_option("memory-page-limit"sv, MemLim)
            .add_option("allow-command"sv, AllowCmd)
@@ -153,8 +180,20 @@ int main(int Argc, const char *Argv[]) {
   if (PropMultiMem.value()) {
     Conf.addProposal(WasmEdge::Proposal::MultiMemories);
   }
+  if (PropExceptionHandling.value()) {
+    Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+  }
+  if (PropFunctionReferences.value()) {
+    Conf.addProposal(WasmEdge::Proposal::FunctionReferences);
+  }
+  if (PropRelaxedSIMD.value()) {
+    Conf.addProposal(WasmEdge::Proposal::RelaxedSIMD);
+  }
   if (PropAll.value()) {
     Conf.addProposal(WasmEdge::Proposal::MultiMemories);
+    Conf.addProposal(WasmEdge::Proposal::ExceptionHandling);
+    Conf.addProposal(WasmEdge::Proposal::FunctionReferences);
+    Conf.addProposal(WasmEdge::Proposal::RelaxedSIMD);
   }
 
   std::optional<std::chrono::system_clock::time_point> Timeout;
@@ -187,11 +226,43 @@ int main(int Argc, const char *Argv[]) {
     }
   }
 
+  if (!ProfileOut.value().empty()) {
+    Conf.getStatisticsConfigure().setProfiling(true);
+    Conf.getStatisticsConfigure().setProfileInterval(
+        std::chrono::microseconds(ProfileInterval.value()));
+  }
+
   Conf.addHostRegistration(WasmEdge::HostRegistration::Wasi);
   Conf.addHostRegistration(WasmEdge::HostRegistration::WasmEdge_Process);
+  Conf.addHostRegistration(WasmEdge::HostRegistration::WasmEdge_Memory);
+  Conf.addHostRegistration(WasmEdge::HostRegistration::WasmEdge_Fs);
   const auto InputPath = std::filesystem::absolute(SoName.value());
   WasmEdge::VM::VM VM(Conf);
 
+  if (Conf.getStatisticsConfigure().isTimeMeasuring()) {
+    VM.getStatistics().setCPUTimeMeasuring(true);
+  }
+  if (CPUTimeLim.value() > 0) {
+    VM.getStatistics().setCPUTimeLimit(
+        std::chrono::milliseconds(CPUTimeLim.value()));
+  }
+
+  // Write the profile when leaving, whether the execution succeeded or not.
+  struct ProfileWriter {
+    WasmEdge::Profiler *Prof;
+    std::string Path;
+    ~ProfileWriter() noexcept {
+      if (!Prof) {
+        return;
+      }
+      std::ofstream File(std::filesystem::u8path(Path));
+      Prof->dumpFolded(File);
+      if (!File) {
+        std::cerr << "Failed to write the profile to " << Path << ".\n";
+      }
+    }
+  } ProfileWriterGuard{VM.getProfiler(), ProfileOut.value()};
+
   WasmEdge::Host::WasiModule *WasiMod =
       dynamic_cast<WasmEdge::Host::WasiModule *>(
           VM.getImportModule(WasmEdge::HostRegistration::Wasi));